@@ -38,6 +38,7 @@ struct Foption_t {
    int More;        // "M"  Improve fit results.
    int Range;       // "R"  Use the range stored in function
    int Gradient;    // "G"  Option to compute derivatives analytically
+   int NoGradient;  // "NOGRAD" Do not use by default the Clad gradient of formula-based functions
    int Nostore;     // "N"  If set, do not store the function graph
    int Nograph;     // "0"  If set, do not display the function graph
    int Plus;        // "+"  Add new function (default is replace)
@@ -64,6 +65,7 @@ struct Foption_t {
       More         (0),
       Range        (0),
       Gradient     (0),
+      NoGradient   (0),
       Nostore      (0),
       Nograph      (0),
       Plus         (0),
@@ -29,6 +29,8 @@ struct Foption_t;
 
 #include "TFitResultPtr.h"
 
+#include <vector>
+
 namespace ROOT {
 
    namespace Math {
@@ -44,6 +46,7 @@ namespace ROOT {
       class BinData;
       class UnBinData;
       class SparseData;
+      class BatchFitResult;
 
       enum class EFitObjectType {
          kHistogram,
@@ -100,6 +103,18 @@ namespace ROOT {
       */
       TFitResultPtr UnBinFit(ROOT::Fit::UnBinData * data, TF1 * f1 , Foption_t & option , const ROOT::Math::MinimizerOptions & moption);
 
+      /**
+          fit the function f1 to each histogram of hists, with the same fit
+          options as TH1::Fit except "U", "E", "M" and the weighted or
+          multinomial likelihood fits. The fit configuration, the minimizers and
+          the copies of f1 are set up once for all histograms. With implicit
+          multi-threading (unless option "SERIAL" is given) the histograms are
+          fitted in parallel, each fit running sequentially.
+          f1 is not modified: the parameters of each fit are returned in the
+          compact ROOT::Fit::BatchFitResult (see Fit/BatchFitter.h).
+      */
+      BatchFitResult FitHistograms(const std::vector<TH1 *> & hists, TF1 & f1, const char * option = "");
+
       /**
           fill the data vector from a TH1. Pass also the TF1 function which is
           needed in case of integral option and to reject points rejected by the function
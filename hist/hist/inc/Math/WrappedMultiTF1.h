@@ -131,6 +131,9 @@ namespace ROOT {
          // return capability of computing parameter Hessian
          bool HasParameterHessian() const override;
 
+         // return capability of evaluating many points at once (vectorized formula)
+         bool HasBatchEvaluation() const override;
+
          // evaluate the 2nd derivatives of the function with respect to the parameters
          bool ParameterG2(const T *, const double *, T *) const override {
             return false; // not yet implemented
@@ -178,6 +181,9 @@ namespace ROOT {
             return fFunc->EvalPar(x, nullptr);
          }
 
+         /// evaluate function on many points passing the coordinates per dimension and vector of parameters
+         void DoEvalParBatch(unsigned int n, const T *const *x, const double *p, T *result) const override;
+
          /// evaluate the partial derivative with respect to the parameter
          T DoParameterDerivative(const T *x, const double *p, unsigned int ipar) const override;
 
@@ -359,6 +365,58 @@ namespace ROOT {
          return GeneralHessianCalc<T>::IsAvailable(fFunc);
       }
 
+      // struct for dealing with the evaluation on many points, done at once only for TF1 based on a TFormula
+      template <class T>
+      struct GeneralBatchCalc {
+         static void EvalParBatch(TF1 *func, unsigned int ndim, unsigned int n, const T *const *x, const double *p, T *result)
+         {
+            std::vector<T> xx(ndim);
+            for (unsigned int i = 0; i < n; ++i) {
+               for (unsigned int j = 0; j < ndim; ++j)
+                  xx[j] = x[j][i];
+               result[i] = func->EvalPar(xx.data(), p);
+            }
+         }
+         static bool IsAvailable(TF1 *) { return false; }
+      };
+
+      template <>
+      struct GeneralBatchCalc<double> {
+         static void EvalParBatch(TF1 *func, unsigned int ndim, unsigned int n, const double *const *x, const double *p, double *result)
+         {
+            if (func->GetFormula() && !func->IsVectorized()) {
+               func->EvalParBatch(n, x, result, p);
+               return;
+            }
+            std::vector<double> xx(ndim);
+            for (unsigned int i = 0; i < n; ++i) {
+               for (unsigned int j = 0; j < ndim; ++j)
+                  xx[j] = x[j][i];
+               result[i] = func->EvalPar(xx.data(), p);
+            }
+         }
+         static bool IsAvailable(TF1 *func)
+         {
+            // the evaluation on many points is worth only when the formula loop is vectorized
+            auto formula = func->GetFormula();
+            if (!formula || func->IsVectorized())
+               return false;
+            return formula->GenerateBatchEval();
+         }
+      };
+
+      template <class T>
+      void WrappedMultiTF1Templ<T>::DoEvalParBatch(unsigned int n, const T *const *x, const double *p, T *result) const
+      {
+         GeneralBatchCalc<T>::EvalParBatch(fFunc, fDim, n, x, p, result);
+      }
+
+      template <class T>
+      bool WrappedMultiTF1Templ<T>::HasBatchEvaluation() const
+      {
+         return GeneralBatchCalc<T>::IsAvailable(fFunc);
+      }
+
       template <class T>
       T WrappedMultiTF1Templ<T>::DoParameterDerivative(const T *x, const double *p, unsigned int ipar) const
       {
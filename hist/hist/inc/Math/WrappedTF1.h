@@ -119,6 +119,10 @@ namespace ROOT {
             deriv = DoDerivative(x);
          }
 
+         /// return capability of evaluating many points at once: only for formulas whose
+         /// vectorized evaluation was already generated, see TFormula::GenerateBatchEval()
+         bool HasBatchEvaluation() const override;
+
          /// precision value used for calculating the derivative step-size
          /// h = eps * |x|. The default is 0.001, give a smaller in case function changes rapidly
          static void SetDerivPrecision(double eps);
@@ -148,6 +152,9 @@ namespace ROOT {
             return fFunc->EvalPar(fX, nullptr);
          }
 
+         /// evaluate function on many points using the cached parameter values (of TF1)
+         void DoEvalBatch(unsigned int n, const double *x, double *f) const override;
+
          /// return the function derivatives w.r.t. x
          double DoDerivative(double  x) const override;
 
@@ -458,6 +458,7 @@ public:
    //template <class T> T Eval(T x, T y = 0, T z = 0, T t = 0) const;
    virtual Double_t EvalPar(const Double_t *x, const Double_t *params = nullptr);
    template <class T> T EvalPar(const T *x, const Double_t *params = nullptr);
+   virtual void     EvalParBatch(Int_t n, const Double_t *const *x, Double_t *result, const Double_t *params = nullptr);
    virtual Double_t operator()(Double_t x, Double_t y = 0, Double_t z = 0, Double_t t = 0) const;
    template <class T> T operator()(const T *x, const Double_t *params = nullptr);
    void     ExecuteEvent(Int_t event, Int_t px, Int_t py) override;
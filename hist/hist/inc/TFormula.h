@@ -107,6 +107,8 @@ private:
    CallFuncSignature fFuncPtr = nullptr;           ///<! Function pointer, owned by the JIT.
    CallFuncSignature fGradFuncPtr = nullptr;       ///<! Function pointer, owned by the JIT.
    CallFuncSignature fHessFuncPtr = nullptr;       ///<! Function pointer, owned by the JIT.
+   CallFuncSignature fBatchFuncPtr = nullptr;      ///<! Function pointer, owned by the JIT.
+   std::atomic<Int_t> fBatchStatus{0};             ///<! Status of the batch evaluation: 0 not generated yet, 1 available, -1 not supported
    void *   fLambdaPtr = nullptr;                  ///<! Pointer to the lambda function
    static bool       fIsCladRuntimeIncluded;
 
@@ -133,6 +135,10 @@ private:
       assert(fClingName.Length() && "TFormula is not initialized yet!");
       return std::string(fClingName.Data()) + "_hessian_1";
    }
+   std::string GetBatchFuncName() const {
+      assert(fClingName.Length() && "TFormula is not initialized yet!");
+      return std::string(fClingName.Data()) + "_batch";
+   }
    bool HasGradientGenerationFailed() const {
       return !fGradFuncPtr && !fGradGenerationInput.empty();
    }
@@ -240,6 +246,19 @@ public:
       return fHessFuncPtr != nullptr;
    }
 
+   /// Generate the evaluation of the formula on many points at once, in a loop
+   /// vectorized by the compiler.
+   /// \returns true if it was generated and EvalParBatch uses it.
+   bool GenerateBatchEval();
+
+   /// Evaluate the formula on n points, x[i] pointing to the n values of the i-th variable.
+   void EvalParBatch(Int_t n, const Double_t *const *x, Double_t *result, const Double_t *params = nullptr) const;
+
+   // query if TFormula provides the vectorized evaluation on many points
+   bool HasGeneratedBatchEval() const {
+      return fBatchStatus > 0;
+   }
+
    // template <class T>
    // T Eval(T x, T y = 0, T z = 0, T t = 0) const;
    template <class T>
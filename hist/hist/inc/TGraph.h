@@ -29,6 +29,8 @@
 #include "TVectorDfwd.h"
 #include "TFitResultPtr.h"
 
+#include <memory>
+
 class TBrowser;
 class TAxis;
 class TH1;
@@ -38,6 +40,12 @@ class TF1;
 class TSpline;
 class TList;
 
+namespace ROOT {
+namespace Internal {
+class TGraphInterpolationCache;
+}
+}
+
 class TGraph : public TNamed, public TAttLine, public TAttFill, public TAttMarker {
 
 protected:
@@ -50,6 +58,7 @@ protected:
    TH1F              *fHistogram; ///< Pointer to histogram used for drawing axis
    Double_t           fMinimum;   ///< Minimum value for plotting along y
    Double_t           fMaximum;   ///< Maximum value for plotting along y
+   mutable std::shared_ptr<const ROOT::Internal::TGraphInterpolationCache> fInterpolation; ///<!Sorted points and spline used by Eval
 
    static void        SwapValues(Double_t* arr, Int_t pos1, Int_t pos2);
    virtual void       SwapPoints(Int_t pos1, Int_t pos2);
@@ -64,6 +73,7 @@ protected:
    virtual void       FillZero(Int_t begin, Int_t end, Bool_t from_ctor = kTRUE);
    Double_t         **ShrinkAndCopy(Int_t size, Int_t iend);
    virtual Bool_t     DoMerge(const TGraph * g);
+   std::shared_ptr<const ROOT::Internal::TGraphInterpolationCache> GetInterpolationCache(Bool_t spline) const;
 
    TString            SaveArray(std::ostream &out, const char *suffix, Int_t frameNumber, Double_t *arr);
    void               SaveHistogramAndFunctions(std::ostream &out, const char *varname, Int_t &frameNumber, Option_t *option);
@@ -110,6 +120,7 @@ public:
    virtual void          DrawGraph(Int_t n, const Double_t *x=nullptr, const Double_t *y=nullptr, Option_t *option="");
    virtual void          DrawPanel(); // *MENU*
    virtual Double_t      Eval(Double_t x, TSpline *spline=nullptr, Option_t *option="") const;
+   void                  Eval(Int_t n, const Double_t *x, Double_t *y, Option_t *option="") const;
    void                  ExecuteEvent(Int_t event, Int_t px, Int_t py) override;
    virtual void          Expand(Int_t newsize);
    virtual void          Expand(Int_t newsize, Int_t step);
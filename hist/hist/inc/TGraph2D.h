@@ -74,6 +74,8 @@ private:
 
 protected:
 
+   void ResetInterpolator();
+
 public:
 
    TGraph2D();
@@ -144,6 +146,7 @@ public:
    virtual Double_t      GetZminE() const {return GetZmin();}
    virtual Int_t         GetPoint(Int_t i, Double_t &x, Double_t &y, Double_t &z) const;
    Double_t              Interpolate(Double_t x, Double_t y);
+   void                  Interpolate(Int_t n, const Double_t *x, const Double_t *y, Double_t *z);
    void                  Paint(Option_t *option="") override;
    void          Print(Option_t *chopt="") const override;
    TH1                  *Project(Option_t *option="x") const; // *MENU*
@@ -22,6 +22,8 @@
 
 #include "TH2.h"
 
+#include <vector>
+
 class TH2PolyBin: public TObject{
 
 public:
@@ -102,6 +104,7 @@ public:
    const char  *GetBinName(Int_t bin) const;
    const char  *GetBinTitle(Int_t bin) const;
    Bool_t       GetFloat(){return fFloat;}
+   Bool_t       GetUseIndex() const{return fUseIndex;}
    Double_t     GetMaximum() const;
    Double_t     GetMaximum(Double_t maxval) const override;
    Double_t     GetMinimum() const;
@@ -118,6 +121,7 @@ public:
    void SetBinError(Int_t bin, Double_t error) override;
    void         SetBinContentChanged(Bool_t flag){fBinContentChanged = flag;}
    void         SetFloat(Bool_t flag = true);
+   void         SetUseIndex(Bool_t flag = true);
    void         SetNewBinAdded(Bool_t flag){fNewBinAdded = flag;}
    Bool_t       IsInsideBin(Int_t binnr, Double_t x, Double_t y);
    void GetStats(Double_t *stats) const override;
@@ -165,8 +169,21 @@ protected:
    Bool_t   fNewBinAdded;          ///<!For the 3D Painter
    Bool_t   fBinContentChanged;    ///<!For the 3D Painter
    TList   *fBins;                 ///< List of bins. The list owns the contained objects
+   Bool_t   fUseIndex;             ///< When set to kTRUE, bins are found using the spatial index instead of the partition
+   Bool_t   fIndexValid;           ///<!The spatial index is up to date with the bins
+   Int_t    fIndexNX;              ///<!Number of raster cells of the spatial index in the x-direction
+   Int_t    fIndexNY;              ///<!Number of raster cells of the spatial index in the y-direction
+   Double_t fIndexStepX;           ///<!Width of a raster cell
+   Double_t fIndexStepY;           ///<!Height of a raster cell
+   std::vector<Int_t>  fIndexOffsets;       ///<!Offset of the candidate bins of each raster cell in fIndexBins
+   std::vector<Int_t>  fIndexBins;          ///<!Candidate bins of the raster cells, as indices in fIndexBinPtrs
+   std::vector<Char_t> fIndexCovered;       ///<!Whether the last candidate bin of a raster cell covers the whole cell
+   std::vector<TH2PolyBin*> fIndexBinPtrs;  ///<!The bins, in the order of fBins
+   std::vector<TGraph*> fIndexGraphs;       ///<!The polygon of each bin if it is a TGraph, else nullptr
 
    void   AddBinToPartition(TH2PolyBin *bin);  // Adds the input bin into the partition matrix
+   void   BuildIndex();                        // Builds the spatial index of the bins
+   TH2PolyBin *FindPolyBin(Double_t x, Double_t y); // Finds the bin containing a point inside the histogram limits
    void   Initialize(Double_t xlow, Double_t xup, Double_t ylow, Double_t yup, Int_t n, Int_t m);
    Bool_t IsIntersecting(TH2PolyBin *bin, Double_t xclipl, Double_t xclipr, Double_t yclipb, Double_t yclipt);
    Bool_t IsIntersectingPolygon(Int_t bn, Double_t *x, Double_t *y, Double_t xclipl, Double_t xclipr, Double_t yclipb, Double_t yclipt);
@@ -178,7 +195,7 @@ protected:
       return (bin>=kNOverflow) ? SetBinContent(bin-kNOverflow+1,content) : SetBinContent(-bin-1,content);
    }
 
-   ClassDefOverride(TH2Poly,3)  //2-Dim histogram with polygon bins
+   ClassDefOverride(TH2Poly,4)  //2-Dim histogram with polygon bins
  };
 
 #endif
@@ -79,6 +79,8 @@ public:
            void     Copy(TObject &hnew) const override;
    virtual Int_t    Fill(Double_t x, Double_t y, Double_t z);
    virtual Int_t    Fill(Double_t x, Double_t y, Double_t z, Double_t w);
+   using TH1::FillN;
+   virtual void     FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w, Int_t stride=1);
 
    virtual Int_t    Fill(const char *namex, const char *namey, const char *namez, Double_t w);
    virtual Int_t    Fill(const char *namex, Double_t y, const char *namez, Double_t w);
@@ -142,6 +142,8 @@ public:
 
    void Sumw2() override;
 
+   Long64_t Merge(TCollection* list);
+
    /// Forwards to THnBase::Projection().
    /// Non-virtual, as a CINT-compatible replacement of a using declaration.
    TH1D*      Projection(Int_t xDim, Option_t* option = "") const {
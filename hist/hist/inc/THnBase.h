@@ -111,6 +111,7 @@ protected:
                           Bool_t wantNDim, Option_t* option = "") const;
    Bool_t PrintBin(Long64_t idx, Int_t* coord, Option_t* options) const;
    void AddInternal(const THnBase* h, Double_t c, Bool_t rebinned);
+   void AddStatistics(const THnBase* h, Double_t c);
    THnBase* RebinBase(Int_t group) const;
    THnBase* RebinBase(const Int_t* group) const;
    void ResetBase(Option_t *option= "");
@@ -38,8 +38,7 @@ class THnSparse: public THnBase {
    Int_t      fChunkSize;                   ///<  Number of entries for each chunk
    Long64_t   fFilledBins;                  ///<  Number of filled bins
    TObjArray  fBinContent;                  ///<  Array of THnSparseArrayChunk
-   TExMap     fBins;                        ///<! Filled bins
-   TExMap     fBinsContinued;               ///<! Filled bins for non-unique hashes, containing pairs of (bin index 0, bin index 1)
+   THnSparseHashTable fBins;                ///<! Filled bins
    THnSparseCompactBinCoord *fCompactCoord; ///<! Compact coordinate
 
    THnSparse(const THnSparse&) = delete;
@@ -58,8 +57,10 @@ class THnSparse: public THnBase {
    THnSparseArrayChunk* AddChunk();
    void Reserve(Long64_t nbins) override;
    void FillExMap();
+   void FillNParallel(Long64_t n, const Double_t *x, const Double_t *w);
    virtual TArray* GenerateArray() const = 0;
    Long64_t GetBinIndexForCurrentBin(Bool_t allocate);
+   Long64_t AllocateBin(const Char_t* buf);
 
    /// Increment the bin content of "bin" by "w",
    /// return the bin index.
@@ -124,6 +125,8 @@ class THnSparse: public THnBase {
    Double_t GetBinContent(Long64_t bin, Int_t* idx = nullptr) const override;
    Double_t GetBinError2(Long64_t linidx) const override;
 
+   void FillN(Long64_t n, const Double_t *x, const Double_t *w = nullptr);
+
    Double_t GetSparseFractionBins() const;
    Double_t GetSparseFractionMem() const;
 
@@ -23,6 +23,9 @@
 
 #include "TObject.h"
 
+#include <array>
+#include <vector>
+
 class TBrowser;
 class TH1;
 class THnSparse;
@@ -66,5 +69,140 @@ class THnSparseArrayChunk: public TObject {
 
    ClassDefOverride(THnSparseArrayChunk, 1); // chunks of linearized bins
 };
+
+/// Map from the hash of a compact bin coordinate to the linear bin index + 1,
+/// used by THnSparse to find its filled bins.
+/// The table is split in kNShards shards, selected by the high bits of the
+/// (mixed) hash, that can be modified concurrently by different threads.
+/// Each shard is a flat, open-addressing table with linear probing; entries
+/// with the same hash (possible if the compact coordinate is larger than 8
+/// bytes) simply occupy consecutive slots and are told apart by the caller.
+/// A value of 0 denotes an empty slot.
+/// IsFilled() tells in constant time whether entries were inserted; entries
+/// inserted directly in the shards must be recorded with SetFilled().
+class THnSparseHashTable {
+public:
+   enum { kNShards = 64 };
+
+   struct Slot {
+      ULong64_t fHash;  ///< Hash of the compact bin coordinate
+      Long64_t  fValue; ///< Bin index + 1; 0 if empty
+   };
+
+   class Shard {
+   public:
+      /// Return the first value with hash "hash" accepted by match(value), 0 if none.
+      template <class MATCH>
+      Long64_t Find(ULong64_t hash, MATCH &&match) const {
+         if (fSlots.empty()) return 0;
+         const size_t mask = fSlots.size() - 1;
+         for (size_t i = Mix(hash) & mask; fSlots[i].fValue; i = (i + 1) & mask)
+            if (fSlots[i].fHash == hash && match(fSlots[i].fValue))
+               return fSlots[i].fValue;
+         return 0;
+      }
+
+      /// Add the pair (hash, value); value must not be 0.
+      void Insert(ULong64_t hash, Long64_t value) {
+         if (4 * (fSize + 1) > 3 * (Long64_t)fSlots.size())
+            Rehash(fSlots.empty() ? kMinSlots : 2 * fSlots.size());
+         Put(hash, value);
+         ++fSize;
+      }
+
+      /// Replace the value of the pair (hash, oldValue) by newValue.
+      void Replace(ULong64_t hash, Long64_t oldValue, Long64_t newValue) {
+         const size_t mask = fSlots.size() - 1;
+         for (size_t i = Mix(hash) & mask; fSlots[i].fValue; i = (i + 1) & mask)
+            if (fSlots[i].fHash == hash && fSlots[i].fValue == oldValue) {
+               fSlots[i].fValue = newValue;
+               return;
+            }
+      }
+
+      /// Make room for n entries without rehashing. The smallest table is
+      /// left to the first Insert(), so that empty shards use no memory.
+      void Reserve(Long64_t n) {
+         size_t nslots = kMinSlots;
+         while (3 * nslots < 4 * (size_t)n) nslots *= 2;
+         if (nslots > kMinSlots && nslots > fSlots.size()) Rehash(nslots);
+      }
+
+      void Clear() { std::vector<Slot>().swap(fSlots); fSize = 0; }
+      Long64_t GetSize() const { return fSize; }
+      Long64_t GetCapacity() const { return fSlots.size(); }
+
+   private:
+      enum { kMinSlots = 16 };
+
+      void Put(ULong64_t hash, Long64_t value) {
+         const size_t mask = fSlots.size() - 1;
+         size_t i = Mix(hash) & mask;
+         while (fSlots[i].fValue) i = (i + 1) & mask;
+         fSlots[i].fHash = hash;
+         fSlots[i].fValue = value;
+      }
+
+      void Rehash(size_t nslots) {
+         std::vector<Slot> old(nslots, Slot{0, 0});
+         old.swap(fSlots);
+         for (const Slot &slot: old)
+            if (slot.fValue) Put(slot.fHash, slot.fValue);
+      }
+
+      std::vector<Slot> fSlots; ///< Slots; their number is a power of 2
+      Long64_t fSize = 0;       ///< Number of used slots
+   };
+
+   /// Scramble the bits of hash; compact coordinates are not random at all.
+   static ULong64_t Mix(ULong64_t hash) {
+      hash ^= hash >> 33;
+      hash *= 0xff51afd7ed558ccdULL;
+      hash ^= hash >> 33;
+      hash *= 0xc4ceb9fe1a85ec53ULL;
+      hash ^= hash >> 33;
+      return hash;
+   }
+   static Int_t GetShardIndex(ULong64_t hash) { return Mix(hash) >> 58; }
+
+   Shard &GetShard(Int_t i) { return fShards[i]; }
+
+   template <class MATCH>
+   Long64_t Find(ULong64_t hash, MATCH &&match) const {
+      return fShards[GetShardIndex(hash)].Find(hash, match);
+   }
+   void Insert(ULong64_t hash, Long64_t value) {
+      fShards[GetShardIndex(hash)].Insert(hash, value);
+      fFilled = kTRUE;
+   }
+
+   /// Whether entries were inserted since the construction or the last Clear().
+   Bool_t IsFilled() const { return fFilled; }
+   /// Record that entries were inserted through GetShard().
+   void SetFilled() { fFilled = kTRUE; }
+
+   void Reserve(Long64_t n) {
+      for (Shard &shard: fShards) shard.Reserve(n / kNShards + 1);
+   }
+   void Clear() {
+      for (Shard &shard: fShards) shard.Clear();
+      fFilled = kFALSE;
+   }
+   Long64_t GetSize() const {
+      Long64_t size = 0;
+      for (const Shard &shard: fShards) size += shard.GetSize();
+      return size;
+   }
+   /// Memory used by the slots, in bytes.
+   Long64_t GetMemory() const {
+      Long64_t n = 0;
+      for (const Shard &shard: fShards) n += shard.GetCapacity();
+      return n * sizeof(Slot);
+   }
+
+private:
+   std::array<Shard, kNShards> fShards; ///< Shards of the table
+   Bool_t fFilled = kFALSE;             ///< Whether entries were inserted
+};
 #endif // ROOT_THnSparse_Internal
 
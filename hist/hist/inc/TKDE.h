@@ -76,6 +76,14 @@ public:
       kForcedBinning
    };
 
+   /// Evaluation of the kernel sums.
+   /// They can be set using SetEvaluation()
+   enum EEvaluation {
+      kExact, ///< Sum the kernels of all data points
+      kFFT,   ///< Convolve the data with the kernel on a fine grid using a FFT and interpolate (fixed kernels)
+      kTree   ///< Sum only the kernels whose support contains the point, found with a tree of the data points
+   };
+
    ///  default constructor used only by I/O
    TKDE();
 
@@ -88,6 +96,8 @@ public:
    /// For this reason, by default for Nevents >=10000, the data are automatically binned  in
    /// nbins=Min(10000,Nevents/10)
    /// In case of ForceBinning option the default number of bins is 1000
+   /// For large data sets the kernel sums can also be accelerated with the option "Evaluation:FFT" or
+   /// "Evaluation:Tree" (see EEvaluation); the default is "Evaluation:Exact".
    TKDE(UInt_t events, const Double_t* data, Double_t xMin = 0.0, Double_t xMax = 0.0, const Option_t* option =
                  "KernelType:Gaussian;Iteration:Adaptive;Mirror:noMirror;Binning:RelaxedBinning", Double_t rho = 1.0) {
       Instantiate( nullptr,  events, data, nullptr, xMin, xMax, option, rho);
@@ -119,6 +129,7 @@ public:
    void SetIteration(EIteration iter);
    void SetMirror(EMirror mir);
    void SetBinning(EBinning);
+   void SetEvaluation(EEvaluation eval);
    void SetNBins(UInt_t nbins);
    void SetUseBinsNEvents(UInt_t nEvents);
    void SetTuneFactor(Double_t rho);
@@ -164,9 +175,24 @@ public:
       TKDE *fKDE;
       UInt_t fNWeights;               ///< Number of kernel weights (bandwidth as vectorized for binning)
       std::vector<Double_t> fWeights; ///< Kernel weights (bandwidth)
+      std::vector<Double_t> fGrid;    ///< Estimated density on a regular grid (FFT evaluation)
+      Double_t fGridMin = 0.;         ///< Position of the first grid point
+      Double_t fGridStep = 0.;        ///< Distance between the grid points
+      std::vector<Double_t> fTreeX;   ///< Kernel centres sorted by position (tree evaluation)
+      std::vector<Double_t> fTreeW;   ///< Count divided by the bandwidth of each kernel centre
+      std::vector<Double_t> fTreeInvH;///< Inverse of the bandwidth of each kernel centre
+      std::vector<Double_t> fTreeMin; ///< Lower end of the kernel supports of each tree node
+      std::vector<Double_t> fTreeMax; ///< Upper end of the kernel supports of each tree node
+      UInt_t fTreeNLeaves = 0;        ///< Number of leaves of the tree (power of 2)
+
+      void GetKernelCentres(std::vector<Double_t> &x, std::vector<Double_t> &count, std::vector<Double_t> &bandwidth) const;
+      Double_t EvalGrid(Double_t x) const;
+      Double_t EvalTree(Double_t x) const;
    public:
       TKernel(Double_t weight, TKDE *kde);
       void ComputeAdaptiveWeights();
+      void BuildGrid();
+      void BuildTree();
       Double_t operator()(Double_t x) const;
       Double_t GetWeight(Double_t x) const;
       Double_t GetFixedWeight() const;
@@ -200,6 +226,7 @@ private:
    EIteration fIteration;
    EMirror fMirror;
    EBinning fBinning;
+   EEvaluation fEvaluation;            ///< Evaluation of the kernel sums
 
 
    Bool_t fUseMirroring, fMirrorLeft, fMirrorRight, fAsymLeft, fAsymRight;
@@ -235,6 +262,12 @@ private:
    void Instantiate(KernelFunction_Ptr kernfunc, UInt_t events, const Double_t* data, const Double_t* weight,
                     Double_t xMin, Double_t xMax, const Option_t* option, Double_t rho);
 
+   /// Returns the half-width of the support of the (unit) kernel, 0 if unknown
+   inline Double_t GetKernelSupport() const {
+      // GaussianKernel is cut at 9 sigmas
+      return fKernelType == kGaussian ? 9. : (fKernelType < kUserDefined ? 1. : 0.);
+   }
+
    /// Returns the kernel evaluation at x
    inline Double_t GaussianKernel(Double_t x) const {
       Double_t k2_PI_ROOT_INV = 0.398942280401432703; // (2 * M_PI)**-0.5
@@ -298,7 +331,7 @@ private:
    TF1* GetPDFUpperConfidenceInterval(Double_t confidenceLevel = 0.95, UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
    TF1* GetPDFLowerConfidenceInterval(Double_t confidenceLevel = 0.95, UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
 
-   ClassDefOverride(TKDE, 3) // One dimensional semi-parametric Kernel Density Estimation
+   ClassDefOverride(TKDE, 4) // One dimensional semi-parametric Kernel Density Estimation
 
 };
 
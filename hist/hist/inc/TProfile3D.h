@@ -61,6 +61,8 @@ protected:
    Int_t             Fill(Double_t, const char *, const char *, Double_t) override {return TH3::Fill(0); } //MayNotUse
    Int_t             Fill(Double_t, const char *, Double_t, Double_t) override {return TH3::Fill(0); } //MayNotUse
    Int_t             Fill(Double_t, Double_t, const char *, Double_t) override {return TH3::Fill(0); } //MayNotUse
+   void              FillN(Int_t, const Double_t *, const Double_t *, const Double_t *, const Double_t *, Int_t) override
+                     { MayNotUse("FillN(Int_t, Double_t*, Double_t*, Double_t*, Double_t*, Int_t)"); }
 
    Double_t RetrieveBinContent(Int_t bin) const override { return (fBinEntries.fArray[bin] > 0) ? fArray[bin]/fBinEntries.fArray[bin] : 0; }
    //virtual void     UpdateBinContent(Int_t bin, Double_t content);
@@ -107,6 +109,8 @@ public:
    void      ExtendAxis(Double_t x, TAxis *axis) override;
    Int_t     Fill(Double_t x, Double_t y, Double_t z, Double_t t) override;
    virtual Int_t     Fill(Double_t x, Double_t y, Double_t z, Double_t t, Double_t w);
+   virtual void      FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *t,
+                           const Double_t *w, Int_t stride=1);
    Double_t  GetBinContent(Int_t bin) const override;
    Double_t  GetBinContent(Int_t,Int_t) const override
                      { MayNotUse("GetBinContent(Int_t, Int_t"); return -1; }
@@ -13,6 +13,7 @@
 #include "THnBase.h"
 
 #include "Fit/Fitter.h"
+#include "Fit/BatchFitter.h"
 #include "Fit/FitConfig.h"
 #include "Fit/BinData.h"
 #include "Fit/UnBinData.h"
@@ -35,6 +36,7 @@
 #include "TFitResultPtr.h"
 #include "TFitResult.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cmath>
 #include <memory>
@@ -62,6 +64,10 @@ namespace HFit {
 
    void CheckGraphFitOptions(Foption_t &fitOption);
 
+   bool UseCladGradient(TF1 * f1, const Foption_t & fitOption);
+
+   void SetParameterSettings(ROOT::Fit::FitConfig & fitConfig, const TF1 * f1);
+
 
    void GetDrawingRange(TH1 * h1, ROOT::Fit::DataRange & range);
    void GetDrawingRange(TGraph * gr, ROOT::Fit::DataRange & range);
@@ -236,8 +242,12 @@ TFitResultPtr HFit::Fit(FitObject * h1, TF1 *f1 , Foption_t & fitOption , const
 
 
    // set the fit function
-   // if option grad is specified use gradient
-   if ( (linear || fitOption.Gradient) )
+   // if option grad is specified use gradient. Formula-based functions use by
+   // default the gradient generated with Clad, when it is available and the
+   // chi2 gradient does not need the errors on the coordinates
+   bool cladGradient = !linear && !fitOption.Gradient && !fitdata->HaveCoordErrors() &&
+                       !fitdata->HaveAsymErrors() && HFit::UseCladGradient(f1, fitOption);
+   if ( (linear || fitOption.Gradient || cladGradient) )
       fitter->SetFunction(ROOT::Math::WrappedMultiTF1(*f1));
 #ifdef R__HAS_VECCORE
    else if(f1->IsVectorized())
@@ -259,42 +269,7 @@ TFitResultPtr HFit::Fit(FitObject * h1, TF1 *f1 , Foption_t & fitOption , const
 
    // parameter settings and transfer the parameters values, names and limits from the functions
    // is done automatically in the Fitter.cxx
-   for (int i = 0; i < npar; ++i) {
-      ROOT::Fit::ParameterSettings & parSettings = fitConfig.ParSettings(i);
-
-      // check limits
-      double plow,pup;
-      f1->GetParLimits(i,plow,pup);
-      if (plow*pup != 0 && plow >= pup) { // this is a limitation - cannot fix a parameter to zero value
-         parSettings.Fix();
-      }
-      else if (plow < pup ) {
-         if (!TMath::Finite(pup) && TMath::Finite(plow) )
-            parSettings.SetLowerLimit(plow);
-         else if (!TMath::Finite(plow) && TMath::Finite(pup) )
-            parSettings.SetUpperLimit(pup);
-         else
-            parSettings.SetLimits(plow,pup);
-      }
-
-      // set the parameter step size (by default are set to 0.3 of value)
-      // if function provides meaningful error values
-      double err = f1->GetParError(i);
-      if ( err > 0)
-         parSettings.SetStepSize(err);
-      else if (plow < pup && TMath::Finite(plow) && TMath::Finite(pup) ) { // in case of limits improve step sizes
-         double step = 0.1 * (pup - plow);
-         // check if value is not too close to limit otherwise trim value
-         if (  parSettings.Value() < pup && pup - parSettings.Value() < 2 * step  )
-            step = (pup - parSettings.Value() ) / 2;
-         else if ( parSettings.Value() > plow && parSettings.Value() - plow < 2 * step )
-            step = (parSettings.Value() - plow ) / 2;
-
-         parSettings.SetStepSize(step);
-      }
-
-
-   }
+   HFit::SetParameterSettings(fitConfig, f1);
 
    // needed for setting precision ?
    //   - Compute sum of squares of errors in the bin range
@@ -699,6 +674,12 @@ void ROOT::Fit::FitOptionsMake(EFitObjectType type, const char *option, Foption_
    TString opt = option;
    opt.ToUpper();
 
+   // parse first the options containing letters of other options
+   if (opt.Contains("NOGRAD")) {
+      fitOption.NoGradient = 1;
+      opt.ReplaceAll("NOGRAD","");
+   }
+
    // parse firt the specific options
    if (type == EFitObjectType::kHistogram) {
 
@@ -800,6 +781,66 @@ void ROOT::Fit::FitOptionsMake(EFitObjectType type, const char *option, Foption_
 
 }
 
+void HFit::SetParameterSettings(ROOT::Fit::FitConfig & fitConfig, const TF1 * f1) {
+   // set the limits, the fixed parameters and the step sizes of the fit configuration from the function
+   int npar = f1->GetNpar();
+   for (int i = 0; i < npar; ++i) {
+      ROOT::Fit::ParameterSettings & parSettings = fitConfig.ParSettings(i);
+
+      // check limits
+      double plow,pup;
+      f1->GetParLimits(i,plow,pup);
+      if (plow*pup != 0 && plow >= pup) { // this is a limitation - cannot fix a parameter to zero value
+         parSettings.Fix();
+      }
+      else if (plow < pup ) {
+         if (!TMath::Finite(pup) && TMath::Finite(plow) )
+            parSettings.SetLowerLimit(plow);
+         else if (!TMath::Finite(plow) && TMath::Finite(pup) )
+            parSettings.SetUpperLimit(pup);
+         else
+            parSettings.SetLimits(plow,pup);
+      }
+
+      // set the parameter step size (by default are set to 0.3 of value)
+      // if function provides meaningful error values
+      double err = f1->GetParError(i);
+      if ( err > 0)
+         parSettings.SetStepSize(err);
+      else if (plow < pup && TMath::Finite(plow) && TMath::Finite(pup) ) { // in case of limits improve step sizes
+         double step = 0.1 * (pup - plow);
+         // check if value is not too close to limit otherwise trim value
+         if (  parSettings.Value() < pup && pup - parSettings.Value() < 2 * step  )
+            step = (pup - parSettings.Value() ) / 2;
+         else if ( parSettings.Value() > plow && parSettings.Value() - plow < 2 * step )
+            step = (parSettings.Value() - plow ) / 2;
+
+         parSettings.SetStepSize(step);
+      }
+
+
+   }
+}
+
+bool HFit::UseCladGradient(TF1 * f1, const Foption_t & fitOption) {
+   // Check if the minimization can use the parameter gradient of a
+   // formula-based function generated with Clad. Its Hessian is then also used
+   // by Minuit2 when it can be generated.
+   // This is not done with option "NOGRAD", for user-defined objective
+   // functions, for bin integrals and for vectorized functions, which would
+   // lose their vectorized evaluation.
+   if (fitOption.NoGradient || fitOption.User || fitOption.Integral || f1->IsVectorized())
+      return false;
+   TFormula * formula = f1->GetFormula();
+   if (!formula)
+      return false;
+   // Clad is only available if ROOT was built with it
+   static const bool hasClad = TString(gROOT->GetConfigFeatures()).Contains("clad");
+   if (!hasClad)
+      return false;
+   return formula->GenerateGradientPar();
+}
+
 void HFit::CheckGraphFitOptions(Foption_t & foption) {
    if (foption.Like) {
       Info("CheckGraphFitOptions","L (Log Likelihood fit) is an invalid option when fitting a graph. It is ignored");
@@ -843,7 +884,7 @@ TFitResultPtr ROOT::Fit::UnBinFit(ROOT::Fit::UnBinData * data, TF1 * fitfunc, Fo
    // set the fit function
    // if option grad is specified use gradient
    // need to create a wrapper for an automatic  normalized TF1 ???
-   if ( fitOption.Gradient ) {
+   if ( fitOption.Gradient || ((int) dim == fitfunc->GetNdim() && HFit::UseCladGradient(fitfunc, fitOption)) ) {
       assert ( (int) dim == fitfunc->GetNdim() );
       fitter->SetFunction(ROOT::Math::WrappedMultiTF1(*fitfunc) );
    }
@@ -1021,6 +1062,78 @@ TFitResultPtr ROOT::Fit::FitObject(THnBase * s1, TF1 *f1 , Foption_t & foption ,
 // }
 
 
+// implementation of the batch fit of histograms (defined in HFitInterface)
+
+ROOT::Fit::BatchFitResult ROOT::Fit::FitHistograms(const std::vector<TH1 *> & hists, TF1 & f1, const char * option) {
+   // fit the same function to many histograms, reusing the fit configuration,
+   // the minimizers and the copies of the function for all of them
+
+   Foption_t fitOption;
+   ROOT::Fit::FitOptionsMake(EFitObjectType::kHistogram, option, fitOption);
+   if (fitOption.User || fitOption.Errors || fitOption.More || fitOption.Like > 1)
+      Warning("FitHistograms", "Options U, E, M and weighted or multinomial likelihood fits are not supported, they are ignored");
+
+   ROOT::Math::WrappedMultiTF1 wf(f1);
+   wf.SetAndCopyFunction(&f1); // the clones of the batch fitter must be independent
+   const bool useGradient = fitOption.Gradient || HFit::UseCladGradient(&f1, fitOption);
+   ROOT::Fit::BatchFitter fitter(wf, useGradient);
+   ROOT::Fit::FitConfig & fitConfig = fitter.Config();
+   HFit::SetParameterSettings(fitConfig, &f1);
+   if (fitOption.Verbose) fitConfig.MinimizerOptions().SetPrintLevel(3);
+   if (fitOption.Quiet)    fitConfig.MinimizerOptions().SetPrintLevel(0);
+
+   // create options, as in HFit::Fit
+   ROOT::Fit::DataOptions opt;
+   opt.fIntegral = fitOption.Integral;
+   opt.fUseRange = fitOption.Range;
+   opt.fExpErrors = fitOption.PChi2;
+   if (fitOption.Like || fitOption.PChi2) opt.fUseEmpty = true;
+   if (fitOption.W1 ) opt.fErrors1 = true;
+   if (fitOption.W1 > 1) opt.fUseEmpty = true;
+   if (fitOption.PChi2 == 1) opt.fErrors1 = true;
+   ROOT::Fit::DataRange range;
+   if (opt.fUseRange) HFit::GetFunctionRange(f1, range);
+
+   // error normalization, as in HFit::Fit: in case of W or WW options (weights = 1),
+   // the data sets without errors are normalized by the BatchFitter
+   if (opt.fErrors1) fitConfig.SetNormErrors(true);
+   // normalize errors also in case you are fitting a Ndim histo with a N-1 function
+   auto firstHist = std::find_if(hists.begin(), hists.end(), [](const TH1 * h) { return h != nullptr; });
+   if (firstHist != hists.end() && f1.GetNdim() == HFit::GetDimension(*firstHist) - 1) fitConfig.SetNormErrors(true);
+
+   // initial values of the parameters of the predefined functions, as in HFit::Fit
+   const int special = f1.GetNumber();
+   auto initParams = [&](const ROOT::Fit::BinData & data, TF1 * f) {
+      if (fitOption.Bound) return;
+      if (special == 100 || special == 400) ROOT::Fit::InitGaus(data, f);
+      else if (special == 110 || special == 112 || special == 410) ROOT::Fit::Init2DGaus(data, f);
+      else if (special == 200) ROOT::Fit::InitExpo(data, f);
+   };
+
+   // fill the data and the initial values of the parameters. This is done
+   // sequentially, as FillData uses the global reject-point flag of TF1
+   // (TF1::RejectPoint()); only the fits are run in parallel
+   const unsigned int nhists = hists.size();
+   const int npar = f1.GetNpar();
+   std::vector<std::shared_ptr<ROOT::Fit::BinData>> data(nhists);
+   std::vector<double> params(nhists * npar);
+   TF1 f(f1);
+   for (unsigned int i = 0; i < nhists; ++i) {
+      if (!hists[i]) continue;
+      data[i] = std::make_shared<ROOT::Fit::BinData>(opt, range);
+      ROOT::Fit::FillData(*data[i], hists[i], &f);
+      f.SetParameters(f1.GetParameters());
+      initParams(*data[i], &f);
+      std::copy(f.GetParameters(), f.GetParameters() + npar, params.begin() + i * npar);
+   }
+
+   if (fitOption.Like)
+      fitter.LikelihoodFit(data, true, params.data(), fitOption.ExecPolicy);
+   else
+      fitter.Fit(data, params.data(), fitOption.ExecPolicy);
+   return fitter.Result();
+}
+
 // function to compute the simple chi2 for graphs and histograms
 
 
@@ -1530,6 +1530,40 @@ Double_t TF1::EvalPar(const Double_t *x, const Double_t *params)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate function on n points with given parameters.
+///
+/// The values are stored in the array result, of size n. The coordinates
+/// are given per dimension: for a 1-D function x[0] points to the n values of
+/// the points, for a multi-dimensional function x[i] points to the n values
+/// of the i-th coordinate.
+/// If argument params is omitted or equal 0, the internal values
+/// of parameters will be used instead.
+///
+/// For a function defined by a formula, all points are evaluated with
+/// TFormula::EvalParBatch in a loop vectorized by the compiler, when all the
+/// functions used in the formula can be vectorized. Otherwise the points are
+/// evaluated one by one with EvalPar.
+
+void TF1::EvalParBatch(Int_t n, const Double_t *const *x, Double_t *result, const Double_t *params)
+{
+   if (fType == EFType::kFormula) {
+      assert(fFormula);
+      fFormula->EvalParBatch(n, x, result, params);
+      if (fNormalized && fNormIntegral != 0) {
+         for (Int_t i = 0; i < n; ++i)
+            result[i] /= fNormIntegral;
+      }
+      return;
+   }
+   std::vector<Double_t> xx(std::max(fNdim, 1));
+   for (Int_t i = 0; i < n; ++i) {
+      for (Int_t idim = 0; idim < fNdim; ++idim)
+         xx[idim] = x[idim][i];
+      result[i] = EvalPar(xx.data(), params);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action corresponding to one event.
 ///
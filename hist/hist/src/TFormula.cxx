@@ -9,6 +9,7 @@
  * For the list of contributors see $ROOTSYS/README/CREDITS.             *
  *************************************************************************/
 
+#include "RConfigure.h"
 #include "TROOT.h"
 #include "TBuffer.h"
 #include "TMethod.h"
@@ -757,6 +758,8 @@ void TFormula::Copy(TObject &obj) const
    fnew.fHessGenerationInput = fHessGenerationInput;
    fnew.fGradFuncPtr = fGradFuncPtr;
    fnew.fHessFuncPtr = fHessFuncPtr;
+   fnew.fBatchFuncPtr = fBatchFuncPtr;
+   fnew.fBatchStatus = fBatchStatus.load();
 
 }
 
@@ -779,6 +782,8 @@ void TFormula::Clear(Option_t * )
    fReadyToExecute = false;
    fClingInitialized = false;
    fAllParametersSetted = false;
+   fBatchFuncPtr = nullptr;
+   fBatchStatus = 0;
    fFuncs.clear();
    fVars.clear();
    fParams.clear();
@@ -2334,6 +2339,9 @@ void TFormula::ProcessFormula(TString &formula)
          // set the cling name using hash of the static formulae map
          auto hasher = gClingFunctions.hash_function();
          fClingName = TString::Format("%s__id%zu", gNamePrefix.Data(), hasher(inputFormulaVecFlag));
+         // the batch evaluation of the previous expression cannot be used anymore
+         fBatchFuncPtr = nullptr;
+         fBatchStatus = 0;
 
          fClingInput = TString::Format("%s %s(%s){ return %s ; }", argType.Data(), fClingName.Data(),
                                        argumentsPrototype.Data(), inputFormula.c_str());
@@ -3325,6 +3333,170 @@ void TFormula::HessianPar(const Double_t *x, Double_t *result) {
    CallCladFunction(fHessFuncPtr, vars, pars, result, fNpar * fNpar);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Translate the expression passed to Cling into the one evaluated in the loop
+/// of the batch evaluation, replacing the mathematical functions by versions
+/// that the compiler can vectorize (from VDT when available).
+/// Return false if the expression uses a function or a name which cannot be
+/// vectorized, in which case no batch evaluation is generated.
+
+static bool TranslateBatchExpression(const TString &expr, TString &batchExpr)
+{
+   static const std::map<TString, TString> batchFunctions = {
+#ifdef R__HAS_VDT
+      {"TMath::Exp", "vdt::fast_exp"},     {"TMath::Log", "vdt::fast_log"},   {"TMath::Sin", "vdt::fast_sin"},
+      {"TMath::Cos", "vdt::fast_cos"},     {"TMath::Tan", "vdt::fast_tan"},   {"TMath::ASin", "vdt::fast_asin"},
+      {"TMath::ACos", "vdt::fast_acos"},   {"TMath::ATan", "vdt::fast_atan"}, {"TMath::ATan2", "vdt::fast_atan2"},
+#endif
+      {"TMath::Sqrt", "TMath::Sqrt"},      {"TMath::Abs", "TMath::Abs"},      {"TMath::Sq", "TMath::Sq"},
+      {"TMath::Floor", "TMath::Floor"},    {"TMath::Ceil", "TMath::Ceil"},    {"TMath::Min", "TMath::Min"},
+      {"TMath::Max", "TMath::Max"}};
+
+   batchExpr = "";
+   const Ssiz_t len = expr.Length();
+   Ssiz_t i = 0;
+   while (i < len) {
+      const char c = expr[i];
+      if (isdigit(c) || c == '.') {
+         // numbers, including the ones in scientific notation
+         Ssiz_t j = i + 1;
+         while (j < len && (isalnum(expr[j]) || expr[j] == '.' ||
+                            ((expr[j] == '+' || expr[j] == '-') && (expr[j - 1] == 'e' || expr[j - 1] == 'E'))))
+            ++j;
+         batchExpr.Append(expr(i, j - i));
+         i = j;
+      } else if (isalpha(c) || c == '_') {
+         Ssiz_t j = i + 1;
+         while (j < len && (isalnum(expr[j]) || expr[j] == '_' || expr[j] == ':'))
+            ++j;
+         const TString name = expr(i, j - i);
+         Ssiz_t k = j;
+         while (k < len && isspace(expr[k]))
+            ++k;
+         if ((name == "x" || name == "p") && k < len && expr[k] == '[') {
+            // variables and parameters
+            batchExpr.Append(name);
+         } else if (k < len && expr[k] == '(') {
+            auto it = batchFunctions.find(name);
+            if (it == batchFunctions.end())
+               return false;
+            batchExpr.Append(it->second);
+         } else {
+            return false;
+         }
+         i = j;
+      } else {
+         batchExpr.Append(c);
+         ++i;
+      }
+   }
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the function evaluating the formula on many points at once.
+/// The formula is evaluated in a loop over the points, which is compiled
+/// with optimization and vectorized by the compiler. This is possible only if
+/// all the functions used in the expression have a vectorized implementation:
+/// when ROOT is built with VDT, the exponential, logarithm and trigonometric
+/// functions are replaced by their VDT versions; otherwise only the algebraic
+/// ones (e.g. sqrt, abs, min, max) are supported.
+/// The function is generated automatically by EvalParBatch.
+/// \returns true if the function is available and used by EvalParBatch.
+
+bool TFormula::GenerateBatchEval()
+{
+   // fBatchStatus is set after fBatchFuncPtr, so that other threads reading it
+   // see the function pointer
+   if (fBatchStatus != 0)
+      return fBatchStatus > 0;
+
+   // in case of lazy initialization the formula needs to be compiled first
+   if (!fReadyToExecute || !fClingInitialized)
+      return false;
+
+   R__LOCKGUARD(gROOTMutex);
+   if (fBatchStatus != 0)
+      return fBatchStatus > 0;
+
+   // the expression is extracted from the definition of the function passed to Cling,
+   // which is `double name(double *x, double *p){ return expression ; }`
+   const Ssiz_t begin = fClingInput.Index("{ return ");
+   const Ssiz_t end = fClingInput.Last(';');
+   TString batchExpr;
+   if (fVectorized || TestBit(TFormula::kLambda) || fNdim <= 0 || fClingName.IsNull() || begin == kNPOS ||
+       end == kNPOS || end < begin ||
+       !TranslateBatchExpression(fClingInput(begin + 9, end - begin - 9), batchExpr)) {
+      fBatchStatus = -1;
+      return false;
+   }
+
+   const std::string batchFuncName = GetBatchFuncName();
+   if (!functionExists(batchFuncName)) {
+#ifdef R__HAS_VDT
+      static bool isVdtIncluded = false;
+      if (!isVdtIncluded) {
+         isVdtIncluded = true;
+         gInterpreter->Declare("#include <vdt/vdtMath.h>");
+      }
+#endif
+      TString batchInput = TString::Format("#pragma cling optimize(2)\n"
+                                           "void %s(Int_t n, Double_t **xs, Double_t *p, Double_t *result) {\n"
+                                           "   #pragma clang loop vectorize(enable)\n"
+                                           "   for (Int_t i = 0; i < n; ++i) {\n"
+                                           "      const Double_t x[%d] = {",
+                                           batchFuncName.c_str(), fNdim);
+      for (int idim = 0; idim < fNdim; ++idim)
+         batchInput += TString::Format("%sxs[%d][i]", (idim > 0 ? ", " : ""), idim);
+      batchInput += TString::Format("};\n"
+                                    "      result[i] = %s;\n"
+                                    "   }\n"
+                                    "}",
+                                    batchExpr.Data());
+      if (!gInterpreter->Declare(batchInput)) {
+         fBatchStatus = -1;
+         return false;
+      }
+   }
+
+   TMethodCall method;
+   method.InitWithPrototype(batchFuncName.c_str(), "Int_t,Double_t**,Double_t*,Double_t*");
+   fBatchFuncPtr = method.IsValid() ? prepareFuncPtr(&method) : nullptr;
+   fBatchStatus = fBatchFuncPtr ? 1 : -1;
+   return fBatchFuncPtr != nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the formula on n points and store the values in result.
+/// The coordinates are passed per dimension: x[i] points to the n values of the
+/// i-th variable. If params is null the stored parameter values are used.
+/// When all the functions of the formula have a vectorized implementation the
+/// points are evaluated by the loop generated by GenerateBatchEval, otherwise
+/// they are evaluated one by one with EvalPar.
+
+void TFormula::EvalParBatch(Int_t n, const Double_t *const *x, Double_t *result, const Double_t *params) const
+{
+   if (n <= 0)
+      return;
+   if (const_cast<TFormula *>(this)->GenerateBatchEval()) {
+      void *args[4];
+      Double_t **xs = const_cast<Double_t **>(x);
+      Double_t *pars = (params) ? const_cast<Double_t *>(params) : const_cast<Double_t *>(fClingParameters.data());
+      args[0] = &n;
+      args[1] = &xs;
+      args[2] = &pars;
+      args[3] = &result;
+      (*fBatchFuncPtr)(nullptr, 4, args, /*ret*/ nullptr); // We do not use ret in a return-void func.
+      return;
+   }
+   std::vector<Double_t> xx(std::max(fNdim, 1));
+   for (Int_t i = 0; i < n; ++i) {
+      for (Int_t idim = 0; idim < fNdim; ++idim)
+         xx[idim] = x[idim][i];
+      result[i] = EvalPar(xx.data(), params);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 #ifdef R__HAS_VECCORE
 // ROOT::Double_v TFormula::Eval(ROOT::Double_v x, ROOT::Double_v y, ROOT::Double_v z, ROOT::Double_v t) const
@@ -36,9 +36,11 @@
 #include <cstdlib>
 #include <string>
 #include <cassert>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <cstring>
+#include <memory>
 #include <numeric>
 
 #include "HFitInterface.h"
@@ -909,6 +911,67 @@ void TGraph::DrawPanel()
    if (painter) painter->DrawPanelHelper(this);
 }
 
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Points of a TGraph sorted in x, with the cubic spline through them, used to
+/// interpolate the graph. The cache is immutable once built. It keeps a copy of
+/// the points it was built from, so that it is used only as long as the points
+/// of the graph are the same, however they are modified (also through GetX(),
+/// GetY() or the data members of the derived classes).
+
+class TGraphInterpolationCache {
+public:
+   std::vector<Double_t> fX;        ///< Points of the graph when the cache was built
+   std::vector<Double_t> fY;
+   std::vector<Double_t> fSortedX;  ///< Points sorted in x
+   std::vector<Double_t> fSortedY;
+   Bool_t fDistinctX = kTRUE;       ///< kTRUE if all the abscissas are different
+   std::unique_ptr<TSpline3> fSpline; ///< Spline through the sorted points, if requested
+
+   TGraphInterpolationCache(Int_t n, const Double_t *x, const Double_t *y, Bool_t spline)
+      : fX(x, x + n), fY(y, y + n), fSortedX(n), fSortedY(n)
+   {
+      std::vector<Int_t> indxsort(n);
+      TMath::Sort(n, x, indxsort.data(), false);
+      for (Int_t i = 0; i < n; ++i) {
+         fSortedX[i] = x[indxsort[i]];
+         fSortedY[i] = y[indxsort[i]];
+         if (i > 0 && !(fSortedX[i] > fSortedX[i - 1]))
+            fDistinctX = kFALSE;
+      }
+      if (spline)
+         fSpline = std::make_unique<TSpline3>("", fSortedX.data(), fSortedY.data(), n);
+   }
+
+   Bool_t Matches(Int_t n, const Double_t *x, const Double_t *y) const
+   {
+      return n == (Int_t)fX.size() && std::equal(fX.begin(), fX.end(), x) && std::equal(fY.begin(), fY.end(), y);
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the interpolation cache of the current points, with the spline if
+/// requested. The cache is rebuilt only if the points differ from the ones it
+/// was built from: checking this costs a comparison of the points, much less
+/// than sorting them and building the spline. It is safe to call this function
+/// concurrently: the cache of each graph is exchanged atomically.
+
+std::shared_ptr<const ROOT::Internal::TGraphInterpolationCache> TGraph::GetInterpolationCache(Bool_t spline) const
+{
+   auto cache = std::atomic_load(&fInterpolation);
+   if (cache && (cache->fSpline || !spline) && cache->Matches(fNpoints, fX, fY))
+      return cache;
+
+   cache = std::make_shared<const ROOT::Internal::TGraphInterpolationCache>(fNpoints, fX, fY, spline);
+   std::atomic_store(&fInterpolation, cache);
+   return cache;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Interpolate points in this graph at x using a TSpline.
 ///
@@ -917,7 +980,8 @@ void TGraph::DrawPanel()
 ///    extrapolation is computed.
 ///  - if spline==0 and option="S" a TSpline3 object is created using this graph
 ///    and the interpolated value from the spline is returned.
-///    the internally created spline is deleted on return.
+///    The spline is kept with the graph and reused by the following calls,
+///    as long as the points of the graph are unchanged.
 ///  - if spline is specified, it is used to return the interpolated value.
 ///
 ///   If the points are sorted in X a binary search is used (significantly faster)
@@ -938,24 +1002,9 @@ Double_t TGraph::Eval(Double_t x, TSpline *spline, Option_t *option) const
    if (option && *option) {
       TString opt = option;
       opt.ToLower();
-      // create a TSpline every time when using option "s" and no spline pointer is given
-      if (opt.Contains("s")) {
-
-         // points must be sorted before using a TSpline
-         std::vector<Double_t> xsort(fNpoints);
-         std::vector<Double_t> ysort(fNpoints);
-         std::vector<Int_t> indxsort(fNpoints);
-         TMath::Sort(fNpoints, fX, &indxsort[0], false);
-         for (Int_t i = 0; i < fNpoints; ++i) {
-            xsort[i] = fX[ indxsort[i] ];
-            ysort[i] = fY[ indxsort[i] ];
-         }
-
-         // spline interpolation creating a new spline
-         TSpline3 s("", &xsort[0], &ysort[0], fNpoints);
-         Double_t result = s.Eval(x);
-         return result;
-      }
+      // use the cached spline of the sorted points when using option "s" and no spline pointer is given
+      if (opt.Contains("s"))
+         return GetInterpolationCache(kTRUE)->fSpline->Eval(x);
    }
    //linear interpolation
    //In case x is < fX[0] or > fX[fNpoints-1] return the extrapolated point
@@ -1016,6 +1065,56 @@ Double_t TGraph::Eval(Double_t x, TSpline *spline, Option_t *option) const
    return yn;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Interpolate the graph at the n points x[i] and store the results in y[i].
+///
+/// The results are identical to calling Eval(x[i], nullptr, option) for each
+/// point, but the search of the neighbouring points is faster: when the graph
+/// is not flagged as sorted, the points sorted in x are cached together with
+/// the spline of option "S" and reused by the following calls, as long as the
+/// points of the graph do not change.
+
+void TGraph::Eval(Int_t n, const Double_t *x, Double_t *y, Option_t *option) const
+{
+   TString opt = option;
+   opt.ToLower();
+   Bool_t spline = opt.Contains("s");
+
+   if (fNpoints < 2 || (!spline && TestBit(kIsSortedX))) {
+      for (Int_t i = 0; i < n; ++i)
+         y[i] = Eval(x[i], nullptr, option);
+      return;
+   }
+
+   auto cache = GetInterpolationCache(spline);
+   if (spline) {
+      for (Int_t i = 0; i < n; ++i)
+         y[i] = cache->fSpline->Eval(x[i]);
+      return;
+   }
+
+   // linear interpolation: when the abscissas are distinct, the neighbours of
+   // a point within the graph range are found by a binary search in the sorted
+   // points. Otherwise the points are searched as in Eval.
+   const Int_t np = fNpoints;
+   const Double_t *xs = cache->fSortedX.data();
+   const Double_t *ys = cache->fSortedY.data();
+   for (Int_t i = 0; i < n; ++i) {
+      const Double_t xi = x[i];
+      if (!cache->fDistinctX || !(xi >= xs[0] && xi <= xs[np - 1])) {
+         y[i] = Eval(xi, nullptr, option);
+         continue;
+      }
+      Int_t low = TMath::BinarySearch(np, xs, xi);
+      if (xs[low] == xi) {
+         y[i] = ys[low];
+         continue;
+      }
+      Int_t up = low + 1;
+      y[i] = ys[up] + (xi - xs[up]) * (ys[low] - ys[up]) / (xs[low] - xs[up]);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action corresponding to one event.
 ///
@@ -1125,6 +1224,7 @@ TObject *TGraph::FindObject(const TObject *obj) const
 /// "B"  | Use this option when you want to fix one or more parameters and the fitting function is a predefined one (e.g gaus, expo,..), otherwise in case of pre-defined functions, some default initial values and limits are set.
 /// "C"  | In case of linear fitting, do no calculate the chisquare (saves CPU time).
 /// "G"  | Uses the gradient implemented in `TF1::GradientPar` for the minimization. This allows to use Automatic Differentiation when it is supported by the provided TF1 function.
+/// "NOGRAD" | Does not use by default the gradient of formula-based functions generated with Automatic Differentiation (Clad) for the minimization, but numerical derivatives.
 /// "EX0" | When fitting a TGraphErrors or TGraphAsymErrors do not consider errors in the X coordinates
 /// "ROB" | In case of linear fitting, compute the LTS regression coefficients (robust (resistant) regression), using the default fraction of good points "ROB=0.x" - compute the LTS regression coefficients, using 0.x as a fraction of good points
 ///
@@ -26,6 +26,7 @@
 #include "strtok.h"
 #include "snprintf.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cassert>
 #include <iostream>
@@ -962,6 +963,27 @@ void TGraph2D::CreateInterpolator(Bool_t oldInterp)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Discards the interpolator after the points have changed, so that the
+/// Delaunay triangles are recomputed at the next interpolation. The histogram
+/// filled with the interpolated values is deleted as well, unless it was given
+/// with SetHistogram.
+
+void TGraph2D::ResetInterpolator()
+{
+   if (!fHistogram) return;
+   if (!fUserHisto) {
+      delete fHistogram;
+      fHistogram = nullptr;
+      fDelaunay = nullptr;
+   } else if (fDelaunay) {
+      fHistogram->GetListOfFunctions()->Remove(fDelaunay);
+      delete fDelaunay;
+      fDelaunay = nullptr;
+      CreateInterpolator(TestBit(kOldInterpolation));
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// By default returns a pointer to the Delaunay histogram. If fHistogram
 /// doesn't exist, books the 2D histogram fHistogram with a margin around
@@ -997,9 +1019,10 @@ TH2D *TGraph2D::GetHistogram(Option_t *option)
    if (fHistogram) {
       if (!empty && fHistogram->GetEntries() == 0) {
          if (!fUserHisto) {
+            // keep the interpolator, which does not depend on the histogram
+            if (fDelaunay) fHistogram->GetListOfFunctions()->Remove(fDelaunay);
             delete fHistogram;
             fHistogram = nullptr;
-            fDelaunay = nullptr;
          }
       } else if (fHistogram->GetEntries() == 0)
       {;      }
@@ -1054,7 +1077,12 @@ TH2D *TGraph2D::GetHistogram(Option_t *option)
          fHistogram = new TH2D(GetName(), GetTitle(),
                                fNpx , hxmin, hxmax,
                                fNpy, hymin, hymax);
-         CreateInterpolator(oldInterp);
+         if (fDelaunay && (fDelaunay->IsA() == TGraphDelaunay::Class()) == oldInterp) {
+            fHistogram->GetListOfFunctions()->Add(fDelaunay);
+         } else {
+            delete fDelaunay;
+            CreateInterpolator(oldInterp);
+         }
       }
       fHistogram->SetBit(TH1::kNoStats);
    } else {
@@ -1205,12 +1233,30 @@ Int_t TGraph2D::GetPoint(Int_t i, Double_t &x, Double_t &y, Double_t &z) const
 ////////////////////////////////////////////////////////////////////////////////
 /// Finds the z value at the position (x,y) thanks to
 /// the Delaunay interpolation.
+///
+/// The Delaunay triangles are computed at the first call and kept until the
+/// points of the graph are changed with SetPoint, RemovePoint, Set or Scale.
 
 Double_t TGraph2D::Interpolate(Double_t x, Double_t y)
 {
+   Double_t z;
+   Interpolate(1, &x, &y, &z);
+   return z;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Finds the z values z[i] at the n positions (x[i],y[i]) thanks to
+/// the Delaunay interpolation. This is equivalent to calling
+/// Interpolate(x[i], y[i]) for each position, but the interpolator is looked
+/// up only once.
+
+void TGraph2D::Interpolate(Int_t n, const Double_t *x, const Double_t *y, Double_t *z)
+{
+   if (n <= 0) return;
    if (fNpoints <= 0) {
       Error("Interpolate", "Empty TGraph2D");
-      return 0;
+      std::fill(z, z + n, 0.);
+      return;
    }
 
    if (!fHistogram) GetHistogram("empty");
@@ -1227,16 +1273,22 @@ Double_t TGraph2D::Interpolate(Double_t x, Double_t y)
       }
    }
 
-   if (!fDelaunay) return TMath::QuietNaN();
-
-   if (fDelaunay->IsA() == TGraphDelaunay2D::Class() )
-      return ((TGraphDelaunay2D*)fDelaunay)->ComputeZ(x, y);
-   else if (fDelaunay->IsA() == TGraphDelaunay::Class() )
-      return ((TGraphDelaunay*)fDelaunay)->ComputeZ(x, y);
+   if (!fDelaunay) {
+      std::fill(z, z + n, TMath::QuietNaN());
+      return;
+   }
 
-   // cannot be here
-   assert(false);
-   return TMath::QuietNaN();
+   if (fDelaunay->IsA() == TGraphDelaunay2D::Class() ) {
+      auto dt = (TGraphDelaunay2D*)fDelaunay;
+      for (Int_t i = 0; i < n; ++i) z[i] = dt->ComputeZ(x[i], y[i]);
+   } else if (fDelaunay->IsA() == TGraphDelaunay::Class() ) {
+      auto dt = (TGraphDelaunay*)fDelaunay;
+      for (Int_t i = 0; i < n; ++i) z[i] = dt->ComputeZ(x[i], y[i]);
+   } else {
+      // cannot be here
+      assert(false);
+      std::fill(z, z + n, TMath::QuietNaN());
+   }
 }
 
 
@@ -1494,12 +1546,14 @@ void TGraph2D::Scale(Double_t c1, Option_t *option)
       for (Int_t i=0; i<GetN(); i++)
          GetZ()[i] *= c1;
    }
+   ResetInterpolator();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Set number of points in the 2D graph.
 /// Existing coordinates are preserved.
 /// New coordinates above fNpoints are preset to 0.
+/// The Delaunay triangles are recomputed at the next interpolation.
 
 void TGraph2D::Set(Int_t n)
 {
@@ -1507,6 +1561,7 @@ void TGraph2D::Set(Int_t n)
    if (n == fNpoints) return;
    if (n >  fNpoints) SetPoint(n, 0, 0, 0);
    fNpoints = n;
+   ResetInterpolator();
 }
 
 
@@ -1722,6 +1777,7 @@ void TGraph2D::SetPoint(Int_t n, Double_t x, Double_t y, Double_t z)
    fY[n]    = y;
    fZ[n]    = z;
    fNpoints = TMath::Max(fNpoints, n + 1);
+   ResetInterpolator();
 }
 
 
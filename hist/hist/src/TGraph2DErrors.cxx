@@ -429,6 +429,7 @@ void TGraph2DErrors::SetPoint(Int_t i, Double_t x, Double_t y, Double_t z)
    fX[i] = x;
    fY[i] = y;
    fZ[i] = z;
+   ResetInterpolator();
 }
 
 
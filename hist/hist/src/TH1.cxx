@@ -9,6 +9,7 @@
  * For the list of contributors see $ROOTSYS/README/CREDITS.             *
  *************************************************************************/
 
+#include <algorithm>
 #include <array>
 #include <cctype>
 #include <climits>
@@ -53,6 +54,7 @@
 #include "Math/QuantFuncMathCore.h"
 
 #include "TH1Merger.h"
+#include "THFillNHelper.h"
 
 /** \addtogroup Histograms
 @{
@@ -3426,6 +3428,10 @@ Int_t TH1::Fill(const char *namex, Double_t w)
 /// weights is automatically triggered and the sum of the squares of weights is incremented
 /// by \f$ w^2 \f$ in the bin corresponding to x.
 /// if w is NULL each entry is assumed a weight=1
+///
+/// For an axis with fixed bins which cannot be extended, the bins are computed
+/// arithmetically for blocks of entries before updating the histogram, which
+/// is considerably faster than calling Fill() for each entry.
 
 void TH1::FillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride)
 {
@@ -3458,6 +3464,30 @@ void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stri
    Int_t bin,i;
 
    fEntries += ntimes;
+   if (THFillNHelper::IsFixed(fXaxis)) {
+      const Bool_t statOverflows = GetStatOverflowsBehaviour();
+      Int_t bins[THFillNHelper::kChunkSize];
+      Bool_t inRange[THFillNHelper::kChunkSize];
+      for (Int_t first = 0; first < ntimes; first += THFillNHelper::kChunkSize) {
+         const Int_t n = TMath::Min(THFillNHelper::kChunkSize, ntimes - first);
+         const Double_t *xc = x + Long64_t(first) * stride;
+         const Double_t *wc = w ? w + Long64_t(first) * stride : nullptr;
+         std::fill_n(bins, n, 0);
+         std::fill_n(inRange, n, kTRUE);
+         THFillNHelper::AddBins(fXaxis, n, xc, stride, 1, bins, inRange);
+         THFillNHelper::AddContents(*this, n, bins, wc, stride);
+         for (i = 0; i < n; i++) {
+            if (!statOverflows && !inRange[i]) continue;
+            const Double_t z = wc ? wc[i*stride] : 1.;
+            const Double_t xi = xc[i*stride];
+            fTsumw   += z;
+            fTsumw2  += z*z;
+            fTsumwx  += z*xi;
+            fTsumwx2 += z*xi*xi;
+         }
+      }
+      return;
+   }
    Double_t ww = 1;
    Int_t nbins   = fXaxis.GetNbins();
    ntimes *= stride;
@@ -3943,6 +3973,7 @@ TFitResultPtr TH1::Fit(const char *fname ,Option_t *option ,Option_t *goption, D
 ///   "B"  | Use this option when you want to fix or set limits on one or more parameters and the fitting function is a predefined one (e.g gaus, expo,..), otherwise in case of pre-defined functions, some default initial values and limits will be used.
 ///   "C"  | In case of linear fitting, do no calculate the chisquare (saves CPU time).
 ///   "G"  | Uses the gradient implemented in `TF1::GradientPar` for the minimization. This allows to use Automatic Differentiation when it is supported by the provided TF1 function.
+///   "NOGRAD" | Does not use by default the gradient of formula-based functions generated with Automatic Differentiation (Clad) for the minimization, but numerical derivatives.
 ///   "WIDTH" | Scales the histogran bin content by the bin width (useful for variable bins histograms)
 ///   "SERIAL" | Runs in serial mode. By defult if ROOT is built with MT support and MT is enables, the fit is perfomed in multi-thread     - "E"  Perform better Errors estimation using Minos technique
 ///   "MULTITHREAD" | Forces usage of multi-thread execution whenever possible
@@ -8,9 +8,17 @@
 #include "TError.h"
 #include "THashList.h"
 #include "TClass.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <utility>
+#include <vector>
 
 #define PRINTRANGE(a, b, bn)                                                                                          \
    Printf(" base: %f %f %d, %s: %f %f %d", a->GetXmin(), a->GetXmax(), a->GetNbins(), bn, b->GetXmin(), b->GetXmax(), \
@@ -762,6 +770,8 @@ Bool_t TH1Merger::SameAxesMerge() {
    fH0->GetStats(totstats);
    Double_t nentries = fH0->GetEntries();
 
+   // import the statistics and collect the histograms to merge
+   std::vector<const TH1 *> hists;
    TIter next(&fInputList);
    while (TH1* hist=(TH1*)next()) {
       // process only if the histogram has limits; otherwise it was processed before
@@ -778,13 +788,38 @@ Bool_t TH1Merger::SameAxesMerge() {
       for (Int_t i=0; i<TH1::kNstat; i++)
          totstats[i] += stats[i];
       nentries += hist->GetEntries();
+      hists.push_back(hist);
+   }
 
-         //Int_t nx = hist->GetXaxis()->GetNbins();
-         // loop on bins of the histogram and do the merge
-      for (Int_t ibin = 0; ibin < hist->fNcells; ibin++) {
-         MergeBin(hist, ibin, ibin);
+   // loop on bins of the histograms and do the merge. Each bin receives the
+   // histograms in the order of the list, so that the result does not depend
+   // on how the bins are split in ranges.
+   auto mergeRange = [&](Int_t first, Int_t last) {
+      for (const TH1 *hist : hists) {
+         const Int_t end = std::min(last, hist->fNcells);
+         for (Int_t ibin = first; ibin < end; ibin++)
+            MergeBin(hist, ibin, ibin);
       }
+   };
+
+#ifdef R__USE_IMT
+   // With implicit multi-threading, large merges are done in parallel on
+   // disjoint ranges of bins
+   const Int_t kMinRangeSize = 16384;
+   const Int_t ncells = fH0->fNcells;
+   if (ROOT::IsImplicitMTEnabled() && ncells >= 2 * kMinRangeSize &&
+       (Long64_t)ncells * hists.size() >= (Long64_t)1 << 22) {
+      const Int_t nranges = std::min<Long64_t>(ncells / kMinRangeSize, 8 * (Long64_t)ROOT::GetThreadPoolSize());
+      const Int_t rangeSize = (ncells + nranges - 1) / nranges;
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](UInt_t r) { mergeRange(r * rangeSize, std::min(ncells, (Int_t)(r + 1) * rangeSize)); },
+                   ROOT::TSeqU(nranges));
+   } else
+#endif
+   {
+      mergeRange(0, fH0->fNcells);
    }
+
    //copy merged stats
    fH0->PutStats(totstats);
    fH0->SetEntries(nentries);
@@ -27,6 +27,9 @@
 #include "TObjArray.h"
 #include "TVirtualHistPainter.h"
 #include "snprintf.h"
+#include "THFillNHelper.h"
+
+#include <algorithm>
 
 ClassImp(TH2);
 
@@ -594,6 +597,9 @@ Int_t TH2::Fill(Double_t x, const char *namey, Double_t w)
 ///     weights is automatically triggered and the sum of the squares of weights is incremented
 ///     by w[i]^2 in the bin corresponding to x[i],y[i].
 ///   - If w is NULL each entry is assumed a weight=1
+///   - If both axes have fixed bins and cannot be extended, the bins are
+///     computed arithmetically for blocks of entries before updating the
+///     histogram, see TH1::FillN
 ///
 /// NB: function only valid for a TH2x object
 
@@ -618,6 +624,40 @@ void TH2::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double
          return;
    }
 
+   if (THFillNHelper::IsFixed(fXaxis) && THFillNHelper::IsFixed(fYaxis)) {
+      const Bool_t statOverflows = GetStatOverflowsBehaviour();
+      const Int_t nentries = (ntimes - ifirst + stride - 1) / stride;
+      Int_t bins[THFillNHelper::kChunkSize];
+      Bool_t inRange[THFillNHelper::kChunkSize];
+      fEntries += nentries;
+      for (Int_t first = 0; first < nentries; first += THFillNHelper::kChunkSize) {
+         const Int_t n = TMath::Min(THFillNHelper::kChunkSize, nentries - first);
+         const Long64_t offset = ifirst + Long64_t(first) * stride;
+         const Double_t *xc = x + offset;
+         const Double_t *yc = y + offset;
+         const Double_t *wc = w ? w + offset : nullptr;
+         std::fill_n(bins, n, 0);
+         std::fill_n(inRange, n, kTRUE);
+         THFillNHelper::AddBins(fXaxis, n, xc, stride, 1, bins, inRange);
+         THFillNHelper::AddBins(fYaxis, n, yc, stride, fXaxis.GetNbins()+2, bins, inRange);
+         THFillNHelper::AddContents(*this, n, bins, wc, stride);
+         for (i = 0; i < n; i++) {
+            if (!statOverflows && !inRange[i]) continue;
+            const Double_t z = wc ? wc[i*stride] : 1.;
+            const Double_t xi = xc[i*stride];
+            const Double_t yi = yc[i*stride];
+            fTsumw   += z;
+            fTsumw2  += z*z;
+            fTsumwx  += z*xi;
+            fTsumwx2 += z*xi*xi;
+            fTsumwy  += z*yi;
+            fTsumwy2 += z*yi*yi;
+            fTsumwxy += z*xi*yi;
+         }
+      }
+      return;
+   }
+
    Double_t ww = 1;
    for (i=ifirst;i<ntimes;i+=stride) {
       fEntries++;
@@ -16,7 +16,9 @@
 #include "Riostream.h"
 #include "TList.h"
 #include "TMath.h"
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 
 ClassImp(TH2Poly);
 
@@ -123,6 +125,13 @@ to the histogram. To do this, `AddBin()` calls the
 `AddBinToPartition()` method.
 This method adds the input bin to the partitioning matrix.
 
+For histograms with many bins, e.g. fine honeycomb or irregular detector
+cells, a spatial index can be used instead of the partition, see
+`SetUseIndex()`. It rasterizes the histogram area in about two cells per bin
+and records, for each cell, only the bins whose polygons overlap it. Most of
+the cells are completely inside a bin, in which case no polygon needs to be
+tested at all. The index is rebuilt automatically after bins are added.
+
 The number of partition cells per axis can be specified in the constructor.
 If it is not specified, the default value of 25 along each axis will be
 assigned. This value was chosen because it is small enough to avoid slowing
@@ -252,6 +261,7 @@ Int_t TH2Poly::AddBin(TObject *poly)
 
    fBins->Add((TObject*) bin);
    SetNewBinAdded(kTRUE);
+   fIndexValid = kFALSE;
 
    // Adds the bin to the partition matrix
    AddBinToPartition(bin);
@@ -439,6 +449,7 @@ void TH2Poly::AddBinToPartition(TH2PolyBin *bin)
 
 void TH2Poly::ChangePartition(Int_t n, Int_t m)
 {
+   fIndexValid = kFALSE;                // The histogram limits may have changed
    fCellX = n;                          // Set the number of cells
    fCellY = m;                          // Set the number of cells
 
@@ -555,6 +566,48 @@ Int_t TH2Poly::FindBin(Double_t x, Double_t y, Double_t)
    else if (x > fXaxis.GetXmin()) overflow += -1;
    if (overflow != -5) return overflow;
 
+   TH2PolyBin *bin = FindPolyBin(x, y);
+
+   // If the search has not returned a bin, the point must be on "the sea"
+   return bin ? bin->GetBinNumber() : -5;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the bin containing the point (x,y), which must be within the
+/// histogram limits, or nullptr if the point is not in any bin ("the sea").
+/// If several bins contain the point, the first one is returned.
+/// Uses the spatial index if enabled with SetUseIndex(), otherwise the
+/// partition cells.
+
+TH2PolyBin *TH2Poly::FindPolyBin(Double_t x, Double_t y)
+{
+   if (fUseIndex) {
+      if (!fIndexValid) BuildIndex();
+      if (fIndexBinPtrs.empty()) return nullptr;
+
+      Int_t n = (Int_t)(floor((x-fXaxis.GetXmin())/fIndexStepX));
+      Int_t m = (Int_t)(floor((y-fYaxis.GetXmin())/fIndexStepY));
+      if (n>=fIndexNX) n = fIndexNX-1;
+      if (m>=fIndexNY) m = fIndexNY-1;
+      if (n<0)         n = 0;
+      if (m<0)         m = 0;
+
+      const Int_t cell = n + fIndexNX*m;
+      const Int_t begin = fIndexOffsets[cell];
+      Int_t end = fIndexOffsets[cell + 1];
+      // The last candidate covering the cell contains the point for sure
+      const Bool_t covered = fIndexCovered[cell];
+      if (covered) --end;
+      for (Int_t k = begin; k < end; ++k) {
+         const Int_t ibin = fIndexBins[k];
+         TGraph *g = fIndexGraphs[ibin];
+         if (g ? TMath::IsInside(x, y, g->GetN(), g->GetX(), g->GetY())
+               : fIndexBinPtrs[ibin]->IsInside(x, y))
+            return fIndexBinPtrs[ibin];
+      }
+      return covered ? fIndexBinPtrs[fIndexBins[end]] : nullptr;
+   }
+
    // Finds the cell (x,y) coordinates belong to
    Int_t n = (Int_t)(floor((x-fXaxis.GetXmin())/fStepX));
    Int_t m = (Int_t)(floor((y-fYaxis.GetXmin())/fStepY));
@@ -565,7 +618,7 @@ Int_t TH2Poly::FindBin(Double_t x, Double_t y, Double_t)
    if (n<0)       n = 0;
    if (m<0)       m = 0;
 
-   if (fIsEmpty[n+fCellX*m]) return -5;
+   if (fIsEmpty[n+fCellX*m]) return nullptr;
 
    TH2PolyBin *bin;
 
@@ -575,11 +628,10 @@ Int_t TH2Poly::FindBin(Double_t x, Double_t y, Double_t)
    // Search for the bin in the cell
    while ((obj=next())) {
       bin  = (TH2PolyBin*)obj;
-      if (bin->IsInside(x,y)) return bin->GetBinNumber();
+      if (bin->IsInside(x,y)) return bin;
    }
 
-   // If the search has not returned a bin, the point must be on "the sea"
-   return -5;
+   return nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -621,57 +673,33 @@ Int_t TH2Poly::Fill(Double_t x, Double_t y, Double_t w)
       return overflow;
    }
 
-   // Finds the cell (x,y) coordinates belong to
-   Int_t n = (Int_t)(floor((x-fXaxis.GetXmin())/fStepX));
-   Int_t m = (Int_t)(floor((y-fYaxis.GetXmin())/fStepY));
-
-   // Make sure the array indices are correct.
-   if (n>=fCellX) n = fCellX-1;
-   if (m>=fCellY) m = fCellY-1;
-   if (n<0)       n = 0;
-   if (m<0)       m = 0;
-
-   if (fIsEmpty[n+fCellX*m]) {
+   TH2PolyBin *bin = FindPolyBin(x, y);
+   if (!bin) {
       fOverflow[4]+= w;
       if (fSumw2.fN) fSumw2.fArray[4] += w*w;
       return -5;
    }
 
-   TH2PolyBin *bin;
-   Int_t bi;
+   bin->Fill(w);
 
-   TIter next(&fCells[n+fCellX*m]);
-   TObject *obj;
-
-   while ((obj=next())) {
-      bin  = (TH2PolyBin*)obj;
+   // Statistics
+   fTsumw   = fTsumw + w;
+   fTsumw2  = fTsumw2 + w*w;
+   fTsumwx  = fTsumwx + w*x;
+   fTsumwx2 = fTsumwx2 + w*x*x;
+   fTsumwy  = fTsumwy + w*y;
+   fTsumwy2 = fTsumwy2 + w*y*y;
+   if (fSumw2.fN) {
       // needs to account offset in array for overflow bins
-      bi = bin->GetBinNumber()-1+kNOverflow;
-      if (bin->IsInside(x,y)) {
-         bin->Fill(w);
-
-         // Statistics
-         fTsumw   = fTsumw + w;
-         fTsumw2  = fTsumw2 + w*w;
-         fTsumwx  = fTsumwx + w*x;
-         fTsumwx2 = fTsumwx2 + w*x*x;
-         fTsumwy  = fTsumwy + w*y;
-         fTsumwy2 = fTsumwy2 + w*y*y;
-         if (fSumw2.fN) {
-            assert(bi < fSumw2.fN);
-            fSumw2.fArray[bi] += w*w;
-         }
-         fEntries++;
-
-         SetBinContentChanged(kTRUE);
-
-         return bin->GetBinNumber();
-      }
+      Int_t bi = bin->GetBinNumber()-1+kNOverflow;
+      assert(bi < fSumw2.fN);
+      fSumw2.fArray[bi] += w*w;
    }
+   fEntries++;
+
+   SetBinContentChanged(kTRUE);
 
-   fOverflow[4]+= w;
-   if (fSumw2.fN) fSumw2.fArray[4] += w*w;
-   return -5;
+   return bin->GetBinNumber();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -705,14 +733,19 @@ Int_t TH2Poly::Fill(const char* name, Double_t w)
 ///                      (array size must be ntimes*stride)
 /// \param [in] x:       array of x values to be histogrammed
 /// \param [in] y:       array of y values to be histogrammed
-/// \param [in] w:       array of weights
+/// \param [in] w:       array of weights; if null, all weights are 1
 /// \param [in] stride:  step size through arrays x, y and w
+///
+/// With many bins, enabling the spatial index with SetUseIndex() speeds up
+/// the search of the bins.
 
 void TH2Poly::FillN(Int_t ntimes, const Double_t* x, const Double_t* y,
                                const Double_t* w, Int_t stride)
 {
+   // Build the spatial index once for all the entries
+   if (fUseIndex && !fIndexValid) BuildIndex();
    for (int i = 0; i < ntimes; i += stride) {
-      Fill(x[i], y[i], w[i]);
+      Fill(x[i], y[i], w ? w[i] : 1.);
    }
 }
 
@@ -1066,6 +1099,14 @@ void TH2Poly::Initialize(Double_t xlow, Double_t xup,
       fCompletelyInside[i] = kFALSE;
    }
 
+   // Spatial index, built when needed
+   fUseIndex   = kFALSE;
+   fIndexValid = kFALSE;
+   fIndexNX    = 0;
+   fIndexNY    = 0;
+   fIndexStepX = 0.;
+   fIndexStepY = 0.;
+
    // 3D Painter flags
    SetNewBinAdded(kFALSE);
    SetBinContentChanged(kFALSE);
@@ -1340,6 +1381,156 @@ void TH2Poly::SetFloat(Bool_t flag)
    fFloat = flag;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// When set to kTRUE, the bins containing a point are found with a spatial
+/// index instead of the partition cells (see ChangePartition()). The index
+/// is built, or rebuilt after bins have been added, at the next search.
+/// It speeds up FindBin(), Fill() and FillN() for histograms with many bins,
+/// e.g. fine honeycomb or irregular detector cells.
+
+void TH2Poly::SetUseIndex(Bool_t flag)
+{
+   fUseIndex = flag;
+   if (!fUseIndex) {
+      fIndexValid = kFALSE;
+      std::vector<Int_t>().swap(fIndexOffsets);
+      std::vector<Int_t>().swap(fIndexBins);
+      std::vector<Char_t>().swap(fIndexCovered);
+      std::vector<TH2PolyBin*>().swap(fIndexBinPtrs);
+      std::vector<TGraph*>().swap(fIndexGraphs);
+   }
+}
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns kTRUE if the segment (x1,y1)-(x2,y2) intersects or touches the
+/// rectangle [xl,xr]x[yb,yt].
+
+Bool_t SegmentIntersectsRectangle(Double_t x1, Double_t y1, Double_t x2, Double_t y2,
+                                  Double_t xl, Double_t xr, Double_t yb, Double_t yt)
+{
+   if (std::max(x1, x2) < xl || std::min(x1, x2) > xr || std::max(y1, y2) < yb || std::min(y1, y2) > yt)
+      return kFALSE;
+   // The segment line separates the corners unless they are all on one side
+   const Double_t dx = x2 - x1;
+   const Double_t dy = y2 - y1;
+   auto side = [&](Double_t px, Double_t py) { return dx * (py - y1) - dy * (px - x1); };
+   const Double_t s1 = side(xl, yb), s2 = side(xl, yt), s3 = side(xr, yb), s4 = side(xr, yt);
+   if (s1 > 0 && s2 > 0 && s3 > 0 && s4 > 0) return kFALSE;
+   if (s1 < 0 && s2 < 0 && s3 < 0 && s4 < 0) return kFALSE;
+   return kTRUE;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Builds the spatial index used by FindPolyBin() when fUseIndex is set.
+///
+/// The histogram area is rasterized in about two cells per bin. Each raster
+/// cell records the bins that may contain its points, in the order of the
+/// bins: the bins whose polygon edges cross the cell, or that contain the whole
+/// cell. Cells outside of a polygon are not recorded for its bin. Once a bin
+/// contains a whole cell, the following bins are not recorded for it and the
+/// points of the cell fall in that bin without testing its polygon. The other
+/// candidates are tested directly on the arrays of their TGraph.
+
+void TH2Poly::BuildIndex()
+{
+   fIndexValid = kTRUE;
+   fIndexOffsets.clear();
+   fIndexBins.clear();
+   fIndexCovered.clear();
+   fIndexBinPtrs.clear();
+   fIndexGraphs.clear();
+
+   const Int_t nbins = fBins ? fBins->GetSize() : 0;
+   const Double_t xmin = fXaxis.GetXmin();
+   const Double_t ymin = fYaxis.GetXmin();
+   const Double_t width = fXaxis.GetXmax() - xmin;
+   const Double_t height = fYaxis.GetXmax() - ymin;
+   if (!nbins || width <= 0 || height <= 0) return;
+
+   // Raster of about two cells per bin, with square-ish cells
+   const Double_t ncells = std::min(2. * nbins, (Double_t)(1 << 24));
+   fIndexNX = std::max(1, (Int_t)std::round(std::sqrt(ncells * width / height)));
+   fIndexNY = std::max(1, (Int_t)std::round(ncells / fIndexNX));
+   fIndexStepX = width / fIndexNX;
+   fIndexStepY = height / fIndexNY;
+   // Edges are tested against slightly enlarged cells, to be safe from rounding
+   const Double_t epsX = 1e-9 * fIndexStepX;
+   const Double_t epsY = 1e-9 * fIndexStepY;
+
+   fIndexBinPtrs.reserve(nbins);
+   fIndexGraphs.reserve(nbins);
+   TIter next(fBins);
+   while (TH2PolyBin *bin = (TH2PolyBin*) next()) {
+      fIndexBinPtrs.push_back(bin);
+      TObject *poly = bin->GetPolygon();
+      TGraph *g = (poly && poly->IsA() == TGraph::Class()) ? (TGraph*) poly : nullptr;
+      fIndexGraphs.push_back(g && g->GetN() >= 3 ? g : nullptr);
+   }
+
+   // Candidate (cell, bin) pairs; covering[cell] is set once a bin covers it
+   struct Candidate {
+      Int_t fCell;
+      Int_t fBin;
+   };
+   std::vector<Candidate> candidates;
+   std::vector<Char_t> covering(fIndexNX * fIndexNY, 0);
+
+   for (Int_t ibin = 0; ibin < nbins; ++ibin) {
+      TH2PolyBin *bin = fIndexBinPtrs[ibin];
+      TGraph *g = fIndexGraphs[ibin];
+      Int_t nl = (Int_t)(floor((bin->GetXMin() - xmin)/fIndexStepX));
+      Int_t nr = (Int_t)(floor((bin->GetXMax() - xmin)/fIndexStepX));
+      Int_t mb = (Int_t)(floor((bin->GetYMin() - ymin)/fIndexStepY));
+      Int_t mt = (Int_t)(floor((bin->GetYMax() - ymin)/fIndexStepY));
+      if (nr >= fIndexNX) nr = fIndexNX-1;
+      if (mt >= fIndexNY) mt = fIndexNY-1;
+      if (nl < 0)         nl = 0;
+      if (mb < 0)         mb = 0;
+
+      for (Int_t j = mb; j <= mt; ++j) {
+         const Double_t yb = ymin + j*fIndexStepY;
+         const Double_t yt = yb + fIndexStepY;
+         for (Int_t i = nl; i <= nr; ++i) {
+            const Int_t cell = i + fIndexNX*j;
+            if (covering[cell]) continue; // a previous bin contains the whole cell
+            const Double_t xl = xmin + i*fIndexStepX;
+            const Double_t xr = xl + fIndexStepX;
+            if (!g) {
+               candidates.push_back({cell, ibin});
+               continue;
+            }
+            const Int_t np = g->GetN();
+            const Double_t *px = g->GetX();
+            const Double_t *py = g->GetY();
+            Bool_t crossed = kFALSE;
+            for (Int_t k = 0, l = np - 1; k < np && !crossed; l = k++)
+               crossed = SegmentIntersectsRectangle(px[l], py[l], px[k], py[k], xl - epsX, xr + epsX, yb - epsY, yt + epsY);
+            if (crossed) {
+               candidates.push_back({cell, ibin});
+            } else if (TMath::IsInside(0.5*(xl + xr), 0.5*(yb + yt), np, g->GetX(), g->GetY())) {
+               // no edge crosses the cell and its centre is inside: the whole cell is inside
+               candidates.push_back({cell, ibin});
+               covering[cell] = 1;
+            }
+         }
+      }
+   }
+
+   // Group the candidates by cell, keeping the order of the bins
+   const Int_t ncell = fIndexNX * fIndexNY;
+   fIndexOffsets.assign(ncell + 1, 0);
+   for (const Candidate &c : candidates) ++fIndexOffsets[c.fCell + 1];
+   for (Int_t cell = 0; cell < ncell; ++cell) fIndexOffsets[cell + 1] += fIndexOffsets[cell];
+   fIndexBins.resize(candidates.size());
+   std::vector<Int_t> pos(fIndexOffsets.begin(), fIndexOffsets.end() - 1);
+   for (const Candidate &c : candidates) fIndexBins[pos[c.fCell]++] = c.fBin;
+   fIndexCovered.swap(covering);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return "true" if the point (x,y) is inside the bin of binnr.
 
@@ -24,6 +24,9 @@
 #include "TError.h"
 #include "TMath.h"
 #include "TObjString.h"
+#include "THFillNHelper.h"
+
+#include <algorithm>
 
 ClassImp(TH3);
 
@@ -422,6 +425,90 @@ Int_t TH3::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a 3-D histogram with an array of values and weights.
+///
+///  - ntimes:  number of entries in arrays x, y, z and w (array size must be ntimes*stride)
+///  - x:       array of x values to be histogrammed
+///  - y:       array of y values to be histogrammed
+///  - z:       array of z values to be histogrammed
+///  - w:       array of weights
+///  - stride:  step size through arrays x, y, z and w
+///
+///   - If the weight is not equal to 1, the storage of the sum of squares of
+///     weights is automatically triggered and the sum of the squares of weights is incremented
+///     by w[i]^2 in the bin corresponding to x[i],y[i],z[i].
+///   - If w is NULL each entry is assumed a weight=1
+///   - If all the axes have fixed bins and cannot be extended, the bins are
+///     computed arithmetically for blocks of entries before updating the
+///     histogram, see TH1::FillN
+
+void TH3::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w, Int_t stride)
+{
+   Int_t i;
+   ntimes *= stride;
+   Int_t ifirst = 0;
+
+   //If a buffer is activated, fill buffer
+   if (fBuffer) {
+      for (i=0;i<ntimes;i+=stride) {
+         if (!fBuffer) break; // buffer can be deleted in BufferFill when is empty
+         BufferFill(x[i], y[i], z[i], w ? w[i] : 1.);
+      }
+      // fill the remaining entries if the buffer has been deleted
+      if (i < ntimes && fBuffer==nullptr)
+         ifirst = i;
+      else
+         return;
+   }
+
+   if (!THFillNHelper::IsFixed(fXaxis) || !THFillNHelper::IsFixed(fYaxis) || !THFillNHelper::IsFixed(fZaxis)) {
+      for (i=ifirst;i<ntimes;i+=stride)
+         Fill(x[i], y[i], z[i], w ? w[i] : 1.);
+      return;
+   }
+
+   const Bool_t statOverflows = GetStatOverflowsBehaviour();
+   const Int_t nentries = (ntimes - ifirst + stride - 1) / stride;
+   const Int_t nx = fXaxis.GetNbins()+2;
+   const Int_t ny = fYaxis.GetNbins()+2;
+   Int_t bins[THFillNHelper::kChunkSize];
+   Bool_t inRange[THFillNHelper::kChunkSize];
+   fEntries += nentries;
+   for (Int_t first = 0; first < nentries; first += THFillNHelper::kChunkSize) {
+      const Int_t n = TMath::Min(THFillNHelper::kChunkSize, nentries - first);
+      const Long64_t offset = ifirst + Long64_t(first) * stride;
+      const Double_t *xc = x + offset;
+      const Double_t *yc = y + offset;
+      const Double_t *zc = z + offset;
+      const Double_t *wc = w ? w + offset : nullptr;
+      std::fill_n(bins, n, 0);
+      std::fill_n(inRange, n, kTRUE);
+      THFillNHelper::AddBins(fXaxis, n, xc, stride, 1, bins, inRange);
+      THFillNHelper::AddBins(fYaxis, n, yc, stride, nx, bins, inRange);
+      THFillNHelper::AddBins(fZaxis, n, zc, stride, nx*ny, bins, inRange);
+      THFillNHelper::AddContents(*this, n, bins, wc, stride);
+      for (i = 0; i < n; i++) {
+         if (!statOverflows && !inRange[i]) continue;
+         const Double_t ww = wc ? wc[i*stride] : 1.;
+         const Double_t xi = xc[i*stride];
+         const Double_t yi = yc[i*stride];
+         const Double_t zi = zc[i*stride];
+         fTsumw   += ww;
+         fTsumw2  += ww*ww;
+         fTsumwx  += ww*xi;
+         fTsumwx2 += ww*xi*xi;
+         fTsumwy  += ww*yi;
+         fTsumwy2 += ww*yi*yi;
+         fTsumwxy += ww*xi*yi;
+         fTsumwz  += ww*zi;
+         fTsumwz2 += ww*zi*zi;
+         fTsumwxz += ww*xi*zi;
+         fTsumwyz += ww*yi*zi;
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment cell defined by namex,namey,namez by a weight w
 ///
@@ -0,0 +1,114 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_THFillNHelper
+#define ROOT_THFillNHelper
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// THFillNHelper                                                        //
+//                                                                      //
+// Helper of the FillN methods of TH1, TH2 and TH3 for histograms with  //
+// fixed bins. The entries are processed by chunks: the bins of a chunk //
+// are first computed arithmetically, without calling TAxis::FindBin,  //
+// then the contents and sums of squares of weights are incremented.   //
+// The results are identical to filling the entries one by one.         //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
+
+class THFillNHelper {
+
+public:
+   /// Number of entries processed at once
+   static constexpr Int_t kChunkSize = 512;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Return kTRUE if the bins of axis can be computed arithmetically: the axis
+   /// has fixed bins and cannot be extended.
+
+   static Bool_t IsFixed(const TAxis &axis) { return axis.GetXbins()->fN == 0 && !axis.CanExtend(); }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Compute the bins on axis (with fixed bins, see IsFixed) of the n values
+   /// x[i*stride], exactly as TAxis::FindBin does, and add them multiplied by
+   /// factor to bins[i]. inRange[i] is reset for the values in the underflow or
+   /// overflow bins.
+
+   static void AddBins(const TAxis &axis, Int_t n, const Double_t *x, Int_t stride, Int_t factor, Int_t *bins,
+                       Bool_t *inRange)
+   {
+      const Int_t nbins = axis.GetNbins();
+      const Double_t xmin = axis.GetXmin();
+      const Double_t xmax = axis.GetXmax();
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t xi = x[i * stride];
+         const Bool_t in = xi >= xmin && xi < xmax; // NaN goes to the overflow, as in TAxis::FindBin
+         const Double_t xc = in ? xi : xmin;
+         const Int_t inBin = 1 + Int_t(nbins * (xc - xmin) / (xmax - xmin));
+         bins[i] += factor * (in ? inBin : (xi < xmin ? 0 : nbins + 1));
+         inRange[i] = inRange[i] && in;
+      }
+   }
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Add the weights w[i*stride] (1 if w is null) of n entries to the contents
+   /// of bins[i] of h, and their squares to the sums of squares of weights.
+   /// The storage of the sums of squares is triggered as in TH1::Fill.
+
+   static void AddContents(TH1 &h, Int_t n, const Int_t *bins, const Double_t *w, Int_t stride)
+   {
+      if (w && !h.GetSumw2N() && !h.TestBit(TH1::kIsNotW)) {
+         for (Int_t i = 0; i < n; ++i) {
+            if (w[i * stride] != 1.0) {
+               h.Sumw2();
+               break;
+            }
+         }
+      }
+      if (h.GetSumw2N()) {
+         Double_t *sumw2 = h.GetSumw2()->GetArray();
+         for (Int_t i = 0; i < n; ++i) {
+            const Double_t wi = w ? w[i * stride] : 1.;
+            sumw2[bins[i]] += wi * wi;
+         }
+      }
+      // The contents of the most common histograms are accessed directly,
+      // the others go through AddBinContent.
+      const TClass *cl = h.IsA();
+      if (cl == TH1D::Class() || cl == TH2D::Class() || cl == TH3D::Class()) {
+         AddToArray(dynamic_cast<TArrayD &>(h).GetArray(), n, bins, w, stride);
+      } else if (cl == TH1F::Class() || cl == TH2F::Class() || cl == TH3F::Class()) {
+         AddToArray(dynamic_cast<TArrayF &>(h).GetArray(), n, bins, w, stride);
+      } else {
+         for (Int_t i = 0; i < n; ++i)
+            h.AddBinContent(bins[i], w ? w[i * stride] : 1.);
+      }
+   }
+
+private:
+   template <typename T>
+   static void AddToArray(T *array, Int_t n, const Int_t *bins, const Double_t *w, Int_t stride)
+   {
+      if (w) {
+         for (Int_t i = 0; i < n; ++i)
+            array[bins[i]] += T(w[i * stride]);
+      } else {
+         for (Int_t i = 0; i < n; ++i)
+            array[bins[i]] += T(1);
+      }
+   }
+};
+
+#endif
@@ -11,6 +11,16 @@
 
 #include "THn.h"
 
+#include "TCollection.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
+#include <algorithm>
+#include <vector>
+
 namespace {
    //______________________________________________________________________________
    //
@@ -244,6 +254,86 @@ void THn::InitStorage(Int_t* nbins, Int_t /*chunkSize*/)
    fSumw2.Init(fNdimensions, nbins, true /*addOverflow*/);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Merge all THn of the list into this histogram; return the number of
+/// entries or -1 on error.
+///
+/// The histograms with the same number of bins as this one are merged bin by
+/// bin, each bin receiving the histograms in the order of the list: the result
+/// is identical to adding them one after the other. With implicit
+/// multi-threading, large merges are done in parallel on disjoint ranges of
+/// bins. If the list contains objects that are not THn, THnBase::Merge() is
+/// used.
+
+Long64_t THn::Merge(TCollection* list)
+{
+   if (!list) return 0;
+   if (list->IsEmpty()) return (Long64_t)GetEntries();
+
+   std::vector<const THn*> hists;
+   TIter iter(list);
+   while (const TObject* addMeObj = iter()) {
+      const THn* addMe = dynamic_cast<const THn*>(addMeObj);
+      if (!addMe)
+         return THnBase::Merge(list);
+      if (addMe != this && CheckConsistency(addMe, "Merge"))
+         hists.push_back(addMe);
+   }
+
+   // Errors are calculated if this or any of the histograms calculates them;
+   // the histograms without errors contribute their contents.
+   const Double_t tsumw2 = fTsumw2;
+   Bool_t haveErrors = GetCalculateErrors();
+   for (const THn* h: hists)
+      haveErrors |= h->GetCalculateErrors();
+   if (haveErrors && !GetCalculateErrors())
+      Sumw2();
+
+   TNDArray& content = GetArray();
+   const Long64_t nbins = GetNbins();
+   if (!hists.empty() && nbins) {
+      // allocate the storage before the bins are accessed concurrently
+      content.AddAt(0, 0.);
+      if (haveErrors)
+         fSumw2.AddAt(0, 0.);
+   }
+   auto mergeRange = [&](Long64_t first, Long64_t last) {
+      for (const THn* h: hists) {
+         const TNDArray& hcontent = h->GetArray();
+         for (Long64_t i = first; i < last; ++i) {
+            if (haveErrors)
+               fSumw2.At(i) += h->GetBinError2(i);
+            content.AddAt(i, hcontent.AtAsDouble(i));
+         }
+      }
+   };
+
+#ifdef R__USE_IMT
+   const Long64_t kMinRangeSize = 16384;
+   if (ROOT::IsImplicitMTEnabled() && nbins >= 2 * kMinRangeSize &&
+       nbins * (Long64_t)hists.size() >= (Long64_t)1 << 22) {
+      const Long64_t nranges = std::min<Long64_t>(nbins / kMinRangeSize, 8 * (Long64_t)ROOT::GetThreadPoolSize());
+      const Long64_t rangeSize = (nbins + nranges - 1) / nranges;
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](UInt_t r) { mergeRange(r * rangeSize, std::min(nbins, (r + 1) * rangeSize)); },
+                   ROOT::TSeqU(nranges));
+   } else
+#endif
+   {
+      mergeRange(0, nbins);
+   }
+
+   // the statistics are added as by Add(): the sums of squared weights start
+   // with the first histogram that calculates errors
+   fTsumw2 = tsumw2;
+   for (const THn* h: hists) {
+      if (!GetCalculateErrors() && h->GetCalculateErrors())
+         fTsumw2 = 0.;
+      AddStatistics(h, 1.);
+   }
+   return (Long64_t)GetEntries();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Reset the contents of a THn.
 
@@ -788,8 +788,18 @@ void THnBase::AddInternal(const THnBase* h, Double_t c, Bool_t rebinned)
    delete [] x;
 
    // add also the statistics
+   AddStatistics(h, c);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the statistics (sums of weights and entries) of h scaled by c to the
+/// ones of this histogram. The sums of squared weights and the moments are
+/// only added if this histogram calculates errors.
+
+void THnBase::AddStatistics(const THnBase* h, Double_t c)
+{
    fTsumw += c * h->fTsumw;
-   if (haveErrors) {
+   if (GetCalculateErrors()) {
       fTsumw2 += c * c * h->fTsumw2;
       if (h->fTsumwx.fN == fNdimensions && h->fTsumwx2.fN == fNdimensions) {
          for (Int_t d = 0; d < fNdimensions; ++d) {
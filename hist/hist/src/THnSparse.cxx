@@ -16,6 +16,14 @@
 #include "TDataMember.h"
 #include "TDataType.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
+#include <algorithm>
+#include <vector>
+
 namespace {
 //______________________________________________________________________________
 //
@@ -169,7 +177,7 @@ THnSparseCoordCompression::THnSparseCoordCompression(const THnSparseCoordCompres
    fNdimensions = other.fNdimensions;
    fCoordBufferSize = other.fCoordBufferSize;
    fBitOffsets = new Int_t[fNdimensions + 1];
-   memcpy(fBitOffsets, other.fBitOffsets, sizeof(Int_t) * fNdimensions);
+   memcpy(fBitOffsets, other.fBitOffsets, sizeof(Int_t) * (fNdimensions + 1));
 }
 
 
@@ -184,7 +192,7 @@ THnSparseCoordCompression& THnSparseCoordCompression::operator=(const THnSparseC
    fCoordBufferSize = other.fCoordBufferSize;
    delete [] fBitOffsets;
    fBitOffsets = new Int_t[fNdimensions + 1];
-   memcpy(fBitOffsets, other.fBitOffsets, sizeof(Int_t) * fNdimensions);
+   memcpy(fBitOffsets, other.fBitOffsets, sizeof(Int_t) * (fNdimensions + 1));
    return *this;
 }
 
@@ -318,9 +326,9 @@ ULong64_t THnSparseCoordCompression::GetHashFromBuffer(const Char_t* buf) const
 {
    // Bins are addressed in two different modes, depending
    // on whether the compact bin index fits into a Long64_t or not.
-   // If it does, we can use it as a "perfect hash" for the TExMap.
+   // If it does, we can use it as a "perfect hash" for THnSparse::fBins.
    // If not we build a hash from the compact bin index, and use that
-   // as the TExMap's hash.
+   // as the hash in THnSparse::fBins.
 
    if (fCoordBufferSize <= 8) {
       // fits into a Long64_t
@@ -570,14 +578,18 @@ Translation from an n-dimensional bin coordinate to the linear index within
 the chunks is done by GetBin(). It creates a hash from the compacted bin
 coordinates (the hash of a bin coordinate is the compacted coordinate itself
 if it takes less than 8 bytes, the size of a Long64_t.
-This hash is used to lookup the linear index in the TExMap member fBins;
-the coordinates of the entry fBins points to is compared to the coordinates
+This hash is used to lookup the linear index in the member fBins, a flat
+open-addressing hash table split in shards (see THnSparseHashTable).
+The coordinates of the entry fBins points to are compared to the coordinates
 passed to GetBin(). If they do not match, these two coordinates have the same
 hash - which is extremely unlikely but (for the case where the compact bin
-coordinates are larger than 4 bytes) possible. In this case, fBinsContinued
-contains a chain of linear indexes with the same hash. Iterating through this
-chain and comparing each bin coordinates with the one passed to GetBin() will
-retrieve the matching bin.
+coordinates are larger than 8 bytes) possible. In this case the lookup
+continues with the next entry of fBins with the same hash, until the
+matching bin is found.
+
+Many entries can be filled at once with FillN(). If implicit multi-threading
+is enabled (ROOT::EnableImplicitMT()) the entries are then distributed over
+the shards of fBins, which are filled concurrently.
 */
 
 
@@ -658,27 +670,15 @@ void THnSparse::FillExMap()
    THnSparseArrayChunk* chunk = nullptr;
    THnSparseCoordCompression compactCoord(*GetCompactCoord());
    Long64_t idx = 0;
-   if (2 * GetNbins() > fBins.Capacity())
-      fBins.Expand(3 * GetNbins());
+   fBins.Reserve(GetNbins());
    while ((chunk = (THnSparseArrayChunk*) iChunk())) {
       const Int_t chunkSize = chunk->GetEntries();
       Char_t* buf = chunk->fCoordinates;
       const Int_t singleCoordSize = chunk->fSingleCoordinateSize;
       const Char_t* endbuf = buf + singleCoordSize * chunkSize;
       for (; buf < endbuf; buf += singleCoordSize, ++idx) {
-         Long64_t hash = compactCoord.GetHashFromBuffer(buf);
-         Long64_t linidx = fBins.GetValue(hash);
-         if (linidx) {
-            Long64_t nextidx = linidx;
-            while (nextidx) {
-               // must be a collision, so go to fBinsContinued.
-               linidx = nextidx;
-               nextidx = fBinsContinued.GetValue(linidx);
-            }
-            fBinsContinued.Add(linidx, idx + 1);
-         } else {
-            fBins.Add(hash, idx + 1);
-         }
+         // Bins are unique: no need to look for an existing entry.
+         fBins.Insert(compactCoord.GetHashFromBuffer(buf), idx + 1);
       }
    }
 }
@@ -687,12 +687,10 @@ void THnSparse::FillExMap()
 /// Initialize storage for nbins
 
 void THnSparse::Reserve(Long64_t nbins) {
-   if (!fBins.GetSize() && fBinContent.GetSize()) {
+   if (!fBins.IsFilled() && fBinContent.GetSize()) {
       FillExMap();
    }
-   if (2 * nbins > fBins.Capacity()) {
-      fBins.Expand(3 * nbins);
-   }
+   fBins.Reserve(nbins);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -736,6 +734,192 @@ Long64_t THnSparse::GetBin(const Int_t* coord, Bool_t allocate /*= kTRUE*/)
    return GetBinIndexForCurrentBin(allocate);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill n entries: the coordinates of entry i are x[i * GetNdimensions() + d]
+/// for the dimensions d, its weight is w[i] (1 if w is null).
+/// The result is the same as calling Fill() for each entry; if implicit
+/// multi-threading is enabled the entries are filled in parallel. In that case
+/// the bins created by this call may be numbered differently than when filling
+/// sequentially, and the statistics may differ by rounding errors.
+
+void THnSparse::FillN(Long64_t n, const Double_t *x, const Double_t *w /*= nullptr*/)
+{
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && n > 1) {
+      Bool_t canExtend = kFALSE;
+      for (Int_t d = 0; d < fNdimensions; ++d)
+         canExtend |= GetAxis(d)->CanExtend();
+      if (!canExtend) {
+         FillNParallel(n, x, w);
+         return;
+      }
+   }
+#endif
+   for (Long64_t i = 0; i < n; ++i)
+      Fill(x + i * fNdimensions, w ? w[i] : 1.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill n entries using the thread pool, see FillN().
+/// The entries are processed in batches. For each batch the compact bin
+/// coordinates are computed in parallel, then the entries are grouped by
+/// shard of fBins. Each shard looks up its entries concurrently, recording
+/// the bins it does not know yet under a provisional (negative) index.
+/// The new bins are then allocated in the chunks (sequentially, shard by
+/// shard), before the contents of the bins of each shard are incremented
+/// concurrently: a bin belongs to exactly one shard.
+
+void THnSparse::FillNParallel(Long64_t n, const Double_t *x, const Double_t *w)
+{
+#ifdef R__USE_IMT
+   const Int_t kNShards = THnSparseHashTable::kNShards;
+   const Long64_t kBatchSize = 64 * 1024;
+
+   if (fBinContent.GetSize() && !fBins.IsFilled())
+      FillExMap();
+
+   std::vector<Int_t> nbins(fNdimensions);
+   for (Int_t d = 0; d < fNdimensions; ++d)
+      nbins[d] = GetAxis(d)->GetNbins();
+   const Int_t bufSize = GetCompactCoord()->GetBufferSize();
+   const Bool_t calcErrors = GetCalculateErrors();
+
+   // Statistics of the entries of one shard
+   struct Stats {
+      Double_t fEntries = 0.;
+      Double_t fSumw = 0.;
+      Double_t fSumw2 = 0.;
+      std::vector<Double_t> fSumwx;
+      std::vector<Double_t> fSumwx2;
+   };
+
+   std::vector<Char_t> buf;            // compact coordinates of the entries of the batch
+   std::vector<ULong64_t> hash;        // their hashes
+   std::vector<Long64_t> bin;          // their bin index + 1, or a provisional index < 0
+   std::vector<Long64_t> order;        // entries of the batch sorted by shard
+   std::vector<Long64_t> shardBegin(kNShards + 1);
+   std::vector<std::vector<Long64_t>> newEntries(kNShards); // first entry of each new bin, per shard
+   std::vector<std::vector<Long64_t>> newBins(kNShards);    // index + 1 of the new bins, per shard
+   std::vector<Stats> stats(kNShards);
+
+   ROOT::TThreadExecutor pool;
+
+   for (Long64_t first = 0; first < n; first += kBatchSize) {
+      const Long64_t nbatch = std::min(kBatchSize, n - first);
+      const Double_t *xbatch = x + first * fNdimensions;
+      const Double_t *wbatch = w ? w + first : nullptr;
+      buf.resize(nbatch * bufSize);
+      hash.resize(nbatch);
+      bin.resize(nbatch);
+      order.resize(nbatch);
+
+      // Compute the compact coordinates and their hashes.
+      const Long64_t nranges = kNShards;
+      const Long64_t rangeSize = (nbatch + nranges - 1) / nranges;
+      pool.Foreach([&](UInt_t r) {
+         THnSparseCompactBinCoord cc(fNdimensions, nbins.data());
+         Int_t *coord = cc.GetCoord();
+         const Long64_t end = std::min(nbatch, (r + 1) * rangeSize);
+         for (Long64_t i = r * rangeSize; i < end; ++i) {
+            for (Int_t d = 0; d < fNdimensions; ++d)
+               coord[d] = GetAxis(d)->FindFixBin(xbatch[i * fNdimensions + d]);
+            cc.UpdateCoord();
+            memcpy(buf.data() + i * bufSize, cc.GetBuffer(), bufSize);
+            hash[i] = cc.GetHash();
+         }
+      }, ROOT::TSeqU(nranges));
+
+      // Group the entries by shard, keeping their order.
+      std::fill(shardBegin.begin(), shardBegin.end(), 0);
+      for (Long64_t i = 0; i < nbatch; ++i)
+         ++shardBegin[THnSparseHashTable::GetShardIndex(hash[i]) + 1];
+      for (Int_t s = 0; s < kNShards; ++s)
+         shardBegin[s + 1] += shardBegin[s];
+      {
+         std::vector<Long64_t> pos(shardBegin.begin(), shardBegin.end() - 1);
+         for (Long64_t i = 0; i < nbatch; ++i)
+            order[pos[THnSparseHashTable::GetShardIndex(hash[i])]++] = i;
+      }
+
+      // Look up the bins; unknown bins get the provisional index -(k + 1),
+      // k being their position in newEntries[s].
+      pool.Foreach([&](UInt_t s) {
+         THnSparseHashTable::Shard &shard = fBins.GetShard(s);
+         std::vector<Long64_t> &news = newEntries[s];
+         news.clear();
+         for (Long64_t o = shardBegin[s]; o < shardBegin[s + 1]; ++o) {
+            const Long64_t i = order[o];
+            const Char_t *ibuf = buf.data() + i * bufSize;
+            Long64_t v = shard.Find(hash[i], [&](Long64_t val) {
+               if (val > 0)
+                  return GetChunk((val - 1) / fChunkSize)->Matches((val - 1) % fChunkSize, ibuf);
+               return bufSize <= 8 || !memcmp(buf.data() + news[-val - 1] * bufSize, ibuf, bufSize);
+            });
+            if (!v) {
+               news.push_back(i);
+               v = -(Long64_t)news.size();
+               shard.Insert(hash[i], v);
+            }
+            bin[i] = v;
+         }
+      }, ROOT::TSeqU(kNShards));
+      fBins.SetFilled();
+
+      // Allocate the new bins.
+      for (Int_t s = 0; s < kNShards; ++s) {
+         newBins[s].resize(newEntries[s].size());
+         for (size_t k = 0; k < newEntries[s].size(); ++k)
+            newBins[s][k] = AllocateBin(buf.data() + newEntries[s][k] * bufSize) + 1;
+      }
+
+      // Replace the provisional indices and fill the bins.
+      pool.Foreach([&](UInt_t s) {
+         THnSparseHashTable::Shard &shard = fBins.GetShard(s);
+         for (size_t k = 0; k < newEntries[s].size(); ++k)
+            shard.Replace(hash[newEntries[s][k]], -(Long64_t)(k + 1), newBins[s][k]);
+         Stats &st = stats[s];
+         if (calcErrors && st.fSumwx.empty()) {
+            st.fSumwx.resize(fNdimensions);
+            st.fSumwx2.resize(fNdimensions);
+         }
+         for (Long64_t o = shardBegin[s]; o < shardBegin[s + 1]; ++o) {
+            const Long64_t i = order[o];
+            const Long64_t idx = (bin[i] > 0 ? bin[i] : newBins[s][-bin[i] - 1]) - 1;
+            const Double_t wi = wbatch ? wbatch[i] : 1.;
+            GetChunk(idx / fChunkSize)->AddBinContent(idx % fChunkSize, wi);
+            st.fEntries += 1;
+            if (calcErrors) {
+               st.fSumw += wi;
+               st.fSumw2 += wi * wi;
+               for (Int_t d = 0; d < fNdimensions; ++d) {
+                  const Double_t xd = xbatch[i * fNdimensions + d];
+                  st.fSumwx[d] += wi * xd;
+                  st.fSumwx2[d] += wi * xd * xd;
+               }
+            }
+         }
+      }, ROOT::TSeqU(kNShards));
+   }
+
+   // Merge the statistics, in a reproducible order.
+   for (const Stats &st: stats) {
+      fEntries += st.fEntries;
+      if (calcErrors) {
+         fTsumw += st.fSumw;
+         fTsumw2 += st.fSumw2;
+         for (Int_t d = 0; d < (Int_t)st.fSumwx.size(); ++d) {
+            fTsumwx[d] += st.fSumwx[d];
+            fTsumwx2[d] += st.fSumwx2[d];
+         }
+      }
+   }
+   fIntegralStatus = kInvalidInt;
+#else
+   for (Long64_t i = 0; i < n; ++i)
+      Fill(x + i * fNdimensions, w ? w[i] : 1.);
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the content of the filled bin number "idx".
 /// If coord is non-null, it will contain the bin's coordinates for each axis
@@ -790,46 +974,40 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
 {
    THnSparseCompactBinCoord* cc = GetCompactCoord();
    ULong64_t hash = cc->GetHash();
-   if (fBinContent.GetSize() && !fBins.GetSize())
+   if (fBinContent.GetSize() && !fBins.IsFilled())
       FillExMap();
-   Long64_t linidx = (Long64_t) fBins.GetValue(hash);
-   while (linidx) {
-      // fBins stores index + 1!
-      THnSparseArrayChunk* chunk = GetChunk((linidx - 1)/ fChunkSize);
-      if (chunk->Matches((linidx - 1) % fChunkSize, cc->GetBuffer()))
-         return linidx - 1; // we store idx+1, 0 is "TExMap: not found"
+   // fBins stores index + 1, 0 is "not found"
+   Long64_t linidx = fBins.Find(hash, [this, cc](Long64_t v) {
+      return GetChunk((v - 1) / fChunkSize)->Matches((v - 1) % fChunkSize, cc->GetBuffer());
+   });
+   if (linidx)
+      return linidx - 1;
+   if (!allocate) return -1;
 
-      Long64_t nextlinidx = fBinsContinued.GetValue(linidx);
-      if (!nextlinidx) break;
+   const Long64_t newidx = AllocateBin(cc->GetBuffer());
 
-      linidx = nextlinidx;
-   }
-   if (!allocate) return -1;
+   // store translation between hash and bin
+   fBins.Insert(hash, newidx + 1);
+   return newidx;
+}
 
+////////////////////////////////////////////////////////////////////////////////
+/// Append a bin with compact coordinate buf to the last chunk, creating a new
+/// chunk if needed. Return its linear index.
+
+Long64_t THnSparse::AllocateBin(const Char_t* buf)
+{
    ++fFilledBins;
 
-   // allocate bin in chunk
    THnSparseArrayChunk *chunk = (THnSparseArrayChunk*) fBinContent.Last();
    Long64_t newidx = chunk ? ((Long64_t) chunk->GetEntries()) : -1;
    if (!chunk || newidx == (Long64_t)fChunkSize) {
       chunk = AddChunk();
       newidx = 0;
    }
-   chunk->AddBin(newidx, cc->GetBuffer());
+   chunk->AddBin(newidx, buf);
 
-   // store translation between hash and bin
-   newidx += (fBinContent.GetEntriesFast() - 1) * fChunkSize;
-   if (!linidx) {
-      // fBins didn't find it
-      if (2 * GetNbins() > fBins.Capacity())
-         fBins.Expand(3 * GetNbins());
-      fBins.Add(hash, newidx + 1);
-   } else {
-      // fBins contains one, but it's the wrong one;
-      // add entry to fBinsContinued.
-      fBinsContinued.Add(linidx, newidx + 1);
-   }
-   return newidx;
+   return newidx + (fBinContent.GetEntriesFast() - 1) * (Long64_t)fChunkSize;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -880,7 +1058,7 @@ Double_t THnSparse::GetSparseFractionMem() const {
 
    Double_t size = 0.;
    size += fBinContent.GetEntries() * (GetChunkSize() * sizePerChunkElement + sizeof(THnSparseArrayChunk));
-   size += + 3 * sizeof(Long64_t) * fBins.GetSize() /* TExMap */;
+   size += fBins.GetMemory();
 
    Double_t nbinsTotal = 1.;
    for (Int_t d = 0; d < fNdimensions; ++d)
@@ -962,8 +1140,7 @@ void THnSparse::Sumw2()
 void THnSparse::Reset(Option_t *option /*= ""*/)
 {
    fFilledBins = 0;
-   fBins.Delete();
-   fBinsContinued.Clear();
+   fBins.Clear();
    fBinContent.Delete();
    ResetBase(option);
 }
@@ -22,6 +22,18 @@
 
  The algorithm is briefly described in (4). A binned version is also implemented to address the
  performance issue due to its data size dependance.
+
+ The cost of evaluating the density grows with the number of data points (or bins). Two faster
+ evaluations of the kernel sums can be selected with the option "Evaluation" or with SetEvaluation():
+ - "Evaluation:FFT": for a fixed kernel, the data are binned on a fine grid (with a spacing of 1/32 of
+   the bandwidth) and convolved with the kernel using a FFT; the density is then interpolated on the grid.
+   For an adaptive kernel, this is used for the pilot estimate that determines the bandwidths, and the
+   final kernel sums are evaluated as for "Evaluation:Tree".
+ - "Evaluation:Tree": the kernel centres are sorted in a binary tree, whose nodes record the extent of
+   the supports of their kernels. Only the kernels whose support contains the evaluation point are
+   summed. This gives the same result as the exact evaluation, also for adaptive kernels. The pilot
+   estimate of an adaptive kernel is computed with the FFT.
+ These options are not available for user defined kernels, whose support is unknown.
  */
 
 
@@ -31,6 +43,7 @@
 #include <numeric>
 #include <limits>
 #include <cassert>
+#include <complex>
 
 #include "Math/Error.h"
 #include "TMath.h"
@@ -46,6 +59,44 @@
 
 ClassImp(TKDE);
 
+namespace {
+
+/// Number of kernel centres in each leaf of the tree of TKDE::TKernel
+const UInt_t kTreeLeafSize = 32;
+
+////////////////////////////////////////////////////////////////////////////////
+/// In-place radix-2 FFT of a, whose size must be a power of 2.
+/// The inverse transform is not normalized.
+
+void FFT(std::vector<std::complex<Double_t>> &a, Bool_t inverse)
+{
+   const size_t n = a.size();
+   for (size_t i = 1, j = 0; i < n; ++i) {
+      size_t bit = n >> 1;
+      for (; j & bit; bit >>= 1)
+         j ^= bit;
+      j ^= bit;
+      if (i < j)
+         std::swap(a[i], a[j]);
+   }
+   for (size_t len = 2; len <= n; len <<= 1) {
+      const Double_t angle = (inverse ? 2. : -2.) * M_PI / len;
+      const std::complex<Double_t> wlen(std::cos(angle), std::sin(angle));
+      for (size_t i = 0; i < n; i += len) {
+         std::complex<Double_t> w(1.);
+         for (size_t k = 0; k < len / 2; ++k) {
+            const std::complex<Double_t> u = a[i + k];
+            const std::complex<Double_t> v = a[i + k + len / 2] * w;
+            a[i + k] = u + v;
+            a[i + k + len / 2] = u - v;
+            w *= wlen;
+         }
+      }
+   }
+}
+
+} // namespace
+
 
 struct TKDE::KernelIntegrand {
    enum EIntegralResult{kNorm, kMu, kSigma2, kUnitIntegration};
@@ -66,6 +117,7 @@ TKDE::TKDE() :
    fLowerPDF(nullptr),
    fApproximateBias(nullptr),
    fGraph(nullptr),
+   fEvaluation(kExact),
    fUseMirroring(false), fMirrorLeft(false), fMirrorRight(false), fAsymLeft(false), fAsymRight(false),
    fUseBins(false), fNewData(false), fUseMinMaxFromData(false),
    fNBins(0), fNEvents(0), fSumOfCounts(0), fUseBinsNEvents(0),
@@ -113,7 +165,7 @@ void TKDE::Instantiate(KernelFunction_Ptr kernfunc, UInt_t events, const Double_
    fWeightSize = 0;
    fCanonicalBandwidths = std::vector<Double_t>(kTotalKernels, 0.0);
    fKernelSigmas2 = std::vector<Double_t>(kTotalKernels, -1.0);
-   fSettedOptions = std::vector<Bool_t>(4, kFALSE);
+   fSettedOptions = std::vector<Bool_t>(5, kFALSE);
    SetOptions(option, rho);
    CheckOptions(kTRUE);
    SetMirror();
@@ -128,7 +180,7 @@ void TKDE::SetOptions(const Option_t* option, Double_t rho) {
    TString opt = option;
    opt.ToLower();
    std::string options = opt.Data();
-   size_t numOpt = 4;
+   size_t numOpt = 5;
    std::vector<std::string> voption(numOpt, "");
    for (std::vector<std::string>::iterator it = voption.begin(); it != voption.end() && !options.empty(); ++it) {
       size_t pos = options.find_last_of(';');
@@ -264,6 +316,19 @@ void TKDE::GetOptions(std::string optionType, std::string option) {
          this->Info("GetOptions", "Possible binning type options are: Unbinned, ForcedBinning, RelaxedBinning");
          fBinning = kRelaxedBinning;
       }
+   } else if (optionType.compare("evaluation") == 0) {
+      fSettedOptions[4] = kTRUE;
+      if (option.compare("exact") == 0) {
+         fEvaluation = kExact;
+      } else if (option.compare("fft") == 0) {
+         fEvaluation = kFFT;
+      } else if (option.compare("tree") == 0) {
+         fEvaluation = kTree;
+      } else {
+         this->Warning("GetOptions", "Unknown evaluation option %s: setting to Exact", option.c_str());
+         this->Info("GetOptions", "Possible evaluation type options are: Exact, FFT, Tree");
+         fEvaluation = kExact;
+      }
    }
 }
 
@@ -281,6 +346,9 @@ void TKDE::AssureOptions() {
    if (!fSettedOptions[3]) {
       fBinning = kRelaxedBinning;
    }
+   if (!fSettedOptions[4]) {
+      fEvaluation = kExact;
+   }
 }
 
 void TKDE::CheckOptions(Bool_t isUserDefinedKernel) {
@@ -300,6 +368,10 @@ void TKDE::CheckOptions(Bool_t isUserDefinedKernel) {
       Warning("CheckOptions", "Illegal user binning type input - use default value !");
       fBinning = kRelaxedBinning;
    }
+   if (!(fEvaluation >= kExact && fEvaluation <= kTree)) {
+      Warning("CheckOptions", "Illegal user evaluation type input - use default value !");
+      fEvaluation = kExact;
+   }
    if (fRho <= 0.0) {
       Warning("CheckOptions", "Tuning factor rho cannot be non-positive - use default value !");
       fRho = 1.0;
@@ -343,6 +415,13 @@ void TKDE::SetBinning(EBinning bin) {
    SetUseBins();
 }
 
+void TKDE::SetEvaluation(EEvaluation eval) {
+   // Sets User option for the evaluation of the kernel sums
+   fEvaluation = eval;
+   CheckOptions();
+   fKernel.reset();
+}
+
 void TKDE::SetNBins(UInt_t nbins) {
    // Sets User option for number of bins
    if (!nbins) {
@@ -608,6 +687,11 @@ void TKDE::SetKernel() {
    if (fIteration == kAdaptive) {
       fKernel->ComputeAdaptiveWeights();
    }
+   if (fEvaluation == kFFT && fIteration != kAdaptive) {
+      fKernel->BuildGrid();
+   } else if (fEvaluation != kExact) {
+      fKernel->BuildTree();
+   }
    if (gDebug) {
       if (fIteration != kAdaptive)
          Info("SetKernel",
@@ -781,6 +865,9 @@ void TKDE::TKernel::ComputeAdaptiveWeights() {
    std::vector<Double_t> weights(n, fWeights[0]);
    bool useDataWeights = (fKDE->fBinCount.size() == n);
    Double_t f = 0.0;
+   // the pilot estimate uses the fixed weight: it can be computed on a grid
+   if (fKDE->fEvaluation != kExact)
+      BuildGrid();
    for (unsigned int i = 0; i < n; ++i) {
       // for negative or null bin contents use the fixed weight value (fWeights[0])
       if (useDataWeights && fKDE->fBinCount[i] <= 0) {
@@ -804,6 +891,7 @@ void TKDE::TKernel::ComputeAdaptiveWeights() {
    Double_t kAPPROX_GEO_MEAN = 0.241970724519143365; // 1 / TMath::Power(2 * TMath::Pi(), .5) * TMath::Exp(-.5). Approximated geometric mean over pointwise data (the KDE function is substituted by the "real Gaussian" pdf) and proportional to sigma. Used directly when the mirroring is enabled, otherwise computed from the data
    // not sure for this special case for mirror. This results in a much smaller bandwidth for mirror case
    fKDE->fAdaptiveBandwidthFactor = fKDE->fUseMirroring ? kAPPROX_GEO_MEAN / fKDE->fSigmaRob : std::sqrt(std::exp(fKDE->fAdaptiveBandwidthFactor / fKDE->fData.size()));
+   std::vector<Double_t>().swap(fGrid);
    // set adaptive weights in fWeights matrix
    fWeights.resize(n);
    transform(weights.begin(), weights.end(), fWeights.begin(),
@@ -1007,8 +1095,196 @@ const std::vector<Double_t> & TKDE::TKernel::GetAdaptiveWeights() const {
    return fWeights;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Collect the centres of the kernels with their counts and bandwidths, including
+/// their reflections for the asymmetric mirroring. Kernels with a null bandwidth
+/// (see ComputeAdaptiveWeights) are skipped.
+
+void TKDE::TKernel::GetKernelCentres(std::vector<Double_t> &x, std::vector<Double_t> &count,
+                                     std::vector<Double_t> &bandwidth) const
+{
+   const UInt_t n = fKDE->fData.size();
+   const Bool_t useCount = (fKDE->fBinCount.size() == n);
+   const Bool_t hasAdaptiveWeights = (fWeights.size() == n);
+   for (UInt_t i = 0; i < n; ++i) {
+      const Double_t h = hasAdaptiveWeights ? fWeights[i] : fWeights[0];
+      if (h == 0)
+         continue;
+      const Double_t c = useCount ? fKDE->fBinCount[i] : 1.;
+      const Double_t xi = fKDE->fData[i];
+      x.push_back(xi);
+      count.push_back(c);
+      bandwidth.push_back(h);
+      if (fKDE->fAsymLeft) {
+         x.push_back(2. * fKDE->fXMin - xi);
+         count.push_back(c);
+         bandwidth.push_back(h);
+      }
+      if (fKDE->fAsymRight) {
+         x.push_back(2. * fKDE->fXMax - xi);
+         count.push_back(c);
+         bandwidth.push_back(h);
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the estimated density for the fixed weight on a regular grid, for the
+/// FFT evaluation: the kernel centres are linearly binned on the grid, which is
+/// then convolved with the sampled kernel using a FFT.
+/// The grid is left empty (exact evaluation) if the kernel support is unknown or
+/// if the data range is too large compared to the bandwidth.
+
+void TKDE::TKernel::BuildGrid()
+{
+   fGrid.clear();
+   const Double_t support = fKDE->GetKernelSupport();
+   const Double_t h = fWeights[0];
+   if (support <= 0 || !(h > 0))
+      return;
+
+   std::vector<Double_t> x, count, bandwidth;
+   GetKernelCentres(x, count, bandwidth);
+   if (x.empty())
+      return;
+
+   const UInt_t kMaxGrid = 1 << 18;
+   const auto minmax = std::minmax_element(x.begin(), x.end());
+   const Double_t lo = *minmax.first - support * h;
+   const Double_t hi = *minmax.second + support * h;
+   const UInt_t ngrid = 1 + (UInt_t)std::min<Double_t>(kMaxGrid, std::ceil(32. * (hi - lo) / h));
+   const Double_t step = (hi - lo) / (ngrid - 1);
+   if (step > h / 4) {
+      fKDE->Info("BuildGrid", "Data range too large compared to the bandwidth %g: using the exact evaluation", h);
+      return;
+   }
+
+   // half width of the kernel, in grid steps
+   const UInt_t nkern = (UInt_t)(support * h / step);
+   size_t nfft = 1;
+   while (nfft < ngrid + 2 * nkern)
+      nfft *= 2;
+
+   std::vector<std::complex<Double_t>> data(nfft), kern(nfft);
+   for (size_t i = 0; i < x.size(); ++i) {
+      const Double_t t = (x[i] - lo) / step;
+      const UInt_t j = std::min((UInt_t)t, ngrid - 2);
+      const Double_t f = t - j;
+      data[j] += count[i] * (1. - f);
+      data[j + 1] += count[i] * f;
+   }
+   for (Int_t m = -(Int_t)nkern; m <= (Int_t)nkern; ++m)
+      kern[(m + nfft) % nfft] = (*fKDE->fKernelFunction)(m * step / h) / h;
+
+   FFT(data, kFALSE);
+   FFT(kern, kFALSE);
+   for (size_t i = 0; i < nfft; ++i)
+      data[i] *= kern[i];
+   FFT(data, kTRUE);
+
+   const Double_t norm = 1. / (nfft * fKDE->fSumOfCounts);
+   fGrid.resize(ngrid);
+   for (UInt_t j = 0; j < ngrid; ++j)
+      fGrid[j] = data[j].real() * norm;
+   fGridMin = lo;
+   fGridStep = step;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the tree of the kernel centres for the tree evaluation: the centres are
+/// sorted by position and grouped in leaves of kTreeLeafSize centres; each node
+/// of the (complete, binary) tree stores the range covered by the supports of the
+/// kernels below it.
+/// No tree is built if the kernel support is unknown.
+
+void TKDE::TKernel::BuildTree()
+{
+   const Double_t support = fKDE->GetKernelSupport();
+   if (support <= 0)
+      return;
+
+   std::vector<Double_t> x, count, bandwidth;
+   GetKernelCentres(x, count, bandwidth);
+   const UInt_t n = x.size();
+   if (!n)
+      return;
+
+   std::vector<UInt_t> order(n);
+   std::iota(order.begin(), order.end(), 0);
+   std::sort(order.begin(), order.end(), [&x](UInt_t a, UInt_t b) { return x[a] < x[b]; });
+   fTreeX.resize(n);
+   fTreeW.resize(n);
+   fTreeInvH.resize(n);
+   for (UInt_t i = 0; i < n; ++i) {
+      fTreeX[i] = x[order[i]];
+      fTreeInvH[i] = 1. / bandwidth[order[i]];
+      fTreeW[i] = count[order[i]] * fTreeInvH[i];
+   }
+
+   fTreeNLeaves = 1;
+   while (fTreeNLeaves * kTreeLeafSize < n)
+      fTreeNLeaves *= 2;
+   fTreeMin.assign(2 * fTreeNLeaves, std::numeric_limits<Double_t>::infinity());
+   fTreeMax.assign(2 * fTreeNLeaves, -std::numeric_limits<Double_t>::infinity());
+   for (UInt_t i = 0; i < n; ++i) {
+      const UInt_t leaf = fTreeNLeaves + i / kTreeLeafSize;
+      const Double_t halfWidth = support / fTreeInvH[i];
+      fTreeMin[leaf] = std::min(fTreeMin[leaf], fTreeX[i] - halfWidth);
+      fTreeMax[leaf] = std::max(fTreeMax[leaf], fTreeX[i] + halfWidth);
+   }
+   for (UInt_t node = fTreeNLeaves - 1; node > 0; --node) {
+      fTreeMin[node] = std::min(fTreeMin[2 * node], fTreeMin[2 * node + 1]);
+      fTreeMax[node] = std::max(fTreeMax[2 * node], fTreeMax[2 * node + 1]);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Interpolate the density computed by BuildGrid() at x
+
+Double_t TKDE::TKernel::EvalGrid(Double_t x) const
+{
+   const Double_t t = (x - fGridMin) / fGridStep;
+   if (!(t >= 0. && t <= fGrid.size() - 1.))
+      return TMath::IsNaN(x) ? x : 0.; // outside of the supports of all the kernels
+   const UInt_t j = std::min((UInt_t)t, (UInt_t)fGrid.size() - 2);
+   const Double_t f = t - j;
+   return fGrid[j] * (1. - f) + fGrid[j + 1] * f;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sum the kernels whose support contains x, using the tree built by BuildTree()
+
+Double_t TKDE::TKernel::EvalTree(Double_t x) const
+{
+   Double_t result = 0.;
+   UInt_t stack[64];
+   Int_t depth = 0;
+   stack[depth++] = 1;
+   while (depth) {
+      const UInt_t node = stack[--depth];
+      if (!(x >= fTreeMin[node] && x <= fTreeMax[node]))
+         continue;
+      if (node < fTreeNLeaves) {
+         stack[depth++] = 2 * node + 1;
+         stack[depth++] = 2 * node;
+         continue;
+      }
+      const UInt_t begin = (node - fTreeNLeaves) * kTreeLeafSize;
+      const UInt_t end = std::min<UInt_t>(begin + kTreeLeafSize, fTreeX.size());
+      for (UInt_t i = begin; i < end; ++i)
+         result += fTreeW[i] * (*fKDE->fKernelFunction)((x - fTreeX[i]) * fTreeInvH[i]);
+   }
+   if (TMath::IsNaN(x))
+      return x;
+   return result / fKDE->fSumOfCounts;
+}
+
 Double_t TKDE::TKernel::operator()(Double_t x) const {
    // The internal class's unary function: returns the kernel density estimate
+   if (!fGrid.empty())
+      return EvalGrid(x);
+   if (!fTreeMin.empty())
+      return EvalTree(x);
    Double_t result(0.0);
    UInt_t n = fKDE->fData.size();
    // case of bins or weighted data
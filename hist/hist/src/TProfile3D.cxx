@@ -685,6 +685,27 @@ Int_t TProfile3D::Fill(Double_t x, Double_t y, Double_t z, Double_t t, Double_t
    return bin;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a Profile3D histogram with an array of values and weights.
+///
+///  - ntimes:  number of entries in arrays x, y, z, t and w (array size must be ntimes*stride)
+///  - x, y, z: arrays of the coordinates
+///  - t:       array of the values to be profiled
+///  - w:       array of weights, if NULL each entry is assumed a weight=1
+///  - stride:  step size through the arrays
+///
+/// Equivalent to calling Fill(x[i], y[i], z[i], t[i], w[i]) for each entry.
+/// TH3::FillN(ntimes, x, y, z, w, stride) may not be used, since the fourth
+/// coordinate of a profile is the profiled value and not the weight.
+
+void TProfile3D::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *t,
+                       const Double_t *w, Int_t stride)
+{
+   ntimes *= stride;
+   for (Int_t i = 0; i < ntimes; i += stride)
+      Fill(x[i], y[i], z[i], t[i], w ? w[i] : 1.);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return bin content of a Profile3D histogram.
 
@@ -107,6 +107,28 @@ namespace ROOT {
          }
       }
 
+      bool WrappedTF1::HasBatchEvaluation() const
+      {
+         // the evaluation on many points is used only when the vectorized loop of the
+         // formula was generated by the user (TFormula::GenerateBatchEval or TF1::EvalParBatch),
+         // since generating it costs a compilation and changes the last bits of the results
+         auto formula = fFunc->GetFormula();
+         if (!formula || fFunc->IsVectorized())
+            return false;
+         return formula->HasGeneratedBatchEval();
+      }
+
+      void WrappedTF1::DoEvalBatch(unsigned int n, const double *x, double *f) const
+      {
+         // evaluate the function on n points with the parameter values of TF1
+         if (HasBatchEvaluation()) {
+            fFunc->EvalParBatch(n, &x, f, nullptr);
+            return;
+         }
+         for (unsigned int i = 0; i < n; ++i)
+            f[i] = DoEval(x[i]);
+      }
+
       double WrappedTF1::DoDerivative(double  x) const
       {
          // return the function derivatives w.r.t. x
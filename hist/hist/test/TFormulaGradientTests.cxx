@@ -22,6 +22,8 @@
 #include <TF1.h>
 #include <TF2.h>
 #include <TFitResult.h>
+#include <TH1.h>
+#include <TRandom3.h>
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
@@ -165,3 +167,32 @@ TEST(TFormulaGradientPar, GetGradFormula)
 #endif // R__WIN32
 }
 
+
+// Fits of formula-based functions use the Clad gradient by default, and give
+// the same result as with numerical derivatives
+TEST(TFormulaGradientPar, DefaultFitGradient)
+{
+   TH1D h("h", "h", 100, -5., 5.);
+   h.SetDirectory(nullptr);
+   TRandom3 rndm(42);
+   for (int i = 0; i < 10000; ++i)
+      h.Fill(rndm.Gaus(0.3, 1.2));
+
+   for (const char *option : {"S Q N", "S Q N L"}) {
+      TF1 fclad("fclad", "gaus", -5., 5.);
+      TF1 fnum("fnum", "gaus", -5., 5.);
+      for (TF1 *f : {&fclad, &fnum})
+         f->SetParameters(300., 0., 1.);
+
+      auto rclad = h.Fit(&fclad, option);
+      auto rnum = h.Fit(&fnum, (std::string(option) + " NOGRAD").c_str());
+      ASSERT_EQ(rclad->Status(), 0);
+      ASSERT_EQ(rnum->Status(), 0);
+      EXPECT_TRUE(fclad.GetFormula()->HasGeneratedGradient());
+      EXPECT_FALSE(fnum.GetFormula()->HasGeneratedGradient());
+      for (int i = 0; i < 3; ++i) {
+         EXPECT_NEAR(rclad->Parameter(i), rnum->Parameter(i), 2e-2 * rnum->ParError(i)) << option;
+         EXPECT_NEAR(rclad->ParError(i), rnum->ParError(i), 5e-2 * rnum->ParError(i)) << option;
+      }
+   }
+}
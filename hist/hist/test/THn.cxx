@@ -3,6 +3,12 @@
 #include "THn.h"
 #include "TH1.h"
 #include "TH2.h"
+#include "TList.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+
+#include <memory>
+#include <vector>
 
 // Filling THn
 TEST(THn, Fill) {
@@ -111,3 +117,55 @@ TEST(THn, Projection) {
    }
 
 }
+
+// Merging THn gives the same result as adding them one after the other
+TEST(THn, Merge) {
+   Int_t bins[3] = {60, 60, 40};
+   Double_t xmin[3] = {0., 0., 0.};
+   Double_t xmax[3] = {1., 1., 1.};
+   TRandom3 rndm(42);
+   std::vector<std::unique_ptr<THnD>> hists;
+   TList list;
+   for (int i = 0; i < 30; ++i) {
+      hists.emplace_back(new THnD(Form("hn%d", i), "hn", 3, bins, xmin, xmax));
+      // errors are switched on by the second histogram of the list
+      if (i == 2)
+         hists.back()->Sumw2();
+      Double_t x[3];
+      for (int j = 0; j < 5000; ++j) {
+         for (auto &xi : x)
+            xi = 1.2 * rndm.Rndm() - 0.1;
+         hists.back()->Fill(x, 0.5 + rndm.Rndm());
+      }
+      if (i > 0)
+         list.Add(hists.back().get());
+   }
+
+   std::unique_ptr<THnD> added(static_cast<THnD *>(hists[0]->Clone("added")));
+   for (int i = 1; i < 30; ++i)
+      added->Add(hists[i].get());
+
+   auto check = [&](const THnD &merged) {
+      ASSERT_EQ(added->GetNbins(), merged.GetNbins());
+      EXPECT_TRUE(merged.GetCalculateErrors());
+      for (Long64_t bin = 0; bin < merged.GetNbins(); ++bin) {
+         EXPECT_EQ(added->GetBinContent(bin), merged.GetBinContent(bin)) << "bin " << bin;
+         EXPECT_EQ(added->GetBinError2(bin), merged.GetBinError2(bin)) << "bin " << bin;
+      }
+      EXPECT_EQ(added->GetEntries(), merged.GetEntries());
+      EXPECT_EQ(added->GetSumw(), merged.GetSumw());
+      EXPECT_EQ(added->GetSumw2(), merged.GetSumw2());
+   };
+
+   std::unique_ptr<THnD> merged(static_cast<THnD *>(hists[0]->Clone("merged")));
+   merged->Merge(&list);
+   check(*merged);
+
+#ifdef R__USE_IMT
+   std::unique_ptr<THnD> parallel(static_cast<THnD *>(hists[0]->Clone("parallel")));
+   ROOT::EnableImplicitMT(4);
+   parallel->Merge(&list);
+   ROOT::DisableImplicitMT();
+   check(*parallel);
+#endif
+}
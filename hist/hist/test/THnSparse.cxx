@@ -0,0 +1,124 @@
+#include "gtest/gtest.h"
+
+#include "THnSparse.h"
+#include "TROOT.h"
+#include "TRandom3.h"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+// Create a THnSparse with ndim dimensions of nbins bins in [0, 1)
+std::unique_ptr<THnSparseD> MakeSparse(const char *name, Int_t ndim, Int_t nbins)
+{
+   std::vector<Int_t> bins(ndim, nbins);
+   std::vector<Double_t> xmin(ndim, 0.);
+   std::vector<Double_t> xmax(ndim, 1.);
+   auto h = std::make_unique<THnSparseD>(name, name, ndim, bins.data(), xmin.data(), xmax.data());
+   h->Sumw2();
+   return h;
+}
+
+// Fill h with FillN and with Fill, and compare bin by bin
+void CheckFillN(Int_t ndim, Int_t nbins, Long64_t n)
+{
+   TRandom3 rnd(42);
+   std::vector<Double_t> x(n * ndim);
+   std::vector<Double_t> w(n);
+   for (Long64_t i = 0; i < n; ++i) {
+      for (Int_t d = 0; d < ndim; ++d)
+         x[i * ndim + d] = rnd.Gaus(0.5, 0.2); // includes under- and overflows
+      w[i] = rnd.Uniform(0.5, 2.);
+   }
+
+   auto ref = MakeSparse("ref", ndim, nbins);
+   for (Long64_t i = 0; i < n; ++i)
+      ref->Fill(x.data() + i * ndim, w[i]);
+
+   auto h = MakeSparse("h", ndim, nbins);
+   // Fill in two calls, the second one updating existing bins
+   h->FillN(n / 2, x.data(), w.data());
+   h->FillN(n - n / 2, x.data() + n / 2 * ndim, w.data() + n / 2);
+
+   ASSERT_EQ(ref->GetNbins(), h->GetNbins());
+   EXPECT_DOUBLE_EQ(ref->GetEntries(), h->GetEntries());
+   EXPECT_NEAR(ref->GetSumw(), h->GetSumw(), 1E-9 * ref->GetSumw());
+   EXPECT_NEAR(ref->GetSumw2(), h->GetSumw2(), 1E-9 * ref->GetSumw2());
+   for (Int_t d = 0; d < ndim; ++d)
+      EXPECT_NEAR(ref->GetSumwx(d), h->GetSumwx(d), 1E-9 * std::abs(ref->GetSumwx(d)));
+
+   std::vector<Int_t> coord(ndim);
+   for (Long64_t bin = 0; bin < ref->GetNbins(); ++bin) {
+      const Double_t content = ref->GetBinContent(bin, coord.data());
+      const Long64_t hbin = h->GetBin(coord.data(), kFALSE);
+      ASSERT_GE(hbin, 0);
+      // Entries of a bin are added in the same order: identical sums
+      EXPECT_EQ(content, h->GetBinContent(hbin));
+      EXPECT_EQ(ref->GetBinError2(bin), h->GetBinError2(hbin));
+   }
+}
+
+} // namespace
+
+TEST(THnSparse, FillAndFind)
+{
+   auto h = MakeSparse("h", 3, 10);
+   Double_t x[3] = {0.15, 0.55, 0.95};
+   EXPECT_EQ(-1, h->GetBin(x, kFALSE));
+   const Long64_t bin = h->Fill(x, 2.);
+   EXPECT_EQ(bin, h->GetBin(x, kFALSE));
+   EXPECT_EQ(1, h->GetNbins());
+   EXPECT_DOUBLE_EQ(2., h->GetBinContent(bin));
+   EXPECT_GT(h->GetSparseFractionMem(), 0.);
+
+   h->Reset();
+   EXPECT_EQ(0, h->GetNbins());
+   EXPECT_EQ(-1, h->GetBin(x, kFALSE));
+   EXPECT_EQ(0, h->Fill(x));
+}
+
+TEST(THnSparse, FillN)
+{
+   CheckFillN(3, 20, 100000);
+   // Compact coordinates larger than 8 bytes, hashes are not unique
+   CheckFillN(12, 100, 20000);
+}
+
+#ifdef R__USE_IMT
+TEST(THnSparse, FillNParallel)
+{
+   ROOT::EnableImplicitMT(4);
+   CheckFillN(3, 20, 200000);
+   CheckFillN(12, 100, 100000);
+   ROOT::DisableImplicitMT();
+}
+#endif
+
+// Small tables use no memory until filled, and a streamed histogram rebuilds its table
+TEST(THnSparse, HashTable)
+{
+   THnSparseHashTable table;
+   table.Reserve(100);
+   EXPECT_EQ(0, table.GetMemory());
+   EXPECT_FALSE(table.IsFilled());
+   table.Insert(12345, 1);
+   EXPECT_TRUE(table.IsFilled());
+   EXPECT_EQ(1, table.GetSize());
+   EXPECT_EQ(1, table.Find(12345, [](Long64_t) { return true; }));
+   table.Reserve(1 << 16);
+   EXPECT_GE(table.GetMemory(), Long64_t((1 << 16) * sizeof(THnSparseHashTable::Slot)));
+   EXPECT_EQ(1, table.Find(12345, [](Long64_t) { return true; }));
+   table.Clear();
+   EXPECT_FALSE(table.IsFilled());
+   EXPECT_EQ(0, table.GetMemory());
+
+   auto h = MakeSparse("h", 3, 10);
+   Double_t x[3] = {0.15, 0.55, 0.95};
+   const Long64_t bin = h->Fill(x);
+   std::unique_ptr<THnSparse> clone(static_cast<THnSparse *>(h->Clone("clone")));
+   EXPECT_EQ(bin, clone->GetBin(x, kFALSE));
+   EXPECT_EQ(bin, clone->Fill(x));
+   EXPECT_EQ(1, clone->GetNbins());
+   EXPECT_DOUBLE_EQ(2., clone->GetBinContent(bin));
+}
@@ -0,0 +1,83 @@
+#include "gtest/gtest.h"
+
+#include "Fit/BatchFitter.h"
+#include "HFitInterface.h"
+#include "TF1.h"
+#include "TFitResult.h"
+#include "TH1.h"
+#include "TROOT.h"
+#include "TRandom3.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+std::vector<std::unique_ptr<TH1D>> MakeHistograms(int n)
+{
+   TRandom3 rndm(42);
+   std::vector<std::unique_ptr<TH1D>> hists;
+   for (int i = 0; i < n; ++i) {
+      hists.emplace_back(new TH1D(Form("h%d", i), "h", 50, -5., 5.));
+      hists.back()->SetDirectory(nullptr);
+      const double mean = -1. + 0.04 * i;
+      const double sigma = 0.5 + 0.02 * i;
+      for (int j = 0; j < 2000; ++j)
+         hists.back()->Fill(rndm.Gaus(mean, sigma));
+   }
+   return hists;
+}
+
+// The batch fit gives the same results as fitting each histogram with TH1::Fit
+void ExpectSameAsSingleFits(const char *option)
+{
+   auto hists = MakeHistograms(50);
+   std::vector<TH1 *> input;
+   for (auto &h : hists)
+      input.push_back(h.get());
+
+   TF1 f("f", "gaus", -5., 5.);
+   auto result = ROOT::Fit::FitHistograms(input, f, option);
+   ASSERT_EQ(result.NFits(), hists.size());
+   ASSERT_EQ(result.NPar(), 3u);
+
+   for (unsigned int i = 0; i < hists.size(); ++i) {
+      TF1 fi("fi", "gaus", -5., 5.);
+      auto r = hists[i]->Fit(&fi, (std::string(option) + " Q N S").c_str());
+      ASSERT_EQ(r->Status(), 0);
+      EXPECT_TRUE(result.IsValid(i)) << "fit " << i;
+      EXPECT_EQ(result.Ndf(i), r->Ndf()) << "fit " << i;
+      EXPECT_NEAR(result.MinFcnValue(i), r->MinFcnValue(), 1e-3 * r->MinFcnValue()) << "fit " << i;
+      for (unsigned int ipar = 0; ipar < 3; ++ipar) {
+         EXPECT_NEAR(result.Parameter(i, ipar), r->Parameter(ipar), 2e-2 * r->ParError(ipar)) << "fit " << i;
+         EXPECT_NEAR(result.ParError(i, ipar), r->ParError(ipar), 5e-2 * r->ParError(ipar)) << "fit " << i;
+      }
+   }
+}
+} // namespace
+
+TEST(FitHistograms, Chi2)
+{
+   ExpectSameAsSingleFits("SERIAL");
+}
+
+// errors normalized with the chi2, as in TH1::Fit, when the bin errors are not used
+TEST(FitHistograms, Chi2W)
+{
+   ExpectSameAsSingleFits("W SERIAL");
+}
+
+TEST(FitHistograms, Likelihood)
+{
+   ExpectSameAsSingleFits("L SERIAL");
+}
+
+#ifdef R__USE_IMT
+TEST(FitHistograms, MultiThread)
+{
+   ROOT::EnableImplicitMT(4);
+   ExpectSameAsSingleFits("");
+   ExpectSameAsSingleFits("L");
+   ROOT::DisableImplicitMT();
+}
+#endif
@@ -7,3 +7,97 @@ TEST(TFormula, Interp)
 {
   TFormula f("func", "TGeoBBox::DeclFileLine()");
 }
+
+#include "RConfigure.h"
+#include "TF1.h"
+#include "Math/WrappedTF1.h"
+
+#include <cmath>
+#include <vector>
+
+// Evaluate the formula on n points with EvalParBatch and compare with EvalPar
+static void ExpectSameAsEvalPar(const TFormula &f, const std::vector<std::vector<double>> &x, const double *params)
+{
+   const int n = x[0].size();
+   std::vector<const double *> xs;
+   for (auto &xdim : x)
+      xs.push_back(xdim.data());
+   std::vector<double> result(n);
+   f.EvalParBatch(n, xs.data(), result.data(), params);
+   std::vector<double> point(x.size());
+   for (int i = 0; i < n; ++i) {
+      for (unsigned int idim = 0; idim < x.size(); ++idim)
+         point[idim] = x[idim][i];
+      const double expected = f.EvalPar(point.data(), params);
+      EXPECT_NEAR(result[i], expected, 1e-13 * std::abs(expected)) << "point " << i;
+   }
+}
+
+static std::vector<double> MakePoints(int n, double xmin, double xmax)
+{
+   std::vector<double> x(n);
+   for (int i = 0; i < n; ++i)
+      x[i] = xmin + (xmax - xmin) * i / (n - 1);
+   return x;
+}
+
+// The batch evaluation is generated for formulas with only vectorizable functions
+TEST(TFormula, BatchEval)
+{
+   TFormula f("fbatch", "[0] + [1]*x + [2]*x^2 + sqrt(abs(x))");
+   f.SetParameters(1., 2., 3.);
+   // the number of points is not a multiple of the vector size
+   ExpectSameAsEvalPar(f, {MakePoints(1001, -10., 10.)}, nullptr);
+   EXPECT_TRUE(f.HasGeneratedBatchEval());
+
+   double params[] = {-1., 0.5, 0.25};
+   ExpectSameAsEvalPar(f, {MakePoints(17, -1., 1.)}, params);
+
+   TFormula f2("fbatch2", "[0]*x*y + max(x, y) + [1]/(1 + y*y)");
+   f2.SetParameters(2., 3.);
+   ExpectSameAsEvalPar(f2, {MakePoints(100, -5., 5.), MakePoints(100, 3., -2.)}, nullptr);
+   EXPECT_TRUE(f2.HasGeneratedBatchEval());
+
+#ifdef R__HAS_VDT
+   TFormula fgaus("fbatchgaus", "gaus");
+   fgaus.SetParameters(10., 1., 2.);
+   ExpectSameAsEvalPar(fgaus, {MakePoints(500, -10., 10.)}, nullptr);
+   EXPECT_TRUE(fgaus.HasGeneratedBatchEval());
+#endif
+}
+
+// Formulas with other functions are evaluated point by point
+TEST(TFormula, BatchEvalFallback)
+{
+   TFormula f("fbatchpow", "pow(x, [0]) + TMath::BesselJ0(x)");
+   f.SetParameter(0, 1.5);
+   ExpectSameAsEvalPar(f, {MakePoints(100, 0., 10.)}, nullptr);
+   EXPECT_FALSE(f.HasGeneratedBatchEval());
+}
+
+TEST(TF1, EvalParBatch)
+{
+   TF1 f("f1batch", "[0]*x + [1]", 0., 1.);
+   f.SetParameters(2., 1.);
+   std::vector<double> x = MakePoints(50, 0., 1.);
+   const double *xs[] = {x.data()};
+   std::vector<double> result(x.size());
+   f.EvalParBatch(x.size(), xs, result.data());
+   for (unsigned int i = 0; i < x.size(); ++i)
+      EXPECT_DOUBLE_EQ(result[i], 2. * x[i] + 1.);
+}
+
+// The integrals of a TF1 use the vectorized evaluation of the formula only when it was generated by the user
+TEST(TF1, IntegralBatchOptIn)
+{
+   TF1 f("f1integral", "x*x + sqrt(x)", 0., 4.);
+   ROOT::Math::WrappedTF1 wf(f);
+   EXPECT_FALSE(wf.HasBatchEvaluation());
+   const double integral = f.Integral(0., 4.);
+   EXPECT_FALSE(f.GetFormula()->HasGeneratedBatchEval());
+   EXPECT_NEAR(integral, 64. / 3. + 16. / 3., 1e-8);
+
+   ASSERT_TRUE(f.GetFormula()->GenerateBatchEval());
+   EXPECT_TRUE(wf.HasBatchEvaluation());
+   EXPECT_NEAR(f.Integral(0., 4.), integral, 1e-12 * integral);
+}
@@ -0,0 +1,126 @@
+// test the cached interpolation of TGraph::Eval and TGraph2D::Interpolate
+
+#include "gtest/gtest.h"
+
+#include "TGraph.h"
+#include "TGraph2D.h"
+#include "TRandom3.h"
+
+#include <vector>
+
+// Unsorted graph with a few points
+static TGraph CreateGraph()
+{
+   Double_t x[] = {3., 1., 4., 0.5, 2., 6.};
+   Double_t y[] = {2., 1., 0., 3., -1., 5.};
+   return TGraph(6, x, y);
+}
+
+TEST(TGraph, EvalBatchLinear)
+{
+   auto g = CreateGraph();
+   std::vector<Double_t> x = {-1., 0.5, 0.7, 1., 2.5, 3., 5., 6., 8.};
+   std::vector<Double_t> y(x.size());
+   g.Eval(x.size(), x.data(), y.data());
+   for (size_t i = 0; i < x.size(); ++i)
+      EXPECT_EQ(g.Eval(x[i]), y[i]) << "x = " << x[i];
+
+   g.Sort();
+   g.SetBit(TGraph::kIsSortedX);
+   std::vector<Double_t> ysorted(x.size());
+   g.Eval(x.size(), x.data(), ysorted.data());
+   for (size_t i = 0; i < x.size(); ++i)
+      EXPECT_DOUBLE_EQ(y[i], ysorted[i]) << "x = " << x[i];
+}
+
+TEST(TGraph, EvalBatchDuplicates)
+{
+   // points with equal abscissas are searched as in Eval
+   Double_t xp[] = {1., 2., 2., 3.};
+   Double_t yp[] = {1., 2., 4., 3.};
+   TGraph g(4, xp, yp);
+   std::vector<Double_t> x = {0., 1.5, 2., 2.5, 4.};
+   std::vector<Double_t> y(x.size());
+   g.Eval(x.size(), x.data(), y.data());
+   for (size_t i = 0; i < x.size(); ++i)
+      EXPECT_EQ(g.Eval(x[i]), y[i]) << "x = " << x[i];
+}
+
+TEST(TGraph, EvalSplineCache)
+{
+   auto g = CreateGraph();
+   TRandom3 r(3);
+   std::vector<Double_t> x(100), y(100);
+   for (auto &xi : x)
+      xi = r.Uniform(0., 7.);
+   g.Eval(x.size(), x.data(), y.data(), "S");
+   for (size_t i = 0; i < x.size(); ++i)
+      EXPECT_EQ(g.Eval(x[i], nullptr, "S"), y[i]);
+
+   // the cached spline follows the changes of the points
+   Double_t before = g.Eval(2.5, nullptr, "S");
+   g.SetPoint(4, 2., 1.);
+   Double_t after = g.Eval(2.5, nullptr, "S");
+   EXPECT_NE(before, after);
+   g.GetY()[4] = -1.; // modified directly through the array
+   EXPECT_EQ(before, g.Eval(2.5, nullptr, "S"));
+   g.GetX()[4] = 2.2;
+   Double_t moved = g.Eval(2.5, nullptr, "S");
+   EXPECT_EQ(moved, TGraph(g.GetN(), g.GetX(), g.GetY()).Eval(2.5, nullptr, "S"));
+   g.Eval(1, x.data(), y.data(), "S");
+   EXPECT_EQ(y[0], TGraph(g.GetN(), g.GetX(), g.GetY()).Eval(x[0], nullptr, "S"));
+   g.Set(3);
+   EXPECT_EQ(g.Eval(2.5, nullptr, "S"), TGraph(3, g.GetX(), g.GetY()).Eval(2.5, nullptr, "S"));
+}
+
+TEST(TGraph2D, InterpolateBatch)
+{
+   TGraph2D g;
+   TRandom3 r(5);
+   for (int i = 0; i < 200; ++i) {
+      Double_t x = r.Uniform(-1, 1), y = r.Uniform(-1, 1);
+      g.SetPoint(i, x, y, x * x + y);
+   }
+   std::vector<Double_t> x(50), y(50), z(50);
+   for (size_t i = 0; i < x.size(); ++i) {
+      x[i] = r.Uniform(-0.5, 0.5);
+      y[i] = r.Uniform(-0.5, 0.5);
+   }
+   g.Interpolate(x.size(), x.data(), y.data(), z.data());
+   for (size_t i = 0; i < x.size(); ++i) {
+      EXPECT_EQ(g.Interpolate(x[i], y[i]), z[i]);
+      EXPECT_NEAR(x[i] * x[i] + y[i], z[i], 0.05);
+   }
+}
+
+// the Delaunay triangles of the removed points are not used after shrinking the graph
+TEST(TGraph2D, InterpolateAfterSet)
+{
+   TGraph2D g;
+   TRandom3 r(7);
+   for (int i = 0; i < 100; ++i) {
+      Double_t x = r.Uniform(-1, 1), y = r.Uniform(-1, 1);
+      g.SetPoint(i, x, y, x + y);
+   }
+   g.SetPoint(100, 0., 0., 10.);
+   EXPECT_NEAR(g.Interpolate(0., 0.), 10., 1e-9);
+   g.Set(100);
+   TGraph2D ref(100, g.GetX(), g.GetY(), g.GetZ());
+   EXPECT_EQ(g.Interpolate(0., 0.), ref.Interpolate(0., 0.));
+   EXPECT_NEAR(g.Interpolate(0., 0.), 0., 0.1);
+}
+
+TEST(TGraph2D, InterpolateAfterSetPoint)
+{
+   TGraph2D g;
+   g.SetPoint(0, 0, 0, 1);
+   g.SetPoint(1, 1, 0, 1);
+   g.SetPoint(2, 0, 1, 1);
+   g.SetPoint(3, 1, 1, 1);
+   EXPECT_DOUBLE_EQ(1., g.Interpolate(0.5, 0.5));
+
+   // the triangles are recomputed with the new points
+   for (int i = 0; i < 4; ++i)
+      g.SetPoint(i, g.GetX()[i], g.GetY()[i], 3.);
+   EXPECT_DOUBLE_EQ(3., g.Interpolate(0.5, 0.5));
+}
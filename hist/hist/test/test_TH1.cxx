@@ -2,8 +2,17 @@
 
 #include "TH1.h"
 #include "TH1F.h"
+#include "TH2F.h"
+#include "TH3D.h"
+#include "TProfile3D.h"
 #include "THLimitsFinder.h"
+#include "TList.h"
+#include "TRandom3.h"
+#include "TROOT.h"
 
+#include <cmath>
+#include <limits>
+#include <memory>
 #include <vector>
 
 // StatOverflows TH1
@@ -63,3 +72,151 @@ TEST(TH1, SmoothArrayCrossCheck)
       EXPECT_FLOAT_EQ(arr2[i], 1.0);
    }
 }
+
+namespace {
+// Values covering the underflow, the overflow, the bin edges and NaN
+std::vector<double> FillNValues(std::size_t n, double offset)
+{
+   std::vector<double> v(n);
+   for (std::size_t i = 0; i < n; ++i)
+      v[i] = -2.5 + offset + 0.37 * (i % 41);
+   v[3] = std::numeric_limits<double>::quiet_NaN();
+   v[5] = 10.;
+   v[7] = 0.;
+   return v;
+}
+
+void ExpectSameHistograms(const TH1 &h1, const TH1 &h2)
+{
+   ASSERT_EQ(h1.GetNcells(), h2.GetNcells());
+   for (int bin = 0; bin < h1.GetNcells(); ++bin) {
+      EXPECT_EQ(h1.GetBinContent(bin), h2.GetBinContent(bin)) << "bin " << bin;
+      EXPECT_EQ(h1.GetBinError(bin), h2.GetBinError(bin)) << "bin " << bin;
+   }
+   EXPECT_EQ(h1.GetEntries(), h2.GetEntries());
+   double s1[TH1::kNstat], s2[TH1::kNstat];
+   h1.GetStats(s1);
+   h2.GetStats(s2);
+   for (int i = 0; i < TH1::kNstat; ++i)
+      EXPECT_EQ(s1[i], s2[i]) << "stat " << i;
+}
+} // namespace
+
+// FillN gives the same result as Fill, including with the fixed-bin fast path
+TEST(TH1, FillNSameAsFill)
+{
+   const std::size_t n = 2000; // more than one chunk
+   auto x = FillNValues(2 * n, 0.);
+   std::vector<double> w(2 * n);
+   for (std::size_t i = 0; i < w.size(); ++i)
+      w[i] = 0.5 + (i % 3);
+
+   for (bool weighted : {false, true}) {
+      TH1D h1("h1", "h1", 20, 0., 10.);
+      TH1D h2("h2", "h2", 20, 0., 10.);
+      h1.SetDirectory(nullptr);
+      h2.SetDirectory(nullptr);
+      h1.FillN(n, x.data(), weighted ? w.data() : nullptr, 2);
+      for (std::size_t i = 0; i < n; ++i)
+         h2.Fill(x[2 * i], weighted ? w[2 * i] : 1.);
+      ExpectSameHistograms(h1, h2);
+   }
+
+   const double edges[] = {0., 1., 3., 6., 10.};
+   TH1F hv1("hv1", "hv1", 4, edges);
+   TH1F hv2("hv2", "hv2", 4, edges);
+   hv1.SetDirectory(nullptr);
+   hv2.SetDirectory(nullptr);
+   hv1.FillN(n, x.data(), w.data());
+   for (std::size_t i = 0; i < n; ++i)
+      hv2.Fill(x[i], w[i]);
+   ExpectSameHistograms(hv1, hv2);
+}
+
+TEST(TH2, FillNSameAsFill)
+{
+   const std::size_t n = 1500;
+   auto x = FillNValues(n, 0.);
+   auto y = FillNValues(n, 1.3);
+   std::vector<double> w(n, 2.);
+
+   TH2F h1("h1", "h1", 10, 0., 10., 7, -1., 5.);
+   TH2F h2("h2", "h2", 10, 0., 10., 7, -1., 5.);
+   h1.SetDirectory(nullptr);
+   h2.SetDirectory(nullptr);
+   h1.FillN(n, x.data(), y.data(), w.data());
+   for (std::size_t i = 0; i < n; ++i)
+      h2.Fill(x[i], y[i], w[i]);
+   ExpectSameHistograms(h1, h2);
+}
+
+TEST(TH3, FillNSameAsFill)
+{
+   const std::size_t n = 1500;
+   auto x = FillNValues(n, 0.);
+   auto y = FillNValues(n, 1.3);
+   auto z = FillNValues(n, -0.4);
+
+   TH3D h1("h1", "h1", 10, 0., 10., 7, -1., 5., 5, 0., 8.);
+   TH3D h2("h2", "h2", 10, 0., 10., 7, -1., 5., 5, 0., 8.);
+   h1.SetDirectory(nullptr);
+   h2.SetDirectory(nullptr);
+   h1.FillN(n, x.data(), y.data(), z.data(), nullptr);
+   for (std::size_t i = 0; i < n; ++i)
+      h2.Fill(x[i], y[i], z[i]);
+   ExpectSameHistograms(h1, h2);
+}
+
+// The profiled values are filled by TProfile3D::FillN, not taken as weights
+TEST(TProfile3D, FillNSameAsFill)
+{
+   const std::size_t n = 700;
+   auto x = FillNValues(2 * n, 0.);
+   auto y = FillNValues(2 * n, 1.3);
+   auto z = FillNValues(2 * n, -0.4);
+   std::vector<double> t(2 * n), w(2 * n);
+   for (std::size_t i = 0; i < t.size(); ++i) {
+      t[i] = 0.1 * i - 20.;
+      w[i] = 0.5 + (i % 3);
+   }
+
+   for (bool weighted : {false, true}) {
+      TProfile3D p1("p1", "p1", 10, 0., 10., 7, -1., 5., 5, 0., 8.);
+      TProfile3D p2("p2", "p2", 10, 0., 10., 7, -1., 5., 5, 0., 8.);
+      p1.SetDirectory(nullptr);
+      p2.SetDirectory(nullptr);
+      p1.FillN(n, x.data(), y.data(), z.data(), t.data(), weighted ? w.data() : nullptr, 2);
+      for (std::size_t i = 0; i < n; ++i)
+         p2.Fill(x[2 * i], y[2 * i], z[2 * i], t[2 * i], weighted ? w[2 * i] : 1.);
+      ExpectSameHistograms(p1, p2);
+   }
+}
+
+#ifdef R__USE_IMT
+// The parallel merge of histograms with identical axes gives exactly the
+// sequential result
+TEST(TH3, ParallelMergeSameAsSequential)
+{
+   TRandom3 rndm(42);
+   std::vector<std::unique_ptr<TH3D>> hists;
+   TList list;
+   for (int i = 0; i < 40; ++i) {
+      hists.emplace_back(new TH3D(Form("h%d", i), "h", 100, 0., 1., 100, 0., 1., 10, 0., 1.));
+      hists.back()->SetDirectory(nullptr);
+      if (i % 3 == 0)
+         hists.back()->Sumw2();
+      for (int j = 0; j < 20000; ++j)
+         hists.back()->Fill(rndm.Rndm(), rndm.Rndm(), 1.2 * rndm.Rndm() - 0.1, 0.5 + rndm.Rndm());
+      if (i > 0)
+         list.Add(hists.back().get());
+   }
+
+   std::unique_ptr<TH3D> sequential(static_cast<TH3D *>(hists[0]->Clone("sequential")));
+   std::unique_ptr<TH3D> parallel(static_cast<TH3D *>(hists[0]->Clone("parallel")));
+   sequential->Merge(&list);
+   ROOT::EnableImplicitMT(4);
+   parallel->Merge(&list);
+   ROOT::DisableImplicitMT();
+   ExpectSameHistograms(*sequential, *parallel);
+}
+#endif
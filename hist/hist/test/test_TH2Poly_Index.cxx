@@ -0,0 +1,90 @@
+// test the spatial index of TH2Poly against the partition search
+
+#include "gtest/gtest.h"
+
+#include "TH2Poly.h"
+#include "TRandom3.h"
+
+#include <vector>
+
+void CompareFindBin(TH2Poly &h, Double_t xmin, Double_t xmax, Double_t ymin, Double_t ymax)
+{
+   TRandom3 r(42);
+   std::vector<Double_t> x(20000), y(20000);
+   for (size_t i = 0; i < x.size(); ++i) {
+      x[i] = r.Uniform(xmin, xmax);
+      y[i] = r.Uniform(ymin, ymax);
+   }
+   std::vector<Int_t> expected(x.size());
+   h.SetUseIndex(kFALSE);
+   for (size_t i = 0; i < x.size(); ++i)
+      expected[i] = h.FindBin(x[i], y[i]);
+   h.SetUseIndex(kTRUE);
+   for (size_t i = 0; i < x.size(); ++i)
+      EXPECT_EQ(expected[i], h.FindBin(x[i], y[i])) << "x = " << x[i] << ", y = " << y[i];
+}
+
+TEST(TH2Poly, IndexHoneycomb)
+{
+   TH2Poly h("h", "honeycomb", 0, 10, 0, 10);
+   h.Honeycomb(0, 0, 0.1, 50, 60);
+   CompareFindBin(h, -1, 11, -1, 11);
+}
+
+TEST(TH2Poly, IndexOverlappingBins)
+{
+   // Overlapping bins: the first bin containing a point must be returned
+   TH2Poly h("h", "rectangles", 0, 10, 0, 10);
+   TRandom3 r(1);
+   for (int i = 0; i < 300; ++i) {
+      Double_t x1 = r.Uniform(0, 9), y1 = r.Uniform(0, 9);
+      Double_t x[] = {x1, x1 + r.Uniform(0.1, 2), x1 + r.Uniform(0.1, 2), x1};
+      Double_t y[] = {y1, y1, y1 + r.Uniform(0.1, 2), y1 + r.Uniform(0.1, 2)};
+      h.AddBin(4, x, y);
+   }
+   CompareFindBin(h, 0, 10, 0, 10);
+
+   // Bins added after the index was built
+   Double_t x[] = {0, 10, 10, 0};
+   Double_t y[] = {0, 0, 10, 10};
+   h.AddBin(4, x, y);
+   CompareFindBin(h, 0, 10, 0, 10);
+}
+
+TEST(TH2Poly, IndexFill)
+{
+   TH2Poly h1("h1", "", 0, 10, 0, 10);
+   h1.Honeycomb(0, 0, 0.2, 25, 30);
+   TH2Poly *h2 = (TH2Poly *)h1.Clone("h2");
+   h2->SetUseIndex();
+
+   TRandom3 r(7);
+   for (int i = 0; i < 10000; ++i) {
+      Double_t x = r.Uniform(-1, 11), y = r.Uniform(-1, 11), w = r.Uniform();
+      EXPECT_EQ(h1.Fill(x, y, w), h2->Fill(x, y, w));
+   }
+   for (int i = -9; i <= h1.GetNumberOfBins(); ++i) {
+      if (i == 0) continue;
+      EXPECT_DOUBLE_EQ(h1.GetBinContent(i), h2->GetBinContent(i));
+   }
+   EXPECT_DOUBLE_EQ(h1.GetEntries(), h2->GetEntries());
+   delete h2;
+}
+
+TEST(TH2Poly, FillNWithoutWeights)
+{
+   TH2Poly h("h", "", 0, 2, 0, 1);
+   Double_t x1[] = {0, 1, 1, 0};
+   Double_t x2[] = {1, 2, 2, 1};
+   Double_t y[] = {0, 0, 1, 1};
+   h.AddBin(4, x1, y);
+   h.AddBin(4, x2, y);
+   h.SetUseIndex();
+
+   Double_t xs[] = {0.5, 1.5, 1.2, 3.};
+   Double_t ys[] = {0.5, 0.5, 0.2, 0.5};
+   h.FillN(4, xs, ys, nullptr);
+   EXPECT_EQ(1, h.GetBinContent(1));
+   EXPECT_EQ(2, h.GetBinContent(2));
+   EXPECT_EQ(3, h.GetEntries());
+}
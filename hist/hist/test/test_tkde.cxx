@@ -496,4 +496,49 @@ TEST(TKDE, tkde_io_mirror)
    for (size_t i = 0; i < t.xtest.size(); ++i) {
       EXPECT_NEAR(t.values1[i], t.values2[i], delta);
    }
-}
\ No newline at end of file
+}
+// Compare the FFT and tree evaluations with the exact one
+void CompareEvaluation(const char *options, TKDE::EEvaluation eval, double relTol)
+{
+   TRandom3 r(4357);
+   const int n = 5000;
+   std::vector<double> data(n);
+   for (int i = 0; i < n; ++i)
+      data[i] = (r.Rndm() < 0.2) ? r.Gaus(10, 1) : r.Gaus(10, 7);
+
+   TKDE exact(n, data.data(), -10, 30, options);
+   TKDE fast(n, data.data(), -10, 30, options);
+   fast.SetEvaluation(eval);
+   for (int i = 0; i <= 40; ++i) {
+      const double x = -10 + i;
+      const double f = exact(x);
+      EXPECT_NEAR(f, fast(x), relTol * f) << "x = " << x;
+   }
+}
+
+TEST(TKDE, tkde_fft)
+{
+   CompareEvaluation("KernelType:Gaussian;Iteration:Fixed;Binning:Unbinned", TKDE::kFFT, 1.E-3);
+   CompareEvaluation("KernelType:Epanechnikov;Iteration:Fixed;Mirror:MirrorAsymBoth;Binning:Unbinned", TKDE::kFFT, 1.E-3);
+   CompareEvaluation("KernelType:Gaussian;Iteration:Fixed;Binning:ForcedBinning", TKDE::kFFT, 1.E-3);
+}
+
+TEST(TKDE, tkde_tree)
+{
+   CompareEvaluation("KernelType:Gaussian;Iteration:Fixed;Binning:Unbinned", TKDE::kTree, 1.E-10);
+   CompareEvaluation("KernelType:Biweight;Iteration:Fixed;Mirror:MirrorBoth;Binning:Unbinned", TKDE::kTree, 1.E-10);
+   // the adaptive bandwidths come from a pilot estimate computed with the FFT
+   CompareEvaluation("KernelType:Gaussian;Iteration:Adaptive;Binning:Unbinned", TKDE::kTree, 1.E-3);
+   CompareEvaluation("KernelType:Gaussian;Iteration:Adaptive;Binning:Unbinned", TKDE::kFFT, 1.E-3);
+}
+
+TEST(TKDE, tkde_evaluation_option)
+{
+   TRandom3 r(4357);
+   std::vector<double> data(1000);
+   for (auto &x : data)
+      x = r.Gaus(0, 1);
+   TKDE exact(data.size(), data.data(), -5, 5, "Iteration:Fixed;Binning:Unbinned");
+   TKDE fast(data.size(), data.data(), -5, 5, "Iteration:Fixed;Binning:Unbinned;Evaluation:Tree");
+   EXPECT_NEAR(exact(0.5), fast(0.5), 1.E-10);
+}
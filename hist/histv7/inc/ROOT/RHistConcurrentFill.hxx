@@ -106,6 +106,63 @@ public:
    }
 };
 
+/**
+ \class RHistAtomicFill
+ Fills a histogram concurrently from several threads, without buffers or locks.
+
+ The HIST template can be a RHist instance. The bin index is computed by the
+ calling thread, and the statistics of the bin (content, sum of squared
+ weights, ...) are then updated with atomic operations directly in the
+ histogram. A single RHistAtomicFill can be shared by all threads.
+
+ Compared to RHistConcurrentFillManager, no memory is needed per thread and
+ the histogram is always up to date, but concurrent fills of the same bin
+ contend on its cache line. The buffered manager is preferable when few bins
+ receive most of the entries; the atomic fill scales better with many
+ threads spread over many bins.
+
+ Axes cannot grow while filling atomically, and the statistics must provide
+ `AtomicFill()` (all the statistics except RHistStatRuntime do). The histogram
+ must not be read or modified otherwise during the concurrent filling.
+ **/
+
+template <class HIST>
+class RHistAtomicFill {
+public:
+   using Hist_t = HIST;
+   using CoordArray_t = typename HIST::CoordArray_t;
+   using Weight_t = typename HIST::Weight_t;
+
+private:
+   HIST &fHist;
+
+public:
+   RHistAtomicFill(HIST &hist): fHist(hist) {}
+
+   /// Thread-safe HIST::Fill().
+   void Fill(const CoordArray_t &x, Weight_t weight = 1.) const
+   {
+      auto impl = fHist.GetImpl();
+      impl->GetStat().AtomicFill(x, impl->GetBinIndex(x), weight);
+   }
+
+   /// Thread-safe HIST::FillN().
+   void FillN(const std::span<const CoordArray_t> xN, const std::span<const Weight_t> weightN) const
+   {
+      for (size_t i = 0; i < xN.size(); ++i)
+         Fill(xN[i], weightN[i]);
+   }
+
+   /// Thread-safe HIST::FillN().
+   void FillN(const std::span<const CoordArray_t> xN) const
+   {
+      for (auto &&x : xN)
+         Fill(x);
+   }
+
+   static constexpr int GetNDim() { return HIST::GetNDim(); }
+};
+
 } // namespace Experimental
 } // namespace ROOT
 
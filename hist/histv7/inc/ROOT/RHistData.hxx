@@ -116,6 +116,14 @@ public:
       ++fEntries;
    }
 
+   /// Add weight to the bin content at `binidx`, atomically: can be called
+   /// concurrently from several threads.
+   void AtomicFill(const CoordArray_t & /*x*/, int binidx, Weight_t weight = 1.)
+   {
+      Internal::AtomicAdd(GetBinArray(binidx), weight);
+      Internal::AtomicAdd(fEntries, int64_t(1));
+   }
+
    /// Get the number of entries filled into the histogram - i.e. the number of
    /// calls to Fill().
    int64_t GetEntries() const { return fEntries; }
@@ -198,6 +206,9 @@ public:
    /// Add weight to the bin content at binidx.
    void Fill(const CoordArray_t & /*x*/, int, Weight_t weight = 1.) { fSumWeights += weight; }
 
+   /// Add weight to the bin content at binidx, atomically.
+   void AtomicFill(const CoordArray_t & /*x*/, int, Weight_t weight = 1.) { Internal::AtomicAdd(fSumWeights, weight); }
+
    /// Get the sum of weights.
    Weight_t GetSumOfWeights() const { return fSumWeights; }
 
@@ -242,6 +253,12 @@ public:
    /// Add weight to the bin content at binidx.
    void Fill(const CoordArray_t & /*x*/, int /*binidx*/, Weight_t weight = 1.) { fSumWeights2 += weight * weight; }
 
+   /// Add weight to the bin content at binidx, atomically.
+   void AtomicFill(const CoordArray_t & /*x*/, int /*binidx*/, Weight_t weight = 1.)
+   {
+      Internal::AtomicAdd(fSumWeights2, weight * weight);
+   }
+
    /// Get the sum of weights.
    Weight_t GetSumOfSquaredWeights() const { return fSumWeights2; }
 
@@ -339,6 +356,12 @@ public:
       GetBinArray(binidx) += weight * weight;
    }
 
+   /// Add weight to the bin at `binidx`, atomically.
+   void AtomicFill(const CoordArray_t & /*x*/, int binidx, Weight_t weight = 1.)
+   {
+      Internal::AtomicAdd(GetBinArray(binidx), weight * weight);
+   }
+
    /// Calculate a bin's (Poisson) uncertainty of the bin content as the
    /// square-root of the bin's sum of squared weights.
    double GetBinUncertaintyImpl(int binidx) const { return std::sqrt(GetBinArray(binidx)); }
@@ -415,6 +438,17 @@ public:
       }
    }
 
+   /// Add weight to the bin at binidx, atomically; the coordinate was x.
+   void AtomicFill(const CoordArray_t &x, int /*binidx*/, Weight_t weight = 1.)
+   {
+      for (int idim = 0; idim < DIMENSIONS; ++idim) {
+         const PRECISION xw = x[idim] * weight;
+         const PRECISION x2w = x[idim] * xw;
+         Internal::AtomicAdd(fMomentXW[idim], xw);
+         Internal::AtomicAdd(fMomentX2W[idim], x2w);
+      }
+   }
+
    // FIXME: Add a way to query the inner data
 
    /// Merge with other RHistDataMomentUncert data, assuming same bin configuration.
@@ -563,6 +597,15 @@ public:
       (void)trigger_base_fill{(STAT<DIMENSIONS, PRECISION>::Fill(x, binidx, weight), 0)...};
    }
 
+   /// Fill weight at x to the bin content at binidx, atomically: can be called
+   /// concurrently from several threads, as long as no other function modifies
+   /// the statistics at the same time. Uses the same tricks as `Fill()`.
+   void AtomicFill(const CoordArray_t &x, int binidx, Weight_t weight = 1.)
+   {
+      using trigger_base_fill = int[];
+      (void)trigger_base_fill{(STAT<DIMENSIONS, PRECISION>::AtomicFill(x, binidx, weight), 0)...};
+   }
+
    /// Integrate other statistical data into the current data.
    ///
    /// The implementation assumes that the other statistics were recorded with
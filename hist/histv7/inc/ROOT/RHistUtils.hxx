@@ -16,6 +16,7 @@
 #define ROOT7_RHistUtils
 
 #include <array>
+#include <atomic>
 #include <type_traits>
 
 namespace ROOT {
@@ -59,6 +60,56 @@ using CoordArray_t = RCoordArray<DIMENSIONS>;
 
 
 } // namespace Hist
+
+namespace Internal {
+
+/// Atomically add `value` to `target`, which is a plain (non-atomic) arithmetic
+/// object, e.g. a bin content. All concurrent accesses to `target` must go
+/// through `AtomicAdd()`. Floating point types are updated by a compare-and-swap
+/// loop, integral types by a fetch-and-add. The type of `value` is not deduced:
+/// it is converted to the type of `target`.
+template <class T>
+void AtomicAdd(T &target, typename std::common_type<T>::type value)
+{
+   static_assert(std::is_arithmetic<T>::value, "AtomicAdd requires an arithmetic type");
+#if defined(__cpp_lib_atomic_ref)
+   std::atomic_ref<T> ref(target);
+   if constexpr (std::is_integral<T>::value) {
+      ref.fetch_add(value, std::memory_order_relaxed);
+   } else {
+      T expected = ref.load(std::memory_order_relaxed);
+      while (!ref.compare_exchange_weak(expected, expected + value, std::memory_order_relaxed)) {
+      }
+   }
+#elif defined(__GNUC__) || defined(__clang__)
+   if constexpr (std::is_integral<T>::value) {
+      __atomic_fetch_add(&target, value, __ATOMIC_RELAXED);
+   } else {
+      T expected;
+      __atomic_load(&target, &expected, __ATOMIC_RELAXED);
+      T desired = expected + value;
+      while (!__atomic_compare_exchange(&target, &expected, &desired, /*weak=*/true, __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED)) {
+         desired = expected + value;
+      }
+   }
+#else
+   // Relies on std::atomic<T> having the same representation as T, which holds
+   // for the lock-free arithmetic types on all supported platforms.
+   static_assert(sizeof(std::atomic<T>) == sizeof(T) && alignof(std::atomic<T>) == alignof(T),
+                 "std::atomic<T> does not have the layout of T");
+   auto &ref = reinterpret_cast<std::atomic<T> &>(target);
+   if constexpr (std::is_integral<T>::value) {
+      ref.fetch_add(value, std::memory_order_relaxed);
+   } else {
+      T expected = ref.load(std::memory_order_relaxed);
+      while (!ref.compare_exchange_weak(expected, expected + value, std::memory_order_relaxed)) {
+      }
+   }
+#endif
+}
+
+} // namespace Internal
 } // namespace Experimental
 } // namespace ROOT
 
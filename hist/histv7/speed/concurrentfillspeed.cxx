@@ -0,0 +1,105 @@
+/// \file concurrentfillspeed.cxx
+///
+/// Compares the concurrent filling of one RH2D with the buffered
+/// RHistConcurrentFillManager and with the lock-free RHistAtomicFill, for
+/// several numbers of threads. Build and run with e.g.
+///
+///     g++ -o concurrentfillspeed concurrentfillspeed.cxx `root-config --cflags --libs` -O3
+///     ./concurrentfillspeed 1e8 8 32 128
+///
+/// The first argument is the total number of entries, the following ones the
+/// numbers of threads (default: 8, 32 and 128). Two binnings are used: a fine
+/// one, where the threads rarely fill the same bin at the same time, and a
+/// coarse one, where they often do.
+///
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+#include "ROOT/RHist.hxx"
+#include "ROOT/RHistConcurrentFill.hxx"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace ROOT::Experimental;
+
+using Coords_t = std::vector<RH2D::CoordArray_t>;
+
+/// Uniform random coordinates in [0, 1) x [0, 1).
+Coords_t GenerateInput(size_t n, unsigned int seed)
+{
+   std::mt19937_64 gen(seed);
+   std::uniform_real_distribution<double> dist(0., 1.);
+   Coords_t coords(n);
+   for (auto &x : coords)
+      x = {dist(gen), dist(gen)};
+   return coords;
+}
+
+/// Fill `hist` from `nThreads` threads, each filling its slice of `coords`
+/// with a filler obtained from `makeFiller(threadIndex)`; return the time in seconds.
+template <class MAKEFILLER>
+double TimeFill(const Coords_t &coords, int nThreads, MAKEFILLER makeFiller)
+{
+   auto start = std::chrono::high_resolution_clock::now();
+   std::vector<std::thread> threads;
+   const size_t slice = coords.size() / nThreads;
+   for (int t = 0; t < nThreads; ++t) {
+      threads.emplace_back([&, t] {
+         auto filler = makeFiller();
+         const size_t end = (t == nThreads - 1) ? coords.size() : (t + 1) * slice;
+         for (size_t i = t * slice; i < end; ++i)
+            filler.Fill(coords[i]);
+      });
+   }
+   for (auto &thr : threads)
+      thr.join();
+   std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+   return elapsed.count();
+}
+
+void Report(const char *title, int nBins, int nThreads, size_t n, double seconds)
+{
+   std::cout << title << " " << nBins << "x" << nBins << " bins, " << nThreads << " threads: " << seconds
+             << " seconds, \t" << n / 1e6 / seconds << " millions per seconds\n";
+}
+
+void concurrentfillspeed(size_t n, const std::vector<int> &nThreadsList)
+{
+   const Coords_t coords = GenerateInput(n, 42);
+
+   for (int nBins : {1000, 10}) {
+      for (int nThreads : nThreadsList) {
+         {
+            RH2D hist{{nBins, 0., 1.}, {nBins, 0., 1.}};
+            RHistConcurrentFillManager<RH2D> manager(hist);
+            double seconds = TimeFill(coords, nThreads, [&] { return manager.MakeFiller(); });
+            Report("Buffered", nBins, nThreads, n, seconds);
+         }
+         {
+            RH2D hist{{nBins, 0., 1.}, {nBins, 0., 1.}};
+            RHistAtomicFill<RH2D> filler(hist);
+            double seconds = TimeFill(coords, nThreads, [&] { return filler; });
+            Report("Atomic  ", nBins, nThreads, n, seconds);
+         }
+      }
+   }
+}
+
+int main(int argc, char **argv)
+{
+   size_t n = 1e7;
+   std::vector<int> nThreadsList;
+   if (argc > 1)
+      n = atof(argv[1]);
+   for (int i = 2; i < argc; ++i)
+      nThreadsList.push_back(atoi(argv[i]));
+   if (nThreadsList.empty())
+      nThreadsList = {8, 32, 128};
+
+   concurrentfillspeed(n, nThreadsList);
+}
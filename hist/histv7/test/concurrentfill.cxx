@@ -143,3 +143,58 @@ TEST(ConcurrentFillTest, FillFlush)
    EXPECT_EQ(0, (int)Filler_1.GetCoords().size());
    EXPECT_EQ(0, (int)Filler_2.GetCoords().size());
 }
+
+// Functions for testing atomic fill. The weights are multiples of 1/4 below 2, so that the sums of
+// the weights and of their squares are exact in float precision, whatever the order of the fills.
+static float AtomicFillWeight(int i)
+{
+   return (i % 8) * 0.25f;
+}
+
+template <class HIST>
+void atomicFillWithWeights(const Experimental::RHistAtomicFill<HIST> &filler)
+{
+   for (int i = 0; i < 3000; ++i) {
+      filler.Fill({(double)i / 3000, (double)i / 300}, AtomicFillWeight(i));
+   }
+}
+
+// Test consistency of the hist after atomic fill, compared to a sequential fill
+template <class HIST>
+void testAtomicFill()
+{
+   HIST hist{{100, 0., 1.}, {{0., 1., 2., 3., 10.}}};
+   Experimental::RHistAtomicFill<HIST> filler(hist);
+
+   std::array<std::thread, 4> threads;
+   for (auto &thr : threads) {
+      thr = std::thread(atomicFillWithWeights<HIST>, std::cref(filler));
+   }
+   for (auto &thr : threads)
+      thr.join();
+
+   HIST expected{{100, 0., 1.}, {{0., 1., 2., 3., 10.}}};
+   for (size_t t = 0; t < threads.size(); ++t) {
+      for (int i = 0; i < 3000; ++i)
+         expected.Fill({(double)i / 3000, (double)i / 300}, AtomicFillWeight(i));
+   }
+
+   EXPECT_EQ(expected.GetEntries(), hist.GetEntries());
+   for (int i = 0; i < 3000; i += 7) {
+      typename HIST::CoordArray_t x{(double)i / 3000, (double)i / 300};
+      EXPECT_EQ(expected.GetBinContent(x), hist.GetBinContent(x));
+      EXPECT_EQ(expected.GetBinUncertainty(x), hist.GetBinUncertainty(x));
+   }
+}
+
+TEST(ConcurrentFillTest, AtomicFill)
+{
+   testAtomicFill<Experimental::RH2D>();
+}
+
+TEST(ConcurrentFillTest, AtomicFillFloat)
+{
+   testAtomicFill<Experimental::RH2F>();
+   testAtomicFill<Experimental::RHist<2, float, Experimental::RHistStatContent, Experimental::RHistStatUncertainty,
+                                      Experimental::RHistDataMomentUncert>>();
+}
@@ -53,6 +53,7 @@ class TFilePrefetch;
 class TFile : public TDirectoryFile {
   friend class TDirectoryFile;
   friend class TFilePrefetch;
+  friend class TFileCacheWrite;
 // TODO: We need to make sure only one TBasket is being written at a time
 // if we are writing multiple baskets in parallel.
 #ifdef R__USE_IMT
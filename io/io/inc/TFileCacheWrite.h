@@ -15,6 +15,7 @@
 #include "TObject.h"
 
 class TFile;
+class TFileCacheWriteAsync;
 
 class TFileCacheWrite : public TObject {
 
@@ -25,21 +26,27 @@ protected:
    TFile        *fFile;           ///< Pointer to file
    char         *fBuffer;         ///< [fBufferSize] buffer of contiguous prefetched blocks
    Bool_t        fRecursive;      ///< flag to avoid recursive calls
+   TFileCacheWriteAsync *fAsync;  ///<! state of the background writer (nullptr if synchronous)
 
 private:
    TFileCacheWrite(const TFileCacheWrite &) = delete;            //cannot be copied
    TFileCacheWrite& operator=(const TFileCacheWrite &) = delete;
 
+   Bool_t              FlushAsync();
+
 public:
    TFileCacheWrite();
    TFileCacheWrite(TFile *file, Int_t buffersize);
    ~TFileCacheWrite() override;
    virtual Bool_t      Flush();
    virtual Int_t       GetBytesInCache() const { return fNtot; }
+           Bool_t      IsAsync() const { return fAsync != nullptr; }
            void        Print(Option_t *option="") const override;
    virtual Int_t       ReadBuffer(char *buf, Long64_t pos, Int_t len);
    virtual Int_t       WriteBuffer(const char *buf, Long64_t pos, Int_t len);
+   virtual Bool_t      SetAsync(Int_t maxpending = 2);
    virtual void        SetFile(TFile *file);
+           Bool_t      WaitPending();
 
    ClassDefOverride(TFileCacheWrite,1)  //TFile cache when writing
 };
@@ -981,6 +981,8 @@ void TFile::Close(Option_t *option)
    fMustFlush = kTRUE;
 
    FlushWriteCache();
+   // No asynchronous write may still be in flight when the descriptor is closed
+   if (fCacheWrite) fCacheWrite->WaitPending();
 
    if (gMonitoringWriter)
       gMonitoringWriter->SendFileCloseEvent(this);
@@ -2173,6 +2175,8 @@ Int_t TFile::ReOpen(Option_t *mode)
          }
 
          FlushWriteCache();
+         // No asynchronous write may still be in flight when the descriptor is closed
+         if (fCacheWrite) fCacheWrite->WaitPending();
 
          // delete free segments from free list
          fFree->Delete();
@@ -2226,6 +2230,10 @@ Int_t TFile::ReOpen(Option_t *mode)
          Warning("ReOpen","file %s probably not closed, cannot read free segments", GetName());
    }
 
+   // The background writer of an asynchronous write cache holds the closed
+   // descriptor: recreate it with the new one
+   if (fCacheWrite) fCacheWrite->SetFile(this);
+
    return 0;
 }
 
@@ -23,12 +23,190 @@ TXNetFile and TWebFile (via TFile::WriteBuffers()).
 
 The write cache is automatically created when writing a remote file
 (created in TFile::Open()).
+
+### Asynchronous writing
+
+For local files, including files on network file systems mounted
+locally, the cache can write behind the filling thread:
+~~~ {.cpp}
+   auto file = TFile::Open("out.root", "RECREATE");
+   auto cache = new TFileCacheWrite(file, 32000000);
+   cache->SetAsync(2);
+~~~
+When the cache buffer is full it is handed over to a background thread,
+which writes it to the file, and the filling thread continues with a
+spare buffer. At most `maxpending` buffers wait for the background
+thread; when this limit is reached the filling thread blocks, so the
+memory used by the cache stays bounded by `(maxpending + 1) * buffersize`.
+All the pending buffers are written when the cache is flushed, in
+particular in TFile::Close(). Since the baskets of a TTree are written
+through TFile::WriteBuffer(), TTree::Fill() does not block on their write
+anymore.
 */
 
 
 #include "TFile.h"
 #include "TFileCacheWrite.h"
 
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef WIN32
+#include <unistd.h>
+#endif
+
+/// \cond
+/// State of the background writer of a TFileCacheWrite.
+/// The buffers are written with positioned writes, so the background
+/// thread never changes the offset of the file descriptor used by TFile.
+class TFileCacheWriteAsync {
+   struct RBlock {
+      char    *fBuffer;    ///< buffer handed over by the cache
+      Long64_t fSeekStart; ///< position of the buffer in the file
+      Int_t    fNtot;      ///< number of bytes to write
+   };
+
+   Int_t                   fFd;              ///< file descriptor to write to
+   Int_t                   fBufferSize;      ///< size of the buffers
+   Int_t                   fMaxPending;      ///< maximum number of buffers waiting to be written
+   std::deque<RBlock>      fPending;         ///< buffers waiting to be written, in order
+   std::vector<char *>     fSpare;           ///< written buffers that can be reused
+   Bool_t                  fWriting{kFALSE}; ///< true while the thread writes a buffer
+   Bool_t                  fStop{kFALSE};    ///< true when the thread must terminate
+   Int_t                   fErrno{0};        ///< errno of the first failed write
+   Long64_t                fErrorPos{0};     ///< position of the first failed write
+   std::mutex              fMutex;
+   std::condition_variable fCvWork;          ///< signalled when a buffer is queued or on stop
+   std::condition_variable fCvDone;          ///< signalled when a buffer has been written
+   std::thread             fThread;
+
+   Int_t WriteBlock(const RBlock &block)
+   {
+#ifndef WIN32
+      const char *buf = block.fBuffer;
+      Long64_t pos = block.fSeekStart;
+      Int_t len = block.fNtot;
+      while (len > 0) {
+         ssize_t siz = ::pwrite(fFd, buf, len, pos);
+         if (siz < 0) {
+            if (errno == EINTR)
+               continue;
+            return errno;
+         }
+         if (siz == 0)
+            return EIO;
+         buf += siz;
+         pos += siz;
+         len -= siz;
+      }
+      return 0;
+#else
+      (void)block;
+      return ENOSYS;
+#endif
+   }
+
+   void Run()
+   {
+      std::unique_lock<std::mutex> lock(fMutex);
+      while (true) {
+         fCvWork.wait(lock, [this] { return fStop || !fPending.empty(); });
+         if (fPending.empty())
+            break;
+         RBlock block = fPending.front();
+         fPending.pop_front();
+         fWriting = kTRUE;
+         lock.unlock();
+         Int_t err = fErrno ? 0 : WriteBlock(block);
+         lock.lock();
+         fWriting = kFALSE;
+         if (err && !fErrno) {
+            fErrno = err;
+            fErrorPos = block.fSeekStart;
+         }
+         fSpare.push_back(block.fBuffer);
+         fCvDone.notify_all();
+      }
+   }
+
+public:
+   TFileCacheWriteAsync(Int_t fd, Int_t buffersize, Int_t maxpending)
+      : fFd(fd), fBufferSize(buffersize), fMaxPending(maxpending)
+   {
+      fThread = std::thread([this] { Run(); });
+   }
+
+   ~TFileCacheWriteAsync()
+   {
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fStop = kTRUE;
+      }
+      fCvWork.notify_one();
+      fThread.join();
+      for (auto buf : fSpare)
+         delete[] buf;
+   }
+
+   Int_t GetMaxPending() const { return fMaxPending; }
+
+   /// Queue `buffer` for writing and return a buffer the cache can fill next.
+   /// Blocks while the maximum number of buffers is pending.
+   char *Enqueue(char *buffer, Long64_t seekStart, Int_t ntot)
+   {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fCvDone.wait(lock, [this] { return (Int_t)fPending.size() + (fWriting ? 1 : 0) < fMaxPending; });
+      fPending.push_back({buffer, seekStart, ntot});
+      char *next = nullptr;
+      if (fSpare.empty()) {
+         next = new char[fBufferSize];
+      } else {
+         next = fSpare.back();
+         fSpare.pop_back();
+      }
+      lock.unlock();
+      fCvWork.notify_one();
+      return next;
+   }
+
+   /// Wait until all the queued buffers are written.
+   /// Returns the errno of the first failed write, 0 if all writes succeeded.
+   Int_t Wait(Long64_t &errorPos)
+   {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fCvDone.wait(lock, [this] { return fPending.empty() && !fWriting; });
+      errorPos = fErrorPos;
+      return fErrno;
+   }
+
+   /// Returns the errno of the first failed write, 0 if all writes succeeded so far.
+   Int_t GetError(Long64_t &errorPos)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      errorPos = fErrorPos;
+      return fErrno;
+   }
+
+   /// Check if [pos, pos+len) overlaps a buffer that is not yet written.
+   Bool_t Overlaps(Long64_t pos, Int_t len)
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (fWriting)
+         return kTRUE;
+      for (const auto &block : fPending) {
+         if (pos < block.fSeekStart + block.fNtot && block.fSeekStart < pos + len)
+            return kTRUE;
+      }
+      return kFALSE;
+   }
+};
+/// \endcond
+
 ClassImp(TFileCacheWrite);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -42,6 +220,7 @@ TFileCacheWrite::TFileCacheWrite() : TObject()
    fFile        = 0;
    fBuffer      = 0;
    fRecursive   = kFALSE;
+   fAsync       = nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -59,6 +238,7 @@ TFileCacheWrite::TFileCacheWrite(TFile *file, Int_t buffersize)
    fNtot        = 0;
    fFile        = file;
    fRecursive   = kFALSE;
+   fAsync       = nullptr;
    fBuffer      = new char[fBufferSize];
    if (file) file->SetCacheWrite(this);
    if (gDebug > 0) Info("TFileCacheWrite","Creating a write cache with buffersize=%d bytes",buffersize);
@@ -69,15 +249,21 @@ TFileCacheWrite::TFileCacheWrite(TFile *file, Int_t buffersize)
 
 TFileCacheWrite::~TFileCacheWrite()
 {
+   delete fAsync;
    delete [] fBuffer;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Flush the current write buffer to the file.
+/// In asynchronous mode, also wait for all the pending buffers to be written.
 /// Returns kTRUE in case of error.
 
 Bool_t TFileCacheWrite::Flush()
 {
+   if (fAsync) {
+      if (FlushAsync()) return kTRUE;
+      return WaitPending();
+   }
    if (!fNtot) return kFALSE;
    fFile->Seek(fSeekStart);
    //printf("Flushing buffer at fSeekStart=%lld, fNtot=%d\n",fSeekStart,fNtot);
@@ -88,6 +274,29 @@ Bool_t TFileCacheWrite::Flush()
    return status;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Flush the current write buffer. In asynchronous mode the buffer is handed
+/// over to the background thread and the function returns without waiting
+/// for the write, unless the maximum number of pending buffers is reached.
+/// Returns kTRUE in case of error, including errors of earlier asynchronous writes.
+
+Bool_t TFileCacheWrite::FlushAsync()
+{
+   if (!fAsync) return Flush();
+
+   Long64_t errorPos = 0;
+   if (fAsync->GetError(errorPos)) return WaitPending();
+   if (!fNtot) return kFALSE;
+
+   fBuffer = fAsync->Enqueue(fBuffer, fSeekStart, fNtot);
+   // The buffer is accounted as written as soon as it leaves the cache,
+   // like TFile::GetBytesWritten() already does for the bytes in the cache.
+   fFile->fBytesWrite += fNtot;
+   TFile::fgBytesWrite += fNtot;
+   fNtot = 0;
+   return kFALSE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Print class internal structure.
 
@@ -96,6 +305,8 @@ void TFileCacheWrite::Print(Option_t *option) const
    TString opt = option;
    printf("Write cache for file %s\n",fFile->GetName());
    printf("Size of write cache: %d bytes to be written at %lld\n",fNtot,fSeekStart);
+   if (fAsync)
+      printf("Asynchronous writing with at most %d pending buffers\n",fAsync->GetMaxPending());
    opt.ToLower();
 }
 
@@ -107,7 +318,11 @@ void TFileCacheWrite::Print(Option_t *option) const
 
 Int_t TFileCacheWrite::ReadBuffer(char *buf, Long64_t pos, Int_t len)
 {
-   if (pos < fSeekStart || pos+len > fSeekStart+fNtot) return -1;
+   if (pos < fSeekStart || pos+len > fSeekStart+fNtot) {
+      // the data must be on the file before the caller reads it from there
+      if (fAsync && fAsync->Overlaps(pos, len)) WaitPending();
+      return -1;
+   }
    memcpy(buf,fBuffer+pos-fSeekStart,len);
    return 0;
 }
@@ -126,12 +341,13 @@ Int_t TFileCacheWrite::WriteBuffer(const char *buf, Long64_t pos, Int_t len)
 
    if (fSeekStart + fNtot != pos) {
       //we must flush the current cache
-      if (Flush()) return -1; //failure
+      if (FlushAsync()) return -1; //failure
    }
    if (fNtot + len >= fBufferSize) {
-      if (Flush()) return -1; //failure
+      if (FlushAsync()) return -1; //failure
       if (len >= fBufferSize) {
          //buffer larger than the cache itself: direct write to file
+         if (WaitPending()) return -1; //failure
          fRecursive = kTRUE;
          fFile->Seek(pos); // Flush may have changed this
          if (fFile->WriteBuffer(buf,len)) return -1;  // failure
@@ -146,11 +362,73 @@ Int_t TFileCacheWrite::WriteBuffer(const char *buf, Long64_t pos, Int_t len)
    return 1;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable asynchronous writing with at most maxpending buffers waiting for
+/// the background thread, or disable it if maxpending <= 0.
+/// Asynchronous writing is only supported for local files handled by TFile
+/// itself. Returns kTRUE if asynchronous writing is enabled on return.
+
+Bool_t TFileCacheWrite::SetAsync(Int_t maxpending)
+{
+   if (maxpending <= 0) {
+      if (fAsync) {
+         WaitPending();
+         delete fAsync;
+         fAsync = nullptr;
+      }
+      return kFALSE;
+   }
+#ifdef WIN32
+   Warning("SetAsync", "asynchronous writing is not supported on this platform");
+   return kFALSE;
+#else
+   if (!fFile || fFile->IsA() != TFile::Class() || fFile->GetFd() < 0) {
+      Warning("SetAsync", "asynchronous writing is only supported for local files");
+      return kFALSE;
+   }
+   if (fAsync) {
+      if (fAsync->GetMaxPending() == maxpending) return kTRUE;
+      WaitPending();
+      delete fAsync;
+   }
+   fAsync = new TFileCacheWriteAsync(fFile->GetFd(), fBufferSize, maxpending);
+   if (gDebug > 0) Info("SetAsync","Asynchronous writing with at most %d pending buffers",maxpending);
+   return kTRUE;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the file using this cache.
-/// Any write not yet flushed will be lost.
+/// Any write not yet flushed will be lost, except the buffers already
+/// handed over to the background thread, which are written to the old file.
 
 void TFileCacheWrite::SetFile(TFile *file)
 {
+   if (fAsync) {
+      Int_t maxpending = fAsync->GetMaxPending();
+      SetAsync(0);
+      fFile = file;
+      if (file) SetAsync(maxpending);
+      return;
+   }
    fFile = file;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wait until all the buffers handed over to the background thread are
+/// written to the file. Does nothing if asynchronous writing is not enabled.
+/// Returns kTRUE if any of the asynchronous writes failed.
+
+Bool_t TFileCacheWrite::WaitPending()
+{
+   if (!fAsync) return kFALSE;
+   Long64_t errorPos = 0;
+   Int_t err = fAsync->Wait(errorPos);
+   if (!err) return kFALSE;
+   if (!fFile->TestBit(TFile::kWriteError)) {
+      fFile->SetBit(TFile::kWriteError);
+      Error("WaitPending", "error writing to file %s at position %lld: %s",
+            fFile->GetName(), errorPos, strerror(err));
+   }
+   return kTRUE;
+}
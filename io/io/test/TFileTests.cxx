@@ -4,6 +4,7 @@
 #include "gtest/gtest.h"
 
 #include "TFile.h"
+#include "TFileCacheWrite.h"
 #include "TKey.h"
 #include "TNamed.h"
 #include "TPluginManager.h"
@@ -89,6 +90,74 @@ TEST(TFile, ReadFromSameFile)
    EXPECT_TRUE(o1 != o2) << "Same objects read from two different files have the same pointer!";
 }
 
+TEST(TFile, AsyncWriteCache)
+{
+   const auto filename = "TFileTestAsyncWriteCache.root";
+   const int nobjects = 200;
+   {
+      TFile f(filename, "RECREATE");
+      // small cache so that many buffers go through the background writer
+      auto cache = new TFileCacheWrite(&f, 20000);
+      ASSERT_TRUE(cache->SetAsync(2));
+      EXPECT_TRUE(cache->IsAsync());
+      for (int i = 0; i < nobjects; ++i) {
+         TNamed named(TString::Format("obj%d", i), TString('x', 1000 + 37 * i));
+         f.WriteObject(&named, named.GetName());
+      }
+      f.Close();
+      EXPECT_FALSE(f.TestBit(TFile::kWriteError));
+   }
+
+   TFile input(filename);
+   ASSERT_FALSE(input.IsZombie());
+   for (int i = 0; i < nobjects; ++i) {
+      auto named = input.Get<TNamed>(TString::Format("obj%d", i));
+      ASSERT_TRUE(named != nullptr);
+      EXPECT_EQ(named->GetTitle(), TString('x', 1000 + 37 * i));
+   }
+   input.Close();
+   gSystem->Unlink(filename);
+}
+
+// The asynchronous writer follows the new descriptor after TFile::ReOpen
+TEST(TFile, AsyncWriteCacheReOpen)
+{
+   const auto filename = "TFileTestAsyncWriteCacheReOpen.root";
+   const int nobjects = 100;
+   {
+      TFile f(filename, "RECREATE");
+      auto cache = new TFileCacheWrite(&f, 20000);
+      ASSERT_TRUE(cache->SetAsync(2));
+      for (int i = 0; i < nobjects; ++i) {
+         TNamed named(TString::Format("obj%d", i), TString('x', 1000 + 37 * i));
+         f.WriteObject(&named, named.GetName());
+      }
+      ASSERT_EQ(f.ReOpen("READ"), 0);
+      // descriptors opened meanwhile must not be written to by the background thread
+      TFile other("TFileTestAsyncWriteCacheReOpenOther.root", "RECREATE");
+      ASSERT_EQ(f.ReOpen("UPDATE"), 0);
+      EXPECT_TRUE(cache->IsAsync());
+      for (int i = nobjects; i < 2 * nobjects; ++i) {
+         TNamed named(TString::Format("obj%d", i), TString('x', 1000 + 37 * i));
+         f.WriteObject(&named, named.GetName());
+      }
+      f.Close();
+      EXPECT_FALSE(f.TestBit(TFile::kWriteError));
+      other.Close();
+      gSystem->Unlink(other.GetName());
+   }
+
+   TFile input(filename);
+   ASSERT_FALSE(input.IsZombie());
+   for (int i = 0; i < 2 * nobjects; ++i) {
+      auto named = input.Get<TNamed>(TString::Format("obj%d", i));
+      ASSERT_TRUE(named != nullptr);
+      EXPECT_EQ(named->GetTitle(), TString('x', 1000 + 37 * i));
+   }
+   input.Close();
+   gSystem->Unlink(filename);
+}
+
 TEST(TFile, ReadWithoutGlobalRegistrationLocal)
 {
    const auto localFile = "TFileTestReadWithoutGlobalRegistrationLocal.root";
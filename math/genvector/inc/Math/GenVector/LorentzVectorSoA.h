@@ -0,0 +1,524 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2024 , LCG ROOT MathLib Team                         *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Header file for the collections of LorentzVectors stored as structures of arrays
+// and the batch kinematics functions on them
+
+#ifndef ROOT_Math_GenVector_LorentzVectorSoA
+#define ROOT_Math_GenVector_LorentzVectorSoA  1
+
+#include "Math/GenVector/LorentzVector.h"
+#include "Math/GenVector/PtEtaPhiM4D.h"
+#include "Math/GenVector/PxPyPzE4D.h"
+#include "Math/GenVector/Boost.h"
+#include "Math/GenVector/LorentzRotation.h"
+#include "Math/GenVector/Rotation3D.h"
+#include "Math/GenVector/GenVector_exception.h"
+#include "Math/GenVector/eta.h"
+#include "Math/GenVector/etaMax.h"
+
+#include "ROOT/RSpan.hxx"
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace ROOT {
+
+namespace Math {
+
+//__________________________________________________________________________________________
+/**
+    Non-owning view on a collection of Lorentz vectors stored as a structure of arrays
+    in the (Pt, Eta, Phi, M) coordinate system, as the branches of the particles of an event.
+    The view can be built from any contiguous containers (e.g. std::vector or ROOT::RVec) or
+    from pointers and a size, the containers must outlive the view.
+    As for PtEtaPhiM4D, the Phi values are expected to be in the interval (-PI, PI].
+
+    @ingroup GenVector
+
+    @sa Overview of the @ref GenVector "physics vector library"
+*/
+
+template <class ScalarType = double>
+class PtEtaPhiMSoA {
+
+public:
+   typedef ScalarType Scalar;
+   typedef LorentzVector<PtEtaPhiM4D<Scalar>> Vector;
+
+   /**
+      Default constructor: empty collection
+   */
+   PtEtaPhiMSoA() {}
+
+   /**
+      Construct from the pointers to the n values of each coordinate
+   */
+   PtEtaPhiMSoA(std::size_t n, const Scalar *pt, const Scalar *eta, const Scalar *phi, const Scalar *m)
+      : fPt(pt, n), fEta(eta, n), fPhi(phi, n), fM(m, n)
+   {
+   }
+
+   /**
+      Construct from contiguous containers of the coordinates, which must have the same size
+   */
+   template <class Container>
+   PtEtaPhiMSoA(const Container &pt, const Container &eta, const Container &phi, const Container &m)
+      : fPt(pt.data(), pt.size()), fEta(eta.data(), eta.size()), fPhi(phi.data(), phi.size()), fM(m.data(), m.size())
+   {
+      if (eta.size() != pt.size() || phi.size() != pt.size() || m.size() != pt.size()) {
+         GenVector_exception e("PtEtaPhiMSoA: the coordinate arrays have different sizes");
+         throw e;
+      }
+   }
+
+   std::size_t size() const { return fPt.size(); }
+   bool empty() const { return fPt.empty(); }
+
+   std::span<const Scalar> Pt() const { return fPt; }
+   std::span<const Scalar> Eta() const { return fEta; }
+   std::span<const Scalar> Phi() const { return fPhi; }
+   std::span<const Scalar> M() const { return fM; }
+
+   /**
+      Lorentz vector of index i of the collection
+   */
+   Vector operator[](std::size_t i) const { return Vector(fPt[i], fEta[i], fPhi[i], fM[i]); }
+
+private:
+   std::span<const Scalar> fPt;
+   std::span<const Scalar> fEta;
+   std::span<const Scalar> fPhi;
+   std::span<const Scalar> fM;
+};
+
+//__________________________________________________________________________________________
+/**
+    Collection of Lorentz vectors stored as a structure of arrays in the (Px, Py, Pz, E)
+    coordinate system. It owns its arrays, and is the representation in which the Lorentz
+    transformations and the sums of vectors are computed for the whole collection in one go,
+    in loops on contiguous arrays that the compiler can vectorize.
+    The coordinates of each vector are identical (up to rounding) to those of the corresponding
+    LorentzVector< PxPyPzE4D<Scalar> > transformed one at a time.
+
+    @ingroup GenVector
+
+    @sa Overview of the @ref GenVector "physics vector library"
+*/
+
+template <class ScalarType = double>
+class PxPyPzESoA {
+
+public:
+   typedef ScalarType Scalar;
+   typedef LorentzVector<PxPyPzE4D<Scalar>> Vector;
+
+   /**
+      Construct a collection of n null vectors
+   */
+   explicit PxPyPzESoA(std::size_t n = 0) : fPx(n), fPy(n), fPz(n), fE(n) {}
+
+   /**
+      Construct converting a collection in the (Pt, Eta, Phi, M) coordinate system
+   */
+   explicit PxPyPzESoA(const PtEtaPhiMSoA<Scalar> &v) { SetCoordinates(v); }
+
+   /**
+      Construct from contiguous containers of the coordinates, which must have the same size
+   */
+   template <class Container>
+   PxPyPzESoA(const Container &px, const Container &py, const Container &pz, const Container &e)
+      : fPx(px.begin(), px.end()), fPy(py.begin(), py.end()), fPz(pz.begin(), pz.end()), fE(e.begin(), e.end())
+   {
+      if (py.size() != px.size() || pz.size() != px.size() || e.size() != px.size()) {
+         GenVector_exception ex("PxPyPzESoA: the coordinate arrays have different sizes");
+         throw ex;
+      }
+   }
+
+   std::size_t size() const { return fPx.size(); }
+   bool empty() const { return fPx.empty(); }
+   void resize(std::size_t n)
+   {
+      fPx.resize(n);
+      fPy.resize(n);
+      fPz.resize(n);
+      fE.resize(n);
+   }
+
+   std::span<const Scalar> Px() const { return std::span<const Scalar>(fPx.data(), fPx.size()); }
+   std::span<const Scalar> Py() const { return std::span<const Scalar>(fPy.data(), fPy.size()); }
+   std::span<const Scalar> Pz() const { return std::span<const Scalar>(fPz.data(), fPz.size()); }
+   std::span<const Scalar> E() const { return std::span<const Scalar>(fE.data(), fE.size()); }
+   std::span<Scalar> Px() { return std::span<Scalar>(fPx.data(), fPx.size()); }
+   std::span<Scalar> Py() { return std::span<Scalar>(fPy.data(), fPy.size()); }
+   std::span<Scalar> Pz() { return std::span<Scalar>(fPz.data(), fPz.size()); }
+   std::span<Scalar> E() { return std::span<Scalar>(fE.data(), fE.size()); }
+
+   /**
+      Lorentz vector of index i of the collection
+   */
+   Vector operator[](std::size_t i) const { return Vector(fPx[i], fPy[i], fPz[i], fE[i]); }
+
+   /**
+      Set vector of index i of the collection
+   */
+   void Set(std::size_t i, const Vector &v)
+   {
+      fPx[i] = v.Px();
+      fPy[i] = v.Py();
+      fPz[i] = v.Pz();
+      fE[i] = v.E();
+   }
+
+   /**
+      Set the collection converting one in the (Pt, Eta, Phi, M) coordinate system,
+      as the conversion of PtEtaPhiM4D to PxPyPzE4D
+   */
+   void SetCoordinates(const PtEtaPhiMSoA<Scalar> &v)
+   {
+      const std::size_t n = v.size();
+      resize(n);
+      const Scalar *pt = v.Pt().data();
+      const Scalar *eta = v.Eta().data();
+      const Scalar *phi = v.Phi().data();
+      const Scalar *m = v.M().data();
+      Scalar *px = fPx.data();
+      Scalar *py = fPy.data();
+      Scalar *pz = fPz.data();
+      Scalar *e = fE.data();
+      const Scalar etamax = etaMax<Scalar>();
+      for (std::size_t i = 0; i < n; ++i) {
+         using std::cos;
+         using std::sin;
+         using std::sinh;
+         using std::cosh;
+         using std::sqrt;
+         px[i] = pt[i] * cos(phi[i]);
+         py[i] = pt[i] * sin(phi[i]);
+         // vectors with null Pt store their Pz in Eta, see PtEtaPhiM4D
+         const Scalar etaz = eta[i] == 0 ? 0 : eta[i] > 0 ? eta[i] - etamax : eta[i] + etamax;
+         const Scalar etap = eta[i] > etamax ? eta[i] - etamax : eta[i] < -etamax ? -eta[i] - etamax : 0;
+         pz[i] = pt[i] > 0 ? pt[i] * sinh(eta[i]) : etaz;
+         const Scalar p = pt[i] > 0 ? pt[i] * cosh(eta[i]) : etap;
+         const Scalar e2 = p * p + (m[i] >= 0 ? m[i] * m[i] : -m[i] * m[i]);
+         e[i] = sqrt(e2 > 0 ? e2 : 0);
+      }
+   }
+
+   /**
+      Fill contiguous resizable containers (e.g. std::vector or ROOT::RVec) with the coordinates
+      of the collection in the (Pt, Eta, Phi, M) coordinate system.
+      The mass of a vector with P^2 > E^2 is negative, as in PtEtaPhiM4D.
+   */
+   template <class Container>
+   void GetPtEtaPhiM(Container &pt, Container &eta, Container &phi, Container &m) const
+   {
+      const std::size_t n = size();
+      pt.resize(n);
+      eta.resize(n);
+      phi.resize(n);
+      m.resize(n);
+      for (std::size_t i = 0; i < n; ++i) {
+         using std::sqrt;
+         const Scalar pt2 = fPx[i] * fPx[i] + fPy[i] * fPy[i];
+         const Scalar m2 = fE[i] * fE[i] - pt2 - fPz[i] * fPz[i];
+         pt[i] = sqrt(pt2);
+         m[i] = m2 >= 0 ? sqrt(m2) : -sqrt(-m2);
+      }
+      for (std::size_t i = 0; i < n; ++i) {
+         using std::atan2;
+         phi[i] = (fPx[i] == 0 && fPy[i] == 0) ? 0 : atan2(fPy[i], fPx[i]);
+         eta[i] = Impl::Eta_FromRhoZ(Scalar(pt[i]), fPz[i]);
+      }
+   }
+
+   /**
+      Apply a Lorentz transformation, given by its 4x4 matrix in the (x, y, z, t) row-major order
+      of LorentzRotation::GetComponents, to all the vectors of the collection
+   */
+   void Transform(const double *r)
+   {
+      const std::size_t n = size();
+      Scalar *px = fPx.data();
+      Scalar *py = fPy.data();
+      Scalar *pz = fPz.data();
+      Scalar *e = fE.data();
+      for (std::size_t i = 0; i < n; ++i) {
+         const Scalar x = px[i];
+         const Scalar y = py[i];
+         const Scalar z = pz[i];
+         const Scalar t = e[i];
+         px[i] = r[0] * x + r[1] * y + r[2] * z + r[3] * t;
+         py[i] = r[4] * x + r[5] * y + r[6] * z + r[7] * t;
+         pz[i] = r[8] * x + r[9] * y + r[10] * z + r[11] * t;
+         e[i] = r[12] * x + r[13] * y + r[14] * z + r[15] * t;
+      }
+   }
+
+   /**
+      Apply a boost to all the vectors of the collection
+   */
+   void Apply(const Boost &b)
+   {
+      double r[16];
+      b.GetLorentzRotation(r);
+      Transform(r);
+   }
+
+   /**
+      Apply a Lorentz rotation to all the vectors of the collection
+   */
+   void Apply(const LorentzRotation &lr)
+   {
+      double r[16];
+      lr.GetComponents(r);
+      Transform(r);
+   }
+
+   /**
+      Apply a rotation of the spatial components to all the vectors of the collection
+   */
+   void Apply(const Rotation3D &rot)
+   {
+      double r[9];
+      rot.GetComponents(r);
+      const std::size_t n = size();
+      Scalar *px = fPx.data();
+      Scalar *py = fPy.data();
+      Scalar *pz = fPz.data();
+      for (std::size_t i = 0; i < n; ++i) {
+         const Scalar x = px[i];
+         const Scalar y = py[i];
+         const Scalar z = pz[i];
+         px[i] = r[0] * x + r[1] * y + r[2] * z;
+         py[i] = r[3] * x + r[4] * y + r[5] * z;
+         pz[i] = r[6] * x + r[7] * y + r[8] * z;
+      }
+   }
+
+   /**
+      Sum of all the vectors of the collection
+   */
+   Vector Sum() const
+   {
+      Scalar x = 0, y = 0, z = 0, t = 0;
+      for (std::size_t i = 0; i < size(); ++i) {
+         x += fPx[i];
+         y += fPy[i];
+         z += fPz[i];
+         t += fE[i];
+      }
+      return Vector(x, y, z, t);
+   }
+
+private:
+   std::vector<Scalar> fPx;
+   std::vector<Scalar> fPy;
+   std::vector<Scalar> fPz;
+   std::vector<Scalar> fE;
+};
+
+//__________________________________________________________________________________________
+/**
+    Pairs of vectors built by VectorUtil::MakePairs, stored as a structure of arrays:
+    the indices of the two vectors of each pair in their collections, the invariant mass
+    of the pair and the square of their distance in the (Eta, Phi) plane.
+
+    @ingroup GenVector
+*/
+
+template <class ScalarType = double>
+struct LorentzVectorPairs {
+   typedef ScalarType Scalar;
+
+   std::vector<unsigned int> fFirst;  ///< index of the first vector of the pair
+   std::vector<unsigned int> fSecond; ///< index of the second vector of the pair
+   std::vector<Scalar> fM;            ///< invariant mass of the pair
+   std::vector<Scalar> fDeltaR2;      ///< square of the distance in the (Eta, Phi) plane
+
+   std::size_t size() const { return fFirst.size(); }
+   void clear()
+   {
+      fFirst.clear();
+      fSecond.clear();
+      fM.clear();
+      fDeltaR2.clear();
+   }
+};
+
+namespace VectorUtil {
+
+namespace Detail {
+
+// Square of the distance in the (Eta, Phi) plane of the vector (eta, phi) to the n vectors (etas, phis),
+// with the Phi difference folded in (-PI, PI] as in VectorUtil::DeltaPhi
+template <class Scalar>
+inline void DeltaR2Row(Scalar eta, Scalar phi, std::size_t n, const Scalar *etas, const Scalar *phis, Scalar *out)
+{
+   const Scalar pi = M_PI;
+   for (std::size_t j = 0; j < n; ++j) {
+      Scalar dphi = phis[j] - phi;
+      dphi = dphi > pi ? dphi - 2 * pi : dphi <= -pi ? dphi + 2 * pi : dphi;
+      const Scalar deta = etas[j] - eta;
+      out[j] = dphi * dphi + deta * deta;
+   }
+}
+
+// Invariant mass of the sums of the vector (x, y, z, t) with the n vectors (xs, ys, zs, ts),
+// negative for a space-like sum as LorentzVector::M()
+template <class Scalar>
+inline void InvariantMassRow(Scalar x, Scalar y, Scalar z, Scalar t, std::size_t n, const Scalar *xs,
+                             const Scalar *ys, const Scalar *zs, const Scalar *ts, Scalar *out)
+{
+   for (std::size_t j = 0; j < n; ++j) {
+      using std::sqrt;
+      using std::abs;
+      const Scalar sx = x + xs[j];
+      const Scalar sy = y + ys[j];
+      const Scalar sz = z + zs[j];
+      const Scalar st = t + ts[j];
+      const Scalar m2 = st * st - sx * sx - sy * sy - sz * sz;
+      const Scalar m = sqrt(abs(m2));
+      out[j] = m2 >= 0 ? m : -m;
+   }
+}
+
+template <class Scalar, class Select>
+void MakePairs(const PtEtaPhiMSoA<Scalar> &a, const PxPyPzESoA<Scalar> &a4, const PtEtaPhiMSoA<Scalar> &b,
+               const PxPyPzESoA<Scalar> &b4, bool sameCollection, LorentzVectorPairs<Scalar> &pairs, Select select)
+{
+   pairs.clear();
+   std::vector<Scalar> rowM(b.size());
+   std::vector<Scalar> rowDR2(b.size());
+   for (std::size_t i = 0; i < a.size(); ++i) {
+      // with a single collection only the pairs (i, j > i) are built
+      const std::size_t first = sameCollection ? i + 1 : 0;
+      const std::size_t n = b.size() - first;
+      DeltaR2Row(a.Eta()[i], a.Phi()[i], n, b.Eta().data() + first, b.Phi().data() + first, rowDR2.data());
+      InvariantMassRow(a4.Px()[i], a4.Py()[i], a4.Pz()[i], a4.E()[i], n, b4.Px().data() + first,
+                       b4.Py().data() + first, b4.Pz().data() + first, b4.E().data() + first, rowM.data());
+      for (std::size_t j = 0; j < n; ++j) {
+         if (!select(rowM[j], rowDR2[j]))
+            continue;
+         pairs.fFirst.push_back(i);
+         pairs.fSecond.push_back(first + j);
+         pairs.fM.push_back(rowM[j]);
+         pairs.fDeltaR2.push_back(rowDR2[j]);
+      }
+   }
+}
+
+struct SelectAllPairs {
+   template <class Scalar>
+   bool operator()(Scalar, Scalar) const
+   {
+      return true;
+   }
+};
+
+} // namespace Detail
+
+/**
+   Fill the contiguous resizable container out (e.g. std::vector or ROOT::RVec) with the squares
+   of the distances in the (Eta, Phi) plane between the vectors of the collections a and b,
+   as a matrix in row-major order: out[i * b.size() + j] = DeltaR2(a[i], b[j])
+*/
+template <class Scalar, class Container>
+void DeltaR2Matrix(const PtEtaPhiMSoA<Scalar> &a, const PtEtaPhiMSoA<Scalar> &b, Container &out)
+{
+   const std::size_t nb = b.size();
+   out.resize(a.size() * nb);
+   for (std::size_t i = 0; i < a.size(); ++i)
+      Detail::DeltaR2Row(a.Eta()[i], a.Phi()[i], nb, b.Eta().data(), b.Phi().data(), out.data() + i * nb);
+}
+
+/**
+   Fill the contiguous resizable container out with the distances in the (Eta, Phi) plane between
+   the vectors of the collections a and b, as a matrix in row-major order:
+   out[i * b.size() + j] = DeltaR(a[i], b[j])
+*/
+template <class Scalar, class Container>
+void DeltaRMatrix(const PtEtaPhiMSoA<Scalar> &a, const PtEtaPhiMSoA<Scalar> &b, Container &out)
+{
+   DeltaR2Matrix(a, b, out);
+   for (std::size_t k = 0; k < out.size(); ++k) {
+      using std::sqrt;
+      out[k] = sqrt(out[k]);
+   }
+}
+
+/**
+   Fill the contiguous resizable container out with the invariant masses of the pairs of the vectors
+   of the collections a and b, as a matrix in row-major order:
+   out[i * b.size() + j] = (a[i] + b[j]).M()
+*/
+template <class Scalar, class Container>
+void InvariantMassMatrix(const PxPyPzESoA<Scalar> &a, const PxPyPzESoA<Scalar> &b, Container &out)
+{
+   const std::size_t nb = b.size();
+   out.resize(a.size() * nb);
+   for (std::size_t i = 0; i < a.size(); ++i)
+      Detail::InvariantMassRow(a.Px()[i], a.Py()[i], a.Pz()[i], a.E()[i], nb, b.Px().data(), b.Py().data(),
+                               b.Pz().data(), b.E().data(), out.data() + i * nb);
+}
+
+/**
+   Fill the contiguous resizable container out with the invariant masses of the sums a[i] + b[i]
+   of the vectors of two collections of the same size
+*/
+template <class Scalar, class Container>
+void InvariantMasses(const PxPyPzESoA<Scalar> &a, const PxPyPzESoA<Scalar> &b, Container &out)
+{
+   const std::size_t n = a.size();
+   if (b.size() != n) {
+      GenVector_exception e("VectorUtil::InvariantMasses: the collections have different sizes");
+      throw e;
+   }
+   out.resize(n);
+   for (std::size_t i = 0; i < n; ++i)
+      Detail::InvariantMassRow(a.Px()[i], a.Py()[i], a.Pz()[i], a.E()[i], 1, b.Px().data() + i, b.Py().data() + i,
+                               b.Pz().data() + i, b.E().data() + i, out.data() + i);
+}
+
+/**
+   Build the pairs (a[i], b[j]) of the vectors of two collections (e.g. jets and leptons) for which
+   select(m, deltaR2) is true, where m is the invariant mass of the pair and deltaR2 the square of
+   the distance of the two vectors in the (Eta, Phi) plane. The masses and distances are computed
+   for a row of pairs at a time before the selection, and the pairs are stored in the order of i
+   and then j.
+*/
+template <class Scalar, class Select = Detail::SelectAllPairs>
+void MakePairs(const PtEtaPhiMSoA<Scalar> &a, const PtEtaPhiMSoA<Scalar> &b, LorentzVectorPairs<Scalar> &pairs,
+               Select select = Select())
+{
+   const PxPyPzESoA<Scalar> a4(a);
+   const PxPyPzESoA<Scalar> b4(b);
+   Detail::MakePairs(a, a4, b, b4, false, pairs, select);
+}
+
+/**
+   Build the pairs (v[i], v[j]) with i < j of the vectors of one collection for which select(m, deltaR2)
+   is true, as MakePairs for two collections
+*/
+template <class Scalar, class Select = Detail::SelectAllPairs>
+void MakePairs(const PtEtaPhiMSoA<Scalar> &v, LorentzVectorPairs<Scalar> &pairs, Select select = Select())
+{
+   const PxPyPzESoA<Scalar> v4(v);
+   Detail::MakePairs(v, v4, v, v4, true, pairs, select);
+}
+
+} // namespace VectorUtil
+
+} // namespace Math
+
+} // namespace ROOT
+
+#endif /* ROOT_Math_GenVector_LorentzVectorSoA */
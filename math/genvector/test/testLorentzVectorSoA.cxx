@@ -0,0 +1,259 @@
+// test of the collections of Lorentz vectors stored as structures of arrays (LorentzVectorSoA.h):
+// the conversions, transformations, invariant masses, distances and pairs are compared with the
+// ones computed one vector at a time with LorentzVector, and the time of the pair building is
+// compared with a loop on the vectors
+
+#include "Math/LorentzVectorSoA.h"
+#include "Math/Vector4D.h"
+#include "Math/Vector3D.h"
+#include "Math/Boost.h"
+#include "Math/Rotation3D.h"
+#include "Math/AxisAngle.h"
+#include "Math/LorentzRotation.h"
+#include "Math/VectorUtil.h"
+
+#include "TRandom3.h"
+#include "TStopwatch.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace ROOT::Math;
+
+TRandom3 gRandom3(4357);
+
+bool AlmostEq(double x1, double x2, const char *name, std::size_t i)
+{
+   if (std::abs(x1 - x2) <= 1.E-10 * (1 + std::abs(x2)))
+      return true;
+   std::cout << "Error in " << name << " element " << i << " : " << x1 << " instead of " << x2 << std::endl;
+   return false;
+}
+
+bool AlmostEq(const XYZTVector &v1, const XYZTVector &v2, const char *name, std::size_t i)
+{
+   return AlmostEq(v1.Px(), v2.Px(), name, i) && AlmostEq(v1.Py(), v2.Py(), name, i) &&
+          AlmostEq(v1.Pz(), v2.Pz(), name, i) && AlmostEq(v1.E(), v2.E(), name, i);
+}
+
+struct Particles {
+   std::vector<double> fPt, fEta, fPhi, fM;
+   Particles(std::size_t n, double mass)
+   {
+      for (std::size_t i = 0; i < n; ++i) {
+         fPt.push_back(gRandom3.Exp(30.));
+         fEta.push_back(gRandom3.Uniform(-4, 4));
+         fPhi.push_back(gRandom3.Uniform(-M_PI, M_PI));
+         fM.push_back(mass > 0 ? mass : gRandom3.Uniform(0, 20));
+      }
+   }
+   PtEtaPhiMSoA<double> View() const { return PtEtaPhiMSoA<double>(fPt, fEta, fPhi, fM); }
+};
+
+int testConversions()
+{
+   int iret = 0;
+   Particles p(100, 0);
+   // vectors with null Pt and with negative mass
+   p.fPt[0] = 0;
+   p.fM[1] = -1;
+   const PtEtaPhiMSoA<double> v = p.View();
+   const PxPyPzESoA<double> v4(v);
+   std::vector<double> pt, eta, phi, m;
+   v4.GetPtEtaPhiM(pt, eta, phi, m);
+   for (std::size_t i = 0; i < v.size(); ++i) {
+      const XYZTVector ref(v[i]);
+      if (!AlmostEq(v4[i], ref, "conversion to PxPyPzE", i))
+         iret |= 1;
+      const PtEtaPhiMVector back(ref);
+      if (!AlmostEq(pt[i], back.Pt(), "Pt", i) || !AlmostEq(eta[i], back.Eta(), "Eta", i) ||
+          !AlmostEq(phi[i], back.Phi(), "Phi", i) || !AlmostEq(m[i], back.M(), "M", i))
+         iret |= 1;
+   }
+   return iret;
+}
+
+int testTransformations()
+{
+   int iret = 0;
+   Particles p(100, 0);
+   const PtEtaPhiMSoA<double> v = p.View();
+
+   const Boost b(0.3, -0.4, 0.5);
+   const Rotation3D rot(AxisAngle(XYZVector(1, 2, 3), 0.7));
+   const LorentzRotation lr = LorentzRotation(b) * LorentzRotation(rot);
+
+   PxPyPzESoA<double> vb(v), vr(v), vl(v);
+   vb.Apply(b);
+   vr.Apply(rot);
+   vl.Apply(lr);
+   XYZTVector sum;
+   for (std::size_t i = 0; i < v.size(); ++i) {
+      const XYZTVector ref(v[i]);
+      if (!AlmostEq(vb[i], b(ref), "Boost", i))
+         iret |= 2;
+      if (!AlmostEq(vr[i], rot(ref), "Rotation3D", i))
+         iret |= 2;
+      if (!AlmostEq(vl[i], lr(ref), "LorentzRotation", i))
+         iret |= 2;
+      sum += ref;
+   }
+   if (!AlmostEq(PxPyPzESoA<double>(v).Sum(), sum, "Sum", 0))
+      iret |= 2;
+   return iret;
+}
+
+int testMatrices()
+{
+   int iret = 0;
+   Particles pa(7, 0), pb(5, 0.105);
+   const PtEtaPhiMSoA<double> a = pa.View();
+   const PtEtaPhiMSoA<double> b = pb.View();
+   const PxPyPzESoA<double> a4(a), b4(b);
+
+   std::vector<double> dr, mass, masses;
+   VectorUtil::DeltaRMatrix(a, b, dr);
+   VectorUtil::InvariantMassMatrix(a4, b4, mass);
+   for (std::size_t i = 0; i < a.size(); ++i) {
+      for (std::size_t j = 0; j < b.size(); ++j) {
+         if (!AlmostEq(dr[i * b.size() + j], VectorUtil::DeltaR(a[i], b[j]), "DeltaRMatrix", i * b.size() + j))
+            iret |= 4;
+         if (!AlmostEq(mass[i * b.size() + j], (a[i] + b[j]).M(), "InvariantMassMatrix", i * b.size() + j))
+            iret |= 4;
+      }
+   }
+
+   const PtEtaPhiMSoA<double> a5(5, pa.fPt.data(), pa.fEta.data(), pa.fPhi.data(), pa.fM.data());
+   VectorUtil::InvariantMasses(PxPyPzESoA<double>(a5), b4, masses);
+   for (std::size_t i = 0; i < b.size(); ++i) {
+      if (!AlmostEq(masses[i], VectorUtil::InvariantMass(a[i], b[i]), "InvariantMasses", i))
+         iret |= 4;
+   }
+
+   // collections of different sizes
+   try {
+      VectorUtil::InvariantMasses(a4, b4, masses);
+      std::cout << "Error in InvariantMasses: no exception for collections of different sizes" << std::endl;
+      iret |= 4;
+   } catch (const GenVector_exception &) {
+   }
+   return iret;
+}
+
+// pairs of leptons and jets with a mass in [50, 150] separated by more than 0.4
+struct SelectPair {
+   bool operator()(double m, double dr2) const { return m > 50 && m < 150 && dr2 > 0.16; }
+};
+
+int testPairs()
+{
+   int iret = 0;
+   Particles jets(20, 0), leptons(4, 0.105);
+   const PtEtaPhiMSoA<double> j = jets.View();
+   const PtEtaPhiMSoA<double> l = leptons.View();
+
+   LorentzVectorPairs<double> pairs;
+   VectorUtil::MakePairs(l, j, pairs, SelectPair());
+   std::size_t k = 0;
+   for (std::size_t il = 0; il < l.size(); ++il) {
+      for (std::size_t ij = 0; ij < j.size(); ++ij) {
+         const double m = (l[il] + j[ij]).M();
+         const double dr2 = VectorUtil::DeltaR2(l[il], j[ij]);
+         if (!SelectPair()(m, dr2))
+            continue;
+         if (k >= pairs.size() || pairs.fFirst[k] != il || pairs.fSecond[k] != ij) {
+            std::cout << "Error in MakePairs: missing pair (" << il << "," << ij << ")" << std::endl;
+            return iret | 8;
+         }
+         if (!AlmostEq(pairs.fM[k], m, "MakePairs mass", k) || !AlmostEq(pairs.fDeltaR2[k], dr2, "MakePairs DeltaR2", k))
+            iret |= 8;
+         ++k;
+      }
+   }
+   if (k != pairs.size()) {
+      std::cout << "Error in MakePairs: " << pairs.size() << " pairs instead of " << k << std::endl;
+      iret |= 8;
+   }
+
+   // pairs of jets, i < j
+   VectorUtil::MakePairs(j, pairs);
+   if (pairs.size() != j.size() * (j.size() - 1) / 2) {
+      std::cout << "Error in MakePairs of one collection: " << pairs.size() << " pairs" << std::endl;
+      return iret | 8;
+   }
+   k = 0;
+   for (std::size_t i1 = 0; i1 < j.size(); ++i1) {
+      for (std::size_t i2 = i1 + 1; i2 < j.size(); ++i2, ++k) {
+         if (pairs.fFirst[k] != i1 || pairs.fSecond[k] != i2 ||
+             !AlmostEq(pairs.fM[k], (j[i1] + j[i2]).M(), "MakePairs of one collection", k))
+            iret |= 8;
+      }
+   }
+   return iret;
+}
+
+// time of the building of the pairs of jets in nEvents events with vectors and with the collections
+int testPairsTime()
+{
+   const int nEvents = 2000;
+   std::vector<Particles> events;
+   for (int i = 0; i < nEvents; ++i)
+      events.emplace_back(10 + gRandom3.Integer(30), 0);
+
+   TStopwatch w;
+   std::size_t n1 = 0;
+   double sum1 = 0;
+   w.Start();
+   for (const Particles &ev : events) {
+      std::vector<PtEtaPhiMVector> jets;
+      for (std::size_t i = 0; i < ev.fPt.size(); ++i)
+         jets.emplace_back(ev.fPt[i], ev.fEta[i], ev.fPhi[i], ev.fM[i]);
+      for (std::size_t i1 = 0; i1 < jets.size(); ++i1) {
+         for (std::size_t i2 = i1 + 1; i2 < jets.size(); ++i2) {
+            const double m = (jets[i1] + jets[i2]).M();
+            const double dr2 = VectorUtil::DeltaR2(jets[i1], jets[i2]);
+            if (SelectPair()(m, dr2)) {
+               ++n1;
+               sum1 += m;
+            }
+         }
+      }
+   }
+   w.Stop();
+   std::cout << "Time for the pairs with PtEtaPhiMVector : " << w.RealTime() << "  " << w.CpuTime() << std::endl;
+
+   std::size_t n2 = 0;
+   double sum2 = 0;
+   LorentzVectorPairs<double> pairs;
+   w.Start();
+   for (const Particles &ev : events) {
+      VectorUtil::MakePairs(ev.View(), pairs, SelectPair());
+      n2 += pairs.size();
+      for (std::size_t k = 0; k < pairs.size(); ++k)
+         sum2 += pairs.fM[k];
+   }
+   w.Stop();
+   std::cout << "Time for the pairs with PtEtaPhiMSoA    : " << w.RealTime() << "  " << w.CpuTime() << std::endl;
+
+   if (n1 != n2 || std::abs(sum1 - sum2) > 1.E-8 * std::abs(sum1)) {
+      std::cout << "Error in time test: " << n2 << " pairs instead of " << n1 << std::endl;
+      return 16;
+   }
+   return 0;
+}
+
+int main()
+{
+   int iret = 0;
+   iret |= testConversions();
+   iret |= testTransformations();
+   iret |= testMatrices();
+   iret |= testPairs();
+   iret |= testPairsTime();
+   if (iret != 0)
+      std::cout << "testLorentzVectorSoA: test FAILED !!! " << std::endl;
+   else
+      std::cout << "testLorentzVectorSoA: test OK " << std::endl;
+   return iret;
+}
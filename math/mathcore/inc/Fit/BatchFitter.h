@@ -0,0 +1,180 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2024  LCG ROOT Math Team, CERN/PH-SFT                *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Header file for class BatchFitter
+
+#ifndef ROOT_Fit_BatchFitter
+#define ROOT_Fit_BatchFitter
+
+#include "Fit/BinData.h"
+#include "Fit/FitConfig.h"
+#include "Math/IParamFunction.h"
+#include "ROOT/EExecutionPolicy.hxx"
+
+#include <memory>
+#include <vector>
+
+namespace ROOT {
+
+   namespace Fit {
+
+//___________________________________________________________________________________
+/**
+   Compact results of the fits of a ROOT::Fit::BatchFitter.
+   For each fit it stores the minimizer status, the minimum value of the
+   objective function, the number of degrees of freedom, and the values and
+   errors of the parameters. The parameters of fit `i` are stored contiguously
+   at index `i * NPar()` of the arrays of values and errors.
+
+   @ingroup FitMain
+*/
+class BatchFitResult {
+
+public:
+
+   BatchFitResult() {}
+
+   /// number of fits
+   unsigned int NFits() const { return fStatus.size(); }
+
+   /// number of parameters of each fit
+   unsigned int NPar() const { return fNPar; }
+
+   /// minimizer status of fit i (0 if successful, -1 if the fit could not be done)
+   int Status(unsigned int i) const { return fStatus[i]; }
+
+   /// true if fit i converged
+   bool IsValid(unsigned int i) const { return fStatus[i] == 0; }
+
+   /// minimum value of the objective function (chi2 or log-likelihood) of fit i
+   double MinFcnValue(unsigned int i) const { return fMinFcn[i]; }
+
+   /// estimated distance to minimum of fit i
+   double Edm(unsigned int i) const { return fEdm[i]; }
+
+   /// number of degrees of freedom of fit i
+   unsigned int Ndf(unsigned int i) const { return fNdf[i]; }
+
+   /// values of the parameters of fit i
+   const double * Parameters(unsigned int i) const { return fParams.data() + i * fNPar; }
+
+   /// errors of the parameters of fit i
+   const double * Errors(unsigned int i) const { return fErrors.data() + i * fNPar; }
+
+   /// value of parameter ipar of fit i
+   double Parameter(unsigned int i, unsigned int ipar) const { return fParams[i * fNPar + ipar]; }
+
+   /// error of parameter ipar of fit i
+   double ParError(unsigned int i, unsigned int ipar) const { return fErrors[i * fNPar + ipar]; }
+
+private:
+
+   friend class BatchFitter;
+
+   unsigned int fNPar = 0;             ///< number of parameters of each fit
+   std::vector<int> fStatus;           ///< minimizer status of each fit
+   std::vector<double> fMinFcn;        ///< minimum value of the objective function of each fit
+   std::vector<double> fEdm;           ///< estimated distance to minimum of each fit
+   std::vector<unsigned int> fNdf;     ///< number of degrees of freedom of each fit
+   std::vector<double> fParams;        ///< parameter values, NPar() per fit
+   std::vector<double> fErrors;        ///< parameter errors, NPar() per fit
+};
+
+//___________________________________________________________________________________
+/**
+   Fitter of the same model function to many independent binned data sets.
+
+   In contrast to ROOT::Fit::Fitter, the configuration, the minimizers and the
+   copies of the model function are set up once for the whole batch and reused
+   from one data set to the next. With the ROOT::EExecutionPolicy::kMultiThread
+   policy the data sets are distributed over the threads of a
+   ROOT::TThreadExecutor, each thread using its own minimizer and its own copy
+   (obtained with Clone()) of the model function: the clones must therefore be
+   independent of each other. Each single fit is done sequentially.
+
+   The parameter settings (limits, fixed parameters, step sizes) are taken from
+   the configuration, which is initialized from the model function. Initial
+   values specific to each data set can be passed to the fit methods. Only the
+   compact ROOT::Fit::BatchFitResult is kept for each fit.
+
+   @ingroup FitMain
+*/
+class BatchFitter {
+
+public:
+
+   typedef ROOT::Math::IParamMultiFunction                 IModelFunction;
+   typedef ROOT::Math::IParamMultiGradFunction             IGradModelFunction;
+
+   /**
+      Constructor from the model function, which is cloned.
+      If useGradient is true and the function provides the gradient with
+      respect to the parameters, the gradient of the objective function is
+      computed from it.
+   */
+   BatchFitter(const IModelFunction & func, bool useGradient = false);
+
+   /**
+      Copy constructor (disabled, class is not copyable)
+   */
+   BatchFitter(const BatchFitter &) = delete;
+
+   /**
+      Assignment operator (disabled, class is not copyable)
+   */
+   BatchFitter & operator = (const BatchFitter &) = delete;
+
+   /**
+      Fit each data set with a least square (chi2) fit.
+      initParams, if not null, contains the initial parameter values of each
+      fit (NPar() values per data set); otherwise the values of the
+      configuration are used. Return false if no fit could be done.
+      As in ROOT::Fit::Fitter, the parameter errors are normalized with the
+      chi2 value if FitConfig::NormalizeErrors() is set; they are also
+      normalized for the data sets without errors.
+   */
+   bool Fit(const std::vector<std::shared_ptr<BinData>> & data, const double * initParams = nullptr,
+            const ROOT::EExecutionPolicy & executionPolicy = ROOT::EExecutionPolicy::kSequential) {
+      return DoFit(data, initParams, false, false, executionPolicy);
+   }
+
+   /**
+      Fit each data set with a binned likelihood fit, extended by default.
+      See Fit() for the initial parameter values.
+   */
+   bool LikelihoodFit(const std::vector<std::shared_ptr<BinData>> & data, bool extended = true, const double * initParams = nullptr,
+                      const ROOT::EExecutionPolicy & executionPolicy = ROOT::EExecutionPolicy::kSequential) {
+      return DoFit(data, initParams, true, extended, executionPolicy);
+   }
+
+   /// access to the fit configuration (const method)
+   const FitConfig & Config() const { return fConfig; }
+
+   /// access to the configuration (non const method)
+   FitConfig & Config() { return fConfig; }
+
+   /// access to the results of the last batch of fits
+   const BatchFitResult & Result() const { return fResult; }
+
+private:
+
+   bool DoFit(const std::vector<std::shared_ptr<BinData>> & data, const double * initParams, bool likelihood,
+              bool extended, const ROOT::EExecutionPolicy & executionPolicy);
+
+   std::shared_ptr<IModelFunction> fFunc;   ///< model function
+   bool fUseGradient;                       ///< use the gradient of the model function
+   FitConfig fConfig;                       ///< fit configuration (parameters settings and minimizer options)
+   BatchFitResult fResult;                  ///< results of the last batch of fits
+};
+
+   } // end namespace Fit
+
+} // end namespace ROOT
+
+#endif /* ROOT_Fit_BatchFitter */
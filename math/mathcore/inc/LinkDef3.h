@@ -15,6 +15,8 @@
 #pragma link C++ class ROOT::Fit::DataOptions;
 
 #pragma link C++ class ROOT::Fit::Fitter;
+#pragma link C++ class ROOT::Fit::BatchFitter;
+#pragma link C++ class ROOT::Fit::BatchFitResult;
 #pragma link C++ class ROOT::Fit::FitConfig+;
 #pragma link C++ class ROOT::Fit::FitData+;
 #pragma link C++ class ROOT::Fit::BinData+;
@@ -18,6 +18,8 @@
 
 #include "Math/VirtualIntegrator.h"
 
+#include "ROOT/EExecutionPolicy.hxx"
+
 namespace ROOT {
 namespace Math {
 
@@ -61,6 +63,12 @@ An integration rule of degree seven is used together with a certain
 strategy of subdivision.
 For a more detailed description of the method see References.
 
+The \f$ 2^n +2n(n+1) +1 \f$ nodes of the rule on a region are evaluated at once with
+IBaseFunctionMultiDim::EvalBatch when the integrand evaluates many points more efficiently than one by one
+(see IBaseFunctionMultiDim::HasBatchEvaluation). With the ROOT::EExecutionPolicy::kMultiThread execution policy (see SetExecutionPolicy)
+the nodes are in addition split in ranges evaluated in parallel with ROOT::TThreadExecutor: the integrand
+must then be thread-safe. The result does not depend on the execution policy.
+
 ### Notes:
 
   1..Multi-dimensional integration is time-consuming. For each rectangular
@@ -166,6 +174,13 @@ public:
    ///set max points
    void SetMaxPts(unsigned int n) { fMaxPts = n; }
 
+   /// set the execution policy used for evaluating the integrand (ROOT::EExecutionPolicy::kMultiThread requires IMT
+   /// and a thread-safe integrand)
+   void SetExecutionPolicy(ROOT::EExecutionPolicy policy) { fExecutionPolicy = policy; }
+
+   /// get the execution policy used for evaluating the integrand
+   ROOT::EExecutionPolicy ExecutionPolicy() const { return fExecutionPolicy; }
+
    /// set the options
    void SetOptions(const ROOT::Math::IntegratorMultiDimOptions & opt) override;
 
@@ -191,6 +206,7 @@ protected:
    double fRelError;      ///< Relative error
    int    fNEval;         ///< number of function evaluation
    int fStatus;           ///< status of algorithm (error if not zero)
+   ROOT::EExecutionPolicy fExecutionPolicy; ///< execution policy used for evaluating the integrand
 
    const IMultiGenFunction* fFun;   // pointer to integrand function
 
@@ -32,6 +32,7 @@ namespace Math {
 
    It will use the Gauss Method for function integration in a given interval.
    This class is implemented from TF1::Integral().
+   The 24 points of each sub-interval are evaluated at once with IBaseFunctionOneDim::EvalBatch.
 
    @ingroup Integration
 
@@ -239,12 +240,14 @@ public:
    double operator()(double x) const;
    double DoEval(double x) const override;
    IGenFunction* Clone() const override;
+   bool HasBatchEvaluation() const override;
 private:
    ESemiInfinitySign fSign;
    const IGenFunction* fIntegrand;
    double fBoundary;
    bool fInfiniteInterval;
    double DoEval(double x, double boundary, int sign) const;
+   void DoEvalBatch(unsigned int n, const double *x, double *f) const override;
 };
 
 
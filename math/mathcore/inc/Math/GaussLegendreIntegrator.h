@@ -29,6 +29,7 @@ namespace Math {
 
    It will use the Gauss-Legendre Method for function integration in a given interval.
    This class is implemented from TF1::Integral().
+   The sampling points are evaluated at once with IBaseFunctionOneDim::EvalBatch.
 
    @ingroup Integration
 
@@ -33,6 +33,7 @@
 
 #include "Math/IFunctionfwd.h"
 
+#include <vector>
 
 namespace ROOT {
    namespace Math {
@@ -85,14 +86,36 @@ namespace ROOT {
          T operator()(const Iterator it) const { return DoEval(&(*it)); }
 #endif
 
+         /// Evaluate the function at n points and store the values in f.
+         /// The coordinates are given per dimension: x[i] points to the n values of the i-th coordinate.
+         /// Use the virtual private method DoEvalBatch, which evaluates the points one by one by default.
+         void EvalBatch(unsigned int n, const T *const *x, T *f) const { DoEvalBatch(n, x, f); }
+
          // Indicate whether this class supports gradient calculations, i.e.,
          // if it inherits from ROOT::Math::IGradientFunctionMultiDim.
          virtual bool HasGradient() const { return false; }
 
+         /// Return true if the function evaluates many points at once more efficiently than one by one,
+         /// i.e. if EvalBatch should be preferred to operator()(x).
+         virtual bool HasBatchEvaluation() const { return false; }
+
       private:
 
          /// Implementation of the evaluation function. Must be implemented by derived classes.
          virtual T DoEval(const T *x) const = 0;
+
+         /// Implementation of the evaluation on many points. By default the points are evaluated one by one
+         /// with DoEval: derived classes providing a faster evaluation re-implement it and HasBatchEvaluation.
+         virtual void DoEvalBatch(unsigned int n, const T *const *x, T *f) const
+         {
+            const unsigned int ndim = NDim();
+            std::vector<T> xx(ndim);
+            for (unsigned int i = 0; i < n; ++i) {
+               for (unsigned int j = 0; j < ndim; ++j)
+                  xx[j] = x[j][i];
+               f[i] = DoEval(xx.data());
+            }
+         }
       };
 
 
@@ -129,14 +152,30 @@ namespace ROOT {
          /// Compatible method with multi-dimensional functions.
          double operator()(const double *x) const { return DoEval(*x); }
 
+         /// Evaluate the function at the n points x and store the values in f.
+         /// Use the virtual private method DoEvalBatch, which evaluates the points one by one by default.
+         void EvalBatch(unsigned int n, const double *x, double *f) const { DoEvalBatch(n, x, f); }
+
          // Indicate whether this class supports gradient calculations, i.e.,
          // if it inherits from ROOT::Math::IGradientFunctionOneDim.
          virtual bool HasGradient() const { return false; }
 
+         /// Return true if the function evaluates many points at once more efficiently than one by one,
+         /// i.e. if EvalBatch should be preferred to operator()(x).
+         virtual bool HasBatchEvaluation() const { return false; }
+
       private:
 
          /// implementation of the evaluation function. Must be implemented by derived classes
          virtual double DoEval(double x) const = 0;
+
+         /// Implementation of the evaluation on many points. By default the points are evaluated one by one
+         /// with DoEval: derived classes providing a faster evaluation re-implement it and HasBatchEvaluation.
+         virtual void DoEvalBatch(unsigned int n, const double *x, double *f) const
+         {
+            for (unsigned int i = 0; i < n; ++i)
+               f[i] = DoEval(x[i]);
+         }
       };
 
 
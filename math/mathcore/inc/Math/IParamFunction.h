@@ -24,6 +24,7 @@
 
 #include <cassert>
 #include <string>
+#include <vector>
 
 /**
    @defgroup ParamFunc Parametric Function Evaluation Interfaces.
@@ -130,6 +131,23 @@ namespace ROOT {
             return DoEval(x);
          }
 
+         /**
+         Evaluate function at n points for given parameters p and store the values in result.
+         The coordinates are given per dimension: x[i] points to the n values of the i-th coordinate.
+         Use the virtual function DoEvalParBatch to implement it
+         */
+         void EvalParBatch(unsigned int n, const T *const *x, const double *p, T *result) const
+         {
+            DoEvalParBatch(n, x, p, result);
+         }
+
+         /**
+            Return true if the function evaluates many points at once more efficiently
+            than one by one, i.e. if EvalParBatch should be preferred to operator()(x, p)
+            and EvalBatch to operator()(x)
+         */
+         bool HasBatchEvaluation() const override { return false; }
+
       private:
          /**
             Implementation of the evaluation function using the x values and the parameters.
@@ -137,6 +155,21 @@ namespace ROOT {
          */
          virtual T DoEvalPar(const T *x, const double *p) const = 0;
 
+         /**
+            Implementation of the evaluation on many points. By default the points are
+            evaluated one by one with DoEvalPar
+         */
+         virtual void DoEvalParBatch(unsigned int n, const T *const *x, const double *p, T *result) const
+         {
+            const unsigned int ndim = this->NDim();
+            std::vector<T> xx(ndim);
+            for (unsigned int i = 0; i < n; ++i) {
+               for (unsigned int j = 0; j < ndim; ++j)
+                  xx[j] = x[j][i];
+               result[i] = DoEvalPar(xx.data(), p);
+            }
+         }
+
          /**
             Implement the ROOT::Math::IBaseFunctionMultiDim interface DoEval(x) using the cached parameter values
          */
@@ -144,6 +177,14 @@ namespace ROOT {
          {
             return DoEvalPar(x, Parameters());
          }
+
+         /**
+            Implement the ROOT::Math::IBaseFunctionMultiDim interface DoEvalBatch using the cached parameter values
+         */
+         void DoEvalBatch(unsigned int n, const T *const *x, T *f) const override
+         {
+            DoEvalParBatch(n, x, Parameters(), f);
+         }
       };
 
 
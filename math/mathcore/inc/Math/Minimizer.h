@@ -67,6 +67,7 @@ namespace ROOT {
      - Minimize
      - Fumili (Fumili2)
      - Scan
+     - LBFGS
 
    - Fumili (class TFumiliMinimizer)
 
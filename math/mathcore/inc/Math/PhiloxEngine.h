@@ -0,0 +1,104 @@
+// @(#)root/mathcore:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_Math_PhiloxEngine
+#define ROOT_Math_PhiloxEngine
+
+#include "Math/TRandomEngine.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ROOT {
+namespace Math {
+
+/**
+   Counter-based random number engine Philox4x32-10.
+
+   Each block of four 32-bit random words is obtained by applying 10 rounds of
+   the Philox bijection to a 128-bit counter, with the 64-bit seed as key, see
+   J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw, *Parallel random
+   numbers: as easy as 1, 2, 3*, SC11 (2011), https://doi.org/10.1145/2063384.2063405
+
+   Since there is no state besides the counter, independent and reproducible
+   streams are obtained without any seeding procedure: the counter is built
+   from a stream number (e.g. a thread or a task index), an event number and
+   the index of the block in the sub-sequence of the (stream, event) pair.
+   Each sub-sequence contains \f$ 2^{33} \f$ numbers; longer sequences
+   continue in the sub-sequence of the next event number.
+
+   The blocks are independent, so that the bulk methods RndmArray(), GausArray()
+   and ExpArray() generate many blocks at once, in a form that the compiler can
+   vectorize. RndmArray() gives the same numbers as repeated calls to Rndm().
+
+   @ingroup Random
+*/
+class PhiloxEngine final : public TRandomEngine {
+
+public:
+   /// Engine for stream 0 and event 0 of the given seed
+   PhiloxEngine(uint64_t seed = 314159265) { SetSeed(seed); }
+   /// Engine positioned at the start of the sub-sequence of (stream, event) for the given seed
+   PhiloxEngine(uint64_t seed, uint32_t stream, uint64_t event) : fKey(seed) { SetStream(stream, event); }
+   ~PhiloxEngine() override {}
+
+   /// Generate a double-precision random number in the open interval (0, 1) with 52 bits of randomness
+   double Rndm() override { return (*this)(); }
+   /// Generate a double-precision random number (non-virtual method)
+   double operator()() { return ToDouble(IntRndm()); }
+   /// Generate a random integer value with 64 bits
+   uint64_t IntRndm();
+
+   /// Fill an array with random numbers in (0, 1), the same as `n` calls to Rndm()
+   void RndmArray(size_t n, double *array);
+   /// Fill an array with Gaussian random numbers, computed from pairs of uniform numbers (Box-Muller)
+   void GausArray(size_t n, double *array, double mean = 0, double sigma = 1);
+   /// Fill an array with exponential random numbers of mean `tau`
+   void ExpArray(size_t n, double *array, double tau = 1);
+
+   /// Set the seed (key) and go to the start of stream 0 and event 0
+   void SetSeed(uint64_t seed)
+   {
+      fKey = seed;
+      SetStream(0, 0);
+   }
+   /// Go to the start of the sub-sequence of (stream, event), keeping the seed
+   void SetStream(uint32_t stream, uint64_t event);
+   /// Skip `n` random numbers without generating them
+   void Skip(uint64_t n);
+
+   uint64_t GetSeed() const { return fKey; }
+   uint32_t GetStream() const { return fStream; }
+   uint64_t GetEvent() const { return fEvent; }
+
+   /// Apply the Philox4x32-10 bijection to `ctr` with the key `key`
+   static void Philox(const uint32_t ctr[4], const uint32_t key[2], uint32_t out[4]);
+
+   /// Convert a 64-bit random integer to a double in the open interval (0, 1), using its upper 52 bits:
+   /// with 53 bits, x = 2^64-1 would be rounded to exactly 1
+   static double ToDouble(uint64_t x) { return ((x >> 12) + 0.5) * (1.0 / 4503599627370496.0); }
+
+   /// Get name of the generator
+   static const char *Name() { return "Philox4x32-10"; }
+
+private:
+   void GenerateBlocks(uint64_t first, unsigned int nblocks, uint32_t *out) const;
+
+   uint64_t fKey = 0;    ///< seed, used as key of the bijection
+   uint32_t fStream = 0; ///< stream number
+   uint64_t fEvent = 0;  ///< event number
+   uint64_t fCount = 0;  ///< number of 64-bit numbers generated in the sub-sequence of (stream, event)
+   uint32_t fBuffer[4];  ///< current block
+};
+
+} // end namespace Math
+} // end namespace ROOT
+
+#endif /* ROOT_Math_PhiloxEngine */
@@ -48,9 +48,11 @@ public:
    Index   GetBucketSize() {return fBucketSize;}
 
    void    FindNearestNeighbors(const Value *point, Int_t k, Index *ind, Value *dist);
+   void    FindNearestNeighbors(Index nqueries, const Value *points, Int_t k, Index *ind, Value *dist);
    Index   FindNode(const Value * point) const;
    void    FindPoint(Value * point, Index &index, Int_t &iter);
    void    FindInRange(Value *point, Value range, std::vector<Index> &res);
+   void    FindInRange(Index nqueries, const Value *points, Value range, std::vector<std::vector<Index>> &res);
    void    FindBNodeA(Value * point, Value * delta, Int_t &inode);
 
    Bool_t  IsTerminal(Index inode) const {return (inode>=fNNodes);}
@@ -60,6 +62,7 @@ public:
 
    void    MakeBoundaries(Value *range = nullptr);
    void    MakeBoundariesExact();
+   void    MakePointsData();
    void    SetData(Index npoints, Index ndim, UInt_t bsize, Value **data);
    Int_t   SetData(Index idim, Value *data);
    void    SetOwner(Int_t owner) { fDataOwner = owner; }
@@ -70,8 +73,16 @@ public:
    TKDTree<Index, Value>& operator=(const TKDTree<Index, Value>&); // not implemented
    void CookBoundaries(const Int_t node, Bool_t left);
 
+   void BuildSubtree(Int_t inode, Int_t irow, Int_t pos, Int_t npoints);
+   void DivideNode(Int_t cnode, Int_t crow, Int_t cpos, Int_t npoints, Int_t &nleft, Int_t &nright);
+
+   void Distances(const Value *point, Index first, Index last, Double_t *dist) const;
    void UpdateNearestNeighbors(Index inode, const Value *point, Int_t kNN, Index *ind, Value *dist);
-   void UpdateRange(Index inode, Value *point, Value range, std::vector<Index> &res);
+   void UpdateRange(Index inode, const Value *point, Value range, std::vector<Index> &res);
+   template <class F>
+   void ForeachQueryRange(Index nqueries, F &&func) const;
+
+   static constexpr Int_t kDistBlock = 64; ///< number of distances to the points of a terminal node computed at once
 
  protected:
    Int_t   fDataOwner;  ///<! 0 - not owner, 2 - owner of the pointer array, 1 - owner of the whole 2-d array
@@ -95,6 +106,7 @@ public:
    Int_t   fOffset;     ///<! offset in fIndPoints - if there are 2 rows, that contain terminal nodes
                         ///<  fOffset returns the index in the fIndPoints array of the first point
                         ///<  that belongs to the first node on the second row.
+   Value   *fPointsData;///<! coordinates of the points in the order of fIndPoints, fNPoints per dimension (see MakePointsData())
 
 
    ClassDefOverride(TKDTree, 1)  // KD tree
@@ -28,6 +28,8 @@
 //       can be created for different state N.                          //
 //    * ROOT::MATH::StdEngine to create genersators based on engines    //
 //      provided by the C++ standard libraries
+//    * ROOT::Math::PhiloxEngine for the counter-based Philox generator,
+//      with independent streams and vectorized generation of arrays
 //
 //  Convenient typedef are defines to define the different types of
 //  generators. These typedef are
@@ -36,6 +38,7 @@
 //   * TRandomMixMax256 for the MixMaxEngine<256,2> (MIXMAX with state N=256 )
 //   * TRandomMT64 for the  StdEngine<std::mt19937_64> ( MersenneTwister 64 bits)
 //   * TRandomRanlux48 for the  StdEngine<std::ranlux48> (Ranlux 48 bits)
+//   * TRandomPhilox for the PhiloxEngine (Philox4x32-10)
 //
 //                                                                     //
 //////////////////////////////////////////////////////////////////////////
@@ -77,6 +80,7 @@ public:
 #include "Math/StdEngine.h"
 #include "Math/MixMaxEngine.h"
 #include "Math/RanluxppEngine.h"
+#include "Math/PhiloxEngine.h"
 
 // not working wight now for this classes
 //#define  DEFINE_TEMPL_INSTANCE
@@ -131,6 +135,24 @@ typedef TRandomGen<ROOT::Math::MixMaxEngine<256,2>> TRandomMixMax256;
 
 typedef TRandomGen<ROOT::Math::RanluxppEngine2048> TRandomRanluxpp;
 
+/// The Philox engine fills arrays with its vectorized bulk generation
+template <>
+inline void TRandomGen<ROOT::Math::PhiloxEngine>::RndmArray(Int_t n, Double_t *array)
+{
+   fEngine.RndmArray(n, array);
+}
+
+/**
+  @ingroup Random
+  Counter-based generator Philox4x32-10 (see ROOT::Math::PhiloxEngine).
+  Independent and reproducible streams, e.g. one per thread and event, are obtained
+  directly from the engine with ROOT::Math::PhiloxEngine::SetStream.
+
+   J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw, *Parallel random numbers: as easy as 1, 2, 3*,
+  SC11 (2011), https://doi.org/10.1145/2063384.2063405
+ */
+typedef TRandomGen<ROOT::Math::PhiloxEngine> TRandomPhilox;
+
 /**
   @ingroup Random
   Generator based on a the Mersenne-Twister generator with 64 bits,
@@ -6,8 +6,15 @@
 #include "Math/IntegratorOptions.h"
 #include "Math/Error.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <cassert>
 #include <cmath>
 #include <algorithm>
+#include <memory>
+#include <vector>
 
 namespace ROOT {
 namespace Math {
@@ -25,6 +32,7 @@ AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim(double absTol, double rel
    fError(0), fRelError(0),
    fNEval(0),
    fStatus(-1),
+   fExecutionPolicy(ROOT::EExecutionPolicy::kSequential),
    fFun(nullptr)
 {
    // constructor - without passing a function
@@ -45,6 +53,7 @@ AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim( const IMultiGenFunction
    fError(0), fRelError(0),
    fNEval(0),
    fStatus(-1),
+   fExecutionPolicy(ROOT::EExecutionPolicy::kSequential),
    fFun(&f)
 {
    // constructor passing a multi-dimensional function interface
@@ -182,6 +191,30 @@ double AdaptiveIntegratorMultiDim::DoIntegral(const double* xmin, const double *
 
    unsigned int j1, k, l, m, idvaxn=0, idvax0=0, isbtmp, isbtpp;
 
+   // nodes of the rule on a region and the integrand values. The nodes are stored per coordinate
+   // for an integrand evaluating many points at once, otherwise node after node
+   const bool batch = fFun->HasBatchEvaluation();
+   const unsigned int coordStride = (batch) ? irlcls : 1;
+   const unsigned int nodeStride = (batch) ? 1 : n;
+   std::vector<double> nodes(n*irlcls);
+   std::vector<double> fval(irlcls);
+   unsigned int inode;
+   auto addNode = [&]() {
+      for (unsigned int i=0; i<n; i++) nodes[i*coordStride + inode*nodeStride] = z[i];
+      inode++;
+   };
+
+#ifdef R__USE_IMT
+   std::unique_ptr<ROOT::TThreadExecutor> pool;
+   if (fExecutionPolicy == ROOT::EExecutionPolicy::kMultiThread)
+      pool = std::make_unique<ROOT::TThreadExecutor>();
+#else
+   if (fExecutionPolicy == ROOT::EExecutionPolicy::kMultiThread) {
+      MATH_WARN_MSG("AdaptiveIntegratorMultiDim::DoIntegral", "Multithread execution policy requires IMT, which is disabled. "
+                                                               "Using ROOT::EExecutionPolicy::kSequential.");
+   }
+#endif
+
    //InitArgs(z,fParams);
 
 L20:
@@ -190,39 +223,24 @@ L20:
       rgnvol *= width[j]; //region volume
       z[j]    = ctr[j]; //temporary node
    }
-   sum1 = (*fFun)((const double*)z);//EvalPar(z,fParams); //evaluate function
 
-   difmax = 0;
-   sum2   = 0;
-   sum3   = 0;
+   // store the nodes in the order in which their values are summed below
+   inode = 0;
+   addNode();
 
-   //loop over coordinates
    for (j=0; j<n; j++) {
       z[j]    = ctr[j] - xl2*width[j];
-      if (absValue) f2 = std::abs((*fFun)(z));
-      else          f2 = (*fFun)(z);
+      addNode();
       z[j]    = ctr[j] + xl2*width[j];
-      if (absValue) f2 += std::abs((*fFun)(z));
-      else          f2 += (*fFun)(z);
+      addNode();
       widthl[j] = xl4*width[j];
       z[j]    = ctr[j] - widthl[j];
-      if (absValue) f3 = std::abs((*fFun)(z));
-      else          f3 = (*fFun)(z);
+      addNode();
       z[j]    = ctr[j] + widthl[j];
-      if (absValue) f3 += std::abs((*fFun)(z));
-      else          f3 += (*fFun)(z);
-      sum2   += f2;//sum func eval with different weights separately
-      sum3   += f3;//for a given region
-      dif     = std::abs(7*f2-f3-12*sum1);
-      //storing dimension with biggest error/difference (?)
-      if (dif >= difmax) {
-         difmax=dif;
-         idvaxn=j+1;
-      }
+      addNode();
       z[j]    = ctr[j];
    }
 
-   sum4 = 0;
    for (j=1;j<n;j++) {
       j1 = j-1;
       for (k=j;k<n;k++) {
@@ -232,8 +250,7 @@ L20:
             for (m=0;m<2;m++) {
                widthl[k] = -widthl[k];
                z[k]    = ctr[k] + widthl[k];
-               if (absValue) sum4 += std::abs((*fFun)(z));
-               else            sum4 += (*fFun)(z);
+               addNode();
             }
          }
          z[k] = ctr[k];
@@ -241,20 +258,71 @@ L20:
       z[j1] = ctr[j1];
    }
 
-   sum5 = 0;
-
    for (j=0;j<n;j++) {
       widthl[j] = -xl5*width[j];
       z[j] = ctr[j] + widthl[j];
    }
-L90: //sum over end nodes ~gray codes
-   if (absValue) sum5 += std::abs((*fFun)(z));
-   else          sum5 += (*fFun)(z);
+L90: //end nodes ~gray codes
+   addNode();
    for (j=0;j<n;j++) {
       widthl[j] = -widthl[j];
       z[j] = ctr[j] + widthl[j];
       if (widthl[j] > 0) goto L90;
    }
+   assert(inode == irlcls);
+
+   // evaluate the integrand on all the nodes, in parallel ranges for the multithread policy
+   {
+      auto evalRange = [&](unsigned int first, unsigned int last) {
+         if (batch) {
+            const double *x[15];
+            for (unsigned int i=0; i<n; i++) x[i] = &nodes[i*irlcls + first];
+            fFun->EvalBatch(last - first, x, &fval[first]);
+         } else {
+            for (unsigned int i=first; i<last; i++) fval[i] = (*fFun)(&nodes[i*n]);
+         }
+      };
+#ifdef R__USE_IMT
+      if (pool) {
+         const unsigned int nranges = std::min(irlcls, pool->GetPoolSize());
+         pool->Foreach([&](unsigned int r) { evalRange(r*irlcls/nranges, (r+1)*irlcls/nranges); },
+                       ROOT::TSeq<unsigned int>(nranges));
+      } else
+#endif
+      evalRange(0, irlcls);
+   }
+   // the center value is not taken in absolute value, as in the original algorithm
+   if (absValue) {
+      for (inode=1; inode<irlcls; inode++) fval[inode] = std::abs(fval[inode]);
+   }
+
+   sum1 = fval[0];
+
+   difmax = 0;
+   sum2   = 0;
+   sum3   = 0;
+
+   //loop over coordinates
+   inode = 1;
+   for (j=0; j<n; j++) {
+      f2      = fval[inode] + fval[inode+1];
+      f3      = fval[inode+2] + fval[inode+3];
+      inode  += 4;
+      sum2   += f2;//sum func eval with different weights separately
+      sum3   += f3;//for a given region
+      dif     = std::abs(7*f2-f3-12*sum1);
+      //storing dimension with biggest error/difference (?)
+      if (dif >= difmax) {
+         difmax=dif;
+         idvaxn=j+1;
+      }
+   }
+
+   sum4 = 0;
+   for (k=0; k<2*n*(n-1); k++) sum4 += fval[inode++];
+
+   sum5 = 0;
+   while (inode < irlcls) sum5 += fval[inode++];
 
    rgncmp  = rgnvol*(wpn1[n-2]*sum1+wp2*sum2+wpn3[n-2]*sum3+wp4*sum4);
    rgnval  = wn1[n-2]*sum1+w2*sum2+wn3[n-2]*sum3+w4*sum4+wn5[n-2]*sum5;
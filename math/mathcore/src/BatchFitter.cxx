@@ -0,0 +1,196 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2024  LCG ROOT Math Team, CERN/PH-SFT                *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Implementation file for class BatchFitter
+
+#include "Fit/BatchFitter.h"
+#include "Fit/Chi2FCN.h"
+#include "Fit/PoissonLikelihoodFCN.h"
+#include "Math/Minimizer.h"
+#include "Math/MinimizerOptions.h"
+#include "Math/FitMethodFunction.h"
+#include "Math/Error.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace ROOT {
+
+   namespace Fit {
+
+BatchFitter::BatchFitter(const IModelFunction & func, bool useGradient) :
+   fFunc(dynamic_cast<IModelFunction *>(func.Clone())),
+   fUseGradient(useGradient)
+{
+   // the gradient can be used only if the model function provides it
+   if (fUseGradient && !std::dynamic_pointer_cast<IGradModelFunction>(fFunc)) {
+      MATH_WARN_MSG("BatchFitter::BatchFitter", "model function does not provide gradient - do not use it");
+      fUseGradient = false;
+   }
+   fConfig.CreateParamsSettings(*fFunc);
+}
+
+bool BatchFitter::DoFit(const std::vector<std::shared_ptr<BinData>> & data, const double * initParams, bool likelihood,
+                        bool extended, const ROOT::EExecutionPolicy & executionPolicy)
+{
+   const unsigned int nfits = data.size();
+   const unsigned int npar = fConfig.NPar();
+   if (npar != fFunc->NPar()) {
+      MATH_ERROR_MSG("BatchFitter::DoFit", "wrong number of parameter settings in the configuration");
+      return false;
+   }
+
+   fResult.fNPar = npar;
+   fResult.fStatus.assign(nfits, -1);
+   fResult.fMinFcn.assign(nfits, std::numeric_limits<double>::quiet_NaN());
+   fResult.fEdm.assign(nfits, -1.);
+   fResult.fNdf.assign(nfits, 0);
+   fResult.fParams.assign(nfits * npar, 0.);
+   fResult.fErrors.assign(nfits * npar, 0.);
+   if (nfits == 0)
+      return false;
+
+   // logl fit (error should be 0.5) set if different than default values (of 1)
+   FitConfig config(fConfig);
+   if (likelihood && config.MinimizerOptions().ErrorDef() == ROOT::Math::MinimizerOptions::DefaultErrorDef())
+      config.MinimizerOptions().SetErrorDef(0.5);
+   if (fUseGradient && likelihood && !extended) {
+      MATH_WARN_MSG("BatchFitter::DoFit", "Not-extended binned fit with gradient not yet supported - do an extended fit");
+      extended = true;
+   }
+
+   ROOT::EExecutionPolicy policy = executionPolicy;
+#ifndef R__USE_IMT
+   if (policy == ROOT::EExecutionPolicy::kMultiThread) {
+      MATH_WARN_MSG("BatchFitter::DoFit", "Multithread execution policy requires IMT, which is disabled. Changing "
+                                          "to ROOT::EExecutionPolicy::kSequential.");
+      policy = ROOT::EExecutionPolicy::kSequential;
+   }
+#endif
+
+   // The fits are split in ranges, each one done with its own minimizer and
+   // copy of the model function. They are all created here, sequentially.
+   unsigned int nranges = 1;
+#ifdef R__USE_IMT
+   std::unique_ptr<ROOT::TThreadExecutor> pool;
+   if (policy == ROOT::EExecutionPolicy::kMultiThread) {
+      pool = std::make_unique<ROOT::TThreadExecutor>();
+      nranges = std::min(nfits, 4 * pool->GetPoolSize());
+   }
+#endif
+   std::vector<std::unique_ptr<ROOT::Math::Minimizer>> minimizers(nranges);
+   std::vector<std::shared_ptr<IModelFunction>> funcs(nranges);
+   for (unsigned int r = 0; r < nranges; ++r) {
+      minimizers[r].reset(config.CreateMinimizer());
+      if (!minimizers[r]) {
+         MATH_ERROR_MSG("BatchFitter::DoFit", "Minimizer cannot be created");
+         return false;
+      }
+      funcs[r].reset(dynamic_cast<IModelFunction *>(fFunc->Clone()));
+   }
+
+   auto fitRange = [&](unsigned int r) {
+      ROOT::Math::Minimizer &minimizer = *minimizers[r];
+      std::shared_ptr<IModelFunction> func = funcs[r];
+      std::shared_ptr<IGradModelFunction> gradFunc =
+         fUseGradient ? std::dynamic_pointer_cast<IGradModelFunction>(func) : nullptr;
+      std::vector<ParameterSettings> settings = config.ParamsSettings();
+      const unsigned int first = (uint64_t)nfits * r / nranges;
+      const unsigned int last = (uint64_t)nfits * (r + 1) / nranges;
+      for (unsigned int i = first; i < last; ++i) {
+         if (!data[i] || data[i]->Size() == 0)
+            continue;
+         for (unsigned int ipar = 0; ipar < npar; ++ipar)
+            settings[ipar].SetValue(initParams ? initParams[i * npar + ipar] : config.ParSettings(ipar).Value());
+         auto minimize = [&](const auto &fcn) {
+            minimizer.Clear();
+            minimizer.SetFunction(fcn);
+            // set also the Hessian of the objective function if available, as done by Fitter
+            const auto *gradFcn = dynamic_cast<const ROOT::Math::FitMethodGradFunction *>(&fcn);
+            if (gradFcn && gradFcn->HasHessian()) {
+               minimizer.SetHessianFunction([=](const std::vector<double> &x, double *hess) {
+                  unsigned int ndim = x.size();
+                  std::vector<double> h(ndim * (ndim + 1) / 2);
+                  if (!gradFcn->Hessian(x.data(), h.data()))
+                     return false;
+                  for (unsigned int k = 0; k < ndim; k++) {
+                     for (unsigned int j = 0; j <= k; j++) {
+                        unsigned int index = j + k * (k + 1) / 2; // formula for j <= k
+                        hess[ndim * k + j] = h[index];
+                        hess[ndim * j + k] = h[index];
+                     }
+                  }
+                  return true;
+               });
+            }
+            minimizer.SetVariables(settings.begin(), settings.end());
+            // if requested parabolic error do correct error analysis by the minimizer (call HESSE)
+            if (config.ParabErrors())
+               minimizer.SetValidError(true);
+
+            minimizer.Minimize();
+
+            const double *x = minimizer.X();
+            const double *e = minimizer.Errors();
+            unsigned int nfree = 0;
+            for (unsigned int ipar = 0; ipar < npar; ++ipar) {
+               const bool fixed = settings[ipar].IsFixed();
+               fResult.fParams[i * npar + ipar] = x ? x[ipar] : settings[ipar].Value();
+               fResult.fErrors[i * npar + ipar] = (e && !fixed) ? e[ipar] : 0.;
+               if (!fixed)
+                  ++nfree;
+            }
+            fResult.fStatus[i] = minimizer.Status();
+            fResult.fMinFcn[i] = minimizer.MinValue();
+            fResult.fEdm[i] = minimizer.Edm();
+            fResult.fNdf[i] = (fcn.NPoints() > nfree) ? fcn.NPoints() - nfree : 0;
+            // normalize the errors of the least square fits according to the chi2 value, as done
+            // by Fitter, also when the data set has no errors
+            if (!likelihood && (config.NormalizeErrors() || data[i]->GetErrorType() == BinData::kNoError) &&
+                fResult.fNdf[i] > 0 && fResult.fMinFcn[i] > 0) {
+               const double s = std::sqrt(fResult.fMinFcn[i] / fResult.fNdf[i]);
+               for (unsigned int ipar = 0; ipar < npar; ++ipar)
+                  fResult.fErrors[i * npar + ipar] *= s;
+            }
+         };
+         if (likelihood) {
+            if (gradFunc)
+               minimize(PoissonLikelihoodFCN<ROOT::Math::IMultiGradFunction>(data[i], gradFunc, 0, extended));
+            else
+               minimize(PoissonLikelihoodFCN<ROOT::Math::IMultiGenFunction>(data[i], func, 0, extended));
+         } else {
+            if (gradFunc)
+               minimize(Chi2FCN<ROOT::Math::IMultiGradFunction>(data[i], gradFunc));
+            else
+               minimize(Chi2FCN<ROOT::Math::IMultiGenFunction>(data[i], func));
+         }
+      }
+   };
+
+#ifdef R__USE_IMT
+   if (pool) {
+      pool->Foreach(fitRange, ROOT::TSeqU(nranges));
+   } else
+#endif
+   {
+      fitRange(0);
+   }
+
+   return true;
+}
+
+   } // end namespace Fit
+
+} // end namespace ROOT
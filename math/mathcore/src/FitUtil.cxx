@@ -276,17 +276,66 @@ double FitUtil::EvaluateChi2(const IModelFunction &func, const BinData &data, co
 
    (const_cast<IModelFunction &>(func)).SetParameters(p);
 
-   auto mapFunction = [&](const unsigned i){
+   // chi2 contribution of point i given the value of the model function
+   auto pointChi2 = [&](const unsigned i, const double fval){
 
       double chi2{};
-      double fval{};
 
-      const auto x1 = data.GetCoordComponent(i, 0);
       const auto y = data.Value(i);
       auto invError = data.InvError(i);
 
       //invError = (invError!= 0.0) ? 1.0/invError :1;
 
+      // expected errors
+      if (useExpErrors) {
+         double invWeight  = 1.0;
+         // case of weighted Pearson chi2 fit
+         if (isWeighted) {
+            // in case of requested a weighted Pearson fit (option "PW") a weight factor needs to be applied
+            // the bin inverse weight is estimated from bin error and bin content
+            if (y != 0)
+               invWeight = y * invError * invError;
+            else
+               // when y is 0 we use a global weight estimated form all histogram (correct if scaling the histogram)
+               // note that if the data is weighted data.SumOfError2 will not be equal to zero
+               invWeight = data.SumOfContent()/ data.SumOfError2();
+         }
+         // compute expected error  as f(x) or f(x) / weight (if weighted fit)
+         double invError2 = (fval > 0) ? invWeight / fval : 0.0;
+         invError = std::sqrt(invError2);
+         //std::cout << "using Pearson chi2 " << x[0] << "  " << 1./invError2 << "  " << fval << std::endl;
+      }
+
+#ifdef DEBUG
+      std::cout << i << "  " << y << "  " << 1./invError << " params : ";
+      for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar)
+         std::cout << p[ipar] << "\t";
+      std::cout << "\tfval = " << fval << std::endl;
+#endif
+
+      if (invError > 0) {
+
+         double tmp = ( y -fval )* invError;
+         double resval = tmp * tmp;
+
+
+         // avoid infinity or nan in chi2 values due to wrong function values
+         if ( resval < maxResValue )
+            chi2 += resval;
+         else {
+            //nRejected++;
+            chi2 += maxResValue;
+         }
+      }
+      return chi2;
+  };
+
+   auto mapFunction = [&](const unsigned i){
+
+      double fval{};
+
+      const auto x1 = data.GetCoordComponent(i, 0);
+
       const double * x = nullptr;
       std::vector<double> xc;
       double binVolume = 1.0;
@@ -334,48 +383,27 @@ double FitUtil::EvaluateChi2(const IModelFunction &func, const BinData &data, co
       // we need to multiply by the bin volume (e.g. for variable bins histograms)
       if (useBinVolume) fval *= binVolume;
 
-      // expected errors
-      if (useExpErrors) {
-         double invWeight  = 1.0;
-         // case of weighted Pearson chi2 fit
-         if (isWeighted) {
-            // in case of requested a weighted Pearson fit (option "PW") a weight factor needs to be applied
-            // the bin inverse weight is estimated from bin error and bin content
-            if (y != 0)
-               invWeight = y * invError * invError;
-            else
-               // when y is 0 we use a global weight estimated form all histogram (correct if scaling the histogram)
-               // note that if the data is weighted data.SumOfError2 will not be equal to zero
-               invWeight = data.SumOfContent()/ data.SumOfError2();
-         }
-         // compute expected error  as f(x) or f(x) / weight (if weighted fit)
-         double invError2 = (fval > 0) ? invWeight / fval : 0.0;
-         invError = std::sqrt(invError2);
-         //std::cout << "using Pearson chi2 " << x[0] << "  " << 1./invError2 << "  " << fval << std::endl;
-      }
-
-#ifdef DEBUG
-      std::cout << x[0] << "  " << y << "  " << 1./invError << " params : ";
-      for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar)
-         std::cout << p[ipar] << "\t";
-      std::cout << "\tfval = " << fval << " bin volume " << binVolume << " ref " << wrefVolume << std::endl;
-#endif
-
-      if (invError > 0) {
-
-         double tmp = ( y -fval )* invError;
-         double resval = tmp * tmp;
-
+      return pointChi2(i, fval);
+  };
 
-         // avoid infinity or nan in chi2 values due to wrong function values
-         if ( resval < maxResValue )
-            chi2 += resval;
-         else {
-            //nRejected++;
-            chi2 += maxResValue;
-         }
-      }
-      return chi2;
+  // When the model function evaluates many points at once more efficiently (e.g. a TF1 based
+  // on a formula compiled in a vectorized loop), the chi2 is computed on blocks of points
+  const bool useBatch = !useBinIntegral && !useBinVolume && func.HasBatchEvaluation();
+  constexpr unsigned int kBatchSize = 256;
+  const unsigned int nBlocks = (n + kBatchSize - 1) / kBatchSize;
+
+  auto blockFunction = [&](const unsigned ib){
+     const unsigned int first = ib * kBatchSize;
+     const unsigned int nb = std::min(kBatchSize, n - first);
+     std::vector<const double *> xb(data.NDim());
+     for (unsigned int j = 0; j < xb.size(); ++j)
+        xb[j] = data.GetCoordComponent(first, j);
+     double fvals[kBatchSize];
+     func.EvalParBatch(nb, xb.data(), p, fvals);
+     double chi2{};
+     for (unsigned int i = 0; i < nb; ++i)
+        chi2 += pointChi2(first + i, fvals[i]);
+     return chi2;
   };
 
 #ifdef R__USE_IMT
@@ -395,14 +423,24 @@ double FitUtil::EvaluateChi2(const IModelFunction &func, const BinData &data, co
 
   double res{};
   if(executionPolicy == ROOT::EExecutionPolicy::kSequential){
-    for (unsigned int i=0; i<n; ++i) {
-      res += mapFunction(i);
+    if (useBatch) {
+      for (unsigned int ib=0; ib<nBlocks; ++ib)
+        res += blockFunction(ib);
+    } else {
+      for (unsigned int i=0; i<n; ++i) {
+        res += mapFunction(i);
+      }
     }
 #ifdef R__USE_IMT
   } else if(executionPolicy == ROOT::EExecutionPolicy::kMultiThread) {
     ROOT::TThreadExecutor pool;
-    auto chunks = nChunks !=0? nChunks: setAutomaticChunking(data.Size());
-    res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
+    if (useBatch) {
+      auto chunks = nChunks !=0? std::min(nChunks, nBlocks): setAutomaticChunking(nBlocks);
+      res = pool.MapReduce(blockFunction, ROOT::TSeq<unsigned>(0, nBlocks), redFunction, chunks);
+    } else {
+      auto chunks = nChunks !=0? nChunks: setAutomaticChunking(data.Size());
+      res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
+    }
 #endif
 //   } else if(executionPolicy == ROOT::Fit::kMultitProcess){
     // ROOT::TProcessExecutor pool;
@@ -1493,9 +1531,59 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction &func, const BinData &d
    IntegralEvaluator<> igEval(func, p, useBinIntegral, igType);
 #endif
 
+   // negative log-likelihood contribution of point i given the value of the model function
+   auto pointNLL = [&](const unsigned i, double fval) {
+      auto y = *data.ValuePtr(i);
+
+      // EvalLog protects against 0 values of fval but don't want to add in the -log sum
+      // negative values of fval
+      fval = std::max(fval, 0.0);
+
+      double nloglike = 0; // negative loglikelihood
+      if (useW2) {
+         // apply weight correction . Effective weight is error^2/ y
+         // and expected events in bins is fval/weight
+         // can apply correction only when y is not zero otherwise weight is undefined
+         // (in case of weighted likelihood I don't care about the constant term due to
+         // the saturated model)
+
+         // use for the empty bins the global weight
+         double weight = 1.0;
+         if (y != 0) {
+            double error = data.Error(i);
+            weight = (error * error) / y; // this is the bin effective weight
+            nloglike -= weight * y * ( ROOT::Math::Util::EvalLog(fval/y) );
+         }
+         else {
+            // for empty bin use the average weight  computed from the total data weight
+            weight = data.SumOfError2()/ data.SumOfContent();
+         }
+         if (extended) {
+            nloglike += weight  *  ( fval - y);
+         }
+
+      } else {
+         // standard case no weights or iWeight=1
+         // this is needed for Poisson likelihood (which are extended and not for multinomial)
+         // the formula below  include constant term due to likelihood of saturated model (f(x) = y)
+         // (same formula as in Baker-Cousins paper, page 439 except a factor of 2
+         if (extended) nloglike = fval - y;
+
+         if (y >  0) {
+            nloglike += y * (ROOT::Math::Util::EvalLog(y) - ROOT::Math::Util::EvalLog(fval));
+         }
+      }
+#ifdef DEBUG
+      {
+         R__LOCKGUARD(gROOTMutex);
+         std::cout << " nll = " << nloglike << std::endl;
+      }
+#endif
+      return nloglike;
+   };
+
    auto mapFunction = [&](const unsigned i) {
       auto x1 = data.GetCoordComponent(i, 0);
-      auto y = *data.ValuePtr(i);
 
       const double *x = nullptr;
       std::vector<double> xc;
@@ -1540,8 +1628,6 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction &func, const BinData &d
       }
       if (useBinVolume) fval *= binVolume;
 
-
-
 #ifdef DEBUG
       int NSAMPLE = 100;
       if (i % NSAMPLE == 0) {
@@ -1553,55 +1639,30 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction &func, const BinData &d
             for (unsigned int j = 0; j < func.NDim(); ++j) std::cout << data.GetBinUpEdgeComponent(i, j) << " , ";
             std::cout << "] ";
          }
-         std::cout << "  y = " << y << " fval = " << fval << std::endl;
+         std::cout << "  y = " << *data.ValuePtr(i) << " fval = " << fval << std::endl;
       }
 #endif
 
+      return pointNLL(i, fval);
+   };
 
-      // EvalLog protects against 0 values of fval but don't want to add in the -log sum
-      // negative values of fval
-      fval = std::max(fval, 0.0);
-
-      double nloglike = 0; // negative loglikelihood
-      if (useW2) {
-         // apply weight correction . Effective weight is error^2/ y
-         // and expected events in bins is fval/weight
-         // can apply correction only when y is not zero otherwise weight is undefined
-         // (in case of weighted likelihood I don't care about the constant term due to
-         // the saturated model)
-
-         // use for the empty bins the global weight
-         double weight = 1.0;
-         if (y != 0) {
-            double error = data.Error(i);
-            weight = (error * error) / y; // this is the bin effective weight
-            nloglike -= weight * y * ( ROOT::Math::Util::EvalLog(fval/y) );
-         }
-         else {
-            // for empty bin use the average weight  computed from the total data weight
-            weight = data.SumOfError2()/ data.SumOfContent();
-         }
-         if (extended) {
-            nloglike += weight  *  ( fval - y);
-         }
-
-      } else {
-         // standard case no weights or iWeight=1
-         // this is needed for Poisson likelihood (which are extended and not for multinomial)
-         // the formula below  include constant term due to likelihood of saturated model (f(x) = y)
-         // (same formula as in Baker-Cousins paper, page 439 except a factor of 2
-         if (extended) nloglike = fval - y;
-
-         if (y >  0) {
-            nloglike += y * (ROOT::Math::Util::EvalLog(y) - ROOT::Math::Util::EvalLog(fval));
-         }
-      }
-#ifdef DEBUG
-      {
-         R__LOCKGUARD(gROOTMutex);
-         std::cout << " nll = " << nloglike << std::endl;
-      }
-#endif
+   // When the model function evaluates many points at once more efficiently (e.g. a TF1 based
+   // on a formula compiled in a vectorized loop), the likelihood is computed on blocks of points
+   const bool useBatch = !useBinIntegral && !useBinVolume && func.HasBatchEvaluation();
+   constexpr unsigned int kBatchSize = 256;
+   const unsigned int nBlocks = (n + kBatchSize - 1) / kBatchSize;
+
+   auto blockFunction = [&](const unsigned ib) {
+      const unsigned int first = ib * kBatchSize;
+      const unsigned int nb = std::min(kBatchSize, n - first);
+      std::vector<const double *> xb(data.NDim());
+      for (unsigned int j = 0; j < xb.size(); ++j)
+         xb[j] = data.GetCoordComponent(first, j);
+      double fvals[kBatchSize];
+      func.EvalParBatch(nb, xb.data(), p, fvals);
+      double nloglike = 0;
+      for (unsigned int i = 0; i < nb; ++i)
+         nloglike += pointNLL(first + i, fvals[i]);
       return nloglike;
    };
 
@@ -1622,14 +1683,24 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction &func, const BinData &d
 
    double res{};
    if (executionPolicy == ROOT::EExecutionPolicy::kSequential) {
-      for (unsigned int i = 0; i < n; ++i) {
-         res += mapFunction(i);
+      if (useBatch) {
+         for (unsigned int ib = 0; ib < nBlocks; ++ib)
+            res += blockFunction(ib);
+      } else {
+         for (unsigned int i = 0; i < n; ++i) {
+            res += mapFunction(i);
+         }
       }
 #ifdef R__USE_IMT
    } else if (executionPolicy == ROOT::EExecutionPolicy::kMultiThread) {
       ROOT::TThreadExecutor pool;
-      auto chunks = nChunks != 0 ? nChunks : setAutomaticChunking(data.Size());
-      res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
+      if (useBatch) {
+         auto chunks = nChunks != 0 ? std::min(nChunks, nBlocks) : setAutomaticChunking(nBlocks);
+         res = pool.MapReduce(blockFunction, ROOT::TSeq<unsigned>(0, nBlocks), redFunction, chunks);
+      } else {
+         auto chunks = nChunks != 0 ? nChunks : setAutomaticChunking(data.Size());
+         res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
+      }
 #endif
       //   } else if(executionPolicy == ROOT::Fit::kMultitProcess){
       // ROOT::TProcessExecutor pool;
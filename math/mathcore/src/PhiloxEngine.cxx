@@ -0,0 +1,167 @@
+// @(#)root/mathcore:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/** \class ROOT::Math::PhiloxEngine
+Implementation of the Philox4x32-10 counter-based generator.
+
+The bijection is the one of the Random123 library, so that the blocks match its
+known-answer tests. The bulk methods compute kLanes blocks at a time, with the
+four words of the counters stored in separate arrays and the rounds written as
+loops over the lanes, which are vectorized by the compiler.
+*/
+
+#include "Math/PhiloxEngine.h"
+
+#include <cmath>
+
+namespace {
+
+constexpr uint32_t kPhiloxM0 = 0xD2511F53;
+constexpr uint32_t kPhiloxM1 = 0xCD9E8D57;
+constexpr uint32_t kPhiloxW0 = 0x9E3779B9;
+constexpr uint32_t kPhiloxW1 = 0xBB67AE85;
+constexpr unsigned int kPhiloxRounds = 10;
+
+/// number of blocks computed together by the bulk methods
+constexpr unsigned int kLanes = 16;
+
+/// Philox rounds on n <= kLanes counters, stored in the arrays x0, ..., x3
+inline void PhiloxRounds(unsigned int n, uint32_t *x0, uint32_t *x1, uint32_t *x2, uint32_t *x3, uint32_t k0,
+                         uint32_t k1)
+{
+   for (unsigned int r = 0; r < kPhiloxRounds; ++r) {
+      for (unsigned int l = 0; l < n; ++l) {
+         const uint64_t p0 = uint64_t(kPhiloxM0) * x0[l];
+         const uint64_t p1 = uint64_t(kPhiloxM1) * x2[l];
+         const uint32_t y0 = uint32_t(p1 >> 32) ^ x1[l] ^ k0;
+         const uint32_t y2 = uint32_t(p0 >> 32) ^ x3[l] ^ k1;
+         x0[l] = y0;
+         x1[l] = uint32_t(p1);
+         x2[l] = y2;
+         x3[l] = uint32_t(p0);
+      }
+      k0 += kPhiloxW0;
+      k1 += kPhiloxW1;
+   }
+}
+
+} // namespace
+
+namespace ROOT {
+namespace Math {
+
+void PhiloxEngine::Philox(const uint32_t ctr[4], const uint32_t key[2], uint32_t out[4])
+{
+   uint32_t x0 = ctr[0], x1 = ctr[1], x2 = ctr[2], x3 = ctr[3];
+   PhiloxRounds(1, &x0, &x1, &x2, &x3, key[0], key[1]);
+   out[0] = x0;
+   out[1] = x1;
+   out[2] = x2;
+   out[3] = x3;
+}
+
+/// Compute the blocks first, ..., first + nblocks - 1 (nblocks <= kLanes) of the current sub-sequence
+void PhiloxEngine::GenerateBlocks(uint64_t first, unsigned int nblocks, uint32_t *out) const
+{
+   uint32_t x0[kLanes], x1[kLanes], x2[kLanes], x3[kLanes];
+   for (unsigned int l = 0; l < nblocks; ++l) {
+      const uint64_t block = first + l;
+      // the block index overflows into the event number
+      const uint64_t event = fEvent + (block >> 32);
+      x0[l] = uint32_t(block);
+      x1[l] = fStream;
+      x2[l] = uint32_t(event);
+      x3[l] = uint32_t(event >> 32);
+   }
+   PhiloxRounds(nblocks, x0, x1, x2, x3, uint32_t(fKey), uint32_t(fKey >> 32));
+   for (unsigned int l = 0; l < nblocks; ++l) {
+      out[4 * l] = x0[l];
+      out[4 * l + 1] = x1[l];
+      out[4 * l + 2] = x2[l];
+      out[4 * l + 3] = x3[l];
+   }
+}
+
+uint64_t PhiloxEngine::IntRndm()
+{
+   // each block gives two 64-bit numbers
+   const unsigned int half = fCount % 2;
+   if (half == 0)
+      GenerateBlocks(fCount / 2, 1, fBuffer);
+   ++fCount;
+   return (uint64_t(fBuffer[2 * half + 1]) << 32) | fBuffer[2 * half];
+}
+
+void PhiloxEngine::SetStream(uint32_t stream, uint64_t event)
+{
+   fStream = stream;
+   fEvent = event;
+   fCount = 0;
+}
+
+void PhiloxEngine::Skip(uint64_t n)
+{
+   fCount += n;
+   // the second half of the current block is needed by the next call
+   if (fCount % 2 == 1)
+      GenerateBlocks(fCount / 2, 1, fBuffer);
+}
+
+void PhiloxEngine::RndmArray(size_t n, double *array)
+{
+   size_t i = 0;
+   // finish the current block
+   if (n > 0 && fCount % 2 == 1)
+      array[i++] = (*this)();
+
+   uint32_t words[4 * kLanes];
+   while (n - i >= 2) {
+      const unsigned int nblocks = (n - i) / 2 < kLanes ? (n - i) / 2 : kLanes;
+      GenerateBlocks(fCount / 2, nblocks, words);
+      for (unsigned int j = 0; j < 2 * nblocks; ++j)
+         array[i + j] = ToDouble((uint64_t(words[2 * j + 1]) << 32) | words[2 * j]);
+      i += 2 * nblocks;
+      fCount += 2 * nblocks;
+   }
+
+   if (i < n)
+      array[i] = (*this)();
+}
+
+void PhiloxEngine::GausArray(size_t n, double *array, double mean, double sigma)
+{
+   constexpr double kTwoPi = 6.283185307179586476925286766559;
+   constexpr size_t kChunk = 4 * kLanes;
+   double u[kChunk];
+   for (size_t i = 0; i < n; i += kChunk) {
+      const size_t m = (n - i < kChunk) ? n - i : kChunk;
+      // one pair of uniform numbers for each pair of Gaussian numbers
+      const size_t npairs = (m + 1) / 2;
+      RndmArray(2 * npairs, u);
+      for (size_t j = 0; j < npairs; ++j) {
+         const double r = sigma * std::sqrt(-2. * std::log(u[2 * j]));
+         const double phi = kTwoPi * u[2 * j + 1];
+         u[2 * j] = mean + r * std::cos(phi);
+         u[2 * j + 1] = mean + r * std::sin(phi);
+      }
+      for (size_t j = 0; j < m; ++j)
+         array[i + j] = u[j];
+   }
+}
+
+void PhiloxEngine::ExpArray(size_t n, double *array, double tau)
+{
+   RndmArray(n, array);
+   for (size_t i = 0; i < n; ++i)
+      array[i] = -tau * std::log(array[i]);
+}
+
+} // end namespace Math
+} // end namespace ROOT
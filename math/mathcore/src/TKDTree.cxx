@@ -13,8 +13,16 @@
 #include "TRandom.h"
 
 #include "TString.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
+#include <algorithm>
 #include <cstring>
 #include <limits>
+#include <vector>
 
 templateClassImp(TKDTree);
 
@@ -29,6 +37,7 @@ Contents:
 3. Using TKDTree
    a. Creating the kd-tree and setting the data
    b. Navigating the kd-tree
+   c. Parallel building and bulk queries
 4. TKDTree implementation - technical details
    a. The order of nodes in internal arrays
    b. Division algorithm
@@ -159,6 +168,21 @@ in the 2 subtrees as close as possible. The following section gives more details
     part of the index array. To find the number of point in the node
     (not only terminal), call TKDTree::GetNpointsNode(Index inode).
 
+#### 3c. Parallel building and bulk queries
+
+    With implicit multi-threading enabled (ROOT::EnableImplicitMT()), Build() builds the first rows
+    of large trees node by node in parallel, and then the subtrees below them in parallel. The tree
+    is identical to the one built sequentially.
+
+    FindNearestNeighbors(Index nqueries, const Value *points, Int_t k, Index *ind, Value *dist) and
+    FindInRange(Index nqueries, const Value *points, Value range, std::vector<std::vector<Index>> &res)
+    answer many queries at once, in parallel with implicit multi-threading. The points to query are
+    given row-wise: the coordinates of the i-th point are points[i*ndim], ..., points[i*ndim+ndim-1].
+    The bulk queries keep a copy of the coordinates of the data points, ordered as the terminal nodes,
+    in which the distances to the points of a terminal node are computed in loops vectorized by the
+    compiler. The results are identical to the ones of the single queries, which use this copy as
+    well once it exists.
+
 ### 4.  TKDtree implementation details - internal information, not needed to use the kd-tree.
 
 ####  4a. Order of nodes in the node information arrays:
@@ -285,6 +309,7 @@ TKDTree<Index, Value>::TKDTree() :
    ,fRowT0(0)
    ,fCrossNode(0)
    ,fOffset(0)
+   ,fPointsData(nullptr)
 {
 }
 
@@ -307,6 +332,7 @@ TKDTree<Index, Value>::TKDTree(Index npoints, Index ndim, UInt_t bsize) :
    ,fRowT0(0)
    ,fCrossNode(0)
    ,fOffset(0)
+   ,fPointsData(nullptr)
 {
 // Create the kd-tree of npoints from ndim-dimensional space. Parameter bsize stands for the
 // maximal number of points in the terminal nodes (buckets).
@@ -359,6 +385,7 @@ TKDTree<Index, Value>::TKDTree(Index npoints, Index ndim, UInt_t bsize, Value **
    ,fRowT0(0)
    ,fCrossNode(0)
    ,fOffset(0)
+   ,fPointsData(nullptr)
 {
 
    //Build();
@@ -377,6 +404,7 @@ TKDTree<Index, Value>::~TKDTree()
    if (fIndPoints) delete [] fIndPoints;
    if (fRange) delete [] fRange;
    if (fBoundaries) delete [] fBoundaries;
+   if (fPointsData) delete [] fPointsData;
    if (fData) {
       if (fDataOwner==1){
          //the tree owns all the data
@@ -410,6 +438,11 @@ TKDTree<Index, Value>::~TKDTree()
 template <typename  Index, typename Value>
 void TKDTree<Index, Value>::Build()
 {
+   // the node boundaries and the reordered copy of the coordinates of a previous build are obsolete
+   delete [] fBoundaries;
+   fBoundaries = nullptr;
+   delete [] fPointsData;
+   fPointsData = nullptr;
    //1.
    fNNodes = fNPoints/fBucketSize-1;
    if (fNPoints%fBucketSize) fNNodes++;
@@ -449,71 +482,74 @@ void TKDTree<Index, Value>::Build()
    //
    //
    //4.
+#ifdef R__USE_IMT
+   // With implicit multi-threading, large trees are built row by row, dividing the nodes of a row in
+   // parallel, until there are enough subtrees to build them in parallel. The nodes of different
+   // subtrees and the parts of fIndPoints that they divide are disjoint.
+   const Index kMinParallelPoints = 1 << 16;
+   if (fNPoints >= kMinParallelPoints && ROOT::IsImplicitMTEnabled()) {
+      struct Subtree {
+         Int_t fNode, fRow, fPos, fNPoints;
+      };
+      const size_t nsubtrees = 4 * ROOT::GetThreadPoolSize();
+      std::vector<Subtree> row{{0, 0, 0, fNPoints}};
+      ROOT::TThreadExecutor pool;
+      while (!row.empty() && row.size() < nsubtrees) {
+         std::vector<Int_t> nleft(row.size(), 0), nright(row.size(), 0);
+         pool.Foreach([&](UInt_t i) {
+                         if (row[i].fNPoints > fBucketSize)
+                            DivideNode(row[i].fNode, row[i].fRow, row[i].fPos, row[i].fNPoints, nleft[i], nright[i]);
+                      },
+                      ROOT::TSeqU(row.size()));
+         std::vector<Subtree> next;
+         for (size_t i = 0; i < row.size(); i++) {
+            if (row[i].fNPoints <= fBucketSize)
+               continue; // terminal node
+            next.push_back({2 * row[i].fNode + 1, row[i].fRow + 1, row[i].fPos, nleft[i]});
+            next.push_back({2 * row[i].fNode + 2, row[i].fRow + 1, row[i].fPos + nleft[i], nright[i]});
+         }
+         row.swap(next);
+      }
+      pool.Foreach([&](UInt_t i) { BuildSubtree(row[i].fNode, row[i].fRow, row[i].fPos, row[i].fNPoints); },
+                   ROOT::TSeqU(row.size()));
+      return;
+   }
+#endif
+   BuildSubtree(0, 0, 0, fNPoints);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Non recursive building of the subtree of node `inode`, in row `irow`, dividing the `npoints` points
+/// starting at `pos` in fIndPoints
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::BuildSubtree(Int_t inode, Int_t irow, Int_t pos, Int_t npoints)
+{
    //    stack for non recursive build - size 128 bytes enough
    Int_t rowStack[128];
    Int_t nodeStack[128];
    Int_t npointStack[128];
    Int_t posStack[128];
    Int_t currentIndex = 0;
-   rowStack[0]    = 0;
-   nodeStack[0]   = 0;
-   npointStack[0] = fNPoints;
-   posStack[0]   = 0;
+   rowStack[0]    = irow;
+   nodeStack[0]   = inode;
+   npointStack[0] = npoints;
+   posStack[0]   = pos;
    //
    while (currentIndex>=0){
       //
-      Int_t npoints  = npointStack[currentIndex];
-      if (npoints<=fBucketSize) {
+      Int_t cnpoints = npointStack[currentIndex];
+      if (cnpoints<=fBucketSize) {
          currentIndex--;
          continue; // terminal node
       }
       Int_t crow     = rowStack[currentIndex];
       Int_t cpos     = posStack[currentIndex];
       Int_t cnode    = nodeStack[currentIndex];
-      //printf("currentIndex %d npoints %d node %d\n", currentIndex, npoints, cnode);
+      //printf("currentIndex %d npoints %d node %d\n", currentIndex, cnpoints, cnode);
       //
-      // divide points
-      Int_t nbuckets0 = npoints/fBucketSize;           //current number of  buckets
-      if (npoints%fBucketSize) nbuckets0++;            //
-      Int_t restRows = fRowT0-rowStack[currentIndex];  // rest of fully occupied node row
-      if (restRows<0) restRows =0;
-      for (;nbuckets0>(2<<restRows); restRows++) {}
-      Int_t nfull = 1<<restRows;
-      Int_t nrest = nbuckets0-nfull;
       Int_t nleft =0, nright =0;
-      //
-      if (nrest>(nfull/2)){
-         nleft  = nfull*fBucketSize;
-         nright = npoints-nleft;
-      }else{
-         nright = nfull*fBucketSize/2;
-         nleft  = npoints-nright;
-      }
-
-      //
-      //find the axis with biggest spread
-      Value maxspread=0;
-      Value tempspread, min, max;
-      Index axspread=0;
-      Value *array;
-      for (Int_t idim=0; idim<fNDim; idim++){
-         array = fData[idim];
-         Spread(npoints, array, fIndPoints+cpos, min, max);
-         tempspread = max - min;
-         if (maxspread < tempspread) {
-            maxspread=tempspread;
-            axspread = idim;
-         }
-         if(cnode) continue;
-         //printf("set %d %6.3f %6.3f\n", idim, min, max);
-         fRange[2*idim] = min; fRange[2*idim+1] = max;
-      }
-      array = fData[axspread];
-      KOrdStat(npoints, array, nleft, fIndPoints+cpos);
-      fAxis[cnode]  = axspread;
-      fValue[cnode] = array[fIndPoints[cpos+nleft]];
-      //printf("Set node %d : ax %d val %f\n", cnode, node->fAxis, node->fValue);
-      //
+      DivideNode(cnode, crow, cpos, cnpoints, nleft, nright);
       //
       npointStack[currentIndex] = nleft;
       rowStack[currentIndex]    = crow+1;
@@ -527,13 +563,63 @@ void TKDTree<Index, Value>::Build()
       //
       if (false){
          // consistency check
-         Info("Build()", "%s", Form("points %d left %d right %d", npoints, nleft, nright));
+         Info("Build()", "%s", Form("points %d left %d right %d", cnpoints, nleft, nright));
          if (nleft<nright) Warning("Build", "Problem Left-Right");
          if (nleft<0 || nright<0) Warning("Build()", "Problem Negative number");
       }
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Divide the `npoints` points starting at `cpos` in fIndPoints of node `cnode`, in row `crow`,
+/// in the `nleft` points of the left child node and the `nright` points of the right one.
+/// The cut is made on the axis with the biggest spread.
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::DivideNode(Int_t cnode, Int_t crow, Int_t cpos, Int_t npoints, Int_t &nleft, Int_t &nright)
+{
+   // divide points
+   Int_t nbuckets0 = npoints/fBucketSize;           //current number of  buckets
+   if (npoints%fBucketSize) nbuckets0++;            //
+   Int_t restRows = fRowT0-crow;                    // rest of fully occupied node row
+   if (restRows<0) restRows =0;
+   for (;nbuckets0>(2<<restRows); restRows++) {}
+   Int_t nfull = 1<<restRows;
+   Int_t nrest = nbuckets0-nfull;
+   //
+   if (nrest>(nfull/2)){
+      nleft  = nfull*fBucketSize;
+      nright = npoints-nleft;
+   }else{
+      nright = nfull*fBucketSize/2;
+      nleft  = npoints-nright;
+   }
+
+   //
+   //find the axis with biggest spread
+   Value maxspread=0;
+   Value tempspread, min, max;
+   Index axspread=0;
+   Value *array;
+   for (Int_t idim=0; idim<fNDim; idim++){
+      array = fData[idim];
+      Spread(npoints, array, fIndPoints+cpos, min, max);
+      tempspread = max - min;
+      if (maxspread < tempspread) {
+         maxspread=tempspread;
+         axspread = idim;
+      }
+      if(cnode) continue;
+      //printf("set %d %6.3f %6.3f\n", idim, min, max);
+      fRange[2*idim] = min; fRange[2*idim+1] = max;
+   }
+   array = fData[axspread];
+   KOrdStat(npoints, array, nleft, fIndPoints+cpos);
+   fAxis[cnode]  = axspread;
+   fValue[cnode] = array[fIndPoints[cpos+nleft]];
+   //printf("Set node %d : ax %d val %f\n", cnode, node->fAxis, node->fValue);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///Find kNN nearest neighbors to the point in the first argument
 ///Returns 1 on success, 0 on failure
@@ -556,6 +642,36 @@ void TKDTree<Index, Value>::FindNearestNeighbors(const Value *point, const Int_t
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///Find the kNN nearest neighbors of each of the nqueries points, in parallel with implicit multi-threading.
+///The coordinates of the i-th point are points[i*ndim], ..., points[i*ndim+ndim-1], and its neighbors
+///are returned in ind[i*kNN], ..., ind[i*kNN+kNN-1] and their distances in dist[i*kNN], ..., dist[i*kNN+kNN-1].
+///Arrays ind and dist are provided by the user and are assumed to be at least nqueries*kNN elements long
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::FindNearestNeighbors(Index nqueries, const Value *points, Int_t kNN, Index *ind, Value *dist)
+{
+   if (!ind || !dist) {
+      Error("FindNearestNeighbors", "Working arrays must be allocated by the user!");
+      return;
+   }
+   MakeBoundariesExact();
+   MakePointsData();
+
+   auto findRange = [&](Index first, Index last) {
+      for (Index iquery=first; iquery<last; iquery++){
+         Index *indq = ind + (Long64_t)iquery*kNN;
+         Value *distq = dist + (Long64_t)iquery*kNN;
+         for (Int_t i=0; i<kNN; i++){
+            distq[i]=std::numeric_limits<Value>::max();
+            indq[i]=-1;
+         }
+         UpdateNearestNeighbors(0, points + (Long64_t)iquery*fNDim, kNN, indq, distq);
+      }
+   };
+   ForeachQueryRange(nqueries, findRange);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///Update the nearest neighbors values by examining the node inode
 
@@ -570,24 +686,29 @@ void TKDTree<Index, Value>::UpdateNearestNeighbors(Index inode, const Value *poi
       return;
    }
    if (IsTerminal(inode)) {
-      //examine points one by one
+      //examine points one by one, computing their distances by blocks
       Index f1, l1, f2, l2;
       GetNodePointsIndexes(inode, f1, l1, f2, l2);
-      for (Int_t ipoint=f1; ipoint<=l1; ipoint++){
-         Double_t d = Distance(point, fIndPoints[ipoint]);
-         if (d<dist[kNN-1]){
-            //found a closer point
-            Int_t ishift=0;
-            while(ishift<kNN && d>dist[ishift])
-               ishift++;
-            //replace the neighbor #ishift with the found point
-            //and shift the rest 1 index value to the right
-            for (Int_t i=kNN-1; i>ishift; i--){
-               dist[i]=dist[i-1];
-               ind[i]=ind[i-1];
+      Double_t dists[kDistBlock];
+      for (Int_t first=f1; first<=l1; first+=kDistBlock){
+         const Int_t last = std::min(first+kDistBlock-1, l1);
+         Distances(point, first, last, dists);
+         for (Int_t ipoint=first; ipoint<=last; ipoint++){
+            Double_t d = dists[ipoint-first];
+            if (d<dist[kNN-1]){
+               //found a closer point
+               Int_t ishift=0;
+               while(ishift<kNN && d>dist[ishift])
+                  ishift++;
+               //replace the neighbor #ishift with the found point
+               //and shift the rest 1 index value to the right
+               for (Int_t i=kNN-1; i>ishift; i--){
+                  dist[i]=dist[i-1];
+                  ind[i]=ind[i-1];
+               }
+               dist[ishift]=d;
+               ind[ishift]=fIndPoints[ipoint];
             }
-            dist[ishift]=d;
-            ind[ishift]=fIndPoints[ipoint];
          }
       }
       return;
@@ -626,6 +747,32 @@ Double_t TKDTree<Index, Value>::Distance(const Value *point, Index ind, Int_t ty
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///Compute the L2 distances between point and the points at positions first, ..., last of the
+///index array, in dist[0], ..., dist[last-first]. With the copy of the coordinates made for the
+///bulk queries, the loops on the points are vectorized by the compiler.
+
+template <typename Index, typename Value>
+void TKDTree<Index, Value>::Distances(const Value *point, Index first, Index last, Double_t *dist) const
+{
+   const Index n = last-first+1;
+   if (!fPointsData) {
+      for (Index i=0; i<n; i++)
+         dist[i] = Distance(point, fIndPoints[first+i]);
+      return;
+   }
+   for (Index i=0; i<n; i++)
+      dist[i] = 0;
+   for (Index idim=0; idim<fNDim; idim++){
+      const Value *x = fPointsData + (Long64_t)idim*fNPoints + first;
+      const Value p = point[idim];
+      for (Index i=0; i<n; i++)
+         dist[i] += (p-x[i])*(p-x[i]);
+   }
+   for (Index i=0; i<n; i++)
+      dist[i] = TMath::Sqrt(dist[i]);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///Find the minimal and maximal distance from a given point to a given node.
 ///Type argument specifies the metric: type=2 - L2 metric, type=1 - L1 metric
@@ -752,11 +899,52 @@ void TKDTree<Index, Value>::FindInRange(Value * point, Value range, std::vector<
    UpdateRange(0, point, range, res);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///Find all points in the sphere of a given radius "range" around each of the nqueries points,
+///in parallel with implicit multi-threading.
+///The coordinates of the i-th point are points[i*ndim], ..., points[i*ndim+ndim-1], and the points
+///in its sphere are added to res[i]. res is resized to nqueries elements.
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::FindInRange(Index nqueries, const Value *points, Value range, std::vector<std::vector<Index>> &res)
+{
+   MakeBoundariesExact();
+   MakePointsData();
+   res.resize(nqueries);
+
+   auto findRange = [&](Index first, Index last) {
+      for (Index iquery=first; iquery<last; iquery++)
+         UpdateRange(0, points + (Long64_t)iquery*fNDim, range, res[iquery]);
+   };
+   ForeachQueryRange(nqueries, findRange);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///Call func(first, last) on ranges of the nqueries queries, in parallel with implicit multi-threading
+
+template <typename  Index, typename Value>
+template <class F>
+void TKDTree<Index, Value>::ForeachQueryRange(Index nqueries, F &&func) const
+{
+#ifdef R__USE_IMT
+   const Index kMinQueriesRange = 64;
+   if (nqueries >= 2*kMinQueriesRange && ROOT::IsImplicitMTEnabled()) {
+      const Index nranges = std::min<Long64_t>(nqueries/kMinQueriesRange, 8 * (Long64_t)ROOT::GetThreadPoolSize());
+      const Index rangeSize = (nqueries + nranges - 1) / nranges;
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](UInt_t r) { func(r*rangeSize, std::min<Index>(nqueries, (r+1)*rangeSize)); },
+                   ROOT::TSeqU(nranges));
+      return;
+   }
+#endif
+   func(0, nqueries);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///Internal recursive function with the implementation of range searches
 
 template <typename  Index, typename Value>
-void TKDTree<Index, Value>::UpdateRange(Index inode, Value* point, Value range, std::vector<Index> &res)
+void TKDTree<Index, Value>::UpdateRange(Index inode, const Value* point, Value range, std::vector<Index> &res)
 {
    Value min, max;
    DistanceToNode(point, inode, min, max);
@@ -781,14 +969,17 @@ void TKDTree<Index, Value>::UpdateRange(Index inode, Value* point, Value range,
 
    //this node intersects with the range
    if (IsTerminal(inode)){
-      //examine the points one by one
+      //examine the points one by one, computing their distances by blocks
       Index f1, l1, f2, l2;
-      Double_t d;
+      Double_t dists[kDistBlock];
       GetNodePointsIndexes(inode, f1, l1, f2, l2);
-      for (Int_t ipoint=f1; ipoint<=l1; ipoint++){
-         d = Distance(point, fIndPoints[ipoint]);
-         if (d <= range){
-            res.push_back(fIndPoints[ipoint]);
+      for (Int_t first=f1; first<=l1; first+=kDistBlock){
+         const Int_t last = std::min(first+kDistBlock-1, l1);
+         Distances(point, first, last, dists);
+         for (Int_t ipoint=first; ipoint<=last; ipoint++){
+            if (dists[ipoint-first] <= range){
+               res.push_back(fIndPoints[ipoint]);
+            }
          }
       }
       return;
@@ -1164,6 +1355,26 @@ void TKDTree<Index, Value>::MakeBoundariesExact()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the coordinates of the points in the order of the index array, one row of fNPoints values per
+/// dimension, so that the points of a terminal node are contiguous. Used by the bulk queries, and by
+/// all the queries once it exists.
+
+template <typename Index, typename Value>
+void TKDTree<Index, Value>::MakePointsData()
+{
+   if (fPointsData) {
+      //the copy was already made for this tree
+      return;
+   }
+   fPointsData = new Value[(Long64_t)fNDim*fNPoints];
+   for (Index idim=0; idim<fNDim; idim++){
+      Value *x = fPointsData + (Long64_t)idim*fNPoints;
+      for (Index ipoint=0; ipoint<fNPoints; ipoint++)
+         x[ipoint] = fData[idim][fIndPoints[ipoint]];
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// find the smallest node covering the full range - start
@@ -0,0 +1,127 @@
+#include "Math/PhiloxEngine.h"
+#include "TRandomGen.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace ROOT::Math;
+
+// Known-answer tests of the Random123 library for philox4x32 with 10 rounds
+TEST(PhiloxEngine, KnownAnswers)
+{
+   const uint32_t ctrs[3][4] = {{0, 0, 0, 0},
+                                {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                                {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}};
+   const uint32_t keys[3][2] = {{0, 0}, {0xffffffff, 0xffffffff}, {0xa4093822, 0x299f31d0}};
+   const uint32_t expected[3][4] = {{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+                                    {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+                                    {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}};
+   for (int i = 0; i < 3; ++i) {
+      uint32_t out[4];
+      PhiloxEngine::Philox(ctrs[i], keys[i], out);
+      for (int j = 0; j < 4; ++j)
+         EXPECT_EQ(out[j], expected[i][j]) << "vector " << i << " word " << j;
+   }
+}
+
+TEST(PhiloxEngine, ArrayAndSkip)
+{
+   PhiloxEngine reference(42);
+   std::vector<double> values(1000);
+   for (auto &v : values)
+      v = reference.Rndm();
+
+   // bulk generation gives the same numbers, whatever the sizes of the arrays
+   PhiloxEngine rng(42);
+   std::vector<double> array(1000);
+   size_t offset = 0;
+   for (size_t n : {1, 2, 3, 31, 64, 65, 100, 1, 733}) {
+      rng.RndmArray(n, array.data() + offset);
+      offset += n;
+   }
+   ASSERT_EQ(offset, values.size());
+   for (size_t i = 0; i < values.size(); ++i)
+      EXPECT_EQ(array[i], values[i]) << "number " << i;
+
+   // skipping
+   for (uint64_t skip : {0, 1, 2, 17, 500}) {
+      PhiloxEngine skipped(42);
+      skipped.Rndm();
+      skipped.Skip(skip);
+      EXPECT_EQ(skipped.Rndm(), values[1 + skip]);
+   }
+
+   for (double v : values) {
+      EXPECT_GT(v, 0.);
+      EXPECT_LT(v, 1.);
+   }
+}
+
+TEST(PhiloxEngine, OpenInterval)
+{
+   EXPECT_GT(PhiloxEngine::ToDouble(0), 0.);
+   EXPECT_LT(PhiloxEngine::ToDouble(UINT64_MAX), 1.);
+   EXPECT_LT(PhiloxEngine::ToDouble(UINT64_MAX - 1), 1.);
+}
+
+TEST(PhiloxEngine, Streams)
+{
+   PhiloxEngine rng(42, 3, 1000);
+   PhiloxEngine rng2(42);
+   rng2.Rndm();
+   rng2.SetStream(3, 1000);
+   EXPECT_EQ(rng.GetStream(), 3u);
+   EXPECT_EQ(rng.GetEvent(), 1000u);
+   for (int i = 0; i < 10; ++i)
+      EXPECT_EQ(rng.IntRndm(), rng2.IntRndm());
+
+   // different streams, events and seeds give different numbers
+   const double first = PhiloxEngine(42, 3, 1000).Rndm();
+   EXPECT_NE(PhiloxEngine(42, 4, 1000).Rndm(), first);
+   EXPECT_NE(PhiloxEngine(42, 3, 1001).Rndm(), first);
+   EXPECT_NE(PhiloxEngine(43, 3, 1000).Rndm(), first);
+
+   // the sub-sequence continues in the next event after 2^33 numbers
+   PhiloxEngine last(42, 3, 1000);
+   last.Skip(uint64_t(1) << 33);
+   EXPECT_EQ(last.Rndm(), PhiloxEngine(42, 3, 1001).Rndm());
+}
+
+TEST(PhiloxEngine, Distributions)
+{
+   const size_t n = 1000001;
+   std::vector<double> x(n);
+   PhiloxEngine rng(1234);
+
+   rng.GausArray(n, x.data(), 1., 2.);
+   double sum = 0, sum2 = 0;
+   for (double v : x) {
+      sum += v;
+      sum2 += v * v;
+   }
+   const double mean = sum / n;
+   EXPECT_NEAR(mean, 1., 5 * 2. / std::sqrt(n));
+   EXPECT_NEAR(std::sqrt(sum2 / n - mean * mean), 2., 5 * 2. / std::sqrt(2. * n));
+
+   rng.ExpArray(n, x.data(), 3.);
+   sum = 0;
+   for (double v : x) {
+      EXPECT_GT(v, 0.);
+      sum += v;
+   }
+   EXPECT_NEAR(sum / n, 3., 5 * 3. / std::sqrt(n));
+}
+
+TEST(PhiloxEngine, TRandomPhilox)
+{
+   TRandomPhilox rng(42);
+   ROOT::Math::PhiloxEngine engine(42);
+   std::vector<double> array(100);
+   rng.RndmArray(array.size(), array.data());
+   for (double v : array)
+      EXPECT_EQ(v, engine.Rndm());
+   EXPECT_EQ(rng.Rndm(), engine.Rndm());
+}
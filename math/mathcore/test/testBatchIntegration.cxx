@@ -0,0 +1,148 @@
+// Tests of the evaluation of the integrand on many points at once (EvalBatch) in the numerical integrators:
+// the results must be identical to the ones obtained evaluating the points one by one
+
+#include "Math/Functor.h"
+#include "Math/IFunction.h"
+#include "Math/GaussIntegrator.h"
+#include "Math/GaussLegendreIntegrator.h"
+#include "Math/AdaptiveIntegratorMultiDim.h"
+
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#endif
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cmath>
+
+namespace {
+
+double Func1D(double x)
+{
+   return std::exp(-x * x) * std::cos(3 * x);
+}
+
+double FuncND(const double *x)
+{
+   double s = 0;
+   for (int i = 0; i < 4; ++i)
+      s += x[i] * x[i];
+   return std::exp(-s) * std::sin(x[0] + 2 * x[1]);
+}
+
+// one-dimensional integrand counting the points evaluated one by one and at once
+class BatchFunc1D : public ROOT::Math::IBaseFunctionOneDim {
+public:
+   ROOT::Math::IBaseFunctionOneDim *Clone() const override { return new BatchFunc1D(); }
+   bool HasBatchEvaluation() const override { return true; }
+
+   mutable std::atomic<int> fNScalar{0};
+   mutable std::atomic<int> fNBatch{0};
+
+private:
+   double DoEval(double x) const override
+   {
+      ++fNScalar;
+      return Func1D(x);
+   }
+   void DoEvalBatch(unsigned int n, const double *x, double *f) const override
+   {
+      fNBatch += n;
+      for (unsigned int i = 0; i < n; ++i)
+         f[i] = Func1D(x[i]);
+   }
+};
+
+// multi-dimensional integrand counting the points evaluated one by one and at once
+class BatchFuncND : public ROOT::Math::IBaseFunctionMultiDim {
+public:
+   ROOT::Math::IBaseFunctionMultiDim *Clone() const override { return new BatchFuncND(); }
+   unsigned int NDim() const override { return 4; }
+   bool HasBatchEvaluation() const override { return true; }
+
+   mutable std::atomic<int> fNScalar{0};
+   mutable std::atomic<int> fNBatch{0};
+
+private:
+   double DoEval(const double *x) const override
+   {
+      ++fNScalar;
+      return FuncND(x);
+   }
+   void DoEvalBatch(unsigned int n, const double *const *x, double *f) const override
+   {
+      fNBatch += n;
+      for (unsigned int i = 0; i < n; ++i) {
+         const double xi[4] = {x[0][i], x[1][i], x[2][i], x[3][i]};
+         f[i] = FuncND(xi);
+      }
+   }
+};
+
+} // namespace
+
+TEST(BatchIntegration, GaussIntegrator)
+{
+   ROOT::Math::Functor1D scalar(&Func1D);
+   BatchFunc1D batch;
+
+   ROOT::Math::GaussIntegrator ig1(1.E-12, 1.E-12);
+   ROOT::Math::GaussIntegrator ig2(1.E-12, 1.E-12);
+   ig1.SetFunction(scalar);
+   ig2.SetFunction(batch);
+   EXPECT_EQ(ig1.Integral(-2., 3.), ig2.Integral(-2., 3.));
+   // infinite and semi-infinite intervals
+   EXPECT_EQ(ig1.Integral(), ig2.Integral());
+   EXPECT_EQ(ig1.IntegralUp(0.5), ig2.IntegralUp(0.5));
+   EXPECT_EQ(ig1.IntegralLow(0.5), ig2.IntegralLow(0.5));
+   EXPECT_NEAR(ig2.Integral(), std::sqrt(M_PI) * std::exp(-9. / 4), 1.E-10);
+
+   EXPECT_EQ(batch.fNScalar, 0);
+   EXPECT_GT(batch.fNBatch, 0);
+}
+
+TEST(BatchIntegration, GaussLegendreIntegrator)
+{
+   ROOT::Math::Functor1D scalar(&Func1D);
+   BatchFunc1D batch;
+
+   ROOT::Math::GaussLegendreIntegrator ig1(40);
+   ROOT::Math::GaussLegendreIntegrator ig2(40);
+   ig1.SetFunction(scalar);
+   ig2.SetFunction(batch);
+   EXPECT_EQ(ig1.Integral(-2., 3.), ig2.Integral(-2., 3.));
+
+   EXPECT_EQ(batch.fNScalar, 0);
+   EXPECT_EQ(batch.fNBatch, 40);
+}
+
+TEST(BatchIntegration, AdaptiveIntegratorMultiDim)
+{
+   ROOT::Math::Functor scalar(&FuncND, 4);
+   BatchFuncND batch;
+   const double xmin[4] = {-1., -1., -1., -1.};
+   const double xmax[4] = {1., 2., 1., 1.5};
+
+   ROOT::Math::AdaptiveIntegratorMultiDim ig1(0., 1.E-8, 100000);
+   ROOT::Math::AdaptiveIntegratorMultiDim ig2(0., 1.E-8, 100000);
+   ig1.SetFunction(scalar);
+   ig2.SetFunction(batch);
+   const double result = ig1.Integral(xmin, xmax);
+   EXPECT_EQ(result, ig2.Integral(xmin, xmax));
+   EXPECT_EQ(ig1.Error(), ig2.Error());
+   EXPECT_EQ(ig1.NEval(), ig2.NEval());
+
+   EXPECT_EQ(batch.fNScalar, 0);
+   EXPECT_EQ(batch.fNBatch, ig2.NEval());
+
+#ifdef R__USE_IMT
+   // the nodes of each region are evaluated in parallel, with the same result
+   ROOT::EnableImplicitMT(4);
+   ig1.SetExecutionPolicy(ROOT::EExecutionPolicy::kMultiThread);
+   ig2.SetExecutionPolicy(ROOT::EExecutionPolicy::kMultiThread);
+   EXPECT_EQ(result, ig1.Integral(xmin, xmax));
+   EXPECT_EQ(result, ig2.Integral(xmin, xmax));
+   ROOT::DisableImplicitMT();
+#endif
+}
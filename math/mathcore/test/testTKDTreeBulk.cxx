@@ -0,0 +1,155 @@
+// Tests of the bulk queries and of the parallel building of TKDTree: the results must be identical
+// to the ones of the single queries and of the sequential building
+
+#include "TKDTree.h"
+#include "TRandom3.h"
+
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#endif
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// points stored columnwise, as expected by TKDTree
+struct Data {
+   std::vector<std::vector<Double_t>> fColumns;
+   std::vector<Double_t *> fPointers;
+   Data(Int_t npoints, Int_t ndim, UInt_t seed = 4357)
+      : fColumns(ndim, std::vector<Double_t>(npoints)), fPointers(ndim)
+   {
+      TRandom3 rndm(seed);
+      for (Int_t idim = 0; idim < ndim; ++idim) {
+         for (auto &x : fColumns[idim])
+            x = rndm.Gaus();
+         fPointers[idim] = fColumns[idim].data();
+      }
+   }
+};
+
+std::vector<Double_t> Queries(Int_t nqueries, Int_t ndim)
+{
+   TRandom3 rndm(65539);
+   std::vector<Double_t> points(nqueries * ndim);
+   for (auto &x : points)
+      x = rndm.Gaus();
+   return points;
+}
+
+} // namespace
+
+TEST(TKDTreeBulk, NearestNeighbors)
+{
+   const Int_t npoints = 20000, ndim = 3, nqueries = 1000, k = 7;
+   Data data(npoints, ndim);
+   const auto points = Queries(nqueries, ndim);
+
+   TKDTreeID tree(npoints, ndim, 13, data.fPointers.data());
+   tree.Build();
+
+   std::vector<Int_t> ind1(nqueries * k), ind2(nqueries * k);
+   std::vector<Double_t> dist1(nqueries * k), dist2(nqueries * k);
+   for (Int_t i = 0; i < nqueries; ++i)
+      tree.FindNearestNeighbors(&points[i * ndim], k, &ind1[i * k], &dist1[i * k]);
+   tree.FindNearestNeighbors(nqueries, points.data(), k, ind2.data(), dist2.data());
+   EXPECT_EQ(ind1, ind2);
+   EXPECT_EQ(dist1, dist2);
+
+   // the nearest neighbors by brute force
+   for (Int_t i = 0; i < 10; ++i) {
+      std::vector<Double_t> d(npoints);
+      for (Int_t j = 0; j < npoints; ++j)
+         d[j] = tree.Distance(&points[i * ndim], j);
+      std::vector<Double_t> sorted(d);
+      std::sort(sorted.begin(), sorted.end());
+      for (Int_t l = 0; l < k; ++l) {
+         EXPECT_EQ(dist2[i * k + l], sorted[l]);
+         EXPECT_EQ(d[ind2[i * k + l]], sorted[l]);
+      }
+   }
+
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+   std::vector<Int_t> ind3(nqueries * k);
+   std::vector<Double_t> dist3(nqueries * k);
+   tree.FindNearestNeighbors(nqueries, points.data(), k, ind3.data(), dist3.data());
+   ROOT::DisableImplicitMT();
+   EXPECT_EQ(ind1, ind3);
+   EXPECT_EQ(dist1, dist3);
+#endif
+}
+
+TEST(TKDTreeBulk, InRange)
+{
+   const Int_t npoints = 20000, ndim = 2, nqueries = 500;
+   const Double_t range = 0.1;
+   Data data(npoints, ndim);
+   auto points = Queries(nqueries, ndim);
+
+   TKDTreeID tree(npoints, ndim, 10, data.fPointers.data());
+   tree.Build();
+
+   std::vector<std::vector<Int_t>> res;
+   tree.FindInRange(nqueries, points.data(), range, res);
+   ASSERT_EQ(res.size(), (size_t)nqueries);
+   for (Int_t i = 0; i < nqueries; ++i) {
+      std::vector<Int_t> res1;
+      tree.FindInRange(&points[i * ndim], range, res1);
+      EXPECT_EQ(res1, res[i]);
+      Int_t nin = 0;
+      for (Int_t j = 0; j < npoints; ++j)
+         nin += (tree.Distance(&points[i * ndim], j) <= range);
+      EXPECT_EQ((Int_t)res[i].size(), nin);
+   }
+}
+
+// the queries after new data are set must not use the coordinates of the previous build
+TEST(TKDTreeBulk, SetDataAfterBulkQuery)
+{
+   const Int_t ndim = 2, nqueries = 100, k = 3;
+   const auto points = Queries(nqueries, ndim);
+   Data data1(1000, ndim), data2(5000, ndim, 12345);
+
+   TKDTreeID tree(1000, ndim, 10, data1.fPointers.data());
+   tree.Build();
+   std::vector<Int_t> ind(nqueries * k);
+   std::vector<Double_t> dist(nqueries * k);
+   tree.FindNearestNeighbors(nqueries, points.data(), k, ind.data(), dist.data());
+
+   tree.SetData(5000, ndim, 10, data2.fPointers.data());
+   tree.FindNearestNeighbors(nqueries, points.data(), k, ind.data(), dist.data());
+   for (Int_t i = 0; i < nqueries; ++i) {
+      std::vector<Double_t> d(5000);
+      for (Int_t j = 0; j < 5000; ++j)
+         d[j] = tree.Distance(&points[i * ndim], j);
+      std::sort(d.begin(), d.end());
+      for (Int_t l = 0; l < k; ++l)
+         EXPECT_EQ(dist[i * k + l], d[l]);
+   }
+}
+
+#ifdef R__USE_IMT
+TEST(TKDTreeBulk, ParallelBuild)
+{
+   const Int_t npoints = 200000, ndim = 4;
+   Data data(npoints, ndim);
+
+   TKDTreeID tree1(npoints, ndim, 8, data.fPointers.data());
+   tree1.Build();
+   ROOT::EnableImplicitMT(4);
+   TKDTreeID tree2(npoints, ndim, 8, data.fPointers.data());
+   tree2.Build();
+   ROOT::DisableImplicitMT();
+
+   ASSERT_EQ(tree1.GetNNodes(), tree2.GetNNodes());
+   for (Int_t inode = 0; inode < tree1.GetNNodes(); ++inode) {
+      EXPECT_EQ(tree1.GetNodeAxis(inode), tree2.GetNodeAxis(inode));
+      EXPECT_EQ(tree1.GetNodeValue(inode), tree2.GetNodeValue(inode));
+   }
+   EXPECT_TRUE(std::equal(tree1.GetIndPoints(), tree1.GetIndPoints() + npoints, tree2.GetIndPoints()));
+}
+#endif
@@ -11,9 +11,92 @@
 
 #include "TDecompSparse.h"
 #include "TMath.h"
+#include "TMatrixTParallel.h"
+
+#include <vector>
 
 ClassImp(TDecompSparse);
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Update of the frontal matrix after the elimination of a 1x1 pivot .
+/// a[posfac] is the inverse of the pivot, followed by the m other elements of
+/// its row and by the m rows of the remaining triangle of the front, in packed
+/// storage. The rows are updated in parallel for large fronts, see
+/// TMatrixTParallel.
+
+void UpdateFront1x1(Double_t *a,Int_t posfac,Int_t m)
+{
+   if (m <= 0) return;
+
+   const Double_t  dinv = a[posfac];
+         Double_t *piv  = a+posfac+1;
+         Double_t *rows = piv+m;
+
+   // number of updated elements in the rows [0,irow)
+   std::vector<Long64_t> cumWork(m+1);
+   for (Int_t irow = 0; irow <= m; irow++)
+      cumWork[irow] = Long64_t(irow)*m-Long64_t(irow)*(irow-1)/2;
+
+   // the multipliers are only stored at the end, since all the rows read the pivot row
+   const Int_t nranges = TMatrixTParallel::GetNRanges(cumWork[m]);
+   const std::vector<Int_t> bounds = TMatrixTParallel::SplitRanges(m,cumWork.data(),nranges);
+   TMatrixTParallel::Foreach(nranges,[&](Int_t irange) {
+      for (Int_t irow = bounds[irange]; irow < bounds[irange+1]; irow++) {
+         const Double_t amult = -piv[irow]*dinv;
+         Double_t *row = rows+cumWork[irow];
+         for (Int_t k = 0; k < m-irow; k++)
+            row[k] = row[k]+amult*piv[irow+k];
+      }
+   });
+   for (Int_t irow = 0; irow < m; irow++)
+      piv[irow] = -piv[irow]*dinv;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Update of the frontal matrix after the elimination of a 2x2 pivot .
+/// a[pospv1], a[pospv1+1], a[pospv2] is the inverse of the pivot, with the
+/// m other elements of its first row after a[pospv1+1] and the m other elements
+/// of its second row after a[pospv2], followed by the m rows of the remaining
+/// triangle of the front, in packed storage.
+
+void UpdateFront2x2(Double_t *a,Int_t pospv1,Int_t pospv2,Int_t m)
+{
+   if (m <= 0) return;
+
+   const Double_t  d11  = a[pospv1];
+   const Double_t  d12  = a[pospv1+1];
+   const Double_t  d22  = a[pospv2];
+         Double_t *piv1 = a+pospv1+2;
+         Double_t *piv2 = a+pospv2+1;
+         Double_t *rows = piv2+m;
+
+   std::vector<Long64_t> cumWork(m+1);
+   for (Int_t irow = 0; irow <= m; irow++)
+      cumWork[irow] = Long64_t(irow)*m-Long64_t(irow)*(irow-1)/2;
+
+   const Int_t nranges = TMatrixTParallel::GetNRanges(2*cumWork[m]);
+   const std::vector<Int_t> bounds = TMatrixTParallel::SplitRanges(m,cumWork.data(),nranges);
+   TMatrixTParallel::Foreach(nranges,[&](Int_t irange) {
+      for (Int_t irow = bounds[irange]; irow < bounds[irange+1]; irow++) {
+         const Double_t amult1 = -(d11*piv1[irow]+d12*piv2[irow]);
+         const Double_t amult2 = -(d12*piv1[irow]+d22*piv2[irow]);
+         Double_t *row = rows+cumWork[irow];
+         for (Int_t k = 0; k < m-irow; k++)
+            row[k] = row[k]+amult1*piv1[irow+k]+amult2*piv2[irow+k];
+      }
+   });
+   for (Int_t irow = 0; irow < m; irow++) {
+      const Double_t amult1 = -(d11*piv1[irow]+d12*piv2[irow]);
+      const Double_t amult2 = -(d12*piv1[irow]+d22*piv2[irow]);
+      piv1[irow] = amult1;
+      piv2[irow] = amult2;
+   }
+}
+
+} // namespace
+
 /** \class TDecompSparse
     \ingroup Matrix
 
@@ -1885,12 +1968,12 @@ void TDecompSparse::Factor_sub2(const Int_t n,const Int_t nz,Double_t *a,const I
                                 const Int_t nsteps,Int_t &maxfrt,Int_t *nelim,Int_t *iw2,
                                 Int_t *icntl,Double_t *cntl,Int_t *info)
 {
-   Double_t amax,amult,amult1,amult2,detpiv,rmax,swop,thresh,tmax,uu;
+   Double_t amax,detpiv,rmax,swop,thresh,tmax,uu;
    Int_t ainput,apos,apos1,apos2,apos3,astk,astk2,azero,i,iass;
-   Int_t ibeg,idummy,iell,iend,iexch,ifr,iinput,ioldps,iorg,ipiv;
+   Int_t idummy,iell,iexch,ifr,iinput,ioldps,iorg,ipiv;
    Int_t ipmnp,ipos,irow,isnpiv,istk,istk2,iswop,iwpos,j,j1;
-   Int_t j2,jcol,jdummy,jfirst,jj,jj1,jjj,jlast,jmax,jmxmip,jnew;
-   Int_t jnext,jpiv,jpos,k,k1,k2,kdummy,kk,kmax,krow,laell,lapos2;
+   Int_t j2,jdummy,jfirst,jj,jjj,jlast,jmax,jmxmip,jnew;
+   Int_t jnext,jpiv,jpos,k,kdummy,kk,kmax,krow,laell,lapos2;
    Int_t liell,lnass,lnpiv,lt,ltopst,nass,nblk,newel,nfront,npiv;
    Int_t npivp1,ntotpv,numass,numorg,numstk,pivsiz,posfac,pospv1,pospv2;
    Int_t ntwo,neig,ncmpbi,ncmpbr,nrlbdu,nirbdu;
@@ -2256,21 +2339,7 @@ void TDecompSparse::Factor_sub2(const Int_t n,const Int_t nz,Double_t *a,const I
 hack:
                a[posfac] = one/a[posfac];
                if (a[posfac] < zero) neig = neig+1;
-               j1 = posfac+1;
-               j2 = posfac+nfront-(npiv+1);
-               if (j2 >= j1) {
-                  ibeg = j2+1;
-                  for (jj = j1; jj < j2+1; jj++) {
-                     amult = -a[jj]*a[posfac];
-                     iend = ibeg+nfront-(npiv+jj-j1+2);
-                     for (irow = ibeg; irow < iend+1; irow++) {
-                        jcol = jj+irow-ibeg;
-                        a[irow] = a[irow]+amult*a[jcol];
-                     }
-                     ibeg = iend+1;
-                     a[jj] = amult;
-                  }
-               }
+               UpdateFront1x1(a,posfac,nfront-(npiv+1));
                npiv = npiv+1;
                ntotpv = ntotpv+1;
                jpiv = 1;
@@ -2287,26 +2356,7 @@ hack:
                a[pospv2] = a[pospv1]/detpiv;
                a[pospv1] = swop/detpiv;
                a[pospv1+1] = -a[pospv1+1]/detpiv;
-               j1 = pospv1+2;
-               j2 = pospv1+nfront-(npiv+1);
-               if (j2 >= j1) {
-                  jj1 = pospv2;
-                  ibeg = pospv2+nfront-(npiv+1);
-                  for (jj = j1; jj < j2+1; jj++) {
-                     jj1 = jj1+1;
-                     amult1 =-(a[pospv1]*a[jj]+a[pospv1+1]*a[jj1]);
-                     amult2 =-(a[pospv1+1]*a[jj]+a[pospv2]*a[jj1]);
-                     iend = ibeg+nfront-(npiv+jj-j1+3);
-                     for (irow = ibeg; irow < iend+1; irow++) {
-                        k1 = jj+irow-ibeg;
-                        k2 = jj1+irow-ibeg;
-                        a[irow] = a[irow]+amult1*a[k1]+amult2*a[k2];
-                     }
-                     ibeg = iend+1;
-                     a[jj] = amult1;
-                     a[jj1] = amult2;
-                  }
-               }
+               UpdateFront2x2(a,pospv1,pospv2,nfront-(npiv+2));
                npiv = npiv+2;
                ntotpv = ntotpv+2;
                jpiv = 2;
@@ -0,0 +1,97 @@
+// @(#)root/matrix:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TMatrixTParallel
+#define ROOT_TMatrixTParallel
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TMatrixTParallel                                                     //
+//                                                                      //
+// Helpers to split the sparse matrix kernels in ranges of rows of      //
+// about equal cost, computed in parallel on the ROOT thread pool when  //
+// implicit multi-threading is enabled (ROOT::EnableImplicitMT()) and   //
+// the computation is large enough.                                     //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "RtypesCore.h"
+#include "RConfigure.h"
+
+#include <algorithm>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
+namespace TMatrixTParallel {
+
+// minimal number of multiply-adds of a computation done in parallel
+constexpr Long64_t kMinWork = 1 << 16;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of ranges in which a computation of `work` multiply-adds is split:
+/// the size of the thread pool if implicit multi-threading is enabled and the
+/// computation is large enough, otherwise 1 .
+
+inline Int_t GetNRanges(Long64_t work)
+{
+#ifdef R__USE_IMT
+   if (work >= kMinWork && ROOT::IsImplicitMTEnabled())
+      return ROOT::GetThreadPoolSize();
+#else
+   (void)work;
+#endif
+   return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Boundaries of `nranges` consecutive ranges of [0,n) of about equal cost, where
+/// cumCost[i] is the cost of the elements [0,i) (i = 0, ..., n) .
+/// Range r is [bounds[r],bounds[r+1]) .
+
+template <class T>
+std::vector<Int_t> SplitRanges(Int_t n, const T *cumCost, Int_t nranges)
+{
+   std::vector<Int_t> bounds(nranges + 1);
+   bounds[0] = 0;
+   bounds[nranges] = n;
+   const Double_t total = cumCost[n] - cumCost[0];
+   for (Int_t r = 1; r < nranges; r++) {
+      const T target = cumCost[0] + static_cast<T>(total * r / nranges);
+      const Int_t i = std::lower_bound(cumCost, cumCost + n + 1, target) - cumCost;
+      bounds[r] = std::max(bounds[r - 1], std::min(i, n));
+   }
+   return bounds;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Call func(r) for r = 0, ..., nranges-1, in parallel if nranges > 1 .
+
+template <class F>
+void Foreach(Int_t nranges, F &&func)
+{
+#ifdef R__USE_IMT
+   if (nranges > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(func, ROOT::TSeqI(nranges));
+      return;
+   }
+#endif
+   for (Int_t r = 0; r < nranges; r++)
+      func(r);
+}
+
+} // namespace TMatrixTParallel
+
+#endif
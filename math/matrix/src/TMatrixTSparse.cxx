@@ -81,9 +81,62 @@
 #include "TBuffer.h"
 #include "TMatrixT.h"
 #include "TMath.h"
+#include "TMatrixTParallel.h"
+
+#include <algorithm>
+#include <vector>
 
 templateClassImp(TMatrixTSparse);
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Column indices and values of the non-zero elements of a range of rows of a
+/// matrix product, with the number of non-zero elements of each row .
+
+template<class Element>
+struct TSparseRowRange {
+   std::vector<Int_t>   fNelems;
+   std::vector<Int_t>   fColIndex;
+   std::vector<Element> fElements;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Total number of non-zero elements of consecutive ranges of rows .
+
+template<class Element>
+Int_t RowRangesNonZeros(const std::vector<TSparseRowRange<Element>> &ranges)
+{
+   Int_t nr_nonzeros = 0;
+   for (const auto &range : ranges)
+      nr_nonzeros += range.fElements.size();
+   return nr_nonzeros;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store consecutive ranges of rows, starting at row 0, in the sparse structure
+/// pRowIndex, pColIndex, pData .
+
+template<class Element>
+void StoreRowRanges(const std::vector<TSparseRowRange<Element>> &ranges,Int_t *pRowIndex,Int_t *pColIndex,
+                    Element *pData)
+{
+   Int_t irow  = 0;
+   Int_t ielem = 0;
+   pRowIndex[0] = 0;
+   for (const auto &range : ranges) {
+      for (const Int_t nelems : range.fNelems) {
+         pRowIndex[irow+1] = pRowIndex[irow]+nelems;
+         irow++;
+      }
+      std::copy(range.fColIndex.begin(),range.fColIndex.end(),pColIndex+ielem);
+      std::copy(range.fElements.begin(),range.fElements.end(),pData+ielem);
+      ielem += range.fElements.size();
+   }
+}
+
+} // namespace
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Space is allocated for row/column indices and data, but the sparse structure
@@ -484,18 +537,22 @@ void TMatrixTSparse<Element>::ExtractRow(Int_t rown, Int_t coln, Element *v,Int_
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// General matrix multiplication. Create a matrix C such that C = A * B'.
+/// General matrix multiplication. Create a matrix C such that C = A * B.
 /// Note, matrix C is allocated for constr=1.
+///
+/// The rows of C are computed independently, from the rows of B selected by the
+/// non-zero elements of the corresponding row of A . They are computed in
+/// parallel when implicit multi-threading is enabled and the product is large.
 
 template<class Element>
-void TMatrixTSparse<Element>::AMultBt(const TMatrixTSparse<Element> &a,const TMatrixTSparse<Element> &b,Int_t constr)
+void TMatrixTSparse<Element>::AMultB(const TMatrixTSparse<Element> &a,const TMatrixTSparse<Element> &b,Int_t constr)
 {
    if (gMatrixCheck) {
       R__ASSERT(a.IsValid());
       R__ASSERT(b.IsValid());
 
-      if (a.GetNcols() != b.GetNcols() || a.GetColLwb() != b.GetColLwb()) {
-         Error("AMultBt","A and B columns incompatible");
+      if (a.GetNcols() != b.GetNrows() || a.GetColLwb() != b.GetRowLwb()) {
+         Error("AMultB","A columns and B rows incompatible");
          return;
       }
 
@@ -510,85 +567,74 @@ void TMatrixTSparse<Element>::AMultBt(const TMatrixTSparse<Element> &a,const TMa
       }
    }
 
-   const Int_t * const pRowIndexa = a.GetRowIndexArray();
-   const Int_t * const pColIndexa = a.GetColIndexArray();
-   const Int_t * const pRowIndexb = b.GetRowIndexArray();
-   const Int_t * const pColIndexb = b.GetColIndexArray();
+   const Int_t nrowsc = a.GetNrows();
+   const Int_t ncolsc = b.GetNcols();
 
-   Int_t *pRowIndexc;
-   Int_t *pColIndexc;
-   if (constr) {
-      // make a best guess of the sparse structure; it will guarantee
-      // enough allocated space !
+   const Int_t   * const pRowIndexa = a.GetRowIndexArray();
+   const Int_t   * const pColIndexa = a.GetColIndexArray();
+   const Element * const pDataa     = a.GetMatrixArray();
+   const Int_t   * const pRowIndexb = b.GetRowIndexArray();
+   const Int_t   * const pColIndexb = b.GetColIndexArray();
+   const Element * const pDatab     = b.GetMatrixArray();
 
-      Int_t nr_nonzero_rowa = 0;
-      {
-         for (Int_t irowa = 0; irowa < a.GetNrows(); irowa++)
-            if (pRowIndexa[irowa] < pRowIndexa[irowa+1])
-               nr_nonzero_rowa++;
-      }
-      Int_t nr_nonzero_rowb = 0;
-      {
-         for (Int_t irowb = 0; irowb < b.GetNrows(); irowb++)
-            if (pRowIndexb[irowb] < pRowIndexb[irowb+1])
-              nr_nonzero_rowb++;
-      }
-
-      const Int_t nc = nr_nonzero_rowa*nr_nonzero_rowb; // best guess
-      Allocate(a.GetNrows(),b.GetNrows(),a.GetRowLwb(),b.GetRowLwb(),1,nc);
-
-      pRowIndexc = this->GetRowIndexArray();
-      pColIndexc = this->GetColIndexArray();
-
-      pRowIndexc[0] = 0;
-      Int_t ielem = 0;
-      for (Int_t irowa = 0; irowa < a.GetNrows(); irowa++) {
-         pRowIndexc[irowa+1] = pRowIndexc[irowa];
-         if (pRowIndexa[irowa] >= pRowIndexa[irowa+1]) continue;
-         for (Int_t irowb = 0; irowb < b.GetNrows(); irowb++) {
-            if (pRowIndexb[irowb] >= pRowIndexb[irowb+1]) continue;
-            pRowIndexc[irowa+1]++;
-            pColIndexc[ielem++] = irowb;
-         }
-      }
-   } else {
-      pRowIndexc = this->GetRowIndexArray();
-      pColIndexc = this->GetColIndexArray();
-   }
-
-   const Element * const pDataa = a.GetMatrixArray();
-   const Element * const pDatab = b.GetMatrixArray();
-   Element * const pDatac = this->GetMatrixArray();
-   Int_t indexc_r = 0;
-   for (Int_t irowc = 0; irowc < this->GetNrows(); irowc++) {
-      const Int_t sIndexa = pRowIndexa[irowc];
-      const Int_t eIndexa = pRowIndexa[irowc+1];
-      for (Int_t icolc = 0; icolc < this->GetNcols(); icolc++) {
-         const Int_t sIndexb = pRowIndexb[icolc];
-         const Int_t eIndexb = pRowIndexb[icolc+1];
-         Element sum = 0.0;
-         Int_t indexb = sIndexb;
-         for (Int_t indexa = sIndexa; indexa < eIndexa && indexb < eIndexb; indexa++) {
-            const Int_t icola = pColIndexa[indexa];
-            while (indexb < eIndexb && pColIndexb[indexb] <= icola) {
-               if (icola == pColIndexb[indexb]) {
-                 sum += pDataa[indexa]*pDatab[indexb];
-                 break;
+   // number of multiply-adds needed for the rows [0,irowc)
+   std::vector<Long64_t> cumWork(nrowsc+1);
+   cumWork[0] = 0;
+   for (Int_t irowc = 0; irowc < nrowsc; irowc++) {
+      Long64_t work = 0;
+      for (Int_t indexa = pRowIndexa[irowc]; indexa < pRowIndexa[irowc+1]; indexa++) {
+         const Int_t icola = pColIndexa[indexa];
+         work += pRowIndexb[icola+1]-pRowIndexb[icola];
+      }
+      cumWork[irowc+1] = cumWork[irowc]+work;
+   }
+
+   const Int_t nranges = TMatrixTParallel::GetNRanges(cumWork[nrowsc]);
+   const std::vector<Int_t> bounds = TMatrixTParallel::SplitRanges(nrowsc,cumWork.data(),nranges);
+   std::vector<TSparseRowRange<Element>> ranges(nranges);
+
+   TMatrixTParallel::Foreach(nranges,[&](Int_t irange) {
+      TSparseRowRange<Element> &range = ranges[irange];
+      // dense accumulator of a row of C, with the last row in which each column has been set
+      std::vector<Element> sum(ncolsc);
+      std::vector<Int_t>   lastRow(ncolsc,-1);
+      std::vector<Int_t>   cols;
+      for (Int_t irowc = bounds[irange]; irowc < bounds[irange+1]; irowc++) {
+         cols.clear();
+         for (Int_t indexa = pRowIndexa[irowc]; indexa < pRowIndexa[irowc+1]; indexa++) {
+            const Int_t   icola = pColIndexa[indexa];
+            const Element da    = pDataa[indexa];
+            for (Int_t indexb = pRowIndexb[icola]; indexb < pRowIndexb[icola+1]; indexb++) {
+               const Int_t icolc = pColIndexb[indexb];
+               if (lastRow[icolc] != irowc) {
+                  lastRow[icolc] = irowc;
+                  sum[icolc] = 0.0;
+                  cols.push_back(icolc);
                }
-               indexb++;
+               sum[icolc] += da*pDatab[indexb];
             }
          }
-         if (sum != 0.0) {
-            pColIndexc[indexc_r] = icolc;
-            pDatac[indexc_r] = sum;
-            indexc_r++;
+         std::sort(cols.begin(),cols.end());
+         Int_t nelems = 0;
+         for (const Int_t icolc : cols) {
+            if (sum[icolc] != 0.0) {
+               range.fColIndex.push_back(icolc);
+               range.fElements.push_back(sum[icolc]);
+               nelems++;
+            }
          }
+         range.fNelems.push_back(nelems);
       }
-      pRowIndexc[irowc+1] = indexc_r;
-   }
+   });
 
+   const Int_t nr_nonzeros = RowRangesNonZeros(ranges);
    if (constr)
-      SetSparseIndex(indexc_r);
+      Allocate(nrowsc,ncolsc,a.GetRowLwb(),b.GetColLwb(),1,nr_nonzeros);
+   else if (nr_nonzeros > this->GetNoElements()) {
+      Error("AMultB","sparse structure too small for the %d non-zero elements of the product",nr_nonzeros);
+      return;
+   }
+   StoreRowRanges(ranges,fRowIndex,fColIndex,fElements);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -596,7 +642,7 @@ void TMatrixTSparse<Element>::AMultBt(const TMatrixTSparse<Element> &a,const TMa
 /// Note, matrix C is allocated for constr=1.
 
 template<class Element>
-void TMatrixTSparse<Element>::AMultBt(const TMatrixTSparse<Element> &a,const TMatrixT<Element> &b,Int_t constr)
+void TMatrixTSparse<Element>::AMultBt(const TMatrixTSparse<Element> &a,const TMatrixTSparse<Element> &b,Int_t constr)
 {
    if (gMatrixCheck) {
       R__ASSERT(a.IsValid());
@@ -618,68 +664,81 @@ void TMatrixTSparse<Element>::AMultBt(const TMatrixTSparse<Element> &a,const TMa
       }
    }
 
-   const Int_t * const pRowIndexa = a.GetRowIndexArray();
-   const Int_t * const pColIndexa = a.GetColIndexArray();
+   const TMatrixTSparse<Element> bt(TMatrixTSparse::kTransposed,b);
+   AMultB(a,bt,constr);
+}
 
-   Int_t *pRowIndexc;
-   Int_t *pColIndexc;
-   if (constr) {
-      // make a best guess of the sparse structure; it will guarantee
-      // enough allocated space !
+////////////////////////////////////////////////////////////////////////////////
+/// General matrix multiplication. Create a matrix C such that C = A * B'.
+/// Note, matrix C is allocated for constr=1.
 
-      Int_t nr_nonzero_rowa = 0;
-      {
-         for (Int_t irowa = 0; irowa < a.GetNrows(); irowa++)
-            if (pRowIndexa[irowa] < pRowIndexa[irowa+1])
-               nr_nonzero_rowa++;
-      }
-      Int_t nr_nonzero_rowb = b.GetNrows();
+template<class Element>
+void TMatrixTSparse<Element>::AMultBt(const TMatrixTSparse<Element> &a,const TMatrixT<Element> &b,Int_t constr)
+{
+   if (gMatrixCheck) {
+      R__ASSERT(a.IsValid());
+      R__ASSERT(b.IsValid());
 
-      const Int_t nc = nr_nonzero_rowa*nr_nonzero_rowb; // best guess
-      Allocate(a.GetNrows(),b.GetNrows(),a.GetRowLwb(),b.GetRowLwb(),1,nc);
+      if (a.GetNcols() != b.GetNcols() || a.GetColLwb() != b.GetColLwb()) {
+         Error("AMultBt","A and B columns incompatible");
+         return;
+      }
 
-      pRowIndexc = this->GetRowIndexArray();
-      pColIndexc = this->GetColIndexArray();
+      if (!constr && this->GetMatrixArray() == a.GetMatrixArray()) {
+         Error("AMultB","this = &a");
+         return;
+      }
 
-      pRowIndexc[0] = 0;
-      Int_t ielem = 0;
-      for (Int_t irowa = 0; irowa < a.GetNrows(); irowa++) {
-         pRowIndexc[irowa+1] = pRowIndexc[irowa];
-         for (Int_t irowb = 0; irowb < b.GetNrows(); irowb++) {
-            pRowIndexc[irowa+1]++;
-            pColIndexc[ielem++] = irowb;
-         }
+      if (!constr && this->GetMatrixArray() == b.GetMatrixArray()) {
+         Error("AMultB","this = &b");
+         return;
       }
-   } else {
-      pRowIndexc = this->GetRowIndexArray();
-      pColIndexc = this->GetColIndexArray();
    }
 
-   const Element * const pDataa = a.GetMatrixArray();
-   const Element * const pDatab = b.GetMatrixArray();
-   Element * const pDatac = this->GetMatrixArray();
-   Int_t indexc_r = 0;
-   for (Int_t irowc = 0; irowc < this->GetNrows(); irowc++) {
-      const Int_t sIndexa = pRowIndexa[irowc];
-      const Int_t eIndexa = pRowIndexa[irowc+1];
-      for (Int_t icolc = 0; icolc < this->GetNcols(); icolc++) {
-         const Int_t off = icolc*b.GetNcols();
-         Element sum = 0.0;
-         for (Int_t indexa = sIndexa; indexa < eIndexa; indexa++) {
-            const Int_t icola = pColIndexa[indexa];
-            sum += pDataa[indexa]*pDatab[off+icola];
-         }
-         if (sum != 0.0) {
-            pColIndexc[indexc_r] = icolc;
-            pDatac[indexc_r] = sum;
-            indexc_r++;
+   const Int_t nrowsc = a.GetNrows();
+   const Int_t ncolsc = b.GetNrows();
+
+   const Int_t   * const pRowIndexa = a.GetRowIndexArray();
+   const Int_t   * const pColIndexa = a.GetColIndexArray();
+   const Element * const pDataa     = a.GetMatrixArray();
+   const Element * const pDatab     = b.GetMatrixArray();
+
+   // the work of a row of C is proportional to the number of non-zero elements of the row of A
+   const Int_t nranges = TMatrixTParallel::GetNRanges(Long64_t(pRowIndexa[nrowsc])*ncolsc);
+   const std::vector<Int_t> bounds = TMatrixTParallel::SplitRanges(nrowsc,pRowIndexa,nranges);
+   std::vector<TSparseRowRange<Element>> ranges(nranges);
+
+   TMatrixTParallel::Foreach(nranges,[&](Int_t irange) {
+      TSparseRowRange<Element> &range = ranges[irange];
+      for (Int_t irowc = bounds[irange]; irowc < bounds[irange+1]; irowc++) {
+         const Int_t sIndexa = pRowIndexa[irowc];
+         const Int_t eIndexa = pRowIndexa[irowc+1];
+         Int_t nelems = 0;
+         for (Int_t icolc = 0; icolc < ncolsc; icolc++) {
+            const Int_t off = icolc*b.GetNcols();
+            Element sum = 0.0;
+            for (Int_t indexa = sIndexa; indexa < eIndexa; indexa++) {
+               const Int_t icola = pColIndexa[indexa];
+               sum += pDataa[indexa]*pDatab[off+icola];
+            }
+            if (sum != 0.0) {
+               range.fColIndex.push_back(icolc);
+               range.fElements.push_back(sum);
+               nelems++;
+            }
          }
+         range.fNelems.push_back(nelems);
       }
-      pRowIndexc[irowc+1]= indexc_r;
-   }
+   });
 
+   const Int_t nr_nonzeros = RowRangesNonZeros(ranges);
    if (constr)
-      SetSparseIndex(indexc_r);
+      Allocate(nrowsc,ncolsc,a.GetRowLwb(),b.GetRowLwb(),1,nr_nonzeros);
+   else if (nr_nonzeros > this->GetNoElements()) {
+      Error("AMultBt","sparse structure too small for the %d non-zero elements of the product",nr_nonzeros);
+      return;
+   }
+   StoreRowRanges(ranges,fRowIndex,fColIndex,fElements);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -709,69 +768,53 @@ void TMatrixTSparse<Element>::AMultBt(const TMatrixT<Element> &a,const TMatrixTS
       }
    }
 
-   const Int_t * const pRowIndexb = b.GetRowIndexArray();
-   const Int_t * const pColIndexb = b.GetColIndexArray();
-
-   Int_t *pRowIndexc;
-   Int_t *pColIndexc;
-   if (constr) {
-      // make a best guess of the sparse structure; it will guarantee
-      // enough allocated space !
-
-      Int_t nr_nonzero_rowa = a.GetNrows();
-      Int_t nr_nonzero_rowb = 0;
-      {
-         for (Int_t irowb = 0; irowb < b.GetNrows(); irowb++)
-            if (pRowIndexb[irowb] < pRowIndexb[irowb+1])
-               nr_nonzero_rowb++;
-      }
-
-      const Int_t nc = nr_nonzero_rowa*nr_nonzero_rowb; // best guess
-      Allocate(a.GetNrows(),b.GetNrows(),a.GetRowLwb(),b.GetRowLwb(),1,nc);
-
-      pRowIndexc = this->GetRowIndexArray();
-      pColIndexc = this->GetColIndexArray();
-
-      pRowIndexc[0] = 0;
-      Int_t ielem = 0;
-      for (Int_t irowa = 0; irowa < a.GetNrows(); irowa++) {
-         pRowIndexc[irowa+1] = pRowIndexc[irowa];
-         for (Int_t irowb = 0; irowb < b.GetNrows(); irowb++) {
-            if (pRowIndexb[irowb] >= pRowIndexb[irowb+1]) continue;
-            pRowIndexc[irowa+1]++;
-            pColIndexc[ielem++] = irowb;
-         }
-      }
-   } else {
-      pRowIndexc = this->GetRowIndexArray();
-      pColIndexc = this->GetColIndexArray();
-   }
-
-   const Element * const pDataa = a.GetMatrixArray();
-   const Element * const pDatab = b.GetMatrixArray();
-   Element * const pDatac = this->GetMatrixArray();
-   Int_t indexc_r = 0;
-   for (Int_t irowc = 0; irowc < this->GetNrows(); irowc++) {
-      const Int_t off = irowc*a.GetNcols();
-      for (Int_t icolc = 0; icolc < this->GetNcols(); icolc++) {
-         const Int_t sIndexb = pRowIndexb[icolc];
-         const Int_t eIndexb = pRowIndexb[icolc+1];
-         Element sum = 0.0;
-         for (Int_t indexb = sIndexb; indexb < eIndexb; indexb++) {
-            const Int_t icolb = pColIndexb[indexb];
-            sum += pDataa[off+icolb]*pDatab[indexb];
-         }
-         if (sum != 0.0) {
-            pColIndexc[indexc_r] = icolc;
-            pDatac[indexc_r] = sum;
-            indexc_r++;
+   const Int_t nrowsc = a.GetNrows();
+   const Int_t ncolsc = b.GetNrows();
+
+   const Int_t   * const pRowIndexb = b.GetRowIndexArray();
+   const Int_t   * const pColIndexb = b.GetColIndexArray();
+   const Element * const pDataa     = a.GetMatrixArray();
+   const Element * const pDatab     = b.GetMatrixArray();
+
+   // all the rows of C have the same work
+   std::vector<Int_t> cumRows(nrowsc+1);
+   for (Int_t irowc = 0; irowc <= nrowsc; irowc++)
+      cumRows[irowc] = irowc;
+   const Int_t nranges = TMatrixTParallel::GetNRanges(Long64_t(nrowsc)*pRowIndexb[ncolsc]);
+   const std::vector<Int_t> bounds = TMatrixTParallel::SplitRanges(nrowsc,cumRows.data(),nranges);
+   std::vector<TSparseRowRange<Element>> ranges(nranges);
+
+   TMatrixTParallel::Foreach(nranges,[&](Int_t irange) {
+      TSparseRowRange<Element> &range = ranges[irange];
+      for (Int_t irowc = bounds[irange]; irowc < bounds[irange+1]; irowc++) {
+         const Int_t off = irowc*a.GetNcols();
+         Int_t nelems = 0;
+         for (Int_t icolc = 0; icolc < ncolsc; icolc++) {
+            const Int_t sIndexb = pRowIndexb[icolc];
+            const Int_t eIndexb = pRowIndexb[icolc+1];
+            Element sum = 0.0;
+            for (Int_t indexb = sIndexb; indexb < eIndexb; indexb++) {
+               const Int_t icolb = pColIndexb[indexb];
+               sum += pDataa[off+icolb]*pDatab[indexb];
+            }
+            if (sum != 0.0) {
+               range.fColIndex.push_back(icolc);
+               range.fElements.push_back(sum);
+               nelems++;
+            }
          }
+         range.fNelems.push_back(nelems);
       }
-      pRowIndexc[irowc+1] = indexc_r;
-   }
+   });
 
+   const Int_t nr_nonzeros = RowRangesNonZeros(ranges);
    if (constr)
-      SetSparseIndex(indexc_r);
+      Allocate(nrowsc,ncolsc,a.GetRowLwb(),b.GetRowLwb(),1,nr_nonzeros);
+   else if (nr_nonzeros > this->GetNoElements()) {
+      Error("AMultBt","sparse structure too small for the %d non-zero elements of the product",nr_nonzeros);
+      return;
+   }
+   StoreRowRanges(ranges,fRowIndex,fColIndex,fElements);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -42,6 +42,7 @@ For usage examples see `$ROOTSYS/test/stressLinear.cxx`
 #include "TMath.h"
 #include "TROOT.h"
 #include "Varargs.h"
+#include "TMatrixTParallel.h"
 
 templateClassImp(TVectorT);
 
@@ -1057,16 +1058,21 @@ TVectorT<Element> &TVectorT<Element>::operator*=(const TMatrixTSparse<Element> &
    const Element * const sp = elements_old;
          Element *       tp = this->GetMatrixArray(); // Target vector ptr
 
-   for (Int_t irow = 0; irow < fNrows; irow++) {
-      const Int_t sIndex = pRowIndex[irow];
-      const Int_t eIndex = pRowIndex[irow+1];
-      Element sum = 0.0;
-      for (Int_t index = sIndex; index < eIndex; index++) {
-         const Int_t icol = pColIndex[index];
-         sum += mp[index]*sp[icol];
+   // the rows are split in ranges of about equal number of non-zero elements
+   const Int_t nranges = TMatrixTParallel::GetNRanges(pRowIndex[fNrows]);
+   const std::vector<Int_t> bounds = TMatrixTParallel::SplitRanges(fNrows,pRowIndex,nranges);
+   TMatrixTParallel::Foreach(nranges,[&](Int_t irange) {
+      for (Int_t irow = bounds[irange]; irow < bounds[irange+1]; irow++) {
+         const Int_t sIndex = pRowIndex[irow];
+         const Int_t eIndex = pRowIndex[irow+1];
+         Element sum = 0.0;
+         for (Int_t index = sIndex; index < eIndex; index++) {
+            const Int_t icol = pColIndex[index];
+            sum += mp[index]*sp[icol];
+         }
+         tp[irow] = sum;
       }
-      tp[irow] = sum;
-   }
+   });
 
    if (isAllocated)
       delete [] elements_old;
@@ -1788,8 +1794,12 @@ TVectorT<Element> &TMatrixTAutoloadOps::Add(TVectorT<Element> &target,Element sc
    const Element * const sp = source.GetMatrixArray(); // Source vector ptr
          Element *       tp = target.GetMatrixArray(); // Target vector ptr
 
-   if (scalar == 1.0) {
-      for (Int_t irow = 0; irow < a.GetNrows(); irow++) {
+   // the rows are split in ranges of about equal number of non-zero elements
+   const Int_t nrows   = a.GetNrows();
+   const Int_t nranges = TMatrixTParallel::GetNRanges(pRowIndex[nrows]);
+   const std::vector<Int_t> bounds = TMatrixTParallel::SplitRanges(nrows,pRowIndex,nranges);
+   TMatrixTParallel::Foreach(nranges,[&](Int_t irange) {
+      for (Int_t irow = bounds[irange]; irow < bounds[irange+1]; irow++) {
          const Int_t sIndex = pRowIndex[irow];
          const Int_t eIndex = pRowIndex[irow+1];
          Element sum = 0.0;
@@ -1797,42 +1807,16 @@ TVectorT<Element> &TMatrixTAutoloadOps::Add(TVectorT<Element> &target,Element sc
             const Int_t icol = pColIndex[index];
             sum += mp[index]*sp[icol];
          }
-         tp[irow] += sum;
+         if (scalar == 1.0)
+            tp[irow] += sum;
+         else if (scalar == 0.0)
+            tp[irow]  = sum;
+         else if (scalar == -1.0)
+            tp[irow] -= sum;
+         else
+            tp[irow] += scalar * sum;
       }
-   } else if (scalar == 0.0) {
-      for (Int_t irow = 0; irow < a.GetNrows(); irow++) {
-         const Int_t sIndex = pRowIndex[irow];
-         const Int_t eIndex = pRowIndex[irow+1];
-         Element sum = 0.0;
-         for (Int_t index = sIndex; index < eIndex; index++) {
-            const Int_t icol = pColIndex[index];
-            sum += mp[index]*sp[icol];
-         }
-         tp[irow]  = sum;
-      }
-   } else if (scalar == -1.0) {
-     for (Int_t irow = 0; irow < a.GetNrows(); irow++) {
-        const Int_t sIndex = pRowIndex[irow];
-        const Int_t eIndex = pRowIndex[irow+1];
-        Element sum = 0.0;
-        for (Int_t index = sIndex; index < eIndex; index++) {
-           const Int_t icol = pColIndex[index];
-           sum += mp[index]*sp[icol];
-        }
-        tp[irow] -= sum;
-      }
-   } else {
-      for (Int_t irow = 0; irow < a.GetNrows(); irow++) {
-        const Int_t sIndex = pRowIndex[irow];
-        const Int_t eIndex = pRowIndex[irow+1];
-        Element sum = 0.0;
-        for (Int_t index = sIndex; index < eIndex; index++) {
-           const Int_t icol = pColIndex[index];
-           sum += mp[index]*sp[icol];
-        }
-        tp[irow] += scalar * sum;
-      }
-   }
+   });
 
    return target;
 }
@@ -9,10 +9,16 @@
  *************************************************************************/
 
 #include <TDecompBase.h>
+#include <TDecompSparse.h>
+#include <TMatrixDSparse.h>
+#include <TVectorD.h>
+#include <TROOT.h>
 
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <iostream>
+#include <vector>
 
 // This is just so the can use the protected DiagProd funciton in the test.
 class TDecompDummy : public TDecompBase {
@@ -37,3 +43,44 @@ TEST(testDecomp, DiagProd)
    // using this specific formula to validate the method.
    EXPECT_EQ(d1 * std::pow(2, d2), v[0]);
 }
+
+// Symmetric positive definite band matrix, with fronts large enough for the
+// parallel update of the factorization with implicit multi-threading
+TEST(testDecomp, SparseBand)
+{
+   const int n = 800;
+   const int band = 300;
+   std::vector<int> irow, icol;
+   std::vector<double> val;
+   for (int i = 0; i < n; i++) {
+      for (int j = std::max(0, i - band); j <= std::min(n - 1, i + band); j++) {
+         irow.push_back(i);
+         icol.push_back(j);
+         val.push_back(i == j ? 2. * band + 1. : 1. / (1. + std::abs(i - j)));
+      }
+   }
+   TMatrixDSparse a(0, n - 1, 0, n - 1);
+   a.SetMatrixArray(val.size(), irow.data(), icol.data(), val.data());
+
+   TVectorD b(n);
+   for (int i = 0; i < n; i++)
+      b[i] = std::cos(i);
+
+   auto solve = [&]() {
+      TDecompSparse decomp(a, 0);
+      TVectorD x = b;
+      EXPECT_TRUE(decomp.Solve(x));
+      const TVectorD resid = a * x - b;
+      EXPECT_LT(resid.NormInf(), 1e-10 * b.NormInf());
+      return x;
+   };
+
+   const TVectorD x = solve();
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+   // same solution, independently of the number of threads
+   const TVectorD xMT = solve();
+   ROOT::DisableImplicitMT();
+   EXPECT_EQ(x, xMT);
+#endif
+}
@@ -10,11 +10,15 @@
 
 #include "TMatrixD.h"
 #include "TMatrixDSparse.h"
+#include "TVectorD.h"
 #include "TMath.h"
+#include "TROOT.h"
 
 #include "gtest/gtest.h"
 
 #include <array>
+#include <random>
+#include <vector>
 
 // https://github.com/root-project/root/issues/13848
 TEST(testSparse, LwbInit)
@@ -46,3 +50,107 @@ TEST(testSparse, LwbInit)
 
   EXPECT_EQ(m1, m2);
 }
+
+namespace {
+
+// random sparse matrix with about `density` * nrows * ncols non-zero elements
+TMatrixDSparse RandomSparse(int nrows, int ncols, double density, unsigned int seed)
+{
+   std::mt19937 gen(seed);
+   std::uniform_real_distribution<double> uniform(0., 1.);
+   std::vector<int> irow, icol;
+   std::vector<double> val;
+   for (int i = 0; i < nrows; i++) {
+      for (int j = 0; j < ncols; j++) {
+         if (uniform(gen) < density) {
+            irow.push_back(i);
+            icol.push_back(j);
+            val.push_back(uniform(gen) - 0.5);
+         }
+      }
+   }
+   TMatrixDSparse m(0, nrows - 1, 0, ncols - 1);
+   m.SetMatrixArray(val.size(), irow.data(), icol.data(), val.data());
+   return m;
+}
+
+void ExpectNear(const TMatrixDSparse &m1, const TMatrixD &m2)
+{
+   const TMatrixD d1(m1);
+   ASSERT_EQ(d1.GetNrows(), m2.GetNrows());
+   ASSERT_EQ(d1.GetNcols(), m2.GetNcols());
+   for (int i = 0; i < m2.GetNrows(); i++)
+      for (int j = 0; j < m2.GetNcols(); j++)
+         EXPECT_NEAR(d1(i, j), m2(i, j), 1e-12);
+}
+
+} // namespace
+
+// the products are large enough to be computed in parallel with implicit multi-threading
+TEST(testSparse, Products)
+{
+   const TMatrixDSparse a = RandomSparse(300, 400, 0.05, 1);
+   const TMatrixDSparse b = RandomSparse(400, 200, 0.05, 2);
+   const TMatrixDSparse c = RandomSparse(200, 400, 0.05, 3);
+   const TMatrixD ad(a), bd(b), cd(c);
+
+   auto check = [&]() {
+      const TMatrixDSparse ab(a, TMatrixDSparse::kMult, b);
+      ExpectNear(ab, TMatrixD(ad, TMatrixD::kMult, bd));
+      const TMatrixDSparse act(a, TMatrixDSparse::kMultTranspose, c);
+      ExpectNear(act, TMatrixD(ad, TMatrixD::kMultTranspose, cd));
+      const TMatrixDSparse abd(a, TMatrixDSparse::kMult, bd);
+      ExpectNear(abd, TMatrixD(ad, TMatrixD::kMult, bd));
+      const TMatrixDSparse adb(ad, TMatrixDSparse::kMult, b);
+      ExpectNear(adb, TMatrixD(ad, TMatrixD::kMult, bd));
+      const TMatrixDSparse ata(TMatrixDSparse::kAtA, a);
+      ExpectNear(ata, TMatrixD(TMatrixD::kAtA, ad));
+
+      // product in the existing sparse structure
+      TMatrixDSparse ab2(ab);
+      ab2.Mult(a, b);
+      ExpectNear(ab2, TMatrixD(ad, TMatrixD::kMult, bd));
+      return ab;
+   };
+
+   const TMatrixDSparse ab = check();
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+   // same result, independently of the number of threads
+   const TMatrixDSparse abMT = check();
+   ROOT::DisableImplicitMT();
+   EXPECT_EQ(ab, abMT);
+#endif
+}
+
+TEST(testSparse, MultVector)
+{
+   const TMatrixDSparse a = RandomSparse(2000, 1500, 0.03, 4);
+   TVectorD v(1500);
+   for (int i = 0; i < v.GetNrows(); i++)
+      v[i] = std::sin(i);
+
+   TVectorD expected(2000);
+   const TMatrixD ad(a);
+   for (int i = 0; i < ad.GetNrows(); i++)
+      for (int j = 0; j < ad.GetNcols(); j++)
+         expected[i] += ad(i, j) * v[j];
+
+   auto check = [&]() {
+      const TVectorD av = a * v;
+      for (int i = 0; i < av.GetNrows(); i++)
+         EXPECT_NEAR(av[i], expected[i], 1e-12);
+      TVectorD av2 = v;
+      av2 *= a;
+      EXPECT_EQ(av2, av);
+      return av;
+   };
+
+   const TVectorD av = check();
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+   const TVectorD avMT = check();
+   ROOT::DisableImplicitMT();
+   EXPECT_EQ(av, avMT);
+#endif
+}
@@ -0,0 +1,69 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2024 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#ifndef ROOT_Minuit2_LBFGSBuilder
+#define ROOT_Minuit2_LBFGSBuilder
+
+#include "Minuit2/MnConfig.h"
+#include "Minuit2/MinimumBuilder.h"
+
+#include <vector>
+
+namespace ROOT {
+
+namespace Minuit2 {
+
+class FunctionGradient;
+class MnMachinePrecision;
+
+/**
+   Build (find) function minimum using the limited-memory BFGS method (L-BFGS),
+   see Nocedal and Wright, Numerical Optimization, chapter 7.
+
+   In contrast to the VariableMetricBuilder (MIGRAD), the inverse Hessian is not
+   stored as a matrix: the step is computed from the last NumberOfCorrections()
+   changes of the parameters and of the gradient, starting from the diagonal
+   of the inverse second derivatives (G2) of the gradient. The memory and the
+   time of each iteration are therefore linear in the number of parameters,
+   which makes the method suited for problems with thousands of parameters.
+   The states, including the minimum, have no error matrix, whatever the
+   strategy: it is computed with MnHesse only when the errors are needed
+   (Minuit2Minimizer does it when the errors are requested, see
+   Minimizer::SetValidError).
+ */
+class LBFGSBuilder : public MinimumBuilder {
+
+public:
+   LBFGSBuilder(unsigned int ncorrections = 10) : fNCorrections(ncorrections) {}
+
+   ~LBFGSBuilder() override {}
+
+   FunctionMinimum Minimum(const MnFcn &, const GradientCalculator &, const MinimumSeed &, const MnStrategy &,
+                           unsigned int, double) const override;
+
+   /// number of corrections (pairs of parameter and gradient changes) kept in memory
+   unsigned int NumberOfCorrections() const { return fNCorrections; }
+   void SetNumberOfCorrections(unsigned int n) { fNCorrections = n; }
+
+   /// estimated distance to the minimum using only the diagonal of the inverse second derivatives
+   static double DiagonalEdm(const FunctionGradient &, const MnMachinePrecision &);
+
+private:
+   FunctionMinimum Minimum(const MnFcn &, const GradientCalculator &, const MinimumSeed &, std::vector<MinimumState> &,
+                           unsigned int, double) const;
+
+   void AddResult(std::vector<MinimumState> &result, const MinimumState &state) const;
+
+   unsigned int fNCorrections;
+};
+
+} // namespace Minuit2
+
+} // namespace ROOT
+
+#endif // ROOT_Minuit2_LBFGSBuilder
@@ -0,0 +1,48 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2024 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#ifndef ROOT_Minuit2_LBFGSSeedGenerator
+#define ROOT_Minuit2_LBFGSSeedGenerator
+
+#include "Minuit2/MinimumSeedGenerator.h"
+
+namespace ROOT {
+
+namespace Minuit2 {
+
+class MinimumSeed;
+class MnFcn;
+class MnUserParameterState;
+class MnStrategy;
+
+/**
+   generate the starting point (state) of the L-BFGS minimization.
+   In contrast to MnSeedGenerator the seed does not contain an error matrix,
+   which would need a memory quadratic in the number of parameters:
+   the initial inverse Hessian is given only by the second derivatives (G2)
+   of the gradient.
+ */
+class LBFGSSeedGenerator : public MinimumSeedGenerator {
+
+public:
+   LBFGSSeedGenerator() {}
+
+   ~LBFGSSeedGenerator() override {}
+
+   MinimumSeed
+   operator()(const MnFcn &, const GradientCalculator &, const MnUserParameterState &, const MnStrategy &) const override;
+
+   MinimumSeed operator()(const MnFcn &, const AnalyticalGradientCalculator &, const MnUserParameterState &,
+                          const MnStrategy &) const override;
+};
+
+} // namespace Minuit2
+
+} // namespace ROOT
+
+#endif // ROOT_Minuit2_LBFGSSeedGenerator
@@ -33,7 +33,7 @@ class FunctionMinimum;
 class MnTraceObject;
 
 // enumeration specifying the type of Minuit2 minimizers
-enum EMinimizerType { kMigrad, kSimplex, kCombined, kScan, kFumili, kMigradBFGS };
+enum EMinimizerType { kMigrad, kSimplex, kCombined, kScan, kFumili, kMigradBFGS, kLBFGS };
 
 } // namespace Minuit2
 
@@ -45,6 +45,9 @@ namespace Minuit2 {
    In ROOT it can be instantiated using the plug-in manager (plug-in "Minuit2")
    Using a string  (used by the plugin manager) or via an enumeration
    an one can set all the possible minimization algorithms (Migrad, Simplex, Combined, Scan and Fumili).
+   The LBFGS algorithm (limited-memory BFGS, see ROOT::Minuit2::LBFGSBuilder) does not store the error
+   matrix during the iterations and is suited for problems with thousands of parameters; the number of
+   corrections it keeps can be set with the extra option "LBFGSCorrections".
 
    Refer to the [guide](https://root.cern/root/htmldoc/guides/minuit2/Minuit2.html) for an introduction how Minuit
    works.
@@ -13,6 +13,8 @@
 #include "Minuit2/MnConfig.h"
 #include "Minuit2/MnMatrix.h"
 
+#include <atomic>
+
 namespace ROOT {
 
 namespace Minuit2 {
@@ -23,7 +25,9 @@ class FCNBase;
    Apply conversion from calling the function from a Minuit Vector (MnAlgebraicVector) to a std::vector  for
    the function coordinates.
    The class counts also the number of function calls. By default counter start from zero, but a different value
-   might be given if the class is  instantiated later on, for example for a set of different minimizaitons
+   might be given if the class is  instantiated later on, for example for a set of different minimizaitons.
+   The counter is atomic, since the function can be called from several threads when computing the
+   numerical derivatives in parallel (see MnStrategy::SetParallelDerivatives)
    Normally the derived class MnUserFCN should be instantiated with performs in addition the transformatiopn
    internal-> external parameters
  */
@@ -50,7 +54,7 @@ private:
    const FCNBase &fFCN;
 
 protected:
-   mutable int fNumCall;
+   mutable std::atomic<int> fNumCall;
 };
 
 } // namespace Minuit2
@@ -50,6 +50,8 @@ public:
 
    int StorageLevel() const { return fStoreLevel; }
 
+   unsigned int ParallelDerivatives() const { return fParallelDeriv; }
+
    bool IsLow() const { return fStrategy == 0; }
    bool IsMedium() const { return fStrategy == 1; }
    bool IsHigh() const { return fStrategy == 2; }
@@ -81,6 +83,11 @@ public:
    // 0 = store only last iterations 1 = full storage (default)
    void SetStorageLevel(unsigned int level) { fStoreLevel = level; }
 
+   // 1 = compute the numerical gradient and Hessian in parallel over the parameters, using the ROOT
+   //     thread pool (requires a thread-safe FCN; the result does not depend on the number of threads)
+   // 0 = sequential computation (default)
+   void SetParallelDerivatives(unsigned int flag) { fParallelDeriv = flag; }
+
 private:
    unsigned int fStrategy;
 
@@ -94,6 +101,7 @@ private:
    int fHessCFDG2;
    int fHessForcePosDef;
    int fStoreLevel;
+   unsigned int fParallelDeriv;
 };
 
 } // namespace Minuit2
@@ -0,0 +1,39 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2024 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#ifndef ROOT_Minuit2_MnThreadPool
+#define ROOT_Minuit2_MnThreadPool
+
+#include <functional>
+
+namespace ROOT {
+
+namespace Minuit2 {
+
+/**
+   Helper running the independent computations of the numerical derivatives
+   (one per parameter or per element of the Hessian) on the ROOT thread pool.
+   The thread pool is available only when Minuit2 is built as part of ROOT
+   with implicit multi-threading support; otherwise the loops are sequential.
+ */
+
+class MnThreadPool {
+
+public:
+   /// return true if the loops can be executed in parallel
+   static bool IsAvailable();
+
+   /// call func(i) for i = 0,...,n-1, in parallel if the thread pool is available
+   static void Foreach(unsigned int n, const std::function<void(unsigned int)> &func);
+};
+
+} // namespace Minuit2
+
+} // namespace ROOT
+
+#endif // ROOT_Minuit2_MnThreadPool
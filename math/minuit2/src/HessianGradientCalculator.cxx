@@ -16,6 +16,7 @@
 #include "Minuit2/FunctionGradient.h"
 #include "Minuit2/MnStrategy.h"
 #include "Minuit2/MnPrint.h"
+#include "Minuit2/MnThreadPool.h"
 #include "Minuit2/MPIProcess.h"
 
 #include <cmath>
@@ -90,12 +91,11 @@ HessianGradientCalculator::DeltaGradient(const MinimumParameters &par, const Fun
    unsigned int n = x.size();
    MnAlgebraicVector dgrd(n);
 
-   MPIProcess mpiproc(n, 0);
-   // initial starting values
-   unsigned int startElementIndex = mpiproc.StartElementIndex();
-   unsigned int endElementIndex = mpiproc.EndElementIndex();
+   const bool useThreadPool = Strategy().ParallelDerivatives() && MnThreadPool::IsAvailable();
 
-   for (unsigned int i = startElementIndex; i < endElementIndex; i++) {
+   // compute the derivative with respect to parameter i, using x (equal to the parameter values
+   // on input and on output) for the function evaluations
+   auto computeDerivative = [&](unsigned int i, MnAlgebraicVector &x) {
       double xtf = x(i);
       double dmin = 4. * Precision().Eps2() * (xtf + Precision().Eps2());
       double epspri = Precision().Eps2() + fabs(grd(i) * Precision().Eps2());
@@ -143,9 +143,27 @@ HessianGradientCalculator::DeltaGradient(const MinimumParameters &par, const Fun
 
       dgrd(i) = std::max(dgmin, std::fabs(grdold - grdnew));
 
-      print.Debug("HGC Param :", i, "\t new g1 =", grd(i), "gstep =", d, "dgrd =", dgrd(i));
+      if (!useThreadPool)
+         print.Debug("HGC Param :", i, "\t new g1 =", grd(i), "gstep =", d, "dgrd =", dgrd(i));
+   };
+
+   if (useThreadPool) {
+      // each parameter is computed independently with its own copy of the parameter vector
+      MnThreadPool::Foreach(n, [&](unsigned int i) {
+         MnAlgebraicVector xi = x;
+         computeDerivative(i, xi);
+      });
+      return std::pair<FunctionGradient, MnAlgebraicVector>(FunctionGradient(grd, g2, gstep), dgrd);
    }
 
+   MPIProcess mpiproc(n, 0);
+   // initial starting values
+   unsigned int startElementIndex = mpiproc.StartElementIndex();
+   unsigned int endElementIndex = mpiproc.EndElementIndex();
+
+   for (unsigned int i = startElementIndex; i < endElementIndex; i++)
+      computeDerivative(i, x);
+
    mpiproc.SyncVector(grd);
    mpiproc.SyncVector(gstep);
    mpiproc.SyncVector(dgrd);
@@ -0,0 +1,288 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2024 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#include "Minuit2/LBFGSBuilder.h"
+#include "Minuit2/GradientCalculator.h"
+#include "Minuit2/MinimumState.h"
+#include "Minuit2/MinimumError.h"
+#include "Minuit2/FunctionGradient.h"
+#include "Minuit2/FunctionMinimum.h"
+#include "Minuit2/MnLineSearch.h"
+#include "Minuit2/MinimumSeed.h"
+#include "Minuit2/MnFcn.h"
+#include "Minuit2/MnMachinePrecision.h"
+#include "Minuit2/MnParabolaPoint.h"
+#include "Minuit2/LaSum.h"
+#include "Minuit2/LaProd.h"
+#include "Minuit2/MnStrategy.h"
+#include "Minuit2/MnPrint.h"
+
+#include <cmath>
+#include <deque>
+
+namespace ROOT {
+
+namespace Minuit2 {
+
+double inner_product(const LAVector &, const LAVector &);
+
+namespace {
+
+/// last changes of the parameters (s) and of the gradient (y), with rho = 1 / (s^T y)
+struct LBFGSHistory {
+   std::deque<MnAlgebraicVector> fS;
+   std::deque<MnAlgebraicVector> fY;
+   std::deque<double> fRho;
+
+   bool Empty() const { return fRho.empty(); }
+   void Clear()
+   {
+      fS.clear();
+      fY.clear();
+      fRho.clear();
+   }
+};
+
+/// inverse of the second derivatives, or 1 when they are not available
+double DiagonalInvHessian(const FunctionGradient &g, unsigned int i, const MnMachinePrecision &prec)
+{
+   if (!g.HasG2())
+      return 1.;
+   double g2 = std::fabs(g.G2()(i));
+   return g2 > prec.Eps() ? 1. / g2 : 1.;
+}
+
+/// product of the L-BFGS approximation of the inverse Hessian with the gradient (two-loop recursion);
+/// the initial approximation is the diagonal of the inverse second derivatives, scaled with the latest correction
+MnAlgebraicVector InvHessianProduct(const FunctionGradient &g, const LBFGSHistory &hist, const MnMachinePrecision &prec)
+{
+   const unsigned int n = g.Vec().size();
+   const unsigned int m = hist.fRho.size();
+   MnAlgebraicVector q = g.Vec();
+   std::vector<double> alpha(m);
+   for (unsigned int k = m; k-- > 0;) {
+      alpha[k] = hist.fRho[k] * inner_product(hist.fS[k], q);
+      q += (-alpha[k]) * hist.fY[k];
+   }
+
+   double scale = 1.;
+   if (m > 0) {
+      // scale such that the diagonal matrix has the curvature of the latest correction along y
+      const MnAlgebraicVector &y = hist.fY.back();
+      double ydy = 0.;
+      for (unsigned int i = 0; i < n; i++)
+         ydy += y(i) * DiagonalInvHessian(g, i, prec) * y(i);
+      if (ydy > 0.)
+         scale = 1. / (hist.fRho.back() * ydy);
+   }
+   for (unsigned int i = 0; i < n; i++)
+      q(i) *= scale * DiagonalInvHessian(g, i, prec);
+
+   for (unsigned int k = 0; k < m; k++) {
+      double beta = hist.fRho[k] * inner_product(hist.fY[k], q);
+      q += (alpha[k] - beta) * hist.fS[k];
+   }
+   return q;
+}
+
+} // namespace
+
+double LBFGSBuilder::DiagonalEdm(const FunctionGradient &g, const MnMachinePrecision &prec)
+{
+   // edm = 1/2 g^T V g with V the diagonal of the inverse second derivatives
+   double edm = 0.;
+   for (unsigned int i = 0; i < g.Vec().size(); i++)
+      edm += g.Vec()(i) * g.Vec()(i) * DiagonalInvHessian(g, i, prec);
+   return 0.5 * edm;
+}
+
+void LBFGSBuilder::AddResult(std::vector<MinimumState> &result, const MinimumState &state) const
+{
+   result.push_back(state);
+   if (TraceIter())
+      TraceIteration(result.size() - 1, result.back());
+   else {
+      MnPrint print("LBFGSBuilder", PrintLevel());
+      print.Info(MnPrint::Oneline(result.back(), result.size() - 1));
+   }
+}
+
+FunctionMinimum LBFGSBuilder::Minimum(const MnFcn &fcn, const GradientCalculator &gc, const MinimumSeed &seed,
+                                      const MnStrategy & /*strategy*/, unsigned int maxfcn, double edmval) const
+{
+   MnPrint print("LBFGSBuilder", PrintLevel());
+
+   // same edm convention as the VariableMetricBuilder (consistent with F77 Minuit)
+   edmval *= 0.002;
+
+   FunctionMinimum min(seed, fcn.Up());
+
+   if (seed.Parameters().Vec().size() == 0) {
+      print.Warn("No free parameters.");
+      return min;
+   }
+
+   if (!seed.IsValid()) {
+      print.Error("Minimum seed invalid.");
+      return min;
+   }
+
+   std::vector<MinimumState> result;
+   if (StorageLevel() > 0)
+      result.reserve(10);
+   else
+      result.reserve(2);
+
+   print.Info("Start iterating until Edm is <", edmval, "with call limit =", maxfcn, "and", fNCorrections,
+              "corrections");
+
+   AddResult(result, seed.State());
+
+   min = Minimum(fcn, gc, seed, result, maxfcn, edmval);
+
+   if (min.HasReachedCallLimit()) {
+      print.Warn("FunctionMinimum is invalid, reached function call limit");
+      return min;
+   }
+
+   // the error matrix is left unset whatever the strategy: computing the full Hessian would cost
+   // more than the minimization itself for many parameters, so it is done only when requested
+   // (MnHesse, or Minuit2Minimizer when the errors are needed)
+
+   print.Debug("Minimum found", min);
+
+   return min;
+}
+
+FunctionMinimum LBFGSBuilder::Minimum(const MnFcn &fcn, const GradientCalculator &gc, const MinimumSeed &seed,
+                                      std::vector<MinimumState> &result, unsigned int maxfcn, double edmval) const
+{
+   // perform a line search along -Hg, with H the L-BFGS approximation of the inverse Hessian,
+   // and update the corrections, until the edm is less than required (edmval)
+
+   MnPrint print("LBFGSBuilder", PrintLevel());
+
+   const MnMachinePrecision &prec = seed.Precision();
+
+   MinimumState s0 = result.back();
+   LBFGSHistory hist;
+   MnLineSearch lsearch;
+
+   // H * g at the current point
+   MnAlgebraicVector hg = InvHessianProduct(s0.Gradient(), hist, prec);
+   double edm = s0.Edm();
+
+   do {
+
+      // check if derivatives are not zero
+      if (inner_product(s0.Gradient().Vec(), s0.Gradient().Vec()) <= 0) {
+         print.Debug("all derivatives are zero - return current status");
+         break;
+      }
+
+      MnAlgebraicVector step = -1. * hg;
+
+      // gdel = s^T * g = -g^T H g so it must be negative
+      double gdel = inner_product(step, s0.Gradient().Grad());
+
+      print.Debug("Iteration", result.size(), "Fval", s0.Fval(), "numOfCall", fcn.NumOfCalls(), "gdel", gdel);
+
+      if (!(gdel < 0.)) {
+         if (hist.Empty()) {
+            print.Warn("Diagonal matrix not pos.def, gdel =", gdel, "; stop iterations");
+            break;
+         }
+         // restart from the diagonal approximation
+         print.Warn("Matrix not pos.def, gdel =", gdel, "> 0; reset the corrections");
+         hist.Clear();
+         hg = InvHessianProduct(s0.Gradient(), hist, prec);
+         continue;
+      }
+
+      MnParabolaPoint pp = lsearch(fcn, s0.Parameters(), step, gdel, prec);
+
+      // <= needed for case 0 <= 0
+      if (std::fabs(pp.Y() - s0.Fval()) <= std::fabs(s0.Fval()) * prec.Eps()) {
+         if (!hist.Empty()) {
+            print.Info("No improvement in line search; reset the corrections");
+            hist.Clear();
+            hg = InvHessianProduct(s0.Gradient(), hist, prec);
+            continue;
+         }
+         print.Warn("No improvement in line search");
+         break;
+      }
+
+      MinimumParameters p(s0.Vec() + pp.X() * step, pp.Y());
+
+      FunctionGradient g = gc(p, s0.Gradient());
+
+      // keep the correction only if the curvature condition s^T y > 0 holds, so that the
+      // approximation of the inverse Hessian stays positive definite
+      MnAlgebraicVector s = pp.X() * step;
+      MnAlgebraicVector y = g.Vec() - s0.Gradient().Vec();
+      double sy = inner_product(s, y);
+      if (sy > prec.Eps() * std::sqrt(inner_product(s, s) * inner_product(y, y))) {
+         hist.fS.push_back(s);
+         hist.fY.push_back(y);
+         hist.fRho.push_back(1. / sy);
+         if (hist.fRho.size() > fNCorrections) {
+            hist.fS.pop_front();
+            hist.fY.pop_front();
+            hist.fRho.pop_front();
+         }
+      } else {
+         print.Debug("Curvature condition not satisfied, s^T y =", sy, "; correction not used");
+      }
+
+      hg = InvHessianProduct(g, hist, prec);
+      edm = 0.5 * inner_product(g.Vec(), hg);
+
+      if (std::isnan(edm)) {
+         print.Warn("Edm is NaN; stop iterations");
+         break;
+      }
+
+      s0 = MinimumState(p, MinimumError(0), g, edm, fcn.NumOfCalls());
+      if (StorageLevel() || result.size() <= 1)
+         AddResult(result, s0);
+      else
+         // use a reduced state for not-final iterations
+         AddResult(result, MinimumState(p.Fval(), edm, fcn.NumOfCalls()));
+
+   } while (edm > edmval && fcn.NumOfCalls() < maxfcn); // end of iteration loop
+
+   // save last result in case of no complete final states
+   if (!result.back().IsValid())
+      result.back() = s0;
+
+   if (fcn.NumOfCalls() >= maxfcn) {
+      print.Warn("Call limit exceeded");
+      return FunctionMinimum(seed, result, fcn.Up(), FunctionMinimum::MnReachedCallLimit);
+   }
+
+   if (edm > edmval) {
+      if (edm < 10 * edmval) {
+         print.Info("Edm is close to limit - return current minimum");
+      } else if (edm < std::fabs(prec.Eps2() * result.back().Fval())) {
+         print.Warn("Edm is limited by Machine accuracy - return current minimum");
+      } else {
+         print.Warn("Iterations finish without convergence; Edm", edm, "Requested", edmval);
+         return FunctionMinimum(seed, result, fcn.Up(), FunctionMinimum::MnAboveMaxEdm);
+      }
+   }
+
+   print.Debug("Exiting successfully;", "Ncalls", fcn.NumOfCalls(), "FCN", result.back().Fval(), "Edm", edm,
+               "Requested", edmval);
+
+   return FunctionMinimum(seed, result, fcn.Up());
+}
+
+} // namespace Minuit2
+
+} // namespace ROOT
@@ -0,0 +1,69 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2024 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#include "Minuit2/LBFGSSeedGenerator.h"
+#include "Minuit2/LBFGSBuilder.h"
+#include "Minuit2/MinimumSeed.h"
+#include "Minuit2/MnFcn.h"
+#include "Minuit2/GradientCalculator.h"
+#include "Minuit2/AnalyticalGradientCalculator.h"
+#include "Minuit2/Numerical2PGradientCalculator.h"
+#include "Minuit2/MnUserParameterState.h"
+#include "Minuit2/MinimumParameters.h"
+#include "Minuit2/FunctionGradient.h"
+#include "Minuit2/MinimumError.h"
+#include "Minuit2/MinimumState.h"
+#include "Minuit2/MnStrategy.h"
+#include "Minuit2/MnPrint.h"
+
+namespace ROOT {
+
+namespace Minuit2 {
+
+MinimumSeed LBFGSSeedGenerator::
+operator()(const MnFcn &fcn, const GradientCalculator &gc, const MnUserParameterState &st, const MnStrategy &) const
+{
+   MnPrint print("LBFGSSeedGenerator");
+
+   const unsigned int n = st.VariableParameters();
+
+   print.Info("Computing seed for", n, "free parameters");
+
+   // initial starting values
+   MnAlgebraicVector x(n);
+   for (unsigned int i = 0; i < n; i++)
+      x(i) = st.IntParameters()[i];
+   double fcnmin = fcn(x);
+
+   MinimumParameters pa(x, fcnmin);
+   FunctionGradient dgrad = gc(pa);
+
+   // an existing covariance matrix of the user state is not used; the state has no error matrix
+   double edm = LBFGSBuilder::DiagonalEdm(dgrad, st.Precision());
+   MinimumState state(pa, MinimumError(0), dgrad, edm, fcn.NumOfCalls());
+
+   print.Info("Initial state:", MnPrint::Oneline(state));
+
+   return MinimumSeed(state, st.Trafo());
+}
+
+MinimumSeed LBFGSSeedGenerator::operator()(const MnFcn &fcn, const AnalyticalGradientCalculator &gc,
+                                           const MnUserParameterState &st, const MnStrategy &stra) const
+{
+   // the builder can work without G2, but a numerical G2 gives a better scaling of the first steps
+   // at the cost of 2 * n function calls
+   if (!gc.CanComputeG2() && stra.Strategy() >= 1) {
+      Numerical2PGradientCalculator ngc(fcn, st.Trafo(), stra);
+      return this->operator()(fcn, ngc, st, stra);
+   }
+   return this->operator()(fcn, static_cast<const GradientCalculator &>(gc), st, stra);
+}
+
+} // namespace Minuit2
+
+} // namespace ROOT
@@ -29,6 +29,7 @@
 #include "Minuit2/MnUserFcn.h"
 #include "Minuit2/MnPrint.h"
 #include "Minuit2/VariableMetricMinimizer.h"
+#include "Minuit2/LBFGSMinimizer.h"
 #include "Minuit2/SimplexMinimizer.h"
 #include "Minuit2/CombinedMinimizer.h"
 #include "Minuit2/ScanMinimizer.h"
@@ -109,6 +110,8 @@ Minuit2Minimizer::Minuit2Minimizer(const char *type) : Minimizer(), fDim(0), fMi
       algoType = kFumili;
    if (algoname == "bfgs")
       algoType = kMigradBFGS;
+   if (algoname == "lbfgs")
+      algoType = kLBFGS;
 
    SetMinimizerType(algoType);
 }
@@ -126,6 +129,9 @@ void Minuit2Minimizer::SetMinimizerType(ROOT::Minuit2::EMinimizerType type)
       // std::cout << "Minuit2Minimizer: minimize using MIGRAD " << std::endl;
       SetMinimizer(new ROOT::Minuit2::VariableMetricMinimizer(VariableMetricMinimizer::BFGSType()));
       return;
+   case ROOT::Minuit2::kLBFGS:
+      SetMinimizer(new ROOT::Minuit2::LBFGSMinimizer());
+      return;
    case ROOT::Minuit2::kSimplex:
       // std::cout << "Minuit2Minimizer: minimize using SIMPLEX " << std::endl;
       SetMinimizer(new ROOT::Minuit2::SimplexMinimizer());
@@ -445,6 +451,8 @@ ROOT::Minuit2::MnStrategy customizedStrategy(unsigned int strategyLevel, ROOT::M
    st.SetHessianStepTolerance(customize("HessianStepTolerance", st.HessianStepTolerance()));
    st.SetHessianG2Tolerance(customize("HessianG2Tolerance", st.HessianG2Tolerance()));
 
+   st.SetParallelDerivatives(customize("ParallelDerivatives", int(st.ParallelDerivatives())));
+
    return st;
 }
 
@@ -509,6 +517,12 @@ bool Minuit2Minimizer::Minimize()
       if (ret)
          SetStorageLevel(storageLevel);
 
+      // number of corrections kept by the L-BFGS minimizer
+      auto *lbfgsBuilder = dynamic_cast<ROOT::Minuit2::LBFGSBuilder *>(&fMinimizer->Builder());
+      int ncorrections = 0;
+      if (lbfgsBuilder && minuit2Opt->GetValue("LBFGSCorrections", ncorrections) && ncorrections > 0)
+         lbfgsBuilder->SetNumberOfCorrections(ncorrections);
+
       if (printLevel > 0) {
          std::cout << "Minuit2Minimizer::Minuit  - Changing default options" << std::endl;
          minuit2Opt->Print();
@@ -619,7 +633,10 @@ bool Minuit2Minimizer::ExamineMinimum(const ROOT::Minuit2::FunctionMinimum &min)
 
    fStatus = 0;
    std::string txt;
-   if (!min.HasPosDefCovar()) {
+   // the L-BFGS minimum has no error matrix when the errors are not requested
+   const bool noErrorsRequested = !IsValidError() && !min.HasCovariance() && fMinimizer &&
+                                  dynamic_cast<ROOT::Minuit2::LBFGSBuilder *>(&fMinimizer->Builder());
+   if (!min.HasPosDefCovar() && !noErrorsRequested) {
       // this happens normally when Hesse failed
       // it can happen in case MnSeed failed (see ROOT-9522)
       txt = "Covar is not pos def";
@@ -22,6 +22,7 @@
 #include "Minuit2/VariableMetricEDMEstimator.h"
 #include "Minuit2/FunctionMinimum.h"
 #include "Minuit2/MnPrint.h"
+#include "Minuit2/MnThreadPool.h"
 #include "Minuit2/MPIProcess.h"
 
 namespace ROOT {
@@ -228,15 +229,24 @@ MinimumState MnHesse::ComputeNumerical(const MnFcn &mfcn, const MinimumState &st
    print.Debug("Gradient is", st.Gradient().IsAnalytical() ? "analytical" : "numerical", "\n  point:", x,
                "\n  fcn  :", amin, "\n  grad :", grd, "\n  step :", gst, "\n  g2   :", g2);
 
-   for (unsigned int i = 0; i < n; i++) {
+   // with the ROOT thread pool the elements are computed in parallel, each one with its own copy of
+   // the parameter vector, so the result does not depend on the number of threads
+   const bool useThreadPool = fStrategy.ParallelDerivatives() && MnThreadPool::IsAvailable();
+   // the debug printing is done only in the sequential case
+   const bool printDebug = !useThreadPool;
 
+   // compute the second derivative with respect to parameter i, using x (equal to the parameter values
+   // on input and on output) for the function evaluations and adding their number to nfcn;
+   // return false if it is zero
+   auto computeDiagonal = [&](unsigned int i, MnAlgebraicVector &x, unsigned int &nfcn) {
       double xtf = x(i);
       double dmin = 8. * prec.Eps2() * (std::fabs(xtf) + prec.Eps2());
       double d = std::fabs(gst(i));
       if (d < dmin)
          d = dmin;
 
-      print.Debug("Derivative parameter", i, "d =", d, "dmin =", dmin);
+      if (printDebug)
+         print.Debug("Derivative parameter", i, "d =", d, "dmin =", dmin);
 
       for (unsigned int icyc = 0; icyc < Ncycles(); icyc++) {
          double sag = 0.;
@@ -247,10 +257,12 @@ MinimumState MnHesse::ComputeNumerical(const MnFcn &mfcn, const MinimumState &st
             fs1 = mfcn(x);
             x(i) = xtf - d;
             fs2 = mfcn(x);
+            nfcn += 2;
             x(i) = xtf;
             sag = 0.5 * (fs1 + fs2 - 2. * amin);
 
-            print.Debug("cycle", icyc, "mul", multpy, "\tsag =", sag, "d =", d);
+            if (printDebug)
+               print.Debug("cycle", icyc, "mul", multpy, "\tsag =", sag, "d =", d);
 
             //  Now as F77 Minuit - check that sag is not zero
             if (sag != 0)
@@ -267,18 +279,7 @@ MinimumState MnHesse::ComputeNumerical(const MnFcn &mfcn, const MinimumState &st
          }
 
       L26:
-         // get parameter name for i
-         // (need separate scope for avoiding compl error when declaring name)
-         print.Warn("2nd derivative zero for parameter", trafo.Name(trafo.ExtOfInt(i)),
-                    "; MnHesse fails and will return diagonal matrix");
-
-         for (unsigned int j = 0; j < n; j++) {
-            double tmp = g2(j) < prec.Eps2() ? 1. : 1. / g2(j);
-            vhmat(j, j) = tmp < prec.Eps2() ? 1. : tmp;
-         }
-
-         return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed), st.Gradient(), st.Edm(),
-                             mfcn.NumOfCalls());
+         return false;
 
       L30:
          double g2bfor = g2(i);
@@ -294,8 +295,9 @@ MinimumState MnHesse::ComputeNumerical(const MnFcn &mfcn, const MinimumState &st
          if (d < dmin)
             d = dmin;
 
-         print.Debug("g1 =", grd(i), "g2 =", g2(i), "step =", gst(i), "d =", d, "diffd =", std::fabs(d - dlast) / d,
-                     "diffg2 =", std::fabs(g2(i) - g2bfor) / g2(i));
+         if (printDebug)
+            print.Debug("g1 =", grd(i), "g2 =", g2(i), "step =", gst(i), "d =", d, "diffd =", std::fabs(d - dlast) / d,
+                        "diffg2 =", std::fabs(g2(i) - g2bfor) / g2(i));
 
          // see if converged
          if (std::fabs((d - dlast) / d) < Tolerstp())
@@ -305,19 +307,69 @@ MinimumState MnHesse::ComputeNumerical(const MnFcn &mfcn, const MinimumState &st
          d = std::min(d, 10. * dlast);
          d = std::max(d, 0.1 * dlast);
       }
+      return true;
+   };
+
+   // return the state with the diagonal matrix of the inverse second derivatives, in case of failure
+   auto diagonalState = [&](const MnAlgebraicVector &g2diag, MinimumError::Status status) {
+      for (unsigned int j = 0; j < n; j++) {
+         double tmp = g2diag(j) < prec.Eps2() ? 1. : 1. / g2diag(j);
+         vhmat(j, j) = tmp < prec.Eps2() ? 1. : tmp;
+      }
+      return MinimumState(st.Parameters(), MinimumError(vhmat, status), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
+   };
+
+   if (useThreadPool) {
+      const MnAlgebraicVector g2initial = g2;
+      const unsigned int ncallInitial = mfcn.NumOfCalls();
+      std::vector<int> ok(n);
+      std::vector<unsigned int> ncalls(n, 0);
+      MnThreadPool::Foreach(n, [&](unsigned int i) {
+         MnAlgebraicVector xi = x;
+         ok[i] = computeDiagonal(i, xi, ncalls[i]);
+      });
+      // check the parameters in order, as in the sequential case
+      unsigned int ncall = ncallInitial;
+      for (unsigned int i = 0; i < n; i++) {
+         // second derivatives of the parameters which would have been computed sequentially
+         auto g2done = [&]() {
+            MnAlgebraicVector g2diag = g2initial;
+            for (unsigned int j = 0; j <= i; j++)
+               g2diag(j) = g2(j);
+            return g2diag;
+         };
+         if (!ok[i]) {
+            print.Warn("2nd derivative zero for parameter", trafo.Name(trafo.ExtOfInt(i)),
+                       "; MnHesse fails and will return diagonal matrix");
+            return diagonalState(g2done(), MinimumError::MnHesseFailed);
+         }
+         vhmat(i, i) = g2(i);
+         ncall += ncalls[i];
+         if (ncall > maxcalls) {
+            print.Warn("Maximum number of allowed function calls exhausted; will return diagonal matrix");
+            return diagonalState(g2done(), MinimumError::MnReachedCallLimit);
+         }
+      }
+   }
+
+   for (unsigned int i = 0; i < n && !useThreadPool; i++) {
+
+      unsigned int nfcn = 0;
+      if (!computeDiagonal(i, x, nfcn)) {
+         // get parameter name for i
+         // (need separate scope for avoiding compl error when declaring name)
+         print.Warn("2nd derivative zero for parameter", trafo.Name(trafo.ExtOfInt(i)),
+                    "; MnHesse fails and will return diagonal matrix");
+
+         return diagonalState(g2, MinimumError::MnHesseFailed);
+      }
       vhmat(i, i) = g2(i);
       if (mfcn.NumOfCalls() > maxcalls) {
 
          // std::cout<<"maxcalls " << maxcalls << " " << mfcn.NumOfCalls() << "  " <<   st.NFcn() << std::endl;
          print.Warn("Maximum number of allowed function calls exhausted; will return diagonal matrix");
 
-         for (unsigned int j = 0; j < n; j++) {
-            double tmp = g2(j) < prec.Eps2() ? 1. : 1. / g2(j);
-            vhmat(j, j) = tmp < prec.Eps2() ? 1. : tmp;
-         }
-
-         return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnReachedCallLimit), st.Gradient(),
-                             st.Edm(), mfcn.NumOfCalls());
+         return diagonalState(g2, MinimumError::MnReachedCallLimit);
       }
    }
 
@@ -335,7 +387,32 @@ MinimumState MnHesse::ComputeNumerical(const MnFcn &mfcn, const MinimumState &st
    // off-diagonal Elements
    // initial starting values
    bool doCentralFD = fStrategy.HessianCentralFDMixedDerivatives();
-   if (n > 0) {
+   if (n > 0 && useThreadPool) {
+      // each row is computed with its own copy of the parameter vector, whose values are restored
+      // exactly after each evaluation
+      const MnAlgebraicVector x0 = x;
+      MnThreadPool::Foreach(n - 1, [&](unsigned int i) {
+         MnAlgebraicVector xi = x0;
+         xi(i) = x0(i) + dirin(i);
+         for (unsigned int j = i + 1; j < n; j++) {
+            xi(j) = x0(j) + dirin(j);
+            double fs1 = mfcn(xi);
+            if (!doCentralFD) {
+               vhmat(i, j) = (fs1 + amin - yy(i) - yy(j)) / (dirin(i) * dirin(j));
+            } else {
+               // three more function evaluations required for central fd
+               xi(i) = x0(i) - dirin(i);
+               double fs3 = mfcn(xi);
+               xi(j) = x0(j) - dirin(j);
+               double fs4 = mfcn(xi);
+               xi(i) = x0(i) + dirin(i);
+               double fs2 = mfcn(xi);
+               vhmat(i, j) = (fs1 - fs2 - fs3 + fs4) / (4. * dirin(i) * dirin(j));
+            }
+            xi(j) = x0(j);
+         }
+      });
+   } else if (n > 0) {
       MPIProcess mpiprocOffDiagonal(n * (n - 1) / 2, 0);
       unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
       unsigned int endParIndexOffDiagonal = mpiprocOffDiagonal.EndElementIndex();
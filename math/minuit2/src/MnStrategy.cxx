@@ -13,13 +13,13 @@ namespace ROOT {
 
 namespace Minuit2 {
 
-MnStrategy::MnStrategy() : fHessCFDG2(0), fHessForcePosDef(1), fStoreLevel(1)
+MnStrategy::MnStrategy() : fHessCFDG2(0), fHessForcePosDef(1), fStoreLevel(1), fParallelDeriv(0)
 {
    // default strategy
    SetMediumStrategy();
 }
 
-MnStrategy::MnStrategy(unsigned int stra) : fHessCFDG2(0), fHessForcePosDef(1), fStoreLevel(1)
+MnStrategy::MnStrategy(unsigned int stra) : fHessCFDG2(0), fHessForcePosDef(1), fStoreLevel(1), fParallelDeriv(0)
 {
    // user defined strategy (0, 1, 2, >=3)
    if (stra == 0)
@@ -0,0 +1,48 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2024 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#include "Minuit2/MnThreadPool.h"
+
+#ifdef USE_ROOT_ERROR
+#include "RConfigure.h"
+#endif
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+namespace ROOT {
+
+namespace Minuit2 {
+
+bool MnThreadPool::IsAvailable()
+{
+#ifdef R__USE_IMT
+   return true;
+#else
+   return false;
+#endif
+}
+
+void MnThreadPool::Foreach(unsigned int n, const std::function<void(unsigned int)> &func)
+{
+#ifdef R__USE_IMT
+   if (n > 1) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(func, ROOT::TSeqU(n));
+      return;
+   }
+#endif
+   for (unsigned int i = 0; i < n; ++i)
+      func(i);
+}
+
+} // namespace Minuit2
+
+} // namespace ROOT
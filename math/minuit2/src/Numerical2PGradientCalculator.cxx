@@ -16,6 +16,7 @@
 #include "Minuit2/FunctionGradient.h"
 #include "Minuit2/MnStrategy.h"
 #include "Minuit2/MnPrint.h"
+#include "Minuit2/MnThreadPool.h"
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -97,35 +98,13 @@ operator()(const MinimumParameters &par, const FunctionGradient &Gradient) const
 
    print.Debug("Calculating gradient around function value", fcnmin, "\n\t at point", par.Vec());
 
-#ifndef _OPENMP
-
-   MPIProcess mpiproc(n, 0);
-
-   // for serial execution this can be outside the loop
-   MnAlgebraicVector x = par.Vec();
-
-   unsigned int startElementIndex = mpiproc.StartElementIndex();
-   unsigned int endElementIndex = mpiproc.EndElementIndex();
-
-   for (unsigned int i = startElementIndex; i < endElementIndex; i++) {
-
-#else
-
-   // parallelize this loop using OpenMP
-//#define N_PARALLEL_PAR 5
-#pragma omp parallel
-#pragma omp for
-   //#pragma omp for schedule (static, N_PARALLEL_PAR)
-
-   for (int i = 0; i < int(n); i++) {
-
-#endif
-
-#ifdef _OPENMP
-      // create in loop since each thread will use its own copy
-      MnAlgebraicVector x = par.Vec();
-#endif
+   // with the ROOT thread pool the parameters are computed in parallel; the trace printing is done only
+   // in the sequential case
+   const bool useThreadPool = Strategy().ParallelDerivatives() && MnThreadPool::IsAvailable();
 
+   // compute the derivatives with respect to parameter i, using x (equal to the parameter values
+   // on input and on output) for the function evaluations
+   auto computeDerivative = [&](unsigned int i, MnAlgebraicVector &x) {
       double xtf = x(i);
       double epspri = eps2 + std::fabs(grd(i) * eps2);
       double stepb4 = 0.;
@@ -169,6 +148,7 @@ operator()(const MinimumParameters &par, const FunctionGradient &Gradient) const
          grd(i) = 0.5 * (fs1 - fs2) / step;
          g2(i) = (fs1 + fs2 - 2. * fcnmin) / step / step;
 
+         if (!useThreadPool) {
 #ifdef _OPENMP
 #pragma omp critical
 #endif
@@ -200,6 +180,7 @@ operator()(const MinimumParameters &par, const FunctionGradient &Gradient) const
                os.precision(pr);
             });
          }
+         }
 
          if (std::fabs(grdb4 - grd(i)) / (std::fabs(grd(i)) + dfmin / step) < GradTolerance()) {
             //    std::cout<<"j= "<<j<<std::endl;
@@ -213,13 +194,52 @@ operator()(const MinimumParameters &par, const FunctionGradient &Gradient) const
       //     vgrd(i) = grd;
       //     vgrd2(i) = g2;
       //     vgstp(i) = gstep;
-   }
+   };
+
+   if (useThreadPool) {
+
+      // each parameter is computed independently with its own copy of the parameter vector,
+      // so the result does not depend on the number of threads
+      MnThreadPool::Foreach(n, [&](unsigned int i) {
+         MnAlgebraicVector x = par.Vec();
+         computeDerivative(i, x);
+      });
+
+   } else {
 
 #ifndef _OPENMP
-   mpiproc.SyncVector(grd);
-   mpiproc.SyncVector(g2);
-   mpiproc.SyncVector(gstep);
+
+      MPIProcess mpiproc(n, 0);
+
+      // for serial execution this can be outside the loop
+      MnAlgebraicVector x = par.Vec();
+
+      unsigned int startElementIndex = mpiproc.StartElementIndex();
+      unsigned int endElementIndex = mpiproc.EndElementIndex();
+
+      for (unsigned int i = startElementIndex; i < endElementIndex; i++)
+         computeDerivative(i, x);
+
+      mpiproc.SyncVector(grd);
+      mpiproc.SyncVector(g2);
+      mpiproc.SyncVector(gstep);
+
+#else
+
+      // parallelize this loop using OpenMP
+//#define N_PARALLEL_PAR 5
+#pragma omp parallel
+#pragma omp for
+      //#pragma omp for schedule (static, N_PARALLEL_PAR)
+
+      for (int i = 0; i < int(n); i++) {
+         // create in loop since each thread will use its own copy
+         MnAlgebraicVector x = par.Vec();
+         computeDerivative(i, x);
+      }
+
 #endif
+   }
 
    // print after parallel processing to avoid synchronization issues
    print.Debug([&](std::ostream &os) {
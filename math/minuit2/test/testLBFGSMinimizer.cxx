@@ -0,0 +1,123 @@
+#include "gtest/gtest.h"
+
+#include "Math/Functor.h"
+#include "Minuit2/FCNGradientBase.h"
+#include "Minuit2/FunctionMinimum.h"
+#include "Minuit2/LBFGSMinimizer.h"
+#include "Minuit2/Minuit2Minimizer.h"
+#include "Minuit2/MnHesse.h"
+#include "Minuit2/MnStrategy.h"
+#include "Minuit2/MnUserParameters.h"
+#include "Minuit2/VariableMetricMinimizer.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace ROOT::Minuit2;
+
+namespace {
+// Chain of coupled parameters with minimum at x_i = 1 + 0.01 i and different scales
+class ChainFcn : public FCNGradientBase {
+public:
+   double operator()(std::vector<double> const &x) const override
+   {
+      double f = 0;
+      for (unsigned int i = 0; i < x.size(); ++i) {
+         const double d = Delta(x, i);
+         f += Weight(i) * d * d;
+         if (i > 0)
+            f += 0.5 * d * Delta(x, i - 1);
+      }
+      return f;
+   }
+   std::vector<double> Gradient(std::vector<double> const &x) const override
+   {
+      std::vector<double> g(x.size());
+      for (unsigned int i = 0; i < x.size(); ++i) {
+         g[i] = 2. * Weight(i) * Delta(x, i);
+         if (i > 0)
+            g[i] += 0.5 * Delta(x, i - 1);
+         if (i + 1 < x.size())
+            g[i] += 0.5 * Delta(x, i + 1);
+      }
+      return g;
+   }
+   double Up() const override { return 1.; }
+
+private:
+   static double Delta(std::vector<double> const &x, unsigned int i) { return x[i] - (1. + 0.01 * i); }
+   static double Weight(unsigned int i) { return 1. + (i % 10); }
+};
+
+MnUserParameters MakeParameters(unsigned int n)
+{
+   MnUserParameters upar;
+   for (unsigned int i = 0; i < n; ++i)
+      upar.Add("x" + std::to_string(i), 0., 0.1);
+   return upar;
+}
+} // namespace
+
+// Many parameters, without error matrix
+TEST(LBFGSMinimizer, ManyParameters)
+{
+   const unsigned int n = 2000;
+   ChainFcn fcn;
+   LBFGSMinimizer minimizer;
+   FunctionMinimum min = minimizer.Minimize(fcn, MakeParameters(n), MnStrategy(0));
+
+   ASSERT_TRUE(min.IsValid());
+   EXPECT_FALSE(min.HasCovariance());
+   EXPECT_NEAR(min.Fval(), 0., 1e-3);
+   for (unsigned int i = 0; i < n; ++i)
+      EXPECT_NEAR(min.UserState().Value(i), 1. + 0.01 * i, 1e-2) << "parameter " << i;
+}
+
+// The errors computed with Hesse at the L-BFGS minimum agree with Migrad
+TEST(LBFGSMinimizer, SameAsMigrad)
+{
+   const unsigned int n = 20;
+   ChainFcn fcn;
+   // numerical gradient
+   const FCNBase &fcnNoGrad = fcn;
+   for (unsigned int ncorrections : {1u, 5u, 10u}) {
+      FunctionMinimum lbfgs = LBFGSMinimizer(ncorrections).Minimize(fcnNoGrad, MakeParameters(n), MnStrategy(1));
+      FunctionMinimum migrad = VariableMetricMinimizer().Minimize(fcnNoGrad, MakeParameters(n), MnStrategy(1));
+
+      ASSERT_TRUE(lbfgs.IsValid());
+      ASSERT_TRUE(migrad.IsValid());
+      // the error matrix is not computed by the minimization, whatever the strategy
+      EXPECT_FALSE(lbfgs.HasCovariance());
+      MnHesse()(fcnNoGrad, lbfgs);
+      EXPECT_TRUE(lbfgs.HasValidCovariance());
+      for (unsigned int i = 0; i < n; ++i) {
+         EXPECT_NEAR(lbfgs.UserState().Value(i), migrad.UserState().Value(i), 0.05 * migrad.UserState().Error(i));
+         EXPECT_NEAR(lbfgs.UserState().Error(i), migrad.UserState().Error(i), 1e-3 * migrad.UserState().Error(i));
+      }
+   }
+}
+
+// Minuit2Minimizer runs Hesse at the L-BFGS minimum only when the errors are requested
+TEST(LBFGSMinimizer, Minuit2MinimizerErrors)
+{
+   const unsigned int n = 20;
+   ChainFcn fcn;
+   auto f = [&](const double *x) { return fcn(std::vector<double>(x, x + n)); };
+   ROOT::Math::Functor func(f, n);
+   for (bool validError : {false, true}) {
+      ROOT::Minuit2::Minuit2Minimizer minimizer("LBFGS");
+      minimizer.SetFunction(func);
+      for (unsigned int i = 0; i < n; ++i)
+         minimizer.SetVariable(i, "x" + std::to_string(i), 0., 0.1);
+      minimizer.SetValidError(validError);
+
+      ASSERT_TRUE(minimizer.Minimize());
+      EXPECT_EQ(minimizer.Status(), 0);
+      EXPECT_EQ(minimizer.CovMatrixStatus(), validError ? 3 : -1);
+      if (validError)
+         EXPECT_GT(minimizer.Errors()[0], 0.);
+      for (unsigned int i = 0; i < n; ++i)
+         EXPECT_NEAR(minimizer.X()[i], 1. + 0.01 * i, 1e-2) << "parameter " << i;
+   }
+}
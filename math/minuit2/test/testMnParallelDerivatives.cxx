@@ -0,0 +1,79 @@
+#include "gtest/gtest.h"
+
+#include "Minuit2/FCNBase.h"
+#include "Minuit2/FunctionMinimum.h"
+#include "Minuit2/MnHesse.h"
+#include "Minuit2/MnMigrad.h"
+#include "Minuit2/MnStrategy.h"
+#include "Minuit2/MnUserParameters.h"
+
+#include "RConfigure.h"
+#include "TROOT.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace ROOT::Minuit2;
+
+namespace {
+// Thread-safe function with correlated parameters
+class CorrelatedFcn : public FCNBase {
+public:
+   double operator()(std::vector<double> const &x) const override
+   {
+      double f = 0;
+      for (unsigned int i = 0; i < x.size(); ++i) {
+         const double xi = x[i] - 0.1 * (i + 1);
+         f += (i + 1) * xi * xi + std::pow(xi, 4);
+         if (i > 0)
+            f += 0.5 * xi * (x[i - 1] - 0.1 * i);
+      }
+      return f;
+   }
+   double Up() const override { return 1.; }
+};
+
+FunctionMinimum Minimize(unsigned int parallel)
+{
+   CorrelatedFcn fcn;
+   MnUserParameters upar;
+   for (unsigned int i = 0; i < 8; ++i)
+      upar.Add("x" + std::to_string(i), 1. + i, 0.1);
+   // a limited parameter, to test the transformation in the Hessian
+   upar.SetLimits("x3", -2., 5.);
+   MnStrategy strategy(2);
+   strategy.SetParallelDerivatives(parallel);
+   MnMigrad migrad(fcn, upar, strategy);
+   FunctionMinimum min = migrad();
+   MnHesse hesse(strategy);
+   hesse(fcn, min);
+   return min;
+}
+} // namespace
+
+// The parallel computation of the derivatives gives the sequential result. The mixed derivatives
+// of the Hessian are computed from exact shifts of the parameters instead of the accumulated ones,
+// so the results can differ by rounding only.
+TEST(MnParallelDerivatives, SameAsSequential)
+{
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   FunctionMinimum seq = Minimize(0);
+   FunctionMinimum par = Minimize(1);
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+
+   ASSERT_TRUE(seq.IsValid());
+   ASSERT_TRUE(par.IsValid());
+   EXPECT_NEAR(par.Fval(), seq.Fval(), 1e-12);
+   const MnUserParameterState &s1 = seq.UserState();
+   const MnUserParameterState &s2 = par.UserState();
+   for (unsigned int i = 0; i < s1.Params().size(); ++i) {
+      EXPECT_NEAR(s2.Value(i), s1.Value(i), 1e-8);
+      EXPECT_NEAR(s2.Error(i), s1.Error(i), 1e-6 * s1.Error(i));
+      for (unsigned int j = 0; j < s1.Params().size(); ++j)
+         EXPECT_NEAR(s2.Covariance()(i, j), s1.Covariance()(i, j), 1e-6 * s1.Error(i) * s1.Error(j));
+   }
+}
@@ -0,0 +1,425 @@
+// @(#)root/smatrix:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_Math_SMatrixPack
+#define ROOT_Math_SMatrixPack
+
+/** @file
+ * Packs of small matrices and vectors of the same dimension, stored as structure of arrays, and the operations of
+ * track fitting on them: products, similarity transformations, Cholesky inversion and the Kalman filter update.
+ *
+ * Each element of a pack is an array of N values, one for each matrix (or "lane") of the pack, and each operation
+ * is written as loops over the lanes, which are vectorized by the compiler: a pack of N = 64 / sizeof(T) matrices
+ * fills the widest vector registers. The same sequence of operations is thus applied to N matrices at once, instead
+ * of one SMatrix at a time.
+ *
+ * usage example:
+ * @code
+ * SMatrixPack<double, 5, 5, MatRepSym<double, 5>> cov;  // covariance matrices of 8 tracks
+ * SVectorPack<double, 5> par;                            // their parameters
+ * for (unsigned int l = 0; l < cov.kLanes; ++l) {
+ *    cov.Set(l, tracks[l].Covariance());
+ *    par.Set(l, tracks[l].Parameters());
+ * }
+ * // update with 2D measurements m, of covariance V, of the projection H of the parameters
+ * KalmanUpdate(par, cov, m, V, H);
+ * @endcode
+ */
+
+#include "Math/SMatrix.h"
+#include "Math/SVector.h"
+
+#include <cmath>
+#include <type_traits>
+
+namespace ROOT {
+
+namespace Math {
+
+namespace SMatrixPackHelpers {
+
+/// storage of the elements of a matrix representation: number of elements and position of element (i, j)
+template <class R>
+struct Layout;
+
+template <class T, unsigned int D1, unsigned int D2>
+struct Layout<MatRepStd<T, D1, D2>> {
+   static constexpr unsigned int kSize = D1 * D2;
+   static constexpr unsigned int Offset(unsigned int i, unsigned int j) { return i * D2 + j; }
+};
+
+/// same packed storage of the lower triangle as MatRepSym
+template <class T, unsigned int D>
+struct Layout<MatRepSym<T, D>> {
+   static constexpr unsigned int kSize = D * (D + 1) / 2;
+   static constexpr unsigned int Offset(unsigned int i, unsigned int j)
+   {
+      return i >= j ? i * (i + 1) / 2 + j : j * (j + 1) / 2 + i;
+   }
+};
+
+} // namespace SMatrixPackHelpers
+
+/** SMatrixPack
+ * Pack of N matrices D1 x D2 with the representation R (MatRepStd or MatRepSym), stored as structure of arrays:
+ * the N values of each matrix element are contiguous.
+ *
+ * @ingroup SMatrixSVector
+ */
+template <class T, unsigned int D1, unsigned int D2 = D1, class R = MatRepStd<T, D1, D2>,
+          unsigned int N = 64 / sizeof(T)>
+class SMatrixPack {
+public:
+   typedef T value_type;
+   typedef R rep_type;
+   typedef SMatrixPackHelpers::Layout<R> layout_type;
+
+   enum {
+      kRows = D1,  ///< number of rows
+      kCols = D2,  ///< number of columns
+      kSize = layout_type::kSize, ///< number of stored elements of each matrix
+      kLanes = N   ///< number of matrices in the pack
+   };
+
+   /// pack of zero matrices
+   SMatrixPack()
+   {
+      for (unsigned int k = 0; k < kSize; ++k)
+         for (unsigned int l = 0; l < N; ++l)
+            fArray[k][l] = 0;
+   }
+
+   /// values of the element (i, j) of all the matrices of the pack
+   T *Lanes(unsigned int i, unsigned int j) { return fArray[layout_type::Offset(i, j)]; }
+   const T *Lanes(unsigned int i, unsigned int j) const { return fArray[layout_type::Offset(i, j)]; }
+
+   /// element (i, j) of the matrix in the given lane
+   T &At(unsigned int i, unsigned int j, unsigned int lane) { return fArray[layout_type::Offset(i, j)][lane]; }
+   T At(unsigned int i, unsigned int j, unsigned int lane) const { return fArray[layout_type::Offset(i, j)][lane]; }
+
+   /// copy the matrix of the given lane into an SMatrix
+   SMatrix<T, D1, D2, R> Get(unsigned int lane) const
+   {
+      SMatrix<T, D1, D2, R> m;
+      for (unsigned int k = 0; k < kSize; ++k)
+         m.Array()[k] = fArray[k][lane];
+      return m;
+   }
+
+   /// set the matrix of the given lane from an SMatrix
+   void Set(unsigned int lane, const SMatrix<T, D1, D2, R> &m)
+   {
+      for (unsigned int k = 0; k < kSize; ++k)
+         fArray[k][lane] = m.Array()[k];
+   }
+
+   /** invert in place the symmetric positive definite matrices of the pack, with the Cholesky decomposition
+    * (same algorithm as SMatrix::InvertChol). Only available for the symmetric representation MatRepSym. The matrices which are not positive definite are left unchanged.
+    * If laneOk is not null, it is filled with the success of each lane.
+    * @returns true if all the matrices have been inverted
+    */
+   bool InvertChol(bool *laneOk = nullptr);
+
+private:
+   alignas(64) T fArray[kSize][N];
+};
+
+/** SVectorPack
+ * Pack of N vectors of dimension D, stored as structure of arrays.
+ *
+ * @ingroup SMatrixSVector
+ */
+template <class T, unsigned int D, unsigned int N = 64 / sizeof(T)>
+class SVectorPack {
+public:
+   typedef T value_type;
+
+   enum {
+      kSize = D, ///< dimension of the vectors
+      kLanes = N ///< number of vectors in the pack
+   };
+
+   /// pack of zero vectors
+   SVectorPack()
+   {
+      for (unsigned int i = 0; i < D; ++i)
+         for (unsigned int l = 0; l < N; ++l)
+            fArray[i][l] = 0;
+   }
+
+   /// values of the element i of all the vectors of the pack
+   T *Lanes(unsigned int i) { return fArray[i]; }
+   const T *Lanes(unsigned int i) const { return fArray[i]; }
+
+   /// element i of the vector in the given lane
+   T &At(unsigned int i, unsigned int lane) { return fArray[i][lane]; }
+   T At(unsigned int i, unsigned int lane) const { return fArray[i][lane]; }
+
+   /// copy the vector of the given lane into an SVector
+   SVector<T, D> Get(unsigned int lane) const
+   {
+      SVector<T, D> v;
+      for (unsigned int i = 0; i < D; ++i)
+         v[i] = fArray[i][lane];
+      return v;
+   }
+
+   /// set the vector of the given lane from an SVector
+   void Set(unsigned int lane, const SVector<T, D> &v)
+   {
+      for (unsigned int i = 0; i < D; ++i)
+         fArray[i][lane] = v[i];
+   }
+
+private:
+   alignas(64) T fArray[D][N];
+};
+
+/**
+   Products of the matrices of two packs, lane by lane: C = A * B
+   @ingroup MatrixFunctions
+*/
+template <class T, unsigned int D1, unsigned int D, unsigned int D2, class R1, class R2, unsigned int N>
+SMatrixPack<T, D1, D2, MatRepStd<T, D1, D2>, N>
+operator*(const SMatrixPack<T, D1, D, R1, N> &a, const SMatrixPack<T, D, D2, R2, N> &b)
+{
+   SMatrixPack<T, D1, D2, MatRepStd<T, D1, D2>, N> c;
+   for (unsigned int i = 0; i < D1; ++i) {
+      for (unsigned int j = 0; j < D2; ++j) {
+         T *cij = c.Lanes(i, j);
+         for (unsigned int k = 0; k < D; ++k) {
+            const T *aik = a.Lanes(i, k);
+            const T *bkj = b.Lanes(k, j);
+            for (unsigned int l = 0; l < N; ++l)
+               cij[l] += aik[l] * bkj[l];
+         }
+      }
+   }
+   return c;
+}
+
+/**
+   Products of the matrices and of the vectors of two packs, lane by lane: w = A * v
+   @ingroup MatrixFunctions
+*/
+template <class T, unsigned int D1, unsigned int D2, class R, unsigned int N>
+SVectorPack<T, D1, N> operator*(const SMatrixPack<T, D1, D2, R, N> &a, const SVectorPack<T, D2, N> &v)
+{
+   SVectorPack<T, D1, N> w;
+   for (unsigned int i = 0; i < D1; ++i) {
+      T *wi = w.Lanes(i);
+      for (unsigned int k = 0; k < D2; ++k) {
+         const T *aik = a.Lanes(i, k);
+         const T *vk = v.Lanes(k);
+         for (unsigned int l = 0; l < N; ++l)
+            wi[l] += aik[l] * vk[l];
+      }
+   }
+   return w;
+}
+
+/**
+   Similarity transformations of the symmetric matrices of a pack, lane by lane: B = U * A * U^T
+   @ingroup MatrixFunctions
+*/
+template <class T, unsigned int D1, unsigned int D2, class R, unsigned int N>
+SMatrixPack<T, D1, D1, MatRepSym<T, D1>, N>
+Similarity(const SMatrixPack<T, D1, D2, R, N> &u, const SMatrixPack<T, D2, D2, MatRepSym<T, D2>, N> &a)
+{
+   // U * A, then only the lower triangle of (U * A) * U^T
+   const SMatrixPack<T, D1, D2, MatRepStd<T, D1, D2>, N> ua = u * a;
+   SMatrixPack<T, D1, D1, MatRepSym<T, D1>, N> b;
+   for (unsigned int i = 0; i < D1; ++i) {
+      for (unsigned int j = 0; j <= i; ++j) {
+         T *bij = b.Lanes(i, j);
+         for (unsigned int k = 0; k < D2; ++k) {
+            const T *uaik = ua.Lanes(i, k);
+            const T *ujk = u.Lanes(j, k);
+            for (unsigned int l = 0; l < N; ++l)
+               bij[l] += uaik[l] * ujk[l];
+         }
+      }
+   }
+   return b;
+}
+
+template <class T, unsigned int D1, unsigned int D2, class R, unsigned int N>
+bool SMatrixPack<T, D1, D2, R, N>::InvertChol(bool *laneOk)
+{
+   static_assert(D1 == D2, "InvertChol needs square matrices");
+   static_assert(std::is_same<R, MatRepSym<T, D1>>::value, "InvertChol needs symmetric matrices (MatRepSym)");
+   constexpr unsigned int D = D1;
+   using LT = SMatrixPackHelpers::Layout<MatRepSym<T, D>>;
+
+   // Cholesky decomposition A = L L^T, as in CholeskyDecomp: L(i, j) (j <= i) in lower triangle
+   // storage, with the inverse of the diagonal elements
+   T lw[LT::kSize][N];
+   bool ok[N];
+   for (unsigned int l = 0; l < N; ++l)
+      ok[l] = true;
+   for (unsigned int i = 0; i < D; ++i) {
+      T diag[N];
+      for (unsigned int l = 0; l < N; ++l)
+         diag[l] = 0;
+      for (unsigned int j = 0; j < i; ++j) {
+         T *lij = lw[LT::Offset(i, j)];
+         const T *aij = Lanes(i, j);
+         const T *ljj = lw[LT::Offset(j, j)];
+         for (unsigned int l = 0; l < N; ++l) {
+            T tmp = aij[l];
+            for (unsigned int k = 0; k < j; ++k)
+               tmp -= lw[LT::Offset(i, k)][l] * lw[LT::Offset(j, k)][l];
+            tmp *= ljj[l];
+            lij[l] = tmp;
+            diag[l] += tmp * tmp;
+         }
+      }
+      T *lii = lw[LT::Offset(i, i)];
+      const T *aii = Lanes(i, i);
+      for (unsigned int l = 0; l < N; ++l) {
+         const T d = aii[l] - diag[l];
+         // continue with 1 for the lanes which are not positive definite, they are not written at the end
+         ok[l] = ok[l] && d > 0;
+         lii[l] = T(1) / std::sqrt(d > 0 ? d : T(1));
+      }
+   }
+
+   // invert the off-diagonal part of L, as in CholeskyDecomp
+   for (unsigned int i = 1; i < D; ++i) {
+      for (unsigned int j = 0; j < i; ++j) {
+         T *lij = lw[LT::Offset(i, j)];
+         const T *lii = lw[LT::Offset(i, i)];
+         for (unsigned int l = 0; l < N; ++l) {
+            T tmp = 0;
+            for (unsigned int k = j; k < i; ++k)
+               tmp -= lw[LT::Offset(i, k)][l] * lw[LT::Offset(k, j)][l];
+            lij[l] = tmp * lii[l];
+         }
+      }
+   }
+
+   // A^-1 = Li^T Li
+   bool allOk = true;
+   for (unsigned int l = 0; l < N; ++l)
+      allOk = allOk && ok[l];
+   for (unsigned int i = 0; i < D; ++i) {
+      for (unsigned int j = 0; j <= i; ++j) {
+         T *aij = Lanes(i, j);
+         for (unsigned int l = 0; l < N; ++l) {
+            T tmp = 0;
+            for (unsigned int k = i; k < D; ++k)
+               tmp += lw[LT::Offset(k, i)][l] * lw[LT::Offset(k, j)][l];
+            aij[l] = ok[l] ? tmp : aij[l];
+         }
+      }
+   }
+   if (laneOk)
+      for (unsigned int l = 0; l < N; ++l)
+         laneOk[l] = ok[l];
+   return allOk;
+}
+
+/**
+   Kalman filter update of the states x, of covariance matrices C, with the measurements m, of covariance
+   matrices V, for the measurement model m = H x, lane by lane:
+
+   - residual r = m - H x, of covariance S = V + H C H^T
+   - gain K = C H^T S^-1
+   - x -> x + K r, C -> C - K H C
+   - chi2 = r^T S^-1 r
+
+   The states of the lanes for which S is not positive definite are left unchanged, with a chi2 of zero.
+   If chi2 is not null, it is filled with the chi2 of each lane.
+   @returns true if all the lanes have been updated
+   @ingroup MatrixFunctions
+*/
+template <class T, unsigned int D, unsigned int M, class RH, unsigned int N>
+bool KalmanUpdate(SVectorPack<T, D, N> &x, SMatrixPack<T, D, D, MatRepSym<T, D>, N> &c,
+                  const SVectorPack<T, M, N> &m, const SMatrixPack<T, M, M, MatRepSym<T, M>, N> &v,
+                  const SMatrixPack<T, M, D, RH, N> &h, T *chi2 = nullptr)
+{
+   // residuals and their inverse covariance
+   SVectorPack<T, M, N> r = h * x;
+   for (unsigned int i = 0; i < M; ++i) {
+      T *ri = r.Lanes(i);
+      const T *mi = m.Lanes(i);
+      for (unsigned int l = 0; l < N; ++l)
+         ri[l] = mi[l] - ri[l];
+   }
+   SMatrixPack<T, M, M, MatRepSym<T, M>, N> s = Similarity(h, c);
+   for (unsigned int i = 0; i < M; ++i) {
+      for (unsigned int j = 0; j <= i; ++j) {
+         T *sij = s.Lanes(i, j);
+         const T *vij = v.Lanes(i, j);
+         for (unsigned int l = 0; l < N; ++l)
+            sij[l] += vij[l];
+      }
+   }
+   bool ok[N];
+   const bool allOk = s.InvertChol(ok);
+   // a null inverse gives a null gain for the failed lanes
+   for (unsigned int i = 0; i < M; ++i)
+      for (unsigned int j = 0; j <= i; ++j)
+         for (unsigned int l = 0; l < N; ++l)
+            s.Lanes(i, j)[l] = ok[l] ? s.Lanes(i, j)[l] : T(0);
+
+   // C H^T
+   SMatrixPack<T, D, M, MatRepStd<T, D, M>, N> cht;
+   for (unsigned int i = 0; i < D; ++i) {
+      for (unsigned int j = 0; j < M; ++j) {
+         T *chtij = cht.Lanes(i, j);
+         for (unsigned int k = 0; k < D; ++k) {
+            const T *cik = c.Lanes(i, k);
+            const T *hjk = h.Lanes(j, k);
+            for (unsigned int l = 0; l < N; ++l)
+               chtij[l] += cik[l] * hjk[l];
+         }
+      }
+   }
+   const SMatrixPack<T, D, M, MatRepStd<T, D, M>, N> k = cht * s;
+
+   // x + K r
+   const SVectorPack<T, D, N> kr = k * r;
+   for (unsigned int i = 0; i < D; ++i) {
+      T *xi = x.Lanes(i);
+      const T *kri = kr.Lanes(i);
+      for (unsigned int l = 0; l < N; ++l)
+         xi[l] += kri[l];
+   }
+
+   // C - K H C = C - K (C H^T)^T
+   for (unsigned int i = 0; i < D; ++i) {
+      for (unsigned int j = 0; j <= i; ++j) {
+         T *cij = c.Lanes(i, j);
+         for (unsigned int q = 0; q < M; ++q) {
+            const T *kiq = k.Lanes(i, q);
+            const T *chtjq = cht.Lanes(j, q);
+            for (unsigned int l = 0; l < N; ++l)
+               cij[l] -= kiq[l] * chtjq[l];
+         }
+      }
+   }
+
+   if (chi2) {
+      const SVectorPack<T, M, N> sr = s * r;
+      for (unsigned int l = 0; l < N; ++l)
+         chi2[l] = 0;
+      for (unsigned int i = 0; i < M; ++i)
+         for (unsigned int l = 0; l < N; ++l)
+            chi2[l] += r.Lanes(i)[l] * sr.Lanes(i)[l];
+   }
+   return allOk;
+}
+
+} // namespace Math
+
+} // namespace ROOT
+
+#endif
@@ -0,0 +1,320 @@
+// test of the packs of SMatrix (SMatrixPack.h): the results of the operations on the packs are compared
+// with the ones of SMatrix on each lane, and the time of the Kalman filter update of NTRACK tracks is
+// compared with a loop on SMatrix
+
+#include "Math/SMatrix.h"
+#include "Math/SVector.h"
+#include "Math/SMatrixPack.h"
+
+#include "TRandom3.h"
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+
+#ifndef NDIM1
+#define NDIM1 2
+#endif
+#ifndef NDIM2
+#define NDIM2 5
+#endif
+
+#define NTRACK 1024 // number of tracks updated in the time test
+
+#define NLOOP 1000 // number of times the time test is repeated
+
+using namespace ROOT::Math;
+
+#include "TestTimer.h"
+
+typedef SMatrix<double, NDIM1, NDIM2> MatrixNM;
+typedef SMatrix<double, NDIM2, NDIM2> MatrixMM;
+typedef SMatrix<double, NDIM1, NDIM1, MatRepSym<double, NDIM1>> SymMatrixNN;
+typedef SMatrix<double, NDIM2, NDIM2, MatRepSym<double, NDIM2>> SymMatrixMM;
+typedef SVector<double, NDIM1> VectorN;
+typedef SVector<double, NDIM2> VectorM;
+
+typedef SMatrixPack<double, NDIM1, NDIM2> PackNM;
+typedef SMatrixPack<double, NDIM2, NDIM2> PackMM;
+typedef SMatrixPack<double, NDIM1, NDIM1, MatRepSym<double, NDIM1>> SymPackNN;
+typedef SMatrixPack<double, NDIM2, NDIM2, MatRepSym<double, NDIM2>> SymPackMM;
+typedef SVectorPack<double, NDIM1> VectorPackN;
+typedef SVectorPack<double, NDIM2> VectorPackM;
+
+const unsigned int kLanes = PackMM::kLanes;
+
+TRandom3 gRandom3(4357);
+
+template <class M>
+void fillRandom(M &m)
+{
+   for (unsigned int i = 0; i < M::kRows; ++i)
+      for (unsigned int j = 0; j < M::kCols; ++j)
+         m(i, j) = gRandom3.Rndm() - 0.5;
+}
+
+template <class V>
+void fillRandomVec(V &v)
+{
+   for (unsigned int i = 0; i < V::kSize; ++i)
+      v[i] = gRandom3.Rndm() - 0.5;
+}
+
+// random positive definite symmetric matrix
+template <class S>
+void fillRandomPosDef(S &s)
+{
+   SMatrix<double, S::kRows, S::kRows> a;
+   fillRandom(a);
+   // A A^T + 1
+   for (unsigned int i = 0; i < S::kRows; ++i) {
+      for (unsigned int j = 0; j <= i; ++j) {
+         double sij = (i == j) ? 1 : 0;
+         for (unsigned int k = 0; k < S::kRows; ++k)
+            sij += a(i, k) * a(j, k);
+         s(i, j) = sij;
+      }
+   }
+}
+
+template <class M1, class M2>
+bool areEqual(const M1 &m1, const M2 &m2, const char *name, unsigned int lane)
+{
+   for (unsigned int i = 0; i < M1::kRows; ++i) {
+      for (unsigned int j = 0; j < M1::kCols; ++j) {
+         if (std::abs(m1(i, j) - m2(i, j)) > 1.E-10 * (1 + std::abs(m2(i, j)))) {
+            std::cerr << "Error in " << name << " lane " << lane << " element (" << i << "," << j << ") : " << m1(i, j)
+                      << " instead of " << m2(i, j) << std::endl;
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+template <class V1, class V2>
+bool areEqualVec(const V1 &v1, const V2 &v2, const char *name, unsigned int lane)
+{
+   for (unsigned int i = 0; i < V1::kSize; ++i) {
+      if (std::abs(v1[i] - v2[i]) > 1.E-10 * (1 + std::abs(v2[i]))) {
+         std::cerr << "Error in " << name << " lane " << lane << " element " << i << " : " << v1[i] << " instead of "
+                   << v2[i] << std::endl;
+         return false;
+      }
+   }
+   return true;
+}
+
+// Kalman filter update with SMatrix, as in testKalman
+bool kalmanUpdate(VectorM &x, SymMatrixMM &c, const VectorN &m, const SymMatrixNN &v, const MatrixNM &h, double &chi2)
+{
+   SymMatrixNN s = v + Similarity(h, c);
+   if (!s.InvertChol()) {
+      chi2 = 0;
+      return false;
+   }
+   const VectorN r = m - h * x;
+   const SMatrix<double, NDIM2, NDIM1> k = c * Transpose(h) * s;
+   x += k * r;
+   const MatrixMM khc = k * h * c;
+   // C - K H C, symmetric
+   c -= SymMatrixMM(khc.LowerBlock());
+   chi2 = Similarity(r, s);
+   return true;
+}
+
+int test_operations()
+{
+   int iret = 0;
+
+   PackNM a;
+   PackMM b;
+   SymPackMM c;
+   VectorPackM x;
+   std::vector<MatrixNM> va(kLanes);
+   std::vector<MatrixMM> vb(kLanes);
+   std::vector<SymMatrixMM> vc(kLanes);
+   std::vector<VectorM> vx(kLanes);
+   for (unsigned int l = 0; l < kLanes; ++l) {
+      fillRandom(va[l]);
+      fillRandom(vb[l]);
+      fillRandomPosDef(vc[l]);
+      fillRandomVec(vx[l]);
+      a.Set(l, va[l]);
+      b.Set(l, vb[l]);
+      c.Set(l, vc[l]);
+      x.Set(l, vx[l]);
+   }
+
+   const PackNM ab = a * b;
+   const PackNM ac = a * c;
+   const VectorPackN ax = a * x;
+   const SymPackNN sim = Similarity(a, c);
+   SymPackMM cinv = c;
+   if (!cinv.InvertChol()) {
+      std::cerr << "Error in InvertChol of positive definite matrices" << std::endl;
+      iret |= 1;
+   }
+   for (unsigned int l = 0; l < kLanes; ++l) {
+      if (!areEqual(a.Get(l), va[l], "Set/Get", l))
+         iret |= 1;
+      if (!areEqual(ab.Get(l), va[l] * vb[l], "matrix product", l))
+         iret |= 2;
+      if (!areEqual(ac.Get(l), va[l] * vc[l], "product with symmetric matrix", l))
+         iret |= 2;
+      if (!areEqualVec(ax.Get(l), VectorN(va[l] * vx[l]), "matrix-vector product", l))
+         iret |= 2;
+      if (!areEqual(sim.Get(l), Similarity(va[l], vc[l]), "Similarity", l))
+         iret |= 4;
+      SymMatrixMM inv = vc[l];
+      inv.InvertChol();
+      if (!areEqual(cinv.Get(l), inv, "InvertChol", l))
+         iret |= 8;
+   }
+
+   // a lane which is not positive definite is left unchanged
+   SymMatrixMM notPosDef = vc[1];
+   notPosDef(0, 0) = -1;
+   c.Set(1, notPosDef);
+   bool ok[kLanes];
+   if (c.InvertChol(ok) || ok[1] || !ok[0]) {
+      std::cerr << "Error in InvertChol of a matrix which is not positive definite" << std::endl;
+      iret |= 8;
+   }
+   if (!areEqual(c.Get(1), notPosDef, "InvertChol failed lane", 1))
+      iret |= 8;
+
+   return iret;
+}
+
+int test_kalman()
+{
+   int iret = 0;
+
+   VectorPackM x;
+   SymPackMM c;
+   VectorPackN m;
+   SymPackNN v;
+   PackNM h;
+   std::vector<VectorM> vx(kLanes);
+   std::vector<SymMatrixMM> vc(kLanes);
+   std::vector<VectorN> vm(kLanes);
+   std::vector<SymMatrixNN> vv(kLanes);
+   std::vector<MatrixNM> vh(kLanes);
+   for (unsigned int l = 0; l < kLanes; ++l) {
+      fillRandomVec(vx[l]);
+      fillRandomPosDef(vc[l]);
+      fillRandomVec(vm[l]);
+      fillRandomPosDef(vv[l]);
+      fillRandom(vh[l]);
+      x.Set(l, vx[l]);
+      c.Set(l, vc[l]);
+      m.Set(l, vm[l]);
+      v.Set(l, vv[l]);
+      h.Set(l, vh[l]);
+   }
+
+   double chi2[kLanes];
+   if (!KalmanUpdate(x, c, m, v, h, chi2)) {
+      std::cerr << "Error in KalmanUpdate: failed lanes" << std::endl;
+      iret |= 1;
+   }
+   for (unsigned int l = 0; l < kLanes; ++l) {
+      double chi2l = 0;
+      kalmanUpdate(vx[l], vc[l], vm[l], vv[l], vh[l], chi2l);
+      if (!areEqualVec(x.Get(l), vx[l], "KalmanUpdate state", l))
+         iret |= 2;
+      if (!areEqual(c.Get(l), vc[l], "KalmanUpdate covariance", l))
+         iret |= 2;
+      if (std::abs(chi2[l] - chi2l) > 1.E-10 * (1 + chi2l)) {
+         std::cerr << "Error in KalmanUpdate chi2 lane " << l << " : " << chi2[l] << " instead of " << chi2l
+                   << std::endl;
+         iret |= 2;
+      }
+   }
+   return iret;
+}
+
+// time of the update of NTRACK tracks with SMatrix and with the packs
+int test_kalman_time()
+{
+   std::vector<VectorM> vx(NTRACK);
+   std::vector<SymMatrixMM> vc(NTRACK);
+   std::vector<VectorN> vm(NTRACK);
+   std::vector<SymMatrixNN> vv(NTRACK);
+   std::vector<MatrixNM> vh(NTRACK);
+   for (unsigned int t = 0; t < NTRACK; ++t) {
+      fillRandomVec(vx[t]);
+      fillRandomPosDef(vc[t]);
+      fillRandomVec(vm[t]);
+      fillRandomPosDef(vv[t]);
+      fillRandom(vh[t]);
+   }
+
+   const unsigned int npacks = (NTRACK + kLanes - 1) / kLanes;
+   std::vector<VectorPackM> px(npacks);
+   std::vector<SymPackMM> pc(npacks);
+   std::vector<VectorPackN> pm(npacks);
+   std::vector<SymPackNN> pv(npacks);
+   std::vector<PackNM> ph(npacks);
+   for (unsigned int t = 0; t < NTRACK; ++t) {
+      px[t / kLanes].Set(t % kLanes, vx[t]);
+      pc[t / kLanes].Set(t % kLanes, vc[t]);
+      pm[t / kLanes].Set(t % kLanes, vm[t]);
+      pv[t / kLanes].Set(t % kLanes, vv[t]);
+      ph[t / kLanes].Set(t % kLanes, vh[t]);
+   }
+
+   double sum1 = 0;
+   {
+      test::Timer t("Kalman update with SMatrix    ");
+      for (int k = 0; k < NLOOP; ++k) {
+         for (unsigned int i = 0; i < NTRACK; ++i) {
+            VectorM x = vx[i];
+            SymMatrixMM c = vc[i];
+            double chi2 = 0;
+            kalmanUpdate(x, c, vm[i], vv[i], vh[i], chi2);
+            sum1 += chi2;
+         }
+      }
+   }
+
+   double sum2 = 0;
+   {
+      test::Timer t("Kalman update with SMatrixPack");
+      double chi2[kLanes];
+      for (int k = 0; k < NLOOP; ++k) {
+         for (unsigned int i = 0; i < npacks; ++i) {
+            VectorPackM x = px[i];
+            SymPackMM c = pc[i];
+            KalmanUpdate(x, c, pm[i], pv[i], ph[i], chi2);
+            for (unsigned int l = 0; l < kLanes && i * kLanes + l < NTRACK; ++l)
+               sum2 += chi2[l];
+         }
+      }
+   }
+
+   if (std::abs(sum1 - sum2) > 1.E-8 * std::abs(sum1)) {
+      std::cerr << "Error in time test: sum of chi2 " << sum2 << " instead of " << sum1 << std::endl;
+      return 1;
+   }
+   return 0;
+}
+
+int testSMatrixPack()
+{
+   int iret = 0;
+   iret |= test_operations();
+   iret |= test_kalman();
+   iret |= test_kalman_time();
+   if (iret != 0)
+      std::cerr << "testSMatrixPack: test FAILED !!! " << std::endl;
+   else
+      std::cout << "testSMatrixPack: test OK " << std::endl;
+   return iret;
+}
+
+int main()
+{
+   return testSMatrixPack();
+}
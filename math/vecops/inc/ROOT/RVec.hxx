@@ -76,6 +76,11 @@ template <typename T>
 struct IsRVec<ROOT::VecOps::RVec<T>> : std::true_type {};
 // clang-format on
 
+/// Enabled if an element-wise operation with a result of type R can be stored in the RVec<T> operand,
+/// i.e. if R is T and the other operand U is not an RVec
+template <typename R, typename T, typename U = T>
+using EnableIfInPlace = std::enable_if_t<std::is_same<R, T>::value && !IsRVec<U>::value>;
+
 constexpr bool All(const bool *vals, std::size_t size)
 {
    for (auto i = 0u; i < size; ++i)
@@ -146,7 +151,8 @@ protected:
    /// Always >= 0.
    // Type is signed only for consistency with fCapacity.
    Size_T fSize = 0;
-   /// Always >= -1. fCapacity == -1 indicates the RVec is in "memory adoption" mode.
+   /// Always >= -1, except for buffers taken from an RVecArena, see InArena().
+   /// fCapacity == -1 indicates the RVec is in "memory adoption" mode.
    Size_T fCapacity;
 
    /// The maximum value of the Size_T used.
@@ -170,9 +176,13 @@ protected:
    /// If false, the RVec is in "memory adoption" mode, i.e. it is acting as a view on a memory buffer it does not own.
    bool Owns() const { return fCapacity != -1; }
 
+   /// If true, the buffer was taken from a ROOT::Detail::VecOps::RVecArena, which releases it, and the capacity is
+   /// -2 - fCapacity. The RVec owns its elements, but not its buffer.
+   bool InArena() const { return fCapacity < -1; }
+
 public:
    size_t size() const { return fSize; }
-   size_t capacity() const noexcept { return Owns() ? fCapacity : fSize; }
+   size_t capacity() const noexcept { return fCapacity >= 0 ? fCapacity : (InArena() ? -2 - fCapacity : fSize); }
 
    R__RVEC_NODISCARD bool empty() const { return !fSize; }
 
@@ -578,14 +588,14 @@ public:
    {
       // Subclass has already destructed this vector's elements.
       // If this wasn't grown from the inline copy, deallocate the old space.
-      if (!this->isSmall() && this->Owns())
+      if (!this->isSmall() && this->Owns() && !this->InArena())
          free(this->begin());
    }
 
-   // also give up adopted memory if applicable
+   // also give up adopted memory, or memory taken from an arena (see RVecArena), if applicable
    void clear()
    {
-      if (this->Owns()) {
+      if (this->Owns() && !this->InArena()) {
          this->destroy_range(this->begin(), this->end());
          this->fSize = 0;
       } else {
@@ -998,6 +1008,13 @@ RVecImpl<T> &RVecImpl<T>::operator=(const RVecImpl<T> &RHS)
    if (this == &RHS)
       return *this;
 
+   // A buffer taken from an arena might have been handed out again after a reset of the arena, see RVecArena:
+   // give it up instead of writing to it.
+   if (this->InArena()) {
+      this->destroy_range(this->begin(), this->end());
+      this->resetToSmall();
+   }
+
    // If we already have sufficient space, assign the common elements, then
    // destroy any excess.
    size_t RHSSize = RHS.size();
@@ -1055,7 +1072,7 @@ RVecImpl<T> &RVecImpl<T>::operator=(RVecImpl<T> &&RHS)
    if (!RHS.isSmall()) {
       if (this->Owns()) {
          this->destroy_range(this->begin(), this->end());
-         if (!this->isSmall())
+         if (!this->isSmall() && !this->InArena())
             free(this->begin());
       }
       this->fBeginX = RHS.fBeginX;
@@ -1065,6 +1082,13 @@ RVecImpl<T> &RVecImpl<T>::operator=(RVecImpl<T> &&RHS)
       return *this;
    }
 
+   // A buffer taken from an arena might have been handed out again after a reset of the arena, see RVecArena:
+   // give it up instead of writing to it.
+   if (this->InArena()) {
+      this->destroy_range(this->begin(), this->end());
+      this->resetToSmall();
+   }
+
    // If we already have sufficient space, assign the common elements, then
    // destroy any excess.
    size_t RHSSize = RHS.size();
@@ -1555,11 +1579,37 @@ public:
    using SuperClass::operator[];
 
    template <typename V, typename = std::enable_if<std::is_convertible<V, bool>::value>>
-   RVec operator[](const RVec<V> &conds) const
+   RVec operator[](const RVec<V> &conds) const &
    {
       return RVec(SuperClass::operator[](conds));
    }
 
+   /// Masking of a temporary: the selected elements are moved to the front of its buffer, which is returned
+   template <typename V, typename = std::enable_if<std::is_convertible<V, bool>::value>>
+   RVec operator[](const RVec<V> &conds) &&
+   {
+      if (!this->Owns())
+         return static_cast<const RVec &>(*this)[conds];
+
+      const size_type n = conds.size();
+      if (n != this->size()) {
+         std::string msg = "Cannot index RVecN of size " + std::to_string(this->size()) +
+                           " with condition vector of different size (" + std::to_string(n) + ").";
+         throw std::runtime_error(msg);
+      }
+
+      size_type j = 0u;
+      for (size_type i = 0u; i < n; ++i) {
+         if (conds[i]) {
+            if (i != j)
+               this->operator[](j) = std::move(this->operator[](i));
+            ++j;
+         }
+      }
+      this->erase(this->begin() + j, this->end());
+      return std::move(*this);
+   }
+
    using SuperClass::at;
 
    friend bool ROOT::Detail::VecOps::IsSmall<T>(const RVec<T> &v);
@@ -1584,6 +1634,16 @@ RVec<T> operator OP(const RVec<T> &v)                                          \
    for (auto &x : ret)                                                         \
       x = OP x;                                                                \
 return ret;                                                                    \
+}                                                                              \
+                                                                               \
+template <typename T>                                                          \
+RVec<T> operator OP(RVec<T> &&v)                                               \
+{                                                                              \
+   if (ROOT::Detail::VecOps::IsAdopting(v))                                    \
+      return OP static_cast<const RVec<T> &>(v);                               \
+   for (auto &x : v)                                                           \
+      x = OP x;                                                                \
+   return std::move(v);                                                        \
 }                                                                              \
 
 RVEC_UNARY_OPERATOR(+)
@@ -1632,6 +1692,65 @@ auto operator OP(const RVec<T0> &v0, const RVec<T1> &v1)                       \
    std::transform(v0.begin(), v0.end(), v1.begin(), ret.begin(), op);          \
    return ret;                                                                 \
 }                                                                              \
+                                                                               \
+/* the overloads below store the result in an operand which is a temporary */  \
+/* owning its buffer, when it has the type of the result */                    \
+template <typename T0, typename T1, typename = ROOT::Internal::VecOps::        \
+          EnableIfInPlace<decltype(std::declval<T0>() OP std::declval<T1>()), T0, T1>> \
+RVec<T0> operator OP(RVec<T0> &&v, const T1 &y)                                \
+{                                                                              \
+   if (ROOT::Detail::VecOps::IsAdopting(v))                                    \
+      return static_cast<const RVec<T0> &>(v) OP y;                            \
+   for (auto &x : v)                                                           \
+      x = x OP y;                                                              \
+   return std::move(v);                                                        \
+}                                                                              \
+                                                                               \
+template <typename T0, typename T1, typename = ROOT::Internal::VecOps::        \
+          EnableIfInPlace<decltype(std::declval<T0>() OP std::declval<T1>()), T1, T0>> \
+RVec<T1> operator OP(const T0 &x, RVec<T1> &&v)                                \
+{                                                                              \
+   if (ROOT::Detail::VecOps::IsAdopting(v))                                    \
+      return x OP static_cast<const RVec<T1> &>(v);                            \
+   for (auto &y : v)                                                           \
+      y = x OP y;                                                              \
+   return std::move(v);                                                        \
+}                                                                              \
+                                                                               \
+template <typename T0, typename T1, typename = ROOT::Internal::VecOps::        \
+          EnableIfInPlace<decltype(std::declval<T0>() OP std::declval<T1>()), T0>> \
+RVec<T0> operator OP(RVec<T0> &&v0, const RVec<T1> &v1)                        \
+{                                                                              \
+   if (ROOT::Detail::VecOps::IsAdopting(v0))                                   \
+      return static_cast<const RVec<T0> &>(v0) OP v1;                          \
+   if (v0.size() != v1.size())                                                 \
+      throw std::runtime_error(ERROR_MESSAGE(OP));                             \
+                                                                               \
+   auto op = [](const T0 &x, const T1 &y) { return x OP y; };                  \
+   std::transform(v0.begin(), v0.end(), v1.begin(), v0.begin(), op);          \
+   return std::move(v0);                                                       \
+}                                                                              \
+                                                                               \
+template <typename T0, typename T1, typename = ROOT::Internal::VecOps::        \
+          EnableIfInPlace<decltype(std::declval<T0>() OP std::declval<T1>()), T1>> \
+RVec<T1> operator OP(const RVec<T0> &v0, RVec<T1> &&v1)                        \
+{                                                                              \
+   if (ROOT::Detail::VecOps::IsAdopting(v1))                                   \
+      return v0 OP static_cast<const RVec<T1> &>(v1);                          \
+   if (v0.size() != v1.size())                                                 \
+      throw std::runtime_error(ERROR_MESSAGE(OP));                             \
+                                                                               \
+   auto op = [](const T0 &x, const T1 &y) { return x OP y; };                  \
+   std::transform(v0.begin(), v0.end(), v1.begin(), v1.begin(), op);          \
+   return std::move(v1);                                                       \
+}                                                                              \
+                                                                               \
+template <typename T0, typename T1, typename = ROOT::Internal::VecOps::        \
+          EnableIfInPlace<decltype(std::declval<T0>() OP std::declval<T1>()), T0>> \
+RVec<T0> operator OP(RVec<T0> &&v0, RVec<T1> &&v1)                             \
+{                                                                              \
+   return std::move(v0) OP static_cast<const RVec<T1> &>(v1);                  \
+}                                                                              \
 
 RVEC_BINARY_OPERATOR(+)
 RVEC_BINARY_OPERATOR(-)
@@ -1756,6 +1875,16 @@ using PromoteTypes = decltype(PromoteType<U>() + PromoteType<V>());
       auto f = [](const T &x) { return FUNC(x); };                             \
       std::transform(v.begin(), v.end(), ret.begin(), f);                      \
       return ret;                                                              \
+   }                                                                           \
+                                                                               \
+   template <typename T, typename = ROOT::Internal::VecOps::EnableIfInPlace<PromoteType<T>, T>> \
+   RVec<T> NAME(RVec<T> &&v)                                                   \
+   {                                                                           \
+      if (ROOT::Detail::VecOps::IsAdopting(v))                                 \
+         return NAME(static_cast<const RVec<T> &>(v));                         \
+      for (auto &x : v)                                                        \
+         x = FUNC(x);                                                          \
+      return std::move(v);                                                     \
    }
 
 #define RVEC_BINARY_FUNCTION(NAME, FUNC)                                       \
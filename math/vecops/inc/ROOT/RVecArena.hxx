@@ -0,0 +1,78 @@
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RVECARENA
+#define ROOT_RVECARENA
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace ROOT {
+namespace Detail {
+namespace VecOps {
+
+/**
+\class ROOT::Detail::VecOps::RVecArena
+\brief A bump allocator for the buffers of RVecs of trivially copyable types.
+
+While an RVecArena is active on a thread (see RScope), the RVecs of trivially copyable types which outgrow their
+small buffer on that thread take their new buffer from the arena instead of the heap. Allocations are a pointer
+increment, and the buffers are never released individually: an RVec destroyed or re-allocated leaves its buffer to the
+arena, and Reset() makes all the memory of the arena available again.
+
+The buffers taken from an arena are therefore only valid until the next Reset(): RVecs that must outlive it have to be
+copied while no arena is active, e.g. in a scope opened with `RVecArena::RScope noArena(nullptr);`. An RVec never
+writes to its buffer from an arena when it is destroyed, assigned to (by copy, by move or with assign()) or cleared:
+it gives the buffer up instead, so that RVecs holding a stale buffer can still be destroyed, assigned to or cleared
+after a Reset(). Any other use of such an RVec, e.g. resize() or push_back(), is invalid.
+
+RDataFrame uses one arena per processing slot, reset at each entry, for the expressions of Define and Filter calls,
+if enabled with ROOT::RDF::Experimental::EnableRVecArena().
+*/
+class RVecArena {
+   struct RChunk {
+      std::unique_ptr<char[]> fBuffer;
+      std::size_t fSize;
+   };
+
+   std::vector<RChunk> fChunks; ///< Allocations are done from the last chunk, the others are full
+   std::size_t fOffset = 0;     ///< Position of the next allocation in the last chunk
+
+public:
+   /// A RAII object that activates an arena (or no arena, if nullptr) on the current thread for its lifetime
+   class RScope {
+      RVecArena *fPrevious;
+
+   public:
+      explicit RScope(RVecArena *arena);
+      ~RScope();
+      RScope(const RScope &) = delete;
+      RScope &operator=(const RScope &) = delete;
+   };
+
+   explicit RVecArena(std::size_t chunkSize = 64 * 1024);
+   RVecArena(const RVecArena &) = delete;
+   RVecArena &operator=(const RVecArena &) = delete;
+
+   /// Return a buffer of at least `size` bytes, aligned for any fundamental type
+   void *Allocate(std::size_t size);
+   /// Make all the memory of the arena available again, as one chunk
+   void Reset();
+   /// Total size of the chunks of the arena, in bytes
+   std::size_t GetCapacity() const;
+
+   /// The arena active on the current thread, or nullptr
+   static RVecArena *GetActive();
+};
+
+} // namespace VecOps
+} // namespace Detail
+} // namespace ROOT
+
+#endif
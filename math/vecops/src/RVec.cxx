@@ -11,6 +11,7 @@
  *************************************************************************/
 
 #include "ROOT/RVec.hxx"
+#include "ROOT/RVecArena.hxx"
 using namespace ROOT::VecOps;
 
 // Check that no bytes are wasted and everything is well-aligned.
@@ -68,7 +69,19 @@ void ROOT::Internal::VecOps::SmallVectorBase::grow_pod(void *FirstEl, size_t Min
    NewCapacity = std::min(std::max(NewCapacity, MinSize), SizeTypeMax());
 
    void *NewElts;
-   if (fBeginX == FirstEl || !this->Owns()) {
+   auto *arena = ROOT::Detail::VecOps::RVecArena::GetActive();
+   // the capacity of a buffer from an arena is stored as -2 - fCapacity
+   if (arena && NewCapacity <= SizeTypeMax() - 2) {
+      NewElts = arena->Allocate(NewCapacity * TSize);
+      memcpy(NewElts, this->fBeginX, size() * TSize);
+      if (fBeginX != FirstEl && this->Owns() && !this->InArena())
+         free(this->fBeginX);
+      this->fBeginX = NewElts;
+      this->fCapacity = -2 - Size_T(NewCapacity);
+      return;
+   }
+
+   if (fBeginX == FirstEl || !this->Owns() || this->InArena()) {
       NewElts = malloc(NewCapacity * TSize);
       R__ASSERT(NewElts != nullptr);
 
@@ -0,0 +1,71 @@
+/*************************************************************************
+ * Copyright (C) 1995-2024, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RVecArena.hxx"
+
+#include <algorithm>
+
+namespace {
+thread_local ROOT::Detail::VecOps::RVecArena *gActiveArena = nullptr;
+
+constexpr std::size_t kArenaAlignment = alignof(std::max_align_t);
+} // namespace
+
+ROOT::Detail::VecOps::RVecArena::RScope::RScope(RVecArena *arena) : fPrevious(gActiveArena)
+{
+   gActiveArena = arena;
+}
+
+ROOT::Detail::VecOps::RVecArena::RScope::~RScope()
+{
+   gActiveArena = fPrevious;
+}
+
+ROOT::Detail::VecOps::RVecArena::RVecArena(std::size_t chunkSize)
+{
+   chunkSize = std::max(chunkSize, kArenaAlignment);
+   fChunks.push_back({std::unique_ptr<char[]>(new char[chunkSize]), chunkSize});
+}
+
+void *ROOT::Detail::VecOps::RVecArena::Allocate(std::size_t size)
+{
+   size = (size + kArenaAlignment - 1) / kArenaAlignment * kArenaAlignment;
+   if (fOffset + size > fChunks.back().fSize) {
+      // the memory left in the current chunk is lost until the next Reset()
+      const std::size_t chunkSize = std::max(2 * fChunks.back().fSize, size);
+      fChunks.push_back({std::unique_ptr<char[]>(new char[chunkSize]), chunkSize});
+      fOffset = 0;
+   }
+   void *buffer = fChunks.back().fBuffer.get() + fOffset;
+   fOffset += size;
+   return buffer;
+}
+
+void ROOT::Detail::VecOps::RVecArena::Reset()
+{
+   fOffset = 0;
+   if (fChunks.size() == 1)
+      return;
+   // replace the chunks by a single one, large enough for the allocations of the last cycle
+   const std::size_t capacity = GetCapacity();
+   fChunks.clear();
+   fChunks.push_back({std::unique_ptr<char[]>(new char[capacity]), capacity});
+}
+
+std::size_t ROOT::Detail::VecOps::RVecArena::GetCapacity() const
+{
+   std::size_t capacity = 0;
+   for (const auto &chunk : fChunks)
+      capacity += chunk.fSize;
+   return capacity;
+}
+
+ROOT::Detail::VecOps::RVecArena *ROOT::Detail::VecOps::RVecArena::GetActive()
+{
+   return gActiveArena;
+}
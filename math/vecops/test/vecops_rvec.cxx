@@ -3,6 +3,7 @@
 #include <Math/PtEtaPhiM4D.h>
 #include <Math/Vector4Dfwd.h>
 #include <ROOT/RVec.hxx>
+#include <ROOT/RVecArena.hxx>
 #include <ROOT/TSeq.hxx>
 #include <TFile.h>
 #include <TInterpreter.h>
@@ -1940,3 +1941,126 @@ TEST_P(VecOpsSwap, RegularAdoptingVectors)
 
 INSTANTIATE_TEST_SUITE_P(ROOTVecOpsswap, VecOpsSwap, ::testing::Values(true));
 INSTANTIATE_TEST_SUITE_P(stdswap, VecOpsSwap, ::testing::Values(false));
+
+// operations on temporaries store their result in the buffer of the temporary
+TEST(VecOps, TemporaryReuse)
+{
+   ROOT::RVecD px{10., 20., 30., 5., 40., 1., 2., 3., 4., 50., 6., 7.};
+   ROOT::RVecD py{10., 15., 20., 5., 30., 1., 2., 3., 4., 40., 6., 7.};
+
+   ROOT::RVecD pt(px.size());
+   for (std::size_t i = 0; i < px.size(); ++i)
+      pt[i] = std::sqrt(px[i] * px[i] + py[i] * py[i]);
+   const ROOT::RVecD ref{pt[1], pt[2], pt[4], pt[9]};
+
+   CheckEqual(sqrt(px * px + py * py), pt);
+   CheckEqual(sqrt(px * px + py * py)[pt > 20], ref);
+   CheckEqual(-(2. * px - px) + px, ROOT::RVecD(px.size(), 0.));
+
+   ROOT::RVecD tmp = px * px;
+   ASSERT_FALSE(IsSmall(tmp));
+   const double *buf = tmp.data();
+   ROOT::RVecD res = sqrt(std::move(tmp) + py * py);
+   CheckEqual(res, pt);
+   EXPECT_EQ(res.data(), buf);
+
+   tmp = 2. * px;
+   buf = tmp.data();
+   res = std::move(tmp)[px > 5];
+   CheckEqual(res, ROOT::RVecD{20., 40., 60., 80., 100., 12., 14.});
+   EXPECT_EQ(res.data(), buf);
+
+   // no reuse when the type of the result differs
+   ROOT::RVecI vi{1, 2, 3};
+   CheckEqual(ROOT::RVecI{1, 2, 3} * 1.5, ROOT::RVecD{1.5, 3., 4.5});
+   CheckEqual(sqrt(vi * vi), ROOT::RVecD{1., 2., 3.});
+}
+
+TEST(VecOps, TemporaryReuseAdopting)
+{
+   std::vector<double> data{1., 2., 3., 4.};
+   ROOT::RVecD res = ROOT::RVecD(data.data(), data.size()) + 1.;
+   CheckEqual(res, ROOT::RVecD{2., 3., 4., 5.});
+   res = ROOT::RVecD(data.data(), data.size())[ROOT::RVecI{0, 1, 0, 1}];
+   CheckEqual(res, ROOT::RVecD{2., 4.});
+   res = sqrt(ROOT::RVecD(data.data(), data.size()));
+   EXPECT_EQ(data, (std::vector<double>{1., 2., 3., 4.}));
+}
+
+TEST(VecOps, RVecArena)
+{
+   using ROOT::Detail::VecOps::RVecArena;
+   RVecArena arena(1024);
+
+   ROOT::RVecF heap{1.f, 2.f};
+   ROOT::RVecF inArena;
+   const float *buf = nullptr;
+   {
+      RVecArena::RScope scope(&arena);
+      EXPECT_EQ(RVecArena::GetActive(), &arena);
+      ROOT::RVecF v(100, 1.f);
+      v.push_back(2.f);
+      EXPECT_EQ(v.size(), 101u);
+      EXPECT_GE(v.capacity(), 101u);
+      EXPECT_FALSE(IsAdopting(v));
+      EXPECT_FLOAT_EQ(Sum(v), 102.f);
+      buf = v.data();
+      inArena = std::move(v);
+
+      // escape path: no arena in a nested scope
+      RVecArena::RScope noArena(nullptr);
+      heap = inArena;
+   }
+   EXPECT_EQ(RVecArena::GetActive(), nullptr);
+   EXPECT_EQ(inArena.data(), buf);
+   EXPECT_NE(heap.data(), buf);
+   EXPECT_TRUE(All(heap == inArena));
+
+   // the arena grows with more chunks, which are merged at the reset
+   {
+      RVecArena::RScope scope(&arena);
+      ROOT::RVecD big(1000, 1.);
+      EXPECT_DOUBLE_EQ(Sum(big), 1000.);
+   }
+   EXPECT_GT(arena.GetCapacity(), 1024u + 8000u);
+   const auto capacity = arena.GetCapacity();
+   arena.Reset();
+   EXPECT_EQ(arena.GetCapacity(), capacity);
+
+   // after the reset the stale buffer is not written to, but it can be moved to and destroyed
+   {
+      RVecArena::RScope scope(&arena);
+      ROOT::RVecF v(200, 3.f);
+      inArena = ROOT::RVecF{1.f, 2.f};
+      EXPECT_TRUE(All(v == 3.f));
+      EXPECT_TRUE(All(inArena == ROOT::RVecF{1.f, 2.f}));
+      inArena = std::move(v);
+   }
+   EXPECT_EQ(inArena.size(), 200u);
+
+   // nor is it written to by a copy assignment, assign() or clear(), although it has enough capacity
+   arena.Reset();
+   {
+      RVecArena::RScope scope(&arena);
+      ROOT::RVecF v(200, 4.f);
+      EXPECT_EQ(v.data(), inArena.data());
+      const ROOT::RVecF c{5.f, 6.f};
+      inArena = c;
+      EXPECT_TRUE(All(v == 4.f));
+      EXPECT_TRUE(All(inArena == c));
+      ROOT::RVecF w(200, 7.f);
+      inArena = std::move(w);
+      arena.Reset();
+      ROOT::RVecF x(200, 8.f);
+      inArena.assign({9.f, 10.f});
+      EXPECT_TRUE(All(x == 8.f));
+      EXPECT_TRUE(All(inArena == ROOT::RVecF{9.f, 10.f}));
+   }
+
+   // non trivially copyable types never use the arena
+   {
+      RVecArena::RScope scope(&arena);
+      ROOT::RVec<std::string> s(100, "a");
+      EXPECT_EQ(s[99], "a");
+   }
+}
@@ -73,16 +73,18 @@ class R__CLING_PTRCHECK(off) RDefine final : public RDefineBase {
    template <typename... ColTypes, std::size_t... S>
    void UpdateHelper(unsigned int slot, Long64_t entry, TypeList<ColTypes...>, std::index_sequence<S...>, NoneTag)
    {
-      fLastResults[slot * RDFInternal::CacheLineStep<ret_type>()] =
-         fExpression(fValues[slot][S]->template Get<ColTypes>(entry)...);
+      RDFInternal::AssignWithRVecArena(fLoopManager->GetRVecArena(slot),
+                                       fLastResults[slot * RDFInternal::CacheLineStep<ret_type>()], fExpression,
+                                       fValues[slot][S]->template Get<ColTypes>(entry)...);
       (void)entry; // avoid unused parameter warning (gcc 12.1)
    }
 
    template <typename... ColTypes, std::size_t... S>
    void UpdateHelper(unsigned int slot, Long64_t entry, TypeList<ColTypes...>, std::index_sequence<S...>, SlotTag)
    {
-      fLastResults[slot * RDFInternal::CacheLineStep<ret_type>()] =
-         fExpression(slot, fValues[slot][S]->template Get<ColTypes>(entry)...);
+      RDFInternal::AssignWithRVecArena(fLoopManager->GetRVecArena(slot),
+                                       fLastResults[slot * RDFInternal::CacheLineStep<ret_type>()], fExpression, slot,
+                                       fValues[slot][S]->template Get<ColTypes>(entry)...);
       (void)entry; // avoid unused parameter warning (gcc 12.1)
    }
 
@@ -90,8 +92,9 @@ class R__CLING_PTRCHECK(off) RDefine final : public RDefineBase {
    void
    UpdateHelper(unsigned int slot, Long64_t entry, TypeList<ColTypes...>, std::index_sequence<S...>, SlotAndEntryTag)
    {
-      fLastResults[slot * RDFInternal::CacheLineStep<ret_type>()] =
-         fExpression(slot, entry, fValues[slot][S]->template Get<ColTypes>(entry)...);
+      RDFInternal::AssignWithRVecArena(fLoopManager->GetRVecArena(slot),
+                                       fLastResults[slot * RDFInternal::CacheLineStep<ret_type>()], fExpression, slot,
+                                       entry, fValues[slot][S]->template Get<ColTypes>(entry)...);
    }
 
 public:
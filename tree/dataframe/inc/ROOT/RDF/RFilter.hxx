@@ -109,7 +109,8 @@ public:
    template <typename... ColTypes, std::size_t... S>
    bool CheckFilterHelper(unsigned int slot, Long64_t entry, TypeList<ColTypes...>, std::index_sequence<S...>)
    {
-      return fFilter(fValues[slot][S]->template Get<ColTypes>(entry)...);
+      return RDFInternal::CallWithRVecArena(fLoopManager->GetRVecArena(slot), fFilter,
+                                            fValues[slot][S]->template Get<ColTypes>(entry)...);
       // avoid unused parameter warnings (gcc 12.1)
       (void)slot;
       (void)entry;
@@ -92,6 +92,12 @@ void TriggerRun(ROOT::RDF::RNode node);
 } // namespace RDF
 } // namespace Internal
 
+namespace RDF {
+namespace Experimental {
+void EnableRVecArena(const ROOT::RDF::RNode &node, bool enable = true);
+} // namespace Experimental
+} // namespace RDF
+
 namespace RDF {
 
 // clang-format off
@@ -121,6 +127,7 @@ class RInterface : public RInterfaceBase {
    friend void RDFInternal::TriggerRun(RNode node);
    friend void RDFInternal::ChangeEmptyEntryRange(const RNode &node, std::pair<ULong64_t, ULong64_t> &&newRange);
    friend void RDFInternal::ChangeSpec(const RNode &node, ROOT::RDF::Experimental::RDatasetSpec &&spec);
+   friend void ROOT::RDF::Experimental::EnableRVecArena(const RNode &node, bool enable);
 
    std::shared_ptr<Proxied> fProxiedPtr; ///< Smart pointer to the graph node encapsulated by this RInterface.
 
@@ -17,6 +17,7 @@
 #include "ROOT/RDF/RNodeBase.hxx"
 #include "ROOT/RDF/RNewSampleNotifier.hxx"
 #include "ROOT/RDF/RSampleInfo.hxx"
+#include "ROOT/RVecArena.hxx"
 
 #include <functional>
 #include <limits>
@@ -152,6 +153,11 @@ class RLoopManager : public RNodeBase {
    std::vector<ROOT::RDF::RSampleInfo> fSampleInfos;
    unsigned int fNRuns{0}; ///< Number of event loops run
 
+   /// Arenas (one per slot) for the buffers of the RVecs created by Define and Filter expressions, reset at each entry.
+   /// Empty unless enabled with ROOT::RDF::Experimental::EnableRVecArena.
+   std::vector<std::unique_ptr<ROOT::Detail::VecOps::RVecArena>> fRVecArenas;
+   bool fUseRVecArenas{false};
+
    /// Readers for TTree/RDataSource columns (one per slot), shared by all nodes in the computation graph.
    std::vector<std::unordered_map<std::string, std::unique_ptr<RColumnReaderBase>>> fDatasetColumnReaders;
 
@@ -205,6 +211,12 @@ public:
    void Deregister(RDFInternal::RVariationBase *varPtr);
    bool CheckFilters(unsigned int, Long64_t) final;
    unsigned int GetNSlots() const { return fNSlots; }
+   /// Return the arena for the RVecs created by Define and Filter expressions in this slot, or nullptr if not enabled.
+   ROOT::Detail::VecOps::RVecArena *GetRVecArena(unsigned int slot) const
+   {
+      return fRVecArenas.empty() ? nullptr : fRVecArenas[slot].get();
+   }
+   void SetUseRVecArenas(bool use) { fUseRVecArenas = use; }
    void Report(ROOT::RDF::RCutFlowReport &rep) const final;
    /// End of recursive chain of calls, does nothing
    void PartialReport(ROOT::RDF::RCutFlowReport &) const final {}
@@ -14,6 +14,7 @@
 #include "ROOT/RSpan.hxx"
 #include <string_view>
 #include "ROOT/RVec.hxx"
+#include "ROOT/RVecArena.hxx"
 #include "ROOT/TypeTraits.hxx"
 #include "Rtypes.h"
 
@@ -235,6 +236,31 @@ constexpr std::size_t FindIdxTrue(const T &arr)
    return arr.size();
 }
 
+/// Call f(args...), taking the buffers of the RVecs created by f from arena (if not null).
+/// The arguments are evaluated by the caller, outside of the scope of the arena.
+template <typename F, typename... Args>
+auto CallWithRVecArena(ROOT::Detail::VecOps::RVecArena *arena, F &f, Args &&...args)
+   -> decltype(f(std::forward<Args>(args)...))
+{
+   if (!arena)
+      return f(std::forward<Args>(args)...);
+   ROOT::Detail::VecOps::RVecArena::RScope scope(arena);
+   return f(std::forward<Args>(args)...);
+}
+
+/// Assign f(args...) to dest, taking the buffers of the RVecs created by f or by the assignment from arena (if not null).
+/// The arguments are evaluated by the caller, outside of the scope of the arena.
+template <typename T, typename F, typename... Args>
+void AssignWithRVecArena(ROOT::Detail::VecOps::RVecArena *arena, T &&dest, F &f, Args &&...args)
+{
+   if (!arena) {
+      dest = f(std::forward<Args>(args)...);
+      return;
+   }
+   ROOT::Detail::VecOps::RVecArena::RScope scope(arena);
+   dest = f(std::forward<Args>(args)...);
+}
+
 // return type has to be decltype(auto) to preserve perfect forwarding
 template <std::size_t N, typename... Ts>
 decltype(auto) GetNthElement(Ts &&...args)
@@ -39,3 +39,36 @@ void ROOT::Internal::RDF::TriggerRun(ROOT::RDF::RNode node)
 {
    node.fLoopManager->Run();
 }
+
+/**
+ * \brief Allocate the RVecs created by Define and Filter expressions in per-slot arenas.
+ * \param[in] node Any node of the computation graph.
+ * \param[in] enable Whether the arenas are used in the next event loops.
+ *
+ * When enabled, the RVecs of trivially copyable types (e.g. `ROOT::RVecF`) which outgrow their small buffer inside
+ * the functions passed to Define and Filter take their buffer from an arena of the processing slot instead of the
+ * heap, see ROOT::Detail::VecOps::RVecArena. The arena is reset at each entry, so that these allocations cost a
+ * pointer increment and never contend for the heap between threads.
+ *
+ * The values of the defined columns can be used as usual by the rest of the computation graph: actions copy them
+ * outside of the arena. Functions which keep RVecs beyond the current entry, e.g. in a captured variable, must copy
+ * them in a scope in which no arena is active:
+ * ~~~{.cpp}
+ * ROOT::RDataFrame df("tree", "file.root");
+ * ROOT::RDF::Experimental::EnableRVecArena(df);
+ * ROOT::RVecF kept;
+ * auto h = df.Define("goodPt", [&](const ROOT::RVecF &pt, ULong64_t entry) {
+ *               ROOT::RVecF good = pt[pt > 20];
+ *               if (entry == 0) {
+ *                  ROOT::Detail::VecOps::RVecArena::RScope noArena(nullptr);
+ *                  kept = good;
+ *               }
+ *               return good;
+ *            }, {"pt", "rdfentry_"}).Histo1D("goodPt");
+ * ~~~
+ * Arenas are not used for the functions passed to DefinePerSample and Vary, whose values may be used across entries.
+ */
+void ROOT::RDF::Experimental::EnableRVecArena(const ROOT::RDF::RNode &node, bool enable)
+{
+   node.GetLoopManager()->SetUseRVecArenas(enable);
+}
@@ -654,6 +654,10 @@ void RLoopManager::RunDataSourceMT()
 /// Named filters must be called even if the analysis logic would not require it, lest they report confusing results.
 void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
 {
+   // the RVecs allocated in the arena for the previous entry are not used anymore
+   if (!fRVecArenas.empty())
+      fRVecArenas[slot]->Reset();
+
    // data-block callbacks run before the rest of the graph
    if (fNewSampleNotifier.CheckFlag(slot)) {
       for (auto &callback : fSampleCallbacks)
@@ -836,6 +840,13 @@ void RLoopManager::Run(bool jit)
 
    InitNodes();
 
+   if (!fUseRVecArenas) {
+      fRVecArenas.clear();
+   } else if (fRVecArenas.empty()) {
+      for (auto i = 0u; i < fNSlots; ++i)
+         fRVecArenas.emplace_back(std::make_unique<ROOT::Detail::VecOps::RVecArena>());
+   }
+
    // Exceptions can occur during the event loop. In order to ensure proper cleanup of nodes
    // we use RAII: even in case of an exception, the destructor of the object is invoked and
    // all the cleanup takes place.
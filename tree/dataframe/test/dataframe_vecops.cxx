@@ -131,3 +131,26 @@ TEST(RDFAndVecOps, RVecBool)
    gSystem->Unlink(filename);
 }
 
+
+TEST(RDFAndVecOps, RVecArena)
+{
+   // entries with RVecs larger than the small buffer, of varying size, in each Define and Filter
+   auto makeRVec = [](ULong64_t e) { return RVec<double>(20 + e % 30, double(e)); };
+   auto run = [&](bool useArena) {
+      ROOT::RDataFrame df(100);
+      ROOT::RDF::Experimental::EnableRVecArena(df, useArena);
+      auto sums = df.Define("v", makeRVec, {"rdfentry_"})
+                     .Define("w", [](const RVec<double> &v) { return v * v + v; }, {"v"})
+                     .Filter([](const RVec<double> &w) { return Sum(w[w > 50.]) >= 0.; }, {"w"})
+                     .Take<RVec<double>>("w");
+      return *sums;
+   };
+
+   const auto expected = run(false);
+   const auto withArena = run(true);
+   ASSERT_EQ(withArena.size(), 100u);
+   for (auto i = 0u; i < 100u; ++i) {
+      EXPECT_EQ(withArena[i].size(), 20 + i % 30);
+      EXPECT_TRUE(All(withArena[i] == expected[i]));
+   }
+}
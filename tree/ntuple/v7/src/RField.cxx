@@ -2077,7 +2077,8 @@ void ROOT::Experimental::RRVecField::ReadGlobalImpl(NTupleSize_t globalIndex, vo
       }
 
       // TODO Increment capacity by a factor rather than just enough to fit the elements.
-      if (owns) {
+      // A capacity < -1 marks a buffer taken from an RVecArena, which is released by the arena
+      if (owns && *capacityPtr >= 0) {
          // *beginPtr points to the array of item values (allocated in an earlier call by the following malloc())
          free(*beginPtr);
       }
@@ -2225,8 +2226,9 @@ void ROOT::Experimental::RRVecField::DestroyValue(void *objPtr, bool dtorOnly) c
       paddingMiddle = alignOfT - paddingMiddle;
    const bool isSmall = (reinterpret_cast<void *>(begin) == (beginPtr + dataMemberSz + paddingMiddle));
 
-   const bool owns = (*capacityPtr != -1);
-   if (!isSmall && owns)
+   // a capacity < -1 marks a buffer taken from an RVecArena, which is released by the arena
+   const bool ownsBuffer = (*capacityPtr >= 0);
+   if (!isSmall && ownsBuffer)
       free(begin);
 
    if (!dtorOnly)
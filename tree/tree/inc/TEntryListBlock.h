@@ -14,11 +14,13 @@
 //
 // Used internally in TEntryList to store the entry numbers.
 //
-// There are 2 ways to represent entry numbers in a TEntryListBlock:
+// There are 3 ways to represent entry numbers in a TEntryListBlock:
 // 1) as bits, where passing entry numbers are assigned 1, not passing - 0
 // 2) as a simple array of entry numbers
-// In both cases, a UShort_t* is used. The second option is better in case
-// less than 1/16 of entries passes the selection, and the representation can be
+// 3) as runs of consecutive passing entries
+// In all cases, a UShort_t* is used. The second option is better in case
+// less than 1/16 of entries passes the selection, the third one when the
+// passing entries come in long ranges, and the representation can be
 // changed by calling OptimizeStorage() function.
 // When the block is being filled, it's always stored as bits, and the OptimizeStorage()
 // function is called by TEntryList when it starts filling the next block. If
@@ -29,6 +31,7 @@
 // - Merge() - adds all entries from one block to the other. If the first block
 //             uses array representation, it's changed to bits representation only
 //             if the total number of passing entries is still less than kBlockSize
+// - Subtract() - removes all entries of one block from the other
 // - GetEntry(n) - returns n-th non-zero entry.
 // - Next()      - return next non-zero entry. In case of representation 1), Next()
 //                 is faster than GetEntry()
@@ -47,14 +50,20 @@ class TEntryListBlock:public TObject
                                 ///< not in the entry list
    Int_t    fN;                 ///< size of fIndices for I/O  =fNPassed for list, fBlockSize for bits
    UShort_t *fIndices;          ///<[fN]
-   Int_t    fType;              ///<0 - bits, 1 - list
+   Int_t    fType;              ///<0 - bits, 1 - list, 2 - runs (pairs of first entry, length-1)
    Bool_t   fPassing;           ///<1 - stores entries that belong to the list
                                 ///<0 - stores entries that don't belong to the list
    UShort_t fCurrent;           ///<! to fasten  Contains() in list mode
    Int_t    fLastIndexQueried;  ///<! to optimize GetEntry() in a loop
    Int_t    fLastIndexReturned; ///<! to optimize GetEntry() in a loop
 
+   static Bool_t fgWriteRuns;   ///< Write the blocks stored as runs in this representation, see SetWriteRuns()
+
    void Transform(Bool_t dir, UShort_t *indexnew);
+   void ToBits();
+   void BitsToRuns(Int_t nruns);
+   void Optimize(Bool_t allowRuns);
+   Int_t FindRun(Int_t entry) const;
 
  public:
 
@@ -69,6 +78,8 @@ class TEntryListBlock:public TObject
    Int_t   Contains(Int_t entry);
    void    OptimizeStorage();
    Int_t   Merge(TEntryListBlock *block);
+   Int_t   Subtract(TEntryListBlock *block);
+   void    FillBits(UShort_t *bits) const;
    Int_t   Next();
    Int_t   GetEntry(Int_t entry);
    void    ResetIndices() {fLastIndexQueried = -1, fLastIndexReturned = -1;}
@@ -77,7 +88,10 @@ class TEntryListBlock:public TObject
    void Print(const Option_t *option = "") const override;
    void    PrintWithShift(Int_t shift) const;
 
-   ClassDefOverride(TEntryListBlock, 1) //Used internally in TEntryList to store the entry numbers
+   static void   SetWriteRuns(Bool_t write);
+   static Bool_t GetWriteRuns() { return fgWriteRuns; }
+
+   ClassDefOverride(TEntryListBlock, 2) //Used internally in TEntryList to store the entry numbers
 
 };
 
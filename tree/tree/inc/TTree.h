@@ -507,6 +507,7 @@ public:
            TTreeCache     *GetReadCache(TFile *file) const;
            TTreeCache     *GetReadCache(TFile *file, Bool_t create);
    virtual Long64_t        GetReadEntry()  const { return fReadEntry; }
+           const TList    *GetReadPattern() const;
    virtual Long64_t        GetReadEvent()  const { return fReadEntry; }
    virtual Int_t           GetScanField()  const { return fScanField; }
            TTreeFormula   *GetSelect()    { return GetPlayer()->GetSelect(); }
@@ -549,6 +550,7 @@ public:
    virtual Int_t           LoadBaskets(Long64_t maxmemory = 2000000000);
    virtual Long64_t        LoadTree(Long64_t entry);
    virtual Long64_t        LoadTreeFriend(Long64_t entry, TTree* T);
+   virtual Bool_t          LoadReadPattern(TDirectory *sidecar);
    virtual Int_t           MakeClass(const char *classname = nullptr, Option_t* option = "");
    virtual Int_t           MakeCode(const char *filename = nullptr);
    virtual Int_t           MakeProxy(const char* classname, const char* macrofilename = nullptr, const char* cutfilename = nullptr, const char* option = nullptr, Int_t maxUnrolling = 3);
@@ -572,6 +574,7 @@ public:
    virtual void            RegisterExternalFriend(TFriendElement *);
    virtual void            RemoveExternalFriend(TFriendElement *);
    virtual void            RemoveFriend(TTree*);
+   virtual Int_t           RecordReadPattern(TDirectory *sidecar = nullptr);
            void            RecursiveRemove(TObject *obj) override;
    virtual void            Reset(Option_t* option = "");
    virtual void            ResetAfterMerge(TFileMergeInfo *);
@@ -642,6 +645,7 @@ public:
    virtual void            SetObject(const char* name, const char* title);
    virtual void            SetParallelUnzip(Bool_t opt=kTRUE, Float_t RelSize=-1);
    virtual void            SetPerfStats(TVirtualPerfStats* perf);
+   virtual void            SetReadPattern(const TCollection *branches);
    virtual void            SetScanField(Int_t n = 50) { fScanField = n; } // *MENU*
    void SetTargetMemoryRatio(Float_t ratio) { fTargetMemoryRatio = ratio; }
    virtual void            SetTimerInterval(Int_t msec = 333) { fTimerInterval=msec; }
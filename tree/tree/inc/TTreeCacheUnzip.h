@@ -97,13 +97,19 @@ protected:
    Int_t       fUnzipGroupSize;   ///<!  Min accumulated size of a group of baskets ready to be unzipped by a IMT task
    Long64_t    fUnzipBufferSize;  ///<!  Max Size for the ready unzipped blocks (default is 2*fBufferSize)
 
+   // Scheduling of the unzipping
+   std::vector<Long64_t> fSeekEntry;   ///<!  First entry of the baskets, in the order of fSeek
+   std::vector<Int_t>    fUnzipOrder;  ///<!  Indices of the baskets in the order in which the reader needs them
+   std::atomic<Int_t>    fUnzipNext;   ///<!  Position in fUnzipOrder of the next basket to unzip
+
    static Double_t fgRelBuffSize; ///< This is the percentage of the TTreeCacheUnzip that will be used
 
    // Members use to keep statistics
    Int_t       fNFound;           ///<! number of blocks that were found in the cache
    Int_t       fNMissed;          ///<! number of blocks that were not found in the cache and were unzipped
    Int_t       fNStalls;          ///<! number of hits which caused a stall
-   Int_t       fNUnzip;           ///<! number of blocks that were unzipped
+   std::atomic<Int_t> fNUnzip;    ///<! number of blocks that were unzipped
+   Int_t       fNHelped;          ///<! number of blocks unzipped by the reading thread while waiting for a block
 
 private:
    TTreeCacheUnzip(const TTreeCacheUnzip &) = delete;
@@ -114,6 +120,9 @@ private:
 
    // Private methods
    void  Init();
+   void  AdvanceUnzip(Int_t index);
+   Int_t NextUnzip();
+   void  StopUnzip();
 
 public:
    TTreeCacheUnzip();
@@ -152,6 +161,8 @@ public:
    Int_t  GetNUnzip() { return fNUnzip; }
    Int_t  GetNMissed(){ return fNMissed; }
    Int_t  GetNFound() { return fNFound; }
+   Int_t  GetNStalls() { return fNStalls; }
+   Int_t  GetNHelped() { return fNHelped; }
 
    void Print(Option_t* option = "") const override;
 
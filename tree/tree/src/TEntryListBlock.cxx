@@ -14,21 +14,27 @@
 
 Used by TEntryList to store the entry numbers.
 
-There are 2 ways to represent entry numbers in a TEntryListBlock:
+There are 3 ways to represent entry numbers in a TEntryListBlock:
 
  1. as bits, where passing entry numbers are assigned 1, not passing - 0
  2. as a simple array of entry numbers
   - storing the numbers of entries that pass
   - storing the numbers of entries that don't pass
+ 3. as runs of consecutive passing entries, stored as pairs
+    (first entry of the run, length of the run - 1) (since class version 2)
 
-In both cases, a UShort_t* is used. The second option is better in case
-less than 1/16 or more than 15/16 of entries pass the selection, and the representation can be
-changed by calling OptimizeStorage() function.
+In all cases, a UShort_t* is used. The second option is better in case
+less than 1/16 or more than 15/16 of entries pass the selection, the third one
+when the passing entries come in long ranges. The representation can be
+changed by calling OptimizeStorage() function, which picks the smallest one.
 When the block is being filled, it's always stored as bits, and the OptimizeStorage()
 function is called by TEntryList when it starts filling the next block. If
 Enter() or Remove() is called after OptimizeStorage(), representation is
 again changed to 1).
 
+Set operations between blocks (Merge(), Subtract()) work on the bits
+representation 16 entries at a time, in loops the compiler can vectorize.
+
 Begin_Macro
 entrylistblock_figure1.C
 End_Macro
@@ -38,13 +44,105 @@ End_Macro
  - __Merge__() - adds all entries from one block to the other. If the first block
              uses array representation, it's changed to bits representation only
              if the total number of passing entries is still less than kBlockSize
+ - __Subtract__() - removes all entries of one block from the other
  - __GetEntry(n)__ - returns n-th non-zero entry.
  - __Next__()      - return next non-zero entry. In case of representation 1), Next()
                  is faster than GetEntry()
 */
 
 #include "TEntryListBlock.h"
+#include "TBuffer.h"
 #include "TString.h"
+#include "TMath.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+
+Bool_t TEntryListBlock::fgWriteRuns = kFALSE;
+
+namespace {
+
+constexpr Int_t kNWords = TEntryListBlock::kBlockSize;
+constexpr Int_t kNEntries = TEntryListBlock::kBlockSize * 16;
+
+/// Index of the lowest set bit of a non-zero word
+inline Int_t LowestBit(UInt_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   return __builtin_ctz(word);
+#else
+   Int_t i = 0;
+   while (!(word & 1)) {
+      word >>= 1;
+      ++i;
+   }
+   return i;
+#endif
+}
+
+inline Int_t PopCount(UShort_t word)
+{
+   return std::bitset<16>(word).count();
+}
+
+/// Number of bits set in the bitmap
+Int_t CountBits(const UShort_t *bits)
+{
+   Int_t n = 0;
+   for (Int_t i = 0; i < kNWords; i++)
+      n += PopCount(bits[i]);
+   return n;
+}
+
+/// First entry >= from whose bit has the given value, kNEntries if there is none
+Int_t FindBit(const UShort_t *bits, Int_t from, Bool_t value)
+{
+   Int_t i = from >> 4;
+   if (i >= kNWords)
+      return kNEntries;
+   const UInt_t flip = value ? 0 : 0xFFFF;
+   UInt_t word = (bits[i] ^ flip) & (0xFFFF << (from & 15)) & 0xFFFF;
+   while (!word) {
+      if (++i == kNWords)
+         return kNEntries;
+      word = bits[i] ^ flip;
+   }
+   return i * 16 + LowestBit(word);
+}
+
+/// Number of runs of consecutive set bits in the bitmap
+Int_t CountRuns(const UShort_t *bits)
+{
+   Int_t nruns = 0;
+   UInt_t carry = 0;
+   for (Int_t i = 0; i < kNWords; i++) {
+      const UInt_t word = bits[i];
+      // bits that are set while the previous one is not
+      nruns += PopCount(word & ~((word << 1) | carry) & 0xFFFF);
+      carry = word >> 15;
+   }
+   return nruns;
+}
+
+/// Set the bits of the entries first..last
+void SetBitRange(UShort_t *bits, Int_t first, Int_t last)
+{
+   Int_t ifirst = first >> 4;
+   Int_t ilast = last >> 4;
+   UShort_t maskfirst = 0xFFFF << (first & 15);
+   UShort_t masklast = 0xFFFF >> (15 - (last & 15));
+   if (ifirst == ilast) {
+      bits[ifirst] |= maskfirst & masklast;
+      return;
+   }
+   bits[ifirst] |= maskfirst;
+   for (Int_t i = ifirst + 1; i < ilast; i++)
+      bits[i] = 0xFFFF;
+   bits[ilast] |= masklast;
+}
+
+} // namespace
 
 ClassImp(TEntryListBlock);
 
@@ -127,7 +225,7 @@ TEntryListBlock &TEntryListBlock::operator=(const TEntryListBlock &eblock)
 
 Bool_t TEntryListBlock::Enter(Int_t entry)
 {
-   if (entry > kBlockSize*16) {
+   if (entry >= kBlockSize*16) {
       Error("Enter", "illegal entry value!");
       return false;
    }
@@ -149,12 +247,10 @@ Bool_t TEntryListBlock::Enter(Int_t entry)
          return false;
       }
    }
-   //list
+   //list or runs
    //change to bits
-   UShort_t *bits = new UShort_t[kBlockSize];
-   Transform(true, bits);
-   Enter(entry);
-   return false;
+   ToBits();
+   return Enter(entry);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -165,7 +261,7 @@ Bool_t TEntryListBlock::Enter(Int_t entry)
 
 Bool_t TEntryListBlock::Remove(Int_t entry)
 {
-   if (entry > kBlockSize*16) {
+   if (entry >= kBlockSize*16) {
       Error("Remove", "Illegal entry value!\n");
       return false;
    }
@@ -180,12 +276,12 @@ Bool_t TEntryListBlock::Remove(Int_t entry)
          return false;
       }
    }
-   //list
+   if (!Contains(entry))
+      return false;
+   //list or runs
    //change to bits
-   UShort_t *bits = new UShort_t[kBlockSize];
-   Transform(true, bits);
+   ToBits();
    return Remove(entry);
-   //return 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -193,7 +289,7 @@ Bool_t TEntryListBlock::Remove(Int_t entry)
 
 Int_t TEntryListBlock::Contains(Int_t entry)
 {
-   if (entry > kBlockSize*16) {
+   if (entry >= kBlockSize*16) {
       Error("Contains", "Illegal entry value!\n");
       return 0;
    }
@@ -206,34 +302,21 @@ Int_t TEntryListBlock::Contains(Int_t entry)
       Bool_t result = (fIndices[i] & (1<<j))!=0;
       return result;
    }
+   if (fType==2){
+      //runs
+      Int_t irun = FindRun(entry);
+      return irun < fN/2 && fIndices[2*irun] <= entry;
+   }
    //list
-   if (entry < fCurrent) fCurrent = 0;
-   if (fPassing && fIndices){
-      for (Int_t i = fCurrent; i<fNPassed; i++){
-         if (fIndices[i]==entry){
-            fCurrent = i;
-            return kTRUE;
-         }
-      }
-   } else {
-      if (!fIndices || fNPassed==0){
-         //all entries pass
-         return kTRUE;
-      }
-      if (entry > fIndices[fNPassed-1])
-         return kTRUE;
-      for (Int_t i= fCurrent; i<fNPassed; i++){
-         if (fIndices[i]==entry){
-            fCurrent = i;
-            return kFALSE;
-         }
-         if (fIndices[i]>entry){
-            fCurrent = i;
-            return kTRUE;
-         }
-      }
+   if (!fIndices || fNPassed==0){
+      //all entries pass if the list stores the entries that don't pass
+      return !fPassing;
    }
-   return 0;
+   UShort_t *end = fIndices + fNPassed;
+   UShort_t *found = std::lower_bound(fIndices, end, (UShort_t)entry);
+   fCurrent = found - fIndices;
+   Bool_t inlist = (found != end && *found == entry);
+   return fPassing ? inlist : !inlist;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -242,120 +325,32 @@ Int_t TEntryListBlock::Contains(Int_t entry)
 
 Int_t TEntryListBlock::Merge(TEntryListBlock *block)
 {
-   Int_t i, j;
    if (block->GetNPassed() == 0) return GetNPassed();
    if (GetNPassed() == 0){
       //this block is empty
-      fN = block->fN;
-      fIndices = new UShort_t[fN];
-      for (i=0; i<fN; i++)
-         fIndices[i] = block->fIndices[i];
-      fNPassed = block->fNPassed;
-      fType = block->fType;
-      fPassing = block->fPassing;
-      fCurrent = block->fCurrent;
-      fLastIndexReturned = -1;
-      fLastIndexQueried = -1;
-      return fNPassed;
+      *this = *block;
+      return GetNPassed();
    }
-   if (fType==0){
-      //stored as bits
-      if (block->fType == 0){
-         for (i=0; i<kBlockSize*16; i++){
-            if (block->Contains(i))
-               Enter(i);
-         }
-      } else {
-         if (block->fPassing){
-            //the other block stores entries that pass
-            for (i=0; i<block->fNPassed; i++){
-               Enter(block->fIndices[i]);
-            }
-         } else {
-            //the other block stores entries that don't pass
-            if (block->fNPassed==0){
-               for (i=0; i<kBlockSize*16; i++){
-                  Enter(i);
-               }
-            }
-            for (j=0; j<block->fIndices[0]; j++)
-               Enter(j);
-            for (i=0; i<block->fNPassed-1; i++){
-               for (j=block->fIndices[i]+1; j<block->fIndices[i+1]; j++){
-                  Enter(j);
-               }
-            }
-            for (j=block->fIndices[block->fNPassed-1]+1; j<kBlockSize*16; j++)
-               Enter(j);
-         }
-      }
+   if (fType==1 && fPassing && block->fType==1 && block->fPassing &&
+       fNPassed + block->fNPassed <= kBlockSize){
+      //both blocks store the passing entries as lists: make a bigger list
+      Int_t en = block->fNPassed;
+      Int_t newsize = fNPassed + en;
+      UShort_t *newlist = new UShort_t[newsize];
+      UShort_t *newend = std::set_union(fIndices, fIndices + fNPassed,
+                                        block->fIndices, block->fIndices + en, newlist);
+      delete [] fIndices;
+      fIndices = newlist;
+      fNPassed = newend - newlist;
+      fN = fNPassed;
    } else {
-      //stored as a list
-      if (GetNPassed() + block->GetNPassed() > kBlockSize){
-         //change to bits
-         UShort_t *bits = new UShort_t[kBlockSize];
-         Transform(true, bits);
-         Merge(block);
-      } else {
-         //this is only possible if fPassing=1 in both blocks
-         if (block->fType==1){
-            //second block stored as a list
-            //make a bigger list
-            Int_t en = block->fNPassed;
-            Int_t newsize = fNPassed + en;
-            UShort_t *newlist = new UShort_t[newsize];
-            UShort_t *elst = block->fIndices;
-            Int_t newpos, elpos;
-            newpos = elpos = 0;
-            for (i=0; i<fNPassed; i++) {
-               while (elpos < en && fIndices[i] > elst[elpos]) {
-                  newlist[newpos] = elst[elpos];
-                  newpos++;
-                  elpos++;
-               }
-               if (fIndices[i] == elst[elpos]) elpos++;
-               newlist[newpos] = fIndices[i];
-               newpos++;
-            }
-            while (elpos < en) {
-               newlist[newpos] = elst[elpos];
-               newpos++;
-               elpos++;
-            }
-            delete [] fIndices;
-            fIndices = newlist;
-            fNPassed = newpos;
-            fN = fNPassed;
-         } else {
-            //second block is stored as bits
-
-            Int_t en = block->fNPassed;
-            Int_t newsize = fNPassed + en;
-            UShort_t *newlist = new UShort_t[newsize];
-            Int_t newpos, current;
-            newpos = current = 0;
-            for (i=0; i<kBlockSize*16; i++){
-               if (!block->Contains(i)) continue;
-               while(current < fNPassed && fIndices[current]<i){
-                  newlist[newpos] = fIndices[current];
-                  current++;
-                  newpos++;
-               }
-               if (fIndices[current]==i) current++;
-               newlist[newpos] = i;
-               newpos++;
-            }
-            while(current<fNPassed){
-               newlist[newpos] = fIndices[current];
-               newpos++;
-               current++;
-            }
-            delete [] fIndices;
-            fIndices = newlist;
-            fNPassed = newpos;
-            fN = fNPassed;
-         }
-      }
+      //or the bits of the two blocks
+      UShort_t other[kBlockSize];
+      block->FillBits(other);
+      ToBits();
+      for (Int_t i=0; i<kBlockSize; i++)
+         fIndices[i] |= other[i];
+      fNPassed = CountBits(fIndices);
    }
    fLastIndexQueried = -1;
    fLastIndexReturned = -1;
@@ -363,6 +358,41 @@ Int_t TEntryListBlock::Merge(TEntryListBlock *block)
    return GetNPassed();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the entries of the other block from this block
+/// Returns the resulting number of entries in the block
+
+Int_t TEntryListBlock::Subtract(TEntryListBlock *block)
+{
+   if (block->GetNPassed() == 0 || GetNPassed() == 0) return GetNPassed();
+   if (fType==1 && fPassing && block->fType==1 && block->fPassing){
+      //both blocks store the passing entries as lists
+      Int_t newpos = 0;
+      Int_t elpos = 0;
+      for (Int_t i=0; i<fNPassed; i++){
+         while (elpos < block->fNPassed && block->fIndices[elpos] < fIndices[i])
+            elpos++;
+         if (elpos < block->fNPassed && block->fIndices[elpos] == fIndices[i])
+            continue;
+         fIndices[newpos++] = fIndices[i];
+      }
+      fNPassed = newpos;
+      fN = fNPassed;
+   } else {
+      //clear the bits of this block that are set in the other one
+      UShort_t other[kBlockSize];
+      block->FillBits(other);
+      ToBits();
+      for (Int_t i=0; i<kBlockSize; i++)
+         fIndices[i] &= ~other[i];
+      fNPassed = CountBits(fIndices);
+      OptimizeStorage();
+   }
+   fLastIndexQueried = -1;
+   fLastIndexReturned = -1;
+   return GetNPassed();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the number of entries, passing the selection.
 /// In case, when the block stores entries that pass (fPassing=1) returns fNPassed
@@ -381,24 +411,41 @@ Int_t TEntryListBlock::GetNPassed()
 
 Int_t TEntryListBlock::GetEntry(Int_t entry)
 {
-   if (entry > kBlockSize*16) return -1;
-   if (entry > GetNPassed()) return -1;
+   if (entry >= kBlockSize*16) return -1;
+   if (entry >= GetNPassed()) return -1;
    if (entry == fLastIndexQueried+1) return Next();
    else {
       Int_t i=0; Int_t j=0; Int_t entries_found=0;
       if (fType==0){
-         if ((fIndices[i] & (1<<j))!=0)
-            entries_found++;
-         while (entries_found<entry+1){
-            if (j==15){i++; j=0;}
-            else j++;
-            if ((fIndices[i] & (1<<j))!=0)
-               entries_found++;
+         //skip the words that are before the requested entry
+         Int_t nword = PopCount(fIndices[0]);
+         while (entries_found + nword < entry+1){
+            entries_found += nword;
+            i++;
+            nword = PopCount(fIndices[i]);
+         }
+         UInt_t word = fIndices[i];
+         while (true){
+            j = LowestBit(word);
+            if (++entries_found == entry+1) break;
+            word &= word - 1;
          }
          fLastIndexQueried = entry;
          fLastIndexReturned = i*16+j;
          return fLastIndexReturned;
       }
+      if (fType==2){
+         for (i=0; i<fN; i+=2){
+            Int_t length = fIndices[i+1] + 1;
+            if (entries_found + length > entry){
+               fLastIndexQueried = entry;
+               fLastIndexReturned = fIndices[i] + entry - entries_found;
+               return fLastIndexReturned;
+            }
+            entries_found += length;
+         }
+         return -1;
+      }
       if (fType==1){
          if (fPassing){
             fLastIndexQueried = entry;
@@ -411,29 +458,12 @@ Int_t TEntryListBlock::GetEntry(Int_t entry)
                fLastIndexReturned = entry;
                return fLastIndexReturned;
             }
-            for (i=0; i<fIndices[0]; i++){
-               entries_found++;
-               if (entries_found==entry+1){
-                  fLastIndexReturned = i;
-                  return fLastIndexReturned;
-               }
-            }
-            for (i=0; i<fNPassed-1; i++){
-               for (j=fIndices[i]+1; j<fIndices[i+1]; j++){
-                  entries_found++;
-                  if (entries_found==entry+1){
-                     fLastIndexReturned = j;
-                     return fLastIndexReturned;
-                  }
-               }
-            }
-            for (j=fIndices[fNPassed-1]+1; j<kBlockSize*16; j++){
-               entries_found++;
-               if (entries_found==entry+1){
-                  fLastIndexReturned = j;
-                  return fLastIndexReturned;
-               }
-            }
+            //the result is entry shifted by the number of listed entries that are not above it
+            j = entry;
+            for (i=0; i<fNPassed && fIndices[i]<=j; i++)
+               j++;
+            fLastIndexReturned = j;
+            return fLastIndexReturned;
          }
       }
       return -1;
@@ -454,22 +484,20 @@ Int_t TEntryListBlock::Next()
 
    if (fType==0) {
       //bits
-      Int_t i=0;
-      Int_t j=0;
-      fLastIndexReturned++;
-      i = fLastIndexReturned>>4;
-      j = fLastIndexReturned & 15;
-      Bool_t result=(fIndices[i] & (1<<j))!=0;
-      while (!result) {
-         if (j==15) {j=0; i++;}
-         else j++;
-         result = (fIndices[i] & (1<<j)) != 0;
-      }
-      fLastIndexReturned = i*16+j;
+      fLastIndexReturned = FindBit(fIndices, fLastIndexReturned+1, true);
       fLastIndexQueried++;
       return fLastIndexReturned;
 
    }
+   if (fType==2) {
+      //runs
+      fLastIndexQueried++;
+      fLastIndexReturned++;
+      Int_t irun = FindRun(fLastIndexReturned);
+      if (fIndices[2*irun] > fLastIndexReturned)
+         fLastIndexReturned = fIndices[2*irun];
+      return fLastIndexReturned;
+   }
    if (fType==1) {
       fLastIndexQueried++;
       if (fPassing){
@@ -505,14 +533,12 @@ void TEntryListBlock::PrintWithShift(Int_t shift) const
 {
    Int_t i;
    if (fType==0){
-      Int_t ibit, ibite;
-      Bool_t result;
-      for (i=0; i<kBlockSize*16; i++){
-         ibite = i>>4;
-         ibit = i & 15;
-         result = (fIndices[ibite] & (1<<ibit))!=0;
-         if (result)
-            printf("%d\n", i+shift);
+      for (i=FindBit(fIndices, 0, true); i<kBlockSize*16; i=FindBit(fIndices, i+1, true))
+         printf("%d\n", i+shift);
+   } else if (fType==2){
+      for (i=0; i<fN; i+=2){
+         for (Int_t j=fIndices[i]; j<=fIndices[i]+fIndices[i+1]; j++)
+            printf("%d\n", j+shift);
       }
    } else {
       if (fPassing){
@@ -541,12 +567,30 @@ void TEntryListBlock::PrintWithShift(Int_t shift) const
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// If there are < kBlockSize or >kBlockSize*15 entries, change to an array
-/// representation
+/// Change from bits to the most compact representation:
+/// - if there are < kBlockSize or >kBlockSize*15 entries, an array
+/// - if the entries come in few ranges, runs
 
 void TEntryListBlock::OptimizeStorage()
+{
+   Optimize(kTRUE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Transform a block stored as bits to the smallest representation, the runs
+/// being considered only if allowRuns is true
+
+void TEntryListBlock::Optimize(Bool_t allowRuns)
 {
    if (fType!=0) return;
+   if (allowRuns){
+      Int_t nruns = CountRuns(fIndices);
+      Int_t nlist = TMath::Min(fNPassed, kBlockSize*16-fNPassed);
+      if (2*nruns < nlist && 2*nruns < kBlockSize){
+         BitsToRuns(nruns);
+         return;
+      }
+   }
    if (fNPassed > kBlockSize*15)
       fPassing = false;
    if (fNPassed<kBlockSize || !fPassing){
@@ -556,6 +600,119 @@ void TEntryListBlock::OptimizeStorage()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set whether the blocks stored as runs are written in this representation.
+/// The runs (fType 2) are not understood by the versions of ROOT older than
+/// 6.32, which silently misread them: by default (false), the blocks stored as
+/// runs are written as bits or as a list, like OptimizeStorage() would store
+/// them without runs, and the files remain readable by older versions.
+
+void TEntryListBlock::SetWriteRuns(Bool_t write)
+{
+   fgWriteRuns = write;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Custom streamer for class TEntryListBlock, writing the blocks stored as
+/// runs as bits or as a list, unless SetWriteRuns(kTRUE) was called.
+
+void TEntryListBlock::Streamer(TBuffer &b)
+{
+   if (b.IsReading()) {
+      b.ReadClassBuffer(TEntryListBlock::Class(), this);
+   } else if (fType==2 && !fgWriteRuns) {
+      TEntryListBlock block(*this);
+      block.ToBits();
+      block.Optimize(kFALSE);
+      b.WriteClassBuffer(TEntryListBlock::Class(), &block);
+   } else {
+      b.WriteClassBuffer(TEntryListBlock::Class(), this);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill bits (kBlockSize words) with the bits representation of this block,
+/// whatever the current representation is
+
+void TEntryListBlock::FillBits(UShort_t *bits) const
+{
+   Int_t i;
+   if (fType==0){
+      memcpy(bits, fIndices, kBlockSize*sizeof(UShort_t));
+      return;
+   }
+   if (fType==2){
+      memset(bits, 0, kBlockSize*sizeof(UShort_t));
+      for (i=0; i<fN; i+=2)
+         SetBitRange(bits, fIndices[i], fIndices[i]+fIndices[i+1]);
+      return;
+   }
+   if (fPassing){
+      memset(bits, 0, kBlockSize*sizeof(UShort_t));
+      for (i=0; i<fNPassed && fIndices; i++)
+         bits[fIndices[i]>>4] |= 1<<(fIndices[i] & 15);
+   } else {
+      memset(bits, 0xFF, kBlockSize*sizeof(UShort_t));
+      for (i=0; i<fNPassed && fIndices; i++)
+         bits[fIndices[i]>>4] &= ~(1<<(fIndices[i] & 15));
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Change to bits representation
+
+void TEntryListBlock::ToBits()
+{
+   if (fType==0) return;
+   UShort_t *bits = new UShort_t[kBlockSize];
+   FillBits(bits);
+   fNPassed = GetNPassed();
+   if (fIndices)
+      delete [] fIndices;
+   fIndices = bits;
+   fType = 0;
+   fN = kBlockSize;
+   fPassing = true;
+   fCurrent = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Change from bits to runs representation, given the number of runs
+
+void TEntryListBlock::BitsToRuns(Int_t nruns)
+{
+   UShort_t *runs = new UShort_t[2*nruns];
+   Int_t first = FindBit(fIndices, 0, true);
+   for (Int_t irun=0; irun<nruns; irun++){
+      Int_t last = FindBit(fIndices, first, false) - 1;
+      runs[2*irun] = first;
+      runs[2*irun+1] = last - first;
+      first = FindBit(fIndices, last+1, true);
+   }
+   delete [] fIndices;
+   fIndices = runs;
+   fType = 2;
+   fN = 2*nruns;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the first run which ends at or after entry,
+/// the number of runs if there is none
+
+Int_t TEntryListBlock::FindRun(Int_t entry) const
+{
+   //binary search on the last entry of the runs
+   Int_t lo = 0, hi = fN/2;
+   while (lo < hi){
+      Int_t mid = (lo + hi)/2;
+      if (fIndices[2*mid] + fIndices[2*mid+1] < entry)
+         lo = mid + 1;
+      else
+         hi = mid;
+   }
+   return lo;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Transform the existing fIndices
 /// - dir=0 - transform from bits to a list
@@ -431,10 +431,12 @@ End_Macro
 
 #include "TBranchIMTHelper.h"
 #include "TNotifyLink.h"
+#include "TObjString.h"
 
 #include <chrono>
 #include <cstddef>
 #include <iostream>
+#include <memory>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -6338,6 +6340,17 @@ TTreeCache *TTree::GetReadCache(TFile *file, Bool_t create)
    return pe;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the list of the names (TObjString) of the branches recorded as
+/// being read together, see SetReadPattern(), or nullptr if there is none.
+
+const TList *TTree::GetReadPattern() const
+{
+   if (!fUserInfo)
+      return nullptr;
+   return dynamic_cast<TList *>(fUserInfo->FindObject("ReadPattern"));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return a pointer to the list containing user objects associated to this tree.
 ///
@@ -6538,6 +6551,26 @@ Long64_t TTree::LoadTree(Long64_t entry)
    return fReadEntry;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the read pattern saved by RecordReadPattern() in the directory
+/// sidecar and set it as the read pattern of this tree, see SetReadPattern().
+/// Returns kFALSE if sidecar does not contain a read pattern for this tree.
+
+Bool_t TTree::LoadReadPattern(TDirectory *sidecar)
+{
+   if (!sidecar)
+      return kFALSE;
+   TString keyname = TString::Format("%s_ReadPattern", GetName());
+   std::unique_ptr<TList> pattern(sidecar->Get<TList>(keyname));
+   if (!pattern) {
+      Error("LoadReadPattern", "No read pattern %s in %s", keyname.Data(), sidecar->GetName());
+      return kFALSE;
+   }
+   pattern->SetOwner(kTRUE);
+   SetReadPattern(pattern.get());
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Load entry on behalf of our master tree, we may use an index.
 ///
@@ -7051,6 +7084,11 @@ Bool_t TTree::Notify()
 /// than compMin, the compression is disabled.
 ///
 /// if option ="d" an analysis report is printed.
+///
+/// If the tree has a read pattern (see SetReadPattern()), the branches read
+/// together are given a 4 times larger share of the memory, and their buffer
+/// sizes are rounded to 4 kB, so that their data is stored in fewer, larger
+/// baskets. The option "n" ignores the read pattern.
 
 void TTree::OptimizeBaskets(ULong64_t maxMemory, Float_t minComp, Option_t *option)
 {
@@ -7073,6 +7111,31 @@ void TTree::OptimizeBaskets(ULong64_t maxMemory, Float_t minComp, Option_t *opti
    UInt_t bmax = 256000;
    Double_t memFactor = 1;
    Int_t i, oldMemsize,newMemsize,oldBaskets,newBaskets;
+
+   // Branches read together according to the read pattern, and their share of the memory
+   std::set<std::string> hotBranches;
+   const TList *readPattern = opt.Contains("n") ? nullptr : GetReadPattern();
+   if (readPattern) {
+      TIter next(readPattern);
+      while (TObject *name = next())
+         hotBranches.insert(name->GetName());
+   }
+   const Double_t hotFactor = 4;
+   // a branch is hot if it, or any of its parents up to its top-level mother, is in the read pattern
+   auto isHot = [&hotBranches](TBranch *branch) {
+      if (hotBranches.empty())
+         return false;
+      TBranch *mother = branch->GetMother();
+      while (branch) {
+         if (hotBranches.count(branch->GetName()))
+            return true;
+         if (!mother || branch == mother)
+            break;
+         TBranch *parent = mother->GetSubBranch(branch);
+         branch = (parent == branch) ? nullptr : parent;
+      }
+      return false;
+   };
    i = oldMemsize = newMemsize = oldBaskets = newBaskets = 0;
 
    //we make two passes
@@ -7103,6 +7166,8 @@ void TTree::OptimizeBaskets(ULong64_t maxMemory, Float_t minComp, Option_t *opti
             newBaskets += 1+Int_t(totBytes/oldBsize);
             continue;
          }
+         const Bool_t hot = isHot(branch);
+         if (hot) idealFactor *= hotFactor;
          Double_t bsize = oldBsize*idealFactor*memFactor; //bsize can be very large !
          if (bsize < 0) bsize = bmax;
          if (bsize > bmax) bsize = bmax;
@@ -7124,6 +7189,13 @@ void TTree::OptimizeBaskets(ULong64_t maxMemory, Float_t minComp, Option_t *opti
             // structures we found a factor of 2 fewer baskets needed in the new scheme.
             // rounds up, increases basket size to ensure all entries fit into single basket as intended
             newBsize = newBsize - newBsize%512 + 512;
+            // The buffer sizes of the branches read together are rounded up to a multiple of 4 kB, and
+            // kept below bmax after the rounding. This gives fewer, larger baskets; their offsets in the
+            // file are not aligned on pages, as each basket is preceded by its key header.
+            if (hot) {
+               if (newBsize%4096) newBsize = newBsize - newBsize%4096 + 4096;
+               if (newBsize > bmax) newBsize = bmax - bmax%4096;
+            }
          }
          if (newBsize < sizeOfOneEntry) newBsize = sizeOfOneEntry;
          if (newBsize < bmin) newBsize = bmin;
@@ -7872,6 +7944,51 @@ Long64_t TTree::ReadStream(std::istream& inputStream, const char *branchDescript
    return nGoodLines;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Record the branches read so far from this tree as its read pattern, see
+/// SetReadPattern().
+///
+/// The branches are taken from the TTreeCache of the current file once its
+/// learning phase is over, otherwise they are the branches from which at least
+/// one entry was read. This is meant to be called by the readers of a file, at
+/// the end of their event loop.
+///
+/// If sidecar is not null, the read pattern is also written to this directory
+/// (typically in a separate, writable file, as the tree's own file is often
+/// read-only) so that it can be attached to the tree with LoadReadPattern()
+/// before re-writing it. Otherwise it is kept in the list of user info of the
+/// tree and stored with the tree the next time it is written.
+///
+/// Returns the number of branches recorded.
+
+Int_t TTree::RecordReadPattern(TDirectory *sidecar)
+{
+   TList branches;
+   TFile *file = GetCurrentFile();
+   TTreeCache *cache = file ? GetReadCache(file) : nullptr;
+   if (cache && !cache->IsLearning() && cache->GetCachedBranches()) {
+      TIter next(cache->GetCachedBranches());
+      while (auto branch = (TBranch *)next())
+         branches.Add(branch);
+   } else {
+      TIter next(GetListOfLeaves());
+      while (auto leaf = (TLeaf *)next()) {
+         TBranch *branch = leaf->GetBranch();
+         if (branch->GetReadEntry() >= 0 && !branches.FindObject(branch))
+            branches.Add(branch);
+      }
+   }
+   if (branches.IsEmpty())
+      return 0;
+
+   SetReadPattern(&branches);
+   if (sidecar) {
+      TDirectory::TContext ctxt(sidecar);
+      GetReadPattern()->Write(TString::Format("%s_ReadPattern", GetName()), TObject::kSingleKey | TObject::kOverwrite);
+   }
+   return branches.GetSize();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Make sure that obj (which is being deleted or will soon be) is no
 /// longer referenced by this TTree.
@@ -9319,6 +9436,39 @@ void TTree::SetPerfStats(TVirtualPerfStats *perf)
    fPerfStats = perf;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the list of branches which are read together by the users of this
+/// tree. The names of the objects in branches (typically TBranch or
+/// TObjString) are stored in a TList named "ReadPattern" in the user info of
+/// the tree, replacing the previous read pattern. An empty or null collection
+/// removes the read pattern.
+///
+/// OptimizeBaskets() gives a larger share of the basket memory to these
+/// branches, and rounds their buffer sizes up to a multiple of 4 kB. As the user info is copied
+/// by CloneTree() and when merging trees, re-writing the tree without fast
+/// cloning (for example `hadd -O`) re-baskets it according to this pattern;
+/// see RecordReadPattern() to obtain it from the readers of the tree.
+
+void TTree::SetReadPattern(const TCollection *branches)
+{
+   if (auto old = const_cast<TList *>(GetReadPattern())) {
+      fUserInfo->Remove(old);
+      old->Delete();
+      delete old;
+   }
+   if (!branches || branches->IsEmpty())
+      return;
+   auto pattern = new TList();
+   pattern->SetName("ReadPattern");
+   pattern->SetOwner(kTRUE);
+   TIter next(branches);
+   while (TObject *obj = next()) {
+      if (!pattern->FindObject(obj->GetName()))
+         pattern->Add(new TObjString(obj->GetName()));
+   }
+   GetUserInfo()->Add(pattern);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// The current TreeIndex is replaced by the new index.
 /// Note that this function does not delete the previous index.
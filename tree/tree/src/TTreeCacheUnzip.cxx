@@ -16,6 +16,14 @@
 
 A TTreeCache which exploits parallelized decompression of its own content.
 
+The baskets of the cache are unzipped in the order in which the reader needs
+them, i.e. by increasing first entry. The tasks and the reading thread, while
+it waits for a basket being unzipped, take the next basket from this common
+queue, which skips the baskets whose entries the reader has already passed.
+The queue is stopped when the cache is refilled. The statistics shown by
+Print() count the baskets found unzipped (hits), found being unzipped
+(stalls) and unzipped by the reading thread itself (misses).
+
 */
 
 #include "TTreeCacheUnzip.h"
@@ -33,6 +41,8 @@ A TTreeCache which exploits parallelized decompression of its own content.
 #include "ROOT/TTaskGroup.hxx"
 #endif
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 
 extern "C" void R__unzip(Int_t *nin, UChar_t *bufin, Int_t *lout, char *bufout, Int_t *nout);
@@ -163,10 +173,12 @@ TTreeCacheUnzip::TTreeCacheUnzip() : TTreeCache(),
    fNseekMax(0),
    fUnzipGroupSize(0),
    fUnzipBufferSize(0),
+   fUnzipNext(0),
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
-   fNUnzip(0)
+   fNUnzip(0),
+   fNHelped(0)
 {
    // Default Constructor.
    Init();
@@ -182,10 +194,12 @@ TTreeCacheUnzip::TTreeCacheUnzip(TTree *tree, Int_t buffersize) : TTreeCache(tre
    fNseekMax(0),
    fUnzipGroupSize(0),
    fUnzipBufferSize(0),
+   fUnzipNext(0),
    fNFound(0),
    fNMissed(0),
    fNStalls(0),
-   fNUnzip(0)
+   fNUnzip(0),
+   fNHelped(0)
 {
    Init();
 }
@@ -307,6 +321,7 @@ Bool_t TTreeCacheUnzip::FillBuffer()
 
    //clear cache buffer
    TFileCacheRead::Prefetch(0,0);
+   fSeekEntry.clear();
 
    //store baskets
    for (Int_t i = 0; i < fNbranches; i++) {
@@ -338,6 +353,7 @@ Bool_t TTreeCacheUnzip::FillBuffer()
          fNReadPref++;
 
          TFileCacheRead::Prefetch(pos, len);
+         fSeekEntry.push_back(entries[j]);
       }
       if (gDebug > 0) printf("Entry: %lld, registering baskets branch %s, fEntryNext=%lld, fNseek=%d, fNtot=%d\n", entry, ((TBranch*)fBranches->UncheckedAt(i))->GetName(), fEntryNext, fNseek, fNtot);
    }
@@ -502,6 +518,7 @@ void TTreeCacheUnzip::ResetCache()
 {
    // Reset all the lists and wipe all the chunks
    fCycle++;
+   StopUnzip();
    fUnzipState.Clear(fNseekMax);
 
    if(fNseekMax < fNseek){
@@ -606,46 +623,50 @@ Int_t TTreeCacheUnzip::UnzipCache(Int_t index)
 
 #ifdef R__USE_IMT
 ////////////////////////////////////////////////////////////////////////////////
-/// We create a TTaskGroup and asynchronously maps each group of baskets(> 100 kB in total)
-/// to a task. In TTaskGroup, we use TThreadExecutor to do the actually work of unzipping
-/// a group of basket. The purpose of creating TTaskGroup is to avoid competing with main thread.
+/// We create a TTaskGroup which runs, through TThreadExecutor, a few tasks
+/// unzipping the baskets of the cache in the order in which the reader needs
+/// them (see NextUnzip()). There is one task per group of baskets of about
+/// fUnzipGroupSize bytes, at most one per thread of the pool; each task takes
+/// the next basket when it is done with the previous one, so that idle threads
+/// pick up the remaining work. The purpose of creating TTaskGroup is to avoid
+/// competing with main thread.
 
 Int_t TTreeCacheUnzip::CreateTasks()
 {
-   auto mapFunction = [&]() {
-      auto unzipFunction = [&](const std::vector<Int_t> &indices) {
-         // If cache is invalidated and we should return immediately.
-         if (!fIsTransferred) return nullptr;
-
-         for (auto ii : indices) {
-            if(fUnzipState.TryUnzipping(ii)) {
-               Int_t res = UnzipCache(ii);
-               if(res)
-                  if (gDebug > 0)
-                     Info("UnzipCache", "Unzipping failed or cache is in learning state");
-            }
+   // Order the baskets by first entry, then by position in the file
+   fUnzipOrder.resize(fNseek);
+   for (Int_t i = 0; i < fNseek; i++)
+      fUnzipOrder[i] = i;
+   if ((Int_t)fSeekEntry.size() == fNseek) {
+      std::stable_sort(fUnzipOrder.begin(), fUnzipOrder.end(), [this](Int_t i1, Int_t i2) {
+         if (fSeekEntry[i1] != fSeekEntry[i2])
+            return fSeekEntry[i1] < fSeekEntry[i2];
+         return fSeek[i1] < fSeek[i2];
+      });
+   }
+   fUnzipNext = 0;
+   fEmpty = kTRUE;
+
+   if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
+   Long64_t totsz = 0;
+   for (Int_t i = 0; i < fNseek; i++)
+      totsz += fSeekLen[i];
+   const Int_t ntasks = 1 + Int_t(totsz / fUnzipGroupSize);
+
+   auto mapFunction = [this, ntasks]() {
+      auto unzipFunction = [this](Int_t) {
+         Int_t index;
+         // If cache is invalidated we should return immediately.
+         while (fIsTransferred && (index = NextUnzip()) >= 0) {
+            Int_t res = UnzipCache(index);
+            if (res && gDebug > 0)
+               Info("UnzipCache", "Unzipping failed or cache is in learning state");
          }
-         return nullptr;
       };
 
-      Int_t accusz = 0;
-      std::vector<std::vector<Int_t>> basketIndices;
-      std::vector<Int_t> indices;
-      if (fUnzipGroupSize <= 0) fUnzipGroupSize = 102400;
-      for (Int_t i = 0; i < fNseek; i++) {
-         while (accusz < fUnzipGroupSize) {
-            accusz += fSeekLen[i];
-            indices.push_back(i);
-            i++;
-            if (i >= fNseek) break;
-         }
-         if (i < fNseek) i--;
-         basketIndices.push_back(indices);
-         indices.clear();
-         accusz = 0;
-      }
       ROOT::TThreadExecutor pool;
-      pool.Foreach(unzipFunction, basketIndices);
+      std::vector<Int_t> tasks(std::min<Int_t>(ntasks, pool.GetPoolSize()));
+      pool.Foreach(unzipFunction, tasks);
    };
 
    fUnzipTaskGroup = std::make_unique<ROOT::Experimental::TTaskGroup>();
@@ -655,6 +676,48 @@ Int_t TTreeCacheUnzip::CreateTasks()
 }
 #endif
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the next basket to unzip, in the order in which the
+/// reader needs them, after having marked it as in progress, or -1 if there
+/// is none left. Used by the unzipping tasks and by the reading thread while
+/// it waits for a basket.
+
+Int_t TTreeCacheUnzip::NextUnzip()
+{
+   const Int_t n = fUnzipOrder.size();
+   for (Int_t pos = fUnzipNext++; pos < n; pos = fUnzipNext++) {
+      if (fUnzipState.TryUnzipping(fUnzipOrder[pos]))
+         return fUnzipOrder[pos];
+   }
+   return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// The reader requested the basket index: skip, in the unzipping queue, the
+/// baskets starting before this one's first entry, as the reader is done with
+/// them (or will unzip them itself if it still needs them).
+
+void TTreeCacheUnzip::AdvanceUnzip(Int_t index)
+{
+   if ((Int_t)fSeekEntry.size() != fNseek || (Int_t)fUnzipOrder.size() != fNseek || index < 0 || index >= fNseek)
+      return;
+   const Long64_t entry = fSeekEntry[index];
+   auto first = std::lower_bound(fUnzipOrder.begin(), fUnzipOrder.end(), entry,
+                                 [this](Int_t i, Long64_t e) { return fSeekEntry[i] < e; });
+   const Int_t pos = first - fUnzipOrder.begin();
+   Int_t next = fUnzipNext;
+   while (next < pos && !fUnzipNext.compare_exchange_weak(next, pos)) {
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stop handing out baskets to unzip, the cache is about to be refilled.
+
+void TTreeCacheUnzip::StopUnzip()
+{
+   fUnzipNext = std::numeric_limits<Int_t>::max() / 2;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// We try to read a buffer that has already been unzipped
 /// Returns -1 in case of read failure, 0 in case it's not in the
@@ -697,6 +760,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
          // The buffer is, at minimum, in the file cache. We must know its index in the requests list
          // In order to get its info
          Int_t seekidx = fSeekIndex[loc];
+         AdvanceUnzip(seekidx);
 
          do {
 
@@ -718,24 +782,16 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
                return fUnzipState.fUnzipLen[seekidx];
             }
 
-            // If the requested basket is being unzipped by a background task, we try to steal a blk to unzip.
-            Int_t reqi = -1;
-
+            // If the requested basket is being unzipped by a background task, we help
+            // by unzipping the next basket of the queue.
             if (fUnzipState.IsProgress(seekidx)) {
                if (fEmpty) {
-                  for (Int_t ii = 0; ii < fNseek; ++ii) {
-                     Int_t idx = (seekidx + 1 + ii) % fNseek;
-                     if (fUnzipState.IsUntouched(idx)) {
-                        if(fUnzipState.TryUnzipping(idx)) {
-                           reqi = idx;
-                           break;
-                        }
-                     }
-                  }
+                  Int_t reqi = NextUnzip();
                   if (reqi < 0) {
                      fEmpty = kFALSE;
                   } else {
                      UnzipCache(reqi);
+                     fNHelped++;
                   }
                }
 
@@ -793,6 +849,7 @@ Int_t TTreeCacheUnzip::GetUnzipBuffer(char **buf, Long64_t pos, Int_t len, Bool_
       // Cache is invalidated and we need to wait for all unzipping tasks to be finished before fill new baskets in cache.
 #ifdef R__USE_IMT
       if(ROOT::IsImplicitMTEnabled() && fUnzipTaskGroup) {
+         StopUnzip();
          fUnzipTaskGroup->Cancel();
          fUnzipTaskGroup.reset();
       }
@@ -948,10 +1005,15 @@ void  TTreeCacheUnzip::Print(Option_t* option) const {
 
    printf("******TreeCacheUnzip statistics for file: %s ******\n",fFile->GetName());
    printf("Max allowed mem for pending buffers: %lld\n", fUnzipBufferSize);
-   printf("Number of blocks unzipped by threads: %d\n", fNUnzip);
+   printf("Number of blocks unzipped by threads: %d\n", fNUnzip.load());
+   printf("Number of blocks unzipped while waiting: %d\n", fNHelped);
    printf("Number of hits: %d\n", fNFound);
    printf("Number of stalls: %d\n", fNStalls);
    printf("Number of misses: %d\n", fNMissed);
+   const Int_t nreq = fNFound + fNStalls + fNMissed;
+   if (nreq > 0)
+      printf("Hit rate: %.1f%%, stall rate: %.1f%%, miss rate: %.1f%%\n", 100. * fNFound / nreq,
+             100. * fNStalls / nreq, 100. * fNMissed / nreq);
 
    TTreeCache::Print(option);
 }
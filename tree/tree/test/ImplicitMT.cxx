@@ -2,6 +2,7 @@
 #include "TROOT.h"
 #include "TSystem.h"
 #include "TTree.h"
+#include "TTreeCacheUnzip.h"
 
 #include "gtest/gtest.h"
 
@@ -28,4 +29,49 @@ TEST(TTreeImplicitMT, flushBaskets)
    gSystem->Unlink(ofileName);
 }
 
+TEST(TTreeImplicitMT, ParallelUnzip)
+{
+   ROOT::EnableImplicitMT();
+   const auto ofileName = "parallelUnzipMT.root";
+   {
+      TFile f(ofileName, "RECREATE");
+      TTree t("t", "t");
+      Long64_t x = 0;
+      Double_t y[8] = {};
+      t.Branch("x", &x);
+      t.Branch("y", y, "y[8]/D");
+      t.SetAutoFlush(10000);
+      for (x = 0; x < 100000; ++x) {
+         for (int i = 0; i < 8; ++i)
+            y[i] = x * i;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   const auto oldMode = TTreeCacheUnzip::GetParallelUnzip();
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+   {
+      TFile f(ofileName);
+      auto t = f.Get<TTree>("t");
+      t->SetParallelUnzip(kTRUE);
+      Long64_t x = -1;
+      Double_t y[8] = {};
+      t->SetBranchAddress("x", &x);
+      t->SetBranchAddress("y", y);
+      for (Long64_t entry = 0; entry < t->GetEntries(); ++entry) {
+         t->GetEntry(entry);
+         ASSERT_EQ(x, entry);
+         ASSERT_EQ(y[7], entry * 7.);
+      }
+      auto cache = dynamic_cast<TTreeCacheUnzip *>(t->GetReadCache(&f));
+      ASSERT_NE(cache, nullptr);
+      EXPECT_GT(cache->GetNFound() + cache->GetNStalls() + cache->GetNMissed(), 0);
+      t->ResetBranchAddresses();
+   }
+   TTreeCacheUnzip::SetParallelUnzip(oldMode);
+   ROOT::DisableImplicitMT();
+   gSystem->Unlink(ofileName);
+}
+
 #endif // R__USE_IMT
@@ -0,0 +1,124 @@
+#include "TBranch.h"
+#include "TMemFile.h"
+#include "TNamed.h"
+#include "TObjString.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+
+namespace {
+
+std::unique_ptr<TTree> MakeWideTree()
+{
+   auto t = std::make_unique<TTree>("wide", "wide tree");
+   t->SetDirectory(nullptr);
+   Double_t values[10] = {};
+   for (int b = 0; b < 10; ++b)
+      t->Branch(("b" + std::to_string(b)).c_str(), &values[b]);
+   for (int i = 0; i < 1000; ++i) {
+      for (int b = 0; b < 10; ++b)
+         values[b] = i * b;
+      t->Fill();
+   }
+   t->ResetBranchAddresses();
+   return t;
+}
+
+} // namespace
+
+TEST(TTreeReadPattern, RecordAndLoad)
+{
+   auto t = MakeWideTree();
+   EXPECT_EQ(t->GetReadPattern(), nullptr);
+
+   for (Long64_t i = 0; i < t->GetEntries(); ++i) {
+      t->GetBranch("b2")->GetEntry(i);
+      t->GetBranch("b7")->GetEntry(i);
+   }
+
+   TMemFile sidecar("readpattern_sidecar.root", "RECREATE");
+   EXPECT_EQ(t->RecordReadPattern(&sidecar), 2);
+   ASSERT_NE(t->GetReadPattern(), nullptr);
+   EXPECT_EQ(t->GetReadPattern()->GetSize(), 2);
+
+   auto other = MakeWideTree();
+   EXPECT_TRUE(other->LoadReadPattern(&sidecar));
+   const TList *pattern = other->GetReadPattern();
+   ASSERT_NE(pattern, nullptr);
+   EXPECT_EQ(pattern->GetSize(), 2);
+   EXPECT_NE(pattern->FindObject("b2"), nullptr);
+   EXPECT_NE(pattern->FindObject("b7"), nullptr);
+   EXPECT_EQ(pattern->FindObject("b3"), nullptr);
+
+   other->SetReadPattern(nullptr);
+   EXPECT_EQ(other->GetReadPattern(), nullptr);
+}
+
+TEST(TTreeReadPattern, OptimizeBaskets)
+{
+   auto t = MakeWideTree();
+   TList hot;
+   hot.SetOwner(kTRUE);
+   hot.Add(new TObjString("b1"));
+   hot.Add(new TObjString("b4"));
+   t->SetReadPattern(&hot);
+   t->OptimizeBaskets(100000, 1, "");
+
+   const Int_t hotSize = t->GetBranch("b1")->GetBasketSize();
+   const Int_t coldSize = t->GetBranch("b5")->GetBasketSize();
+   EXPECT_GT(hotSize, coldSize);
+   EXPECT_EQ(hotSize % 4096, 0);
+   EXPECT_EQ(t->GetBranch("b4")->GetBasketSize(), hotSize);
+
+   // Without the read pattern all the branches are treated alike
+   t->OptimizeBaskets(100000, 1, "n");
+   EXPECT_EQ(t->GetBranch("b1")->GetBasketSize(), t->GetBranch("b5")->GetBasketSize());
+}
+
+// The sub-branches of a split branch in the read pattern are hot too
+TEST(TTreeReadPattern, OptimizeBasketsSplit)
+{
+   TTree t("split", "split tree");
+   t.SetDirectory(nullptr);
+   TNamed *hotObj = new TNamed();
+   TNamed *coldObj = new TNamed();
+   t.Branch("hot.", &hotObj, 32000, 99);
+   t.Branch("cold.", &coldObj, 32000, 99);
+   for (int i = 0; i < 1000; ++i) {
+      hotObj->SetNameTitle(std::to_string(i).c_str(), std::string(i % 50, 't').c_str());
+      coldObj->SetNameTitle(hotObj->GetName(), hotObj->GetTitle());
+      t.Fill();
+   }
+   t.ResetBranchAddresses();
+   delete hotObj;
+   delete coldObj;
+
+   TList hot;
+   hot.SetOwner(kTRUE);
+   hot.Add(new TObjString("hot."));
+   t.SetReadPattern(&hot);
+   t.OptimizeBaskets(100000, 1, "");
+
+   for (const char *sub : {"fName", "fTitle"}) {
+      const Int_t hotSize = t.GetBranch((std::string("hot.") + sub).c_str())->GetBasketSize();
+      const Int_t coldSize = t.GetBranch((std::string("cold.") + sub).c_str())->GetBasketSize();
+      EXPECT_GT(hotSize, coldSize) << sub;
+      EXPECT_EQ(hotSize % 4096, 0) << sub;
+   }
+}
+
+TEST(TTreeReadPattern, KeptByCloneTree)
+{
+   auto t = MakeWideTree();
+   TList hot;
+   hot.SetOwner(kTRUE);
+   hot.Add(new TObjString("b3"));
+   t->SetReadPattern(&hot);
+
+   std::unique_ptr<TTree> clone(t->CloneTree(0));
+   ASSERT_NE(clone->GetReadPattern(), nullptr);
+   EXPECT_NE(clone->GetReadPattern()->FindObject("b3"), nullptr);
+}
@@ -0,0 +1,116 @@
+#include <memory>
+#include <set>
+
+#include "TEntryList.h"
+#include "TEntryListBlock.h"
+#include "TFile.h"
+#include "TSystem.h"
+
+#include "gtest/gtest.h"
+
+// Entries spread over several blocks, mixing ranges (stored as runs), sparse
+// entries (stored as lists) and dense entries (stored as bits).
+std::set<Long64_t> FillEntryList(TEntryList &elist, Long64_t offset)
+{
+   std::set<Long64_t> entries;
+   for (Long64_t i = 1000 + offset; i < 150000; ++i)
+      entries.insert(i);
+   for (Long64_t i = 150000 + offset; i < 200000; i += 37)
+      entries.insert(i);
+   for (Long64_t i = 200000 + offset; i < 260000; ++i)
+      if ((i * 7) % 3)
+         entries.insert(i);
+   for (auto entry : entries)
+      elist.Enter(entry);
+   elist.OptimizeStorage();
+   return entries;
+}
+
+void ExpectEntries(TEntryList &elist, const std::set<Long64_t> &expected)
+{
+   ASSERT_EQ(elist.GetN(), (Long64_t)expected.size());
+   Long64_t index = 0;
+   for (auto entry : expected) {
+      EXPECT_EQ(elist.GetEntry(index), entry);
+      ++index;
+   }
+   EXPECT_TRUE(elist.Contains(*expected.begin()));
+   EXPECT_FALSE(elist.Contains(*expected.begin() - 1));
+}
+
+TEST(TEntryList, AddSubtract)
+{
+   TEntryList elist1("elist1", "elist1");
+   TEntryList elist2("elist2", "elist2");
+   auto entries1 = FillEntryList(elist1, 0);
+   auto entries2 = FillEntryList(elist2, 500);
+   ExpectEntries(elist1, entries1);
+
+   TEntryList sum(elist1);
+   sum.Add(&elist2);
+   std::set<Long64_t> expectedSum(entries1);
+   expectedSum.insert(entries2.begin(), entries2.end());
+   ExpectEntries(sum, expectedSum);
+
+   TEntryList difference(elist1);
+   difference.Subtract(&elist2);
+   std::set<Long64_t> expectedDifference;
+   for (auto entry : entries1)
+      if (!entries2.count(entry))
+         expectedDifference.insert(entry);
+   ExpectEntries(difference, expectedDifference);
+}
+
+TEST(TEntryList, RunsIO)
+{
+   const auto filename = "entrylist_setops.root";
+   TEntryList elist("elist", "elist");
+   auto entries = FillEntryList(elist, 0);
+   {
+      TFile f(filename, "RECREATE");
+      elist.Write();
+   }
+   TFile f(filename);
+   std::unique_ptr<TEntryList> read{f.Get<TEntryList>("elist")};
+   ASSERT_TRUE(read != nullptr);
+   ExpectEntries(*read, entries);
+   f.Close();
+   gSystem->Unlink(filename);
+}
+
+// The blocks stored as runs are written as bits or lists, readable by older
+// versions, unless the runs are requested with TEntryListBlock::SetWriteRuns
+TEST(TEntryList, RunsWrittenOnRequest)
+{
+   const auto filename = "entrylist_runs.root";
+   TEntryListBlock block;
+   for (Int_t i = 100; i < 20000; ++i)
+      block.Enter(i);
+   block.OptimizeStorage();
+   ASSERT_EQ(block.GetType(), 2);
+   {
+      TFile f(filename, "RECREATE");
+      f.WriteObject(&block, "bitsOrList");
+      TEntryListBlock::SetWriteRuns(kTRUE);
+      f.WriteObject(&block, "runs");
+      TEntryListBlock::SetWriteRuns(kFALSE);
+   }
+   EXPECT_EQ(block.GetType(), 2);
+
+   TFile f(filename);
+   std::unique_ptr<TEntryListBlock> bitsOrList{f.Get<TEntryListBlock>("bitsOrList")};
+   std::unique_ptr<TEntryListBlock> runs{f.Get<TEntryListBlock>("runs")};
+   ASSERT_TRUE(bitsOrList != nullptr);
+   ASSERT_TRUE(runs != nullptr);
+   EXPECT_NE(bitsOrList->GetType(), 2);
+   EXPECT_EQ(runs->GetType(), 2);
+   for (auto read : {bitsOrList.get(), runs.get()}) {
+      EXPECT_EQ(read->GetNPassed(), 19900);
+      EXPECT_FALSE(read->Contains(99));
+      EXPECT_TRUE(read->Contains(100));
+      EXPECT_TRUE(read->Contains(19999));
+      EXPECT_FALSE(read->Contains(20000));
+   }
+   f.Close();
+   gSystem->Unlink(filename);
+}
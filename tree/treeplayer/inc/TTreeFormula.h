@@ -59,6 +59,10 @@ class TTreeFormula : public ROOT::v5::TFormula {
 
 friend class TTreeFormulaManager;
 
+public:
+   /// Signature of the compiled evaluation function, see Jit()
+   using JitFunc_t = Double_t (*)(TTreeFormula *form, Int_t instance, Bool_t willLoad, Bool_t &didBooleanOptimization);
+
 protected:
    enum EStatusBits {
       kIsCharacter = BIT(12),
@@ -131,6 +135,10 @@ protected:
 
    RealInstanceCache fRealInstanceCache;              ///<! Cache accelerating the GetRealInstance function
 
+   void                *fJitFunction = nullptr;       ///<! Compiled evaluation function, see Jit()
+   Bool_t               fJitRequested = kFALSE;       ///<! Jit() was called, to compile again for a new tree
+   const void          *fJitLeafValues[kMAXCODES] = {}; ///<! Addresses of the values of the leaves read directly by the compiled function
+
    TTreeFormula(const char *name, const char *formula, TTree *tree, const std::vector<std::string>& aliases);
    void Init(const char *name, const char *formula);
    Bool_t      BranchHasMethod(TLeaf* leaf, TBranch* branch, const char* method,const char* params, Long64_t readentry) const;
@@ -148,6 +156,8 @@ protected:
    virtual Double_t  GetValueFromMethod(Int_t i, TLeaf *leaf) const;
    virtual void*     GetValuePointerFromMethod(Int_t i, TLeaf *leaf) const;
    Int_t             GetRealInstance(Int_t instance, Int_t codeindex);
+   template<typename T> Bool_t EvalVariable(Int_t i, Int_t instance, Bool_t willLoad, T &value);
+   Bool_t            GenerateJitCode(const std::string &funcname, std::string &code) const;
 
    void              LoadBranches();
    Bool_t            LoadCurrentDim();
@@ -209,6 +219,17 @@ public:
    virtual void        ResetLoading();
    virtual TTree*      GetTree() const {return fTree;}
    virtual void        UpdateFormulaLeaves();
+   Int_t               Compile(const char *expression="") override;
+   virtual Bool_t      Jit();
+           Bool_t      IsJitted() const { return fJitFunction != nullptr; }
+
+   // Used by the code generated by Jit(), not meant to be called directly.
+   const void *const  *JitLeafValues() const { return fJitLeafValues; }
+   Bool_t              JitLoadLeaf(Int_t code, Bool_t willLoad);
+   Bool_t              JitEvalVariable(Int_t i, Int_t instance, Bool_t willLoad, Double_t &value);
+   Double_t            JitEvalAlias(Int_t i, Int_t instance);
+   Bool_t              JitEvalAlternate(Int_t i, Int_t instance, Double_t &value);
+   Double_t            JitEvalMinMaxIf(Int_t i, Bool_t isMax);
 
    ClassDefOverride(TTreeFormula, 10);  //The Tree formula
 };
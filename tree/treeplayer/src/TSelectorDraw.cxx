@@ -991,6 +991,7 @@ Bool_t TSelectorDraw::CompileVariables(const char *varexp, const char *selection
          fSelect = nullptr;
          return kFALSE;
       }
+      if (gEnv->GetValue("TTreeFormula.Jit", 0)) fSelect->Jit();
    }
 
    // if varexp is empty, take first column by default
@@ -1026,6 +1027,7 @@ Bool_t TSelectorDraw::CompileVariables(const char *varexp, const char *selection
       fVar[i]->SetQuickLoad(kTRUE);
       if(!fVar[i]->GetNdim()) { ClearFormula(); return kFALSE; }
       fManager->Add(fVar[i]);
+      if (gEnv->GetValue("TTreeFormula.Jit", 0)) fVar[i]->Jit();
    }
    fManager->Sync();
 
@@ -51,6 +51,8 @@
 #include <cstdlib>
 #include <typeinfo>
 #include <algorithm>
+#include <type_traits>
+#include <unordered_map>
 
 const Int_t kMaxLen     = 1024;
 
@@ -3935,6 +3937,70 @@ template<> inline LongDouble_t TTreeFormula::GetConstant(Int_t k) {
 }
 template<> inline Long64_t TTreeFormula::GetConstant(Int_t k) { return (Long64_t)GetConstant<LongDouble_t>(k); }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the tree variable of operation i (a kDefinedVariable operation).
+/// Returns kFALSE if the evaluation of the whole formula must stop and return 0,
+/// i.e. when the instance is out of range for this variable.
+
+template<typename T>
+Bool_t TTreeFormula::EvalVariable(Int_t i, Int_t instance, Bool_t willLoad, T &value)
+{
+   const Int_t code = (GetOper()[i] & kTFOperMask);
+   const Int_t lookupType = fLookupType[code];
+   switch (lookupType) {
+      case kIndexOfEntry: value = (T)fTree->GetReadEntry(); return kTRUE;
+      case kIndexOfLocalEntry: value = (T)fTree->GetTree()->GetReadEntry(); return kTRUE;
+      case kEntries:      value = (T)fTree->GetEntries(); return kTRUE;
+      case kLocalEntries: value = (T)fTree->GetTree()->GetEntries(); return kTRUE;
+      case kLength:       value = fManager->fNdata; return kTRUE;
+      case kLengthFunc:   value = ((TTreeFormula*)fAliases.UncheckedAt(i))->GetNdata(); return kTRUE;
+      case kIteration:    value = instance; return kTRUE;
+      case kSum:          value = Summing<T>((TTreeFormula*)fAliases.UncheckedAt(i)); return kTRUE;
+      case kMin:          value = FindMin<T>((TTreeFormula*)fAliases.UncheckedAt(i)); return kTRUE;
+      case kMax:          value = FindMax<T>((TTreeFormula*)fAliases.UncheckedAt(i)); return kTRUE;
+
+      case kDirect:     { TT_EVAL_INIT_LOOP; value = leaf->GetTypedValue<T>(real_instance); return kTRUE; }
+      case kMethod:     { TT_EVAL_INIT_LOOP; value = GetValueFromMethod(code,leaf); return kTRUE; }
+      case kDataMember: { TT_EVAL_INIT_LOOP; value = ((TFormLeafInfo*)fDataMembers.UncheckedAt(code))->
+                                 GetTypedValue<T>(leaf,real_instance); return kTRUE; }
+      case kTreeMember: { TREE_EVAL_INIT_LOOP; value = ((TFormLeafInfo*)fDataMembers.UncheckedAt(code))->
+                                 GetTypedValue<T>((TLeaf*)nullptr,real_instance); return kTRUE; }
+      case kEntryList: { TEntryList *elist = (TEntryList*)fExternalCuts.At(code);
+         value = elist->Contains(fTree->GetReadEntry());
+         return kTRUE;}
+      case -1: break;
+      default: value = 0; return kTRUE;
+   }
+   switch (fCodes[code]) {
+      case -2: {
+         TCutG *gcut = (TCutG*)fExternalCuts.At(code);
+         TTreeFormula *fx = (TTreeFormula *)gcut->GetObjectX();
+         TTreeFormula *fy = (TTreeFormula *)gcut->GetObjectY();
+         if (fDidBooleanOptimization) {
+            fx->ResetLoading();
+            fy->ResetLoading();
+         }
+         T xcut = fx->EvalInstance<T>(instance);
+         T ycut = fy->EvalInstance<T>(instance);
+         value = gcut->IsInside(xcut,ycut);
+         return kTRUE;
+      }
+      case -1: {
+         TCutG *gcut = (TCutG*)fExternalCuts.At(code);
+         TTreeFormula *fx = (TTreeFormula *)gcut->GetObjectX();
+         if (fDidBooleanOptimization) {
+            fx->ResetLoading();
+         }
+         value = fx->EvalInstance<T>(instance);
+         return kTRUE;
+      }
+      default: {
+         value = 0;
+         return kTRUE;
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Evaluate this treeformula.
 
@@ -4006,6 +4072,14 @@ T TTreeFormula::EvalInstance(Int_t instance, const char *stringStackArg[])
       }
    }
 
+   if constexpr (std::is_same<T, Double_t>::value) {
+      if (fJitFunction) {
+         const Bool_t willLoad = (instance==0 || fNeedLoading); fNeedLoading = kFALSE;
+         if (willLoad) fDidBooleanOptimization = kFALSE;
+         return ((JitFunc_t)fJitFunction)(this, instance, willLoad, fDidBooleanOptimization);
+      }
+   }
+
    T tab[kMAXFOUND];
    const Int_t kMAXSTRINGFOUND = 10;
    const char *stringStackLocal[kMAXSTRINGFOUND];
@@ -4222,61 +4296,9 @@ T TTreeFormula::EvalInstance(Int_t instance, const char *stringStackArg[])
          // a tree variable (the most used case).
 
          if (newaction == kDefinedVariable) {
-
-            const Int_t code = (oper & kTFOperMask);
-            const Int_t lookupType = fLookupType[code];
-            switch (lookupType) {
-               case kIndexOfEntry: tab[pos++] = (T)fTree->GetReadEntry(); continue;
-               case kIndexOfLocalEntry: tab[pos++] = (T)fTree->GetTree()->GetReadEntry(); continue;
-               case kEntries:      tab[pos++] = (T)fTree->GetEntries(); continue;
-               case kLocalEntries: tab[pos++] = (T)fTree->GetTree()->GetEntries(); continue;
-               case kLength:       tab[pos++] = fManager->fNdata; continue;
-               case kLengthFunc:   tab[pos++] = ((TTreeFormula*)fAliases.UncheckedAt(i))->GetNdata(); continue;
-               case kIteration:    tab[pos++] = instance; continue;
-               case kSum:          tab[pos++] = Summing<T>((TTreeFormula*)fAliases.UncheckedAt(i)); continue;
-               case kMin:          tab[pos++] = FindMin<T>((TTreeFormula*)fAliases.UncheckedAt(i)); continue;
-               case kMax:          tab[pos++] = FindMax<T>((TTreeFormula*)fAliases.UncheckedAt(i)); continue;
-
-               case kDirect:     { TT_EVAL_INIT_LOOP; tab[pos++] = leaf->GetTypedValue<T>(real_instance); continue; }
-               case kMethod:     { TT_EVAL_INIT_LOOP; tab[pos++] = GetValueFromMethod(code,leaf); continue; }
-               case kDataMember: { TT_EVAL_INIT_LOOP; tab[pos++] = ((TFormLeafInfo*)fDataMembers.UncheckedAt(code))->
-                                          GetTypedValue<T>(leaf,real_instance); continue; }
-               case kTreeMember: { TREE_EVAL_INIT_LOOP; tab[pos++] = ((TFormLeafInfo*)fDataMembers.UncheckedAt(code))->
-                                          GetTypedValue<T>((TLeaf*)nullptr,real_instance); continue; }
-               case kEntryList: { TEntryList *elist = (TEntryList*)fExternalCuts.At(code);
-                  tab[pos++] = elist->Contains(fTree->GetReadEntry());
-                  continue;}
-               case -1: break;
-               default: tab[pos++] = 0; continue;
-            }
-            switch (fCodes[code]) {
-               case -2: {
-                  TCutG *gcut = (TCutG*)fExternalCuts.At(code);
-                  TTreeFormula *fx = (TTreeFormula *)gcut->GetObjectX();
-                  TTreeFormula *fy = (TTreeFormula *)gcut->GetObjectY();
-                  if (fDidBooleanOptimization) {
-                     fx->ResetLoading();
-                     fy->ResetLoading();
-                  }
-                  T xcut = fx->EvalInstance<T>(instance);
-                  T ycut = fy->EvalInstance<T>(instance);
-                  tab[pos++] = gcut->IsInside(xcut,ycut);
-                  continue;
-               }
-               case -1: {
-                  TCutG *gcut = (TCutG*)fExternalCuts.At(code);
-                  TTreeFormula *fx = (TTreeFormula *)gcut->GetObjectX();
-                  if (fDidBooleanOptimization) {
-                     fx->ResetLoading();
-                  }
-                  tab[pos++] = fx->EvalInstance<T>(instance);
-                  continue;
-               }
-               default: {
-                  tab[pos++] = 0;
-                  continue;
-               }
-            }
+            if (!EvalVariable<T>(i, instance, willLoad, tab[pos])) return 0;
+            pos++;
+            continue;
          }
          switch(newaction) {
 
@@ -4412,6 +4434,372 @@ template double TTreeFormula::EvalInstance<double> (int, char const**);
 template long double TTreeFormula::EvalInstance<long double> (int, char const**);
 template long long TTreeFormula::EvalInstance<long long> (int, char const**);
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the tree variable of operation i for the compiled evaluation.
+/// Returns kFALSE if the evaluation must stop and return 0.
+
+Bool_t TTreeFormula::JitEvalVariable(Int_t i, Int_t instance, Bool_t willLoad, Double_t &value)
+{
+   return EvalVariable<Double_t>(i, instance, willLoad, value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Load the branch of the leaf of code, holding a single value, like the
+/// evaluation of a tree variable does, and store the address of its value,
+/// read directly by the compiled evaluation. Returns kFALSE if the evaluation
+/// must stop and return 0.
+
+Bool_t TTreeFormula::JitLoadLeaf(Int_t code, Bool_t willLoad)
+{
+   const Int_t instance = 0; // the leaf holds a single value
+   TT_EVAL_INIT_LOOP;
+   fJitLeafValues[code] = leaf->GetValuePointer();
+   return fJitLeafValues[code] != nullptr;
+}
+
+namespace {
+////////////////////////////////////////////////////////////////////////////////
+/// Return the type of the value of a leaf holding a single number, which the
+/// compiled evaluation reads directly from the address of the value, or nullptr
+/// if the leaf must be read through TLeaf::GetValue.
+
+const char *GetJitLeafType(const TLeaf *leaf)
+{
+   if (!leaf || leaf->GetLeafCount() || leaf->GetLenStatic() != 1)
+      return nullptr;
+   const Bool_t isUnsigned = leaf->IsUnsigned();
+   const char *cl = leaf->ClassName();
+   if (!strcmp(cl, "TLeafD") || !strcmp(cl, "TLeafD32")) return "Double_t";
+   if (!strcmp(cl, "TLeafF") || !strcmp(cl, "TLeafF16")) return "Float_t";
+   if (!strcmp(cl, "TLeafI")) return isUnsigned ? "UInt_t" : "Int_t";
+   if (!strcmp(cl, "TLeafL")) return isUnsigned ? "ULong64_t" : "Long64_t";
+   if (!strcmp(cl, "TLeafS")) return isUnsigned ? "UShort_t" : "Short_t";
+   if (!strcmp(cl, "TLeafB")) return isUnsigned ? "UChar_t" : "Char_t";
+   if (!strcmp(cl, "TLeafO")) return "Bool_t";
+   return nullptr;
+}
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the alias of operation i for the compiled evaluation.
+
+Double_t TTreeFormula::JitEvalAlias(Int_t i, Int_t instance)
+{
+   TTreeFormula *subform = static_cast<TTreeFormula*>(fAliases.UncheckedAt(i));
+   R__ASSERT(subform);
+   subform->fDidBooleanOptimization = fDidBooleanOptimization;
+   return subform->EvalInstance<Double_t>(instance);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the primary formula of the alternate (Alt$) of operation i for the
+/// compiled evaluation. Returns kFALSE if the instance is out of range for the
+/// primary formula, in which case the alternate value must be used.
+
+Bool_t TTreeFormula::JitEvalAlternate(Int_t i, Int_t instance, Double_t &value)
+{
+   TTreeFormula *primary = static_cast<TTreeFormula*>(fAliases.UncheckedAt(i));
+   if (instance >= primary->GetNdata()) return kFALSE;
+   value = primary->EvalInstance<Double_t>(instance);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the MinIf$ or MaxIf$ of operation i for the compiled evaluation.
+
+Double_t TTreeFormula::JitEvalMinMaxIf(Int_t i, Bool_t isMax)
+{
+   TTreeFormula *primary = static_cast<TTreeFormula*>(fAliases.UncheckedAt(i));
+   TTreeFormula *condition = static_cast<TTreeFormula*>(fAliases.UncheckedAt(i+1));
+   return isMax ? FindMax<Double_t>(primary,condition) : FindMin<Double_t>(primary,condition);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the C++ code of the function funcname evaluating this formula
+/// like EvalInstance<Double_t>(), with the signature of JitFunc_t.
+/// The operations of the formula are translated one by one, using an array
+/// as the stack whose positions are known at compile time, and labels for
+/// the targets of the jumps (conditional operator and boolean optimization).
+/// The leaves holding a single number of a basic type are read directly from
+/// the address of their value, refreshed by JitLoadLeaf() when the branch is
+/// loaded. The other tree variables, aliases and Alt$/MinIf$/MaxIf$ are still
+/// evaluated by this object, through the JitEval functions.
+/// Returns kFALSE if the formula contains operations that are not supported
+/// (strings, function calls).
+
+Bool_t TTreeFormula::GenerateJitCode(const std::string &funcname, std::string &code) const
+{
+   // Stack position at the start of the operations that are targets of jumps
+   std::vector<Int_t> posAt(fNoper+1, -1);
+   std::vector<Bool_t> isTarget(fNoper+1, kFALSE);
+   for (Int_t i=0; i<fNoper; ++i) {
+      const Int_t action = GetAction(i);
+      const Int_t param = GetActionParam(i);
+      Int_t target = -1;
+      if (action == kJumpIf || action == kJump) target = param+1;
+      else if (action == kBoolOptimize) target = i+param/10+1;
+      else if (action == kAlternate) target = i+2;
+      if (target >= 0) {
+         if (target > fNoper) return kFALSE;
+         isTarget[target] = kTRUE;
+      }
+   }
+
+   std::string body;
+   Int_t pos = 0;
+   Int_t maxpos = 1;
+   auto v = [](Int_t k) { return "v[" + std::to_string(k) + "]"; };
+   auto label = [](Int_t k) { return "op" + std::to_string(k); };
+   auto binary = [&](const char *op) { pos--; body += "   " + v(pos-1) + " " + op + " " + v(pos) + ";\n"; };
+   auto assign = [&](const std::string &expr) { body += "   " + v(pos-1) + " = " + expr + ";\n"; };
+   auto compare = [&](const char *op) {
+      pos--;
+      assign("(" + v(pos-1) + " " + op + " " + v(pos) + ") ? 1 : 0");
+   };
+   auto bitwise = [&](const char *op) {
+      pos--;
+      assign("(Double_t)(((ULong64_t)" + v(pos-1) + ") " + op + " ((ULong64_t)" + v(pos) + "))");
+   };
+   auto jumpTo = [&](Int_t target, Int_t posTarget) {
+      if (posAt[target] >= 0 && posAt[target] != posTarget) return kFALSE;
+      posAt[target] = posTarget;
+      return kTRUE;
+   };
+
+   for (Int_t i=0; i<fNoper; ++i) {
+      if (isTarget[i]) {
+         if (pos < 0) pos = posAt[i];
+         if (pos < 0 || (posAt[i] >= 0 && posAt[i] != pos)) return kFALSE;
+         body += label(i) + ":\n";
+      }
+      if (pos < 0) return kFALSE; // unreachable code, should not happen
+      if (pos >= kMAXFOUND-1) return kFALSE;
+
+      const Int_t action = GetAction(i);
+      const Int_t param = GetActionParam(i);
+      const std::string x = pos > 0 ? v(pos-1) : "";
+      switch (action) {
+         case kEnd       : body += "   return v[0];\n"; pos = -1; break;
+         case kConstant  : {
+            if (!std::isfinite(fConst[param])) return kFALSE;
+            pos++;
+            assign(TString::Format("%.17g", fConst[param]).Data());
+            break;
+         }
+         case kAdd       : binary("+="); break;
+         case kSubstract : binary("-="); break;
+         case kMultiply  : binary("*="); break;
+         case kDivide    : pos--; assign("(" + v(pos) + " == 0) ? 0 : " + v(pos-1) + " / " + v(pos)); break;
+         case kModulo    : pos--; assign("(Double_t)((Long64_t)" + v(pos-1) + " % (Long64_t)" + v(pos) + ")"); break;
+
+         case kcos  : assign("TMath::Cos(" + x + ")"); break;
+         case ksin  : assign("TMath::Sin(" + x + ")"); break;
+         case ktan  : assign("(TMath::Cos(" + x + ") == 0) ? 0 : TMath::Tan(" + x + ")"); break;
+         case kacos : assign("(TMath::Abs(" + x + ") > 1) ? 0 : TMath::ACos(" + x + ")"); break;
+         case kasin : assign("(TMath::Abs(" + x + ") > 1) ? 0 : TMath::ASin(" + x + ")"); break;
+         case katan : assign("TMath::ATan(" + x + ")"); break;
+         case kcosh : assign("TMath::CosH(" + x + ")"); break;
+         case ksinh : assign("TMath::SinH(" + x + ")"); break;
+         case ktanh : assign("(TMath::CosH(" + x + ") == 0) ? 0 : TMath::TanH(" + x + ")"); break;
+         case kacosh: assign("(" + x + " < 1) ? 0 : TMath::ACosH(" + x + ")"); break;
+         case kasinh: assign("TMath::ASinH(" + x + ")"); break;
+         case katanh: assign("(TMath::Abs(" + x + ") > 1) ? 0 : TMath::ATanH(" + x + ")"); break;
+         case katan2: pos--; assign("TMath::ATan2(" + v(pos-1) + ", " + v(pos) + ")"); break;
+         case kfmod : pos--; assign("fmod(" + v(pos-1) + ", " + v(pos) + ")"); break;
+         case kpow  : pos--; assign("TMath::Power(" + v(pos-1) + ", " + v(pos) + ")"); break;
+         case ksq   : assign(x + " * " + x); break;
+         case ksqrt : assign("TMath::Sqrt(TMath::Abs(" + x + "))"); break;
+         case kmin  : pos--; assign("std::min(" + v(pos-1) + ", " + v(pos) + ")"); break;
+         case kmax  : pos--; assign("std::max(" + v(pos-1) + ", " + v(pos) + ")"); break;
+         case klog  : assign("(" + x + " > 0) ? TMath::Log(" + x + ") : 0"); break;
+         case kexp  : assign("(" + x + " < -700) ? 0 : TMath::Exp(std::min(" + x + ", 700.))"); break;
+         case klog10: assign("(" + x + " > 0) ? TMath::Log10(" + x + ") : 0"); break;
+         case kpi   : pos++; assign("TMath::Pi()"); break;
+         case kabs  : assign("TMath::Abs(" + x + ")"); break;
+         case ksign : assign("(" + x + " < 0) ? -1 : 1"); break;
+         case kint  : assign("(Double_t)(Long64_t)" + x); break;
+         case kSignInv: assign("-1 * " + x); break;
+         case krndm : pos++; assign("gRandom->Rndm()"); break;
+
+         case kAnd        : compare("!= 0 &&"); break;
+         case kOr         : compare("!= 0 ||"); break;
+         case kEqual      : compare("=="); break;
+         case kNotEqual   : compare("!="); break;
+         case kLess       : compare("<"); break;
+         case kGreater    : compare(">"); break;
+         case kLessThan   : compare("<="); break;
+         case kGreaterThan: compare(">="); break;
+         case kNot        : assign("(" + x + " != 0) ? 0 : 1"); break;
+
+         case kBitAnd    : bitwise("&"); break;
+         case kBitOr     : bitwise("|"); break;
+         case kLeftShift : bitwise("<<"); break;
+         case kRightShift: bitwise(">>"); break;
+
+         case kJump   : {
+            if (!jumpTo(param+1, pos)) return kFALSE;
+            body += "   goto " + label(param+1) + ";\n";
+            pos = -1;
+            break;
+         }
+         case kJumpIf : {
+            pos--;
+            if (!jumpTo(param+1, pos)) return kFALSE;
+            body += "   if (!" + v(pos) + ") { if (willLoad) didBooleanOptimization = kTRUE; goto " +
+                    label(param+1) + "; }\n";
+            break;
+         }
+         case kBoolOptimize: {
+            const Int_t op = param % 10; // 1 is && , 2 is ||
+            const Int_t target = i + param/10 + 1;
+            if (op != 1 && op != 2) break;
+            if (!jumpTo(target, pos)) return kFALSE;
+            body += "   if (" + std::string(op == 1 ? "!" : "") + x + ") { " + x + " = " + (op == 1 ? "0" : "1") +
+                    "; if (willLoad) didBooleanOptimization = kTRUE; goto " + label(target) + "; }\n";
+            break;
+         }
+
+         case kDefinedVariable: {
+            const Int_t code = param;
+            const char *leafType = (fLookupType[code] == kDirect && fNdimensions[code] == 0)
+                                      ? GetJitLeafType((TLeaf *)fLeaves.UncheckedAt(code))
+                                      : nullptr;
+            if (leafType) {
+               const std::string value = "leafValues[" + std::to_string(code) + "]";
+               body += "   if ((willLoad || didBooleanOptimization || !" + value + ") && !form->JitLoadLeaf(" +
+                       std::to_string(code) + ", willLoad)) return 0;\n";
+               body += "   " + v(pos) + " = *(const " + leafType + " *)" + value + ";\n";
+            } else {
+               body += "   if (!form->JitEvalVariable(" + std::to_string(i) + ", instance, willLoad, " + v(pos) +
+                       ")) return 0;\n";
+            }
+            pos++;
+            break;
+         }
+         case kAlias: {
+            body += "   " + v(pos) + " = form->JitEvalAlias(" + std::to_string(i) + ", instance);\n";
+            pos++;
+            break;
+         }
+         case kAlternate: {
+            if (!jumpTo(i+2, pos+1)) return kFALSE;
+            body += "   if (form->JitEvalAlternate(" + std::to_string(i) + ", instance, " + v(pos) + ")) goto " +
+                    label(i+2) + ";\n";
+            break;
+         }
+         case kMinIf:
+         case kMaxIf: {
+            body += "   " + v(pos) + " = form->JitEvalMinMaxIf(" + std::to_string(i) + ", " +
+                    (action == kMaxIf ? "kTRUE" : "kFALSE") + ");\n";
+            pos++;
+            ++i; // skip the place holder for the condition
+            break;
+         }
+
+         default:
+            // strings, function calls, ...
+            return kFALSE;
+      }
+      maxpos = std::max(maxpos, pos);
+   }
+   if (isTarget[fNoper]) {
+      if (pos < 0) pos = posAt[fNoper];
+      body += label(fNoper) + ":\n";
+   }
+   body += "   return v[0];\n";
+
+   code = "Double_t " + funcname + "(TTreeFormula *form, Int_t instance, Bool_t willLoad, Bool_t &didBooleanOptimization)\n"
+          "{\n"
+          "   (void)form; (void)instance; (void)willLoad; (void)didBooleanOptimization;\n"
+          "   const void *const *leafValues = form->JitLeafValues(); (void)leafValues;\n"
+          "   Double_t v[" + std::to_string(maxpos) + "];\n" +
+          body +
+          "}\n";
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Parse the expression and build the list of operations, discarding the
+/// compiled evaluation of the previous operations, see Jit().
+
+Int_t TTreeFormula::Compile(const char *expression)
+{
+   fJitFunction = nullptr;
+   fJitRequested = kFALSE;
+   std::fill(std::begin(fJitLeafValues), std::end(fJitLeafValues), nullptr);
+   return ROOT::v5::TFormula::Compile(expression);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compile the evaluation of this formula with the interpreter.
+///
+/// The operations of the formula are translated to a C++ function which is
+/// then just-in-time compiled, removing the dispatch over the operations done
+/// for every entry by EvalInstance(). The leaves holding a single number are
+/// read directly, the other tree variables as in the interpreted evaluation,
+/// so the result is identical. Formulas using strings or calling functions
+/// are not compiled and keep being interpreted, as are EvalInstance64() and
+/// EvalInstanceLD().
+///
+/// The compiled functions are shared between formulas with the same operations.
+/// As the code declared to the interpreter cannot be unloaded, at most 1000
+/// different functions are compiled in a process; beyond this the new
+/// formulas are interpreted. Each compilation costs an
+/// interpreter Declare(), so TTree::Draw and TTree::Scan compile their
+/// formulas only if the resource `TTreeFormula.Jit` is set to 1.
+/// The function is discarded when the formula is compiled again, and rebuilt
+/// when the leaves are updated for a new tree of a chain.
+///
+/// Returns kTRUE if the formula is compiled.
+
+Bool_t TTreeFormula::Jit()
+{
+   if (fJitFunction) return kTRUE;
+   fJitRequested = kTRUE;
+   // Single operations are already evaluated without dispatch
+   if (TestBit(kMissingLeaf) || fAxis || fNoper <= 1) return kFALSE;
+
+   static std::unordered_map<std::string, void *> gJitFunctions;
+   static const std::size_t kMaxJitFunctions = 1000;
+
+   std::string code;
+   if (!GenerateJitCode("TTreeFormula_jit", code)) return kFALSE;
+
+   R__LOCKGUARD(gROOTMutex);
+   auto funcit = gJitFunctions.find(code);
+   if (funcit != gJitFunctions.end()) {
+      fJitFunction = funcit->second;
+      return fJitFunction != nullptr;
+   }
+   if (gJitFunctions.size() >= kMaxJitFunctions) {
+      if (gDebug > 0) Info("Jit", "Too many compiled formulas, using the interpreter for %s", GetTitle());
+      return kFALSE;
+   }
+
+   const std::string funcname = "TTreeFormula_jit" + std::to_string(gJitFunctions.size());
+   std::string declaration;
+   GenerateJitCode(funcname, declaration);
+   declaration = "#include \"TTreeFormula.h\"\n"
+                 "#include \"TMath.h\"\n"
+                 "#include \"TRandom.h\"\n"
+                 "#include <algorithm>\n"
+                 "#include <cmath>\n"
+                 "namespace ROOT { namespace Internal { namespace TTreeFormulaJit {\n" +
+                 declaration +
+                 "}}}\n";
+   void *func = nullptr;
+   if (gInterpreter->Declare(declaration.c_str())) {
+      TInterpreter::EErrorCode error = TInterpreter::kNoError;
+      const std::string address = "(Longptr_t)&ROOT::Internal::TTreeFormulaJit::" + funcname + ";";
+      func = (void *)gInterpreter->Calc(address.c_str(), &error);
+      if (error != TInterpreter::kNoError) func = nullptr;
+   }
+   if (!func && gDebug > 0) Warning("Jit", "Could not compile the formula %s, using the interpreter", GetTitle());
+   gJitFunctions.insert(std::make_pair(code, func));
+   fJitFunction = func;
+   return fJitFunction != nullptr;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return DataMember corresponding to code.
 ///
@@ -5144,6 +5532,10 @@ void TTreeFormula::UpdateFormulaLeaves()
             break;
       }
    }
+   // The leaves of the new tree may have other types or be missing: compile again
+   std::fill(std::begin(fJitLeafValues), std::end(fJitLeafValues), nullptr);
+   fJitFunction = nullptr;
+   if (fJitRequested) Jit();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -5632,6 +6024,8 @@ void TTreeFormula::Convert(UInt_t oldversion)
 {
    // Convert the fOper of a TTTreeFormula version fromVersion to the current in memory version
 
+   fJitFunction = nullptr;
+
    enum { kOldAlias           = /*ROOT::v5::TFormula::kVariable*/ 100000+10000+1,
           kOldAliasString     = kOldAlias+1,
           kOldAlternate       = kOldAlias+2,
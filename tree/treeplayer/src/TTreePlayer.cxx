@@ -2622,6 +2622,10 @@ Long64_t TTreePlayer::Scan(const char *varexp, const char *selection,
       var[ui] = new TTreeFormula("Var1",cnames[ui].Data(),fTree);
       fFormulaList->Add(var[ui]);
    }
+   if (gEnv->GetValue("TTreeFormula.Jit", 0)) {
+      if (select) select->Jit();
+      for (ui=0;ui<ncols;ui++) var[ui]->Jit();
+   }
 
 //*-*- Create a TreeFormulaManager to coordinate the formulas
    TTreeFormulaManager *manager=nullptr;
@@ -0,0 +1,130 @@
+#include "TChain.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeFormula.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+static std::unique_ptr<TTree> MakeJitTree()
+{
+   auto tree = std::make_unique<TTree>("T", "jit test tree");
+   Int_t n = 0;
+   Double_t x = 0;
+   Float_t arr[4] = {};
+   UShort_t u = 0;
+   Bool_t b = false;
+   tree->Branch("n", &n);
+   tree->Branch("x", &x);
+   tree->Branch("arr", arr, "arr[4]/F");
+   tree->Branch("u", &u, "u/s");
+   tree->Branch("b", &b, "b/O");
+   for (Int_t i = 0; i < 50; ++i) {
+      n = i;
+      x = 0.5 * i - 7;
+      u = 65535 - i;
+      b = i % 2;
+      for (Int_t j = 0; j < 4; ++j)
+         arr[j] = i * j - 3;
+      tree->Fill();
+   }
+   tree->ResetBranchAddresses();
+   return tree;
+}
+
+TEST(TTreeFormulaJit, SameResultsAsInterpreter)
+{
+   auto tree = MakeJitTree();
+   const std::vector<const char *> expressions{"x*x+2*n-1",
+                                               "n%3==0 && x>0",
+                                               "n<10 || x>5",
+                                               "!(n>3) ? x : -x",
+                                               "arr*x",
+                                               "Alt$(arr[5],x)",
+                                               "sqrt(abs(x))+TMath::Pi()",
+                                               "n>>1 | 3",
+                                               "u*b+x",
+                                               "b ? u : n"};
+
+   for (auto expression : expressions) {
+      TTreeFormula interpreted("interpreted", expression, tree.get());
+      TTreeFormula compiled("compiled", expression, tree.get());
+      ASSERT_GT(interpreted.GetNdim(), 0) << expression;
+      EXPECT_TRUE(compiled.Jit()) << expression;
+      EXPECT_TRUE(compiled.IsJitted()) << expression;
+
+      for (Long64_t entry = 0; entry < tree->GetEntries(); ++entry) {
+         tree->LoadTree(entry);
+         const Int_t ndata = interpreted.GetNdata();
+         ASSERT_EQ(ndata, compiled.GetNdata()) << expression;
+         for (Int_t instance = 0; instance < ndata; ++instance) {
+            EXPECT_DOUBLE_EQ(interpreted.EvalInstance(instance), compiled.EvalInstance(instance))
+               << expression << " entry " << entry << " instance " << instance;
+         }
+      }
+   }
+}
+
+TEST(TTreeFormulaJit, StringsAreInterpreted)
+{
+   auto tree = MakeJitTree();
+   TTreeFormula formula("string", "\"abc\"", tree.get());
+   EXPECT_FALSE(formula.Jit());
+   EXPECT_FALSE(formula.IsJitted());
+}
+
+// The leaves read directly by the compiled function follow the trees of a chain, which may have other types
+TEST(TTreeFormulaJit, ChainWithDifferentLeafTypes)
+{
+   const std::string fname1 = "formulajit_chain1.root";
+   const std::string fname2 = "formulajit_chain2.root";
+   {
+      TFile f(fname1.c_str(), "RECREATE");
+      TTree t("T", "T");
+      Int_t n = 0;
+      Double_t x = 0;
+      t.Branch("n", &n);
+      t.Branch("x", &x);
+      for (n = 0; n < 10; ++n) {
+         x = 0.5 * n;
+         t.Fill();
+      }
+      t.Write();
+   }
+   {
+      TFile f(fname2.c_str(), "RECREATE");
+      TTree t("T", "T");
+      Int_t n = 0;
+      Float_t x = 0;
+      t.Branch("n", &n);
+      t.Branch("x", &x);
+      for (n = 10; n < 20; ++n) {
+         x = 0.5 * n;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   {
+      TChain chain("T");
+      chain.Add(fname1.c_str());
+      chain.Add(fname2.c_str());
+      chain.LoadTree(0);
+      TTreeFormula formula("f", "2*x+n", &chain);
+      ASSERT_TRUE(formula.Jit());
+      chain.SetNotify(&formula);
+      for (Long64_t entry = 0; entry < chain.GetEntries(); ++entry) {
+         chain.LoadTree(entry);
+         EXPECT_TRUE(formula.IsJitted()) << "entry " << entry;
+         EXPECT_DOUBLE_EQ(formula.EvalInstance(0), 2. * entry) << "entry " << entry;
+      }
+      chain.SetNotify(nullptr);
+   }
+
+   gSystem->Unlink(fname1.c_str());
+   gSystem->Unlink(fname2.c_str());
+}